@@ -70,8 +70,10 @@ class AnaHelpers {
          * @param trk 
          * @param foundL1 
          * @param foundL2 
+         * @param hits TrackerHit collection used to resolve index based hit references
          */
-        void InnermostLayerCheck(Track* trk, bool& foundL1, bool& foundL2);
+        void InnermostLayerCheck(Track* trk, bool& foundL1, bool& foundL2, 
+                                 const std::vector<TrackerHit*>* hits = nullptr);
         
         /**
          * @brief Get the Particles From Vtx object
@@ -79,10 +81,12 @@ class AnaHelpers {
          * @param vtx 
          * @param ele 
          * @param pos 
+         * @param parts Particle collection used to resolve index based particle references
          * @return true 
          * @return false 
          */
-        bool GetParticlesFromVtx(Vertex* vtx, Particle*& ele, Particle*& pos);
+        bool GetParticlesFromVtx(Vertex* vtx, Particle*& ele, Particle*& pos, 
+                                 const std::vector<Particle*>* parts = nullptr);
         
         /**
          * @brief brief description
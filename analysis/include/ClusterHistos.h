@@ -11,8 +11,10 @@
 #include "RawSvtHit.h"
 
 #include "ModuleMapper.h"
+#include "HistoFamily.h"
 
 #include <string>
+#include <vector>
 
 
 class ClusterHistos : public HistoManager{
@@ -51,8 +53,9 @@ class ClusterHistos : public HistoManager{
          * 
          * @param hit 
          * @param weight 
+         * @param rawhits RawSvtHit collection used to resolve index based raw hit references
          */
-        void FillHistograms(TrackerHit* hit, float weight = 1.);
+        void FillHistograms(TrackerHit* hit, float weight = 1., const std::vector<RawSvtHit*>* rawhits = nullptr);
         //void BuildAxesMap();
         
         /**
@@ -85,33 +88,63 @@ class ClusterHistos : public HistoManager{
   
 
     private:
+        /** Histograms defined for each half module, in the order of their family */
+        enum HalfModuleHisto {
+            CHARGE,
+            CLU_SIZE,
+            CHARGE_VS_STRIPPOS,
+            CHARGE_VS_GLOBRAD,
+            CHARGE_CORRECTED_VS_STRIPPOS,
+            SAMPLE0_VS_STRIPPOS,
+            SAMPLE1_VS_STRIPPOS,
+            SAMPLE0_VS_AMP,
+            SAMPLE1_VS_AMP,
+            STRIPPOS_VS_GY,
+            N_HALF_MODULE_HISTOS
+        };
+
+        /** Raw hit sums of one half module over the current cluster */
+        struct ClusterSums {
+            int    cluSize{0}; //!< number of raw hits
+            double charge{0.}; //!< sum of the amplitudes
+            double chargeCorrected{0.}; //!< sum of the baseline corrected amplitudes
+            double position{0.}; //!< sum of the amplitude weighted strips
+        };
+
+        /**
+         * @brief Copy the points of a baseline graph into the per strip
+         *        baselines of the half module it belongs to
+         *
+         * @param name Hw or half module name of the graph
+         * @param graph
+         * @return true if the graph matches a half module
+         */
+        bool setBaselines(const std::string& name, const TGraphErrors* graph);
+
         /** description */
         std::vector<std::string> variables{"charge", "cluSize"};
         
         /** description */
         std::vector<std::string> half_module_names{};
 
-        /** description */
-        std::map<std::string, int>    cluSizeMap;
+        /** Half module histograms, indexed by (layer, module) */
+        HistoFamily hmHistos_;
 
-        /** description */
-        std::map<std::string, double> chargeMap;
+        /** Cluster sums of each half module */
+        std::vector<ClusterSums> cluSums_;
 
-        /** description */
-        std::map<std::string, double> chargeCorrectedMap;
+        /** Half modules with non zero sums for the current cluster */
+        std::vector<int> touched_;
+
+        /** Baseline of each strip, by half module then strip. -999 if not loaded */
+        std::vector<double> baselines_;
 
-        /** description */
-        std::map<std::string, double> cluPositionMap;
-        
         /** description */
         std::string baselineFits_{"/nfs/hps3/svtTests/jlabSystem/baselines/fits/"};
 
         /** description */
         std::string baselineRun_{""};
 
-        /** description */
-        std::map<std::string, TGraphErrors*> baselineGraphs;
-
         /** 
          * description 
          * \todo clean this up
@@ -16,6 +16,8 @@
 //----------------//   
 #include <string>
 #include <map>
+#include <deque>
+#include <vector>
 #include <iostream>
 
 //----------//
@@ -32,6 +34,18 @@
 class FlatTupleMaker {
 
     public:
+        /**
+         * @brief Handle to a typed column of the tuple.
+         * 
+         * Slots are returned when a column is declared and are used to set 
+         * its value without any lookup by name.
+         */
+        template <typename T>
+        struct Slot {
+            int index{-1}; //!< index of the column in the buffer of its type
+            bool valid() const { return index >= 0; }
+        };
+
         /**
          * @brief Constructor
          * 
@@ -95,6 +109,83 @@ class FlatTupleMaker {
          */
         void addToVector(std::string variable_name, double value); 
 
+        /**
+         * @brief Declare a double column (/D).
+         * 
+         * @param name Name of the branch
+         * @return Slot<double> Slot used to set the value of the column
+         */
+        Slot<double> addDouble(const std::string& name);
+
+        /**
+         * @brief Declare a float column (/F).
+         * 
+         * @param name Name of the branch
+         * @return Slot<float> Slot used to set the value of the column
+         */
+        Slot<float> addFloat(const std::string& name);
+
+        /**
+         * @brief Declare an integer column (/I).
+         * 
+         * @param name Name of the branch
+         * @return Slot<int> Slot used to set the value of the column
+         */
+        Slot<int> addInt(const std::string& name);
+
+        /**
+         * @brief Declare a boolean column (/O).
+         * 
+         * @param name Name of the branch
+         * @return Slot<bool> Slot used to set the value of the column
+         */
+        Slot<bool> addBool(const std::string& name);
+
+        /**
+         * @brief Declare a vector of doubles column.
+         * 
+         * @param name Name of the branch
+         * @return Slot<std::vector<double>> Slot used to fill the column
+         */
+        Slot<std::vector<double>> addDoubleVector(const std::string& name);
+
+        /**
+         * @brief Declare a vector of floats column.
+         * 
+         * @param name Name of the branch
+         * @return Slot<std::vector<float>> Slot used to fill the column
+         */
+        Slot<std::vector<float>> addFloatVector(const std::string& name);
+
+        /**
+         * @brief Declare a vector of integers column.
+         * 
+         * @param name Name of the branch
+         * @return Slot<std::vector<int>> Slot used to fill the column
+         */
+        Slot<std::vector<int>> addIntVector(const std::string& name);
+
+        /** @brief Set the value of a double column. */
+        void set(Slot<double> slot, double value) { doubles_[slot.index] = value; }
+
+        /** @brief Set the value of a float column. */
+        void set(Slot<float> slot, float value) { floats_[slot.index] = value; }
+
+        /** @brief Set the value of an integer column. */
+        void set(Slot<int> slot, int value) { ints_[slot.index] = value; }
+
+        /** @brief Set the value of a boolean column. */
+        void set(Slot<bool> slot, bool value) { bools_[slot.index].value = value; }
+
+        /** @brief Append a value to a vector of doubles column. */
+        void push(Slot<std::vector<double>> slot, double value) { double_vectors_[slot.index].push_back(value); }
+
+        /** @brief Append a value to a vector of floats column. */
+        void push(Slot<std::vector<float>> slot, float value) { float_vectors_[slot.index].push_back(value); }
+
+        /** @brief Append a value to a vector of integers column. */
+        void push(Slot<std::vector<int>> slot, int value) { int_vectors_[slot.index].push_back(value); }
+
         /**
          * @brief description
          * 
@@ -148,7 +239,37 @@ class FlatTupleMaker {
 
         /** description */
         std::map <std::string, std::vector<double>> vectors; 
-        
+
+        /** Boolean stored with the size and layout expected by the /O leaves. */
+        struct BoolValue { 
+            bool value{false}; 
+        };
+
+        /**
+         * @brief Create a scalar column in the buffer of its type. The branches 
+         *        of that type are bound again if the buffer was reallocated.
+         */
+        template <typename T>
+        int addScalar(std::vector<T>& buffer, std::vector<std::string>& names, 
+                      const std::string& name, const T& value, const std::string& leaf);
+
+        /** Slot-based scalar columns, stored contiguously by type. */
+        std::vector<double> doubles_;
+        std::vector<float> floats_;
+        std::vector<int> ints_;
+        std::vector<BoolValue> bools_;
+
+        /** Branch names of the scalar columns, in slot order. */
+        std::vector<std::string> double_names_;
+        std::vector<std::string> float_names_;
+        std::vector<std::string> int_names_;
+        std::vector<std::string> bool_names_;
+
+        /** Slot-based vector columns. The deques keep the bound addresses stable. */
+        std::deque<std::vector<double>> double_vectors_;
+        std::deque<std::vector<float>> float_vectors_;
+        std::deque<std::vector<int>> int_vectors_;
+
 
 };
 
@@ -0,0 +1,161 @@
+/**
+ * @file  HistoFamily.h
+ * @brief Copies of json histograms indexed by integers instead of names
+ */
+
+#ifndef HISTOFAMILY_H
+#define HISTOFAMILY_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ROOT
+#include "TH1.h"
+#include "TH2.h"
+
+/**
+ * @brief The copies of a set of json histograms made for each member of a
+ *        dense index space, e.g. one per (layer, module) or (feb, hybrid).
+ *
+ * A family is obtained from HistoManager::getFamily once the copies are
+ * defined. The histograms keep the names given by the manager and are
+ * saved with it; the family only holds pointers to them, so filling
+ * resolves a member and a histogram by index without building any name:
+ *
+ *     int t0 = family.getIndex("SvtHybrids_T0_h");
+ *     family.setMember(layer, module, copy);
+ *     ...
+ *     family.at(hit->getLayer(), hit->getModule()).fill(t0, hit->getT0(0));
+ */
+class HistoFamily {
+
+    public:
+        /**
+         * @brief The histograms of one member of the family. Filling a
+         *        missing member or histogram does nothing.
+         */
+        class Member {
+
+            public:
+                /**
+                 * @brief Fill a 1D histogram
+                 *
+                 * @param index Index from HistoFamily::getIndex
+                 * @param value
+                 * @param weight
+                 */
+                void fill(int index, double value, double weight = 1.) const {
+                    if (TH1* histo = valid(index) ? histos1d_[index] : nullptr) histo->Fill(value, weight);
+                }
+
+                /**
+                 * @brief Fill a 2D histogram
+                 *
+                 * @param index Index from HistoFamily::getIndex
+                 * @param valuex
+                 * @param valuey
+                 * @param weight
+                 */
+                void fill(int index, double valuex, double valuey, double weight) const {
+                    if (TH2* histo = valid(index) ? histos2d_[index] : nullptr) histo->Fill(valuex, valuey, weight);
+                }
+
+                /** @return The histogram, or nullptr if it doesn't exist */
+                TH1* get(int index) const {
+                    if (!valid(index)) return nullptr;
+                    return histos1d_[index] ? histos1d_[index] : histos2d_[index];
+                }
+
+                /** @return Whether the member exists */
+                explicit operator bool() const { return histos1d_ != nullptr; }
+
+            private:
+                friend class HistoFamily;
+
+                Member(TH1* const* histos1d, TH2* const* histos2d, int nhistos) :
+                    histos1d_(histos1d), histos2d_(histos2d), nhistos_(nhistos) {}
+
+                bool valid(int index) const { return histos1d_ && index >= 0 && index < nhistos_; }
+
+                TH1* const* histos1d_{nullptr}; //!< 1D histograms of the member
+                TH2* const* histos2d_{nullptr}; //!< 2D histograms of the member
+                int nhistos_{0}; //!< number of histograms per member
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * @param keys Json keys of the copied histograms
+         * @param nmembers Number of copies
+         */
+        HistoFamily(const std::vector<std::string>& keys = {}, int nmembers = 0);
+
+        /**
+         * @brief Get the index of a histogram of the family
+         *
+         * @param key Json key of the histogram, e.g. "SvtHybrids_T0_h"
+         * @return The index, or -1 if the family has no such histogram
+         */
+        int getIndex(const std::string& key) const;
+
+        /** @return Number of histograms per member */
+        int getNHistos() const { return keys_.size(); }
+
+        /** @return Number of members */
+        int getNMembers() const { return nmembers_; }
+
+        /**
+         * @brief Set the histogram of a member
+         *
+         * @param member Index of the copy
+         * @param index Index of the histogram
+         * @param histo The histogram
+         */
+        void setHisto(int member, int index, TH1* histo) { histos1d_[member*keys_.size()+index] = histo; }
+
+        /**
+         * @brief Set the 2D histogram of a member
+         *
+         * @param member Index of the copy
+         * @param index Index of the histogram
+         * @param histo The histogram
+         */
+        void setHisto(int member, int index, TH2* histo) { histos2d_[member*keys_.size()+index] = histo; }
+
+        /**
+         * @brief Map a position of the 2D index space to a member
+         *
+         * @param i First index, e.g. layer or feb
+         * @param j Second index, e.g. module or hybrid
+         * @param member Index of the copy
+         */
+        void setMember(int i, int j, int member);
+
+        /** @return The member of a copy index */
+        Member at(int member) const {
+            if (member < 0 || member >= nmembers_) return Member(nullptr, nullptr, 0);
+            return Member(histos1d_.data()+member*keys_.size(), histos2d_.data()+member*keys_.size(), keys_.size());
+        }
+
+        /** @return The copy index at a position of the 2D index space, -1 if none */
+        int getMember(int i, int j) const {
+            if (i < 0 || i >= ni_ || j < 0 || j >= nj_) return -1;
+            return members_[i*nj_+j];
+        }
+
+        /** @return The member at a position of the 2D index space */
+        Member at(int i, int j) const { return at(getMember(i, j)); }
+
+    private:
+        std::vector<std::string> keys_; //!< json keys of the histograms
+        std::unordered_map<std::string, int> indices_; //!< index of each key
+        int nmembers_{0}; //!< number of copies
+        std::vector<TH1*> histos1d_; //!< 1D histograms by member then index
+        std::vector<TH2*> histos2d_; //!< 2D histograms by member then index
+        int ni_{0}; //!< size of the first index
+        int nj_{0}; //!< size of the second index
+        std::vector<int> members_; //!< member at each position, -1 if none
+};
+
+#endif
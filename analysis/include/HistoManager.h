@@ -10,6 +10,7 @@
 #include <map>
 #include <vector>
 #include "json.hpp"
+#include "HistoFamily.h"
 
 //for convenience 
 using json = nlohmann::json;
@@ -238,6 +239,18 @@ class HistoManager {
         virtual void DefineHistos(std::vector<std::string> histoCopyNames,
                                   std::string makeCopyJsonTag = "default=single_copy");
 
+        /**
+         * @brief Get the copies made by DefineHistos(histoCopyNames, makeCopyJsonTag)
+         *        as a family, to fill them by index instead of by name.
+         * 
+         * @param histoCopyNames Names given to DefineHistos. Member i of the 
+         *        family is the copy of histoCopyNames[i].
+         * @param makeCopyJsonTag Tag given to DefineHistos
+         * @return HistoFamily Family of the copied 1D and 2D histograms
+         */
+        HistoFamily getFamily(const std::vector<std::string>& histoCopyNames,
+                              const std::string& makeCopyJsonTag);
+
         /**
          * @brief description
          * 
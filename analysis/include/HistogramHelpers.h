@@ -11,6 +11,8 @@
 #include "TFile.h"
 #include "TStyle.h"
 
+#include <vector>
+
 using namespace std;
 
 
@@ -56,6 +58,89 @@ namespace HistogramHelpers {
     int IterativeGaussFit(TH1* hist, double &mu, double &mu_err, double &sigma,
                           double &sigma_err, int m_PrintLevel = 0);
 
+    /**
+     * @brief Contents of a 1D slice of a histogram, e.g. a projection, 
+     *        without creating a TH1. Bins follow the TH1 numbering: 0 is 
+     *        the underflow and nbins+1 the overflow.
+     */
+    struct HistoSlice {
+        std::vector<double> edges; //!< low edges of bins 1..nbins, then the upper edge of the last bin
+        std::vector<double> sumw; //!< bin contents, bins 0..nbins+1
+        std::vector<double> sumw2; //!< squared bin errors, bins 0..nbins+1
+        double entries{0.}; //!< number of entries
+        double mean{0.}; //!< mean of the in range bins
+        double rms{0.}; //!< RMS of the in range bins
+
+        /** @return Number of bins */
+        int getNbins() const { return (int)edges.size()-1; }
+
+        /**
+         * @brief Merge groups of ngroup bins, as TH1::Rebin
+         * 
+         * @param ngroup 
+         */
+        void rebin(int ngroup);
+    };
+
+    /** Result of a Gaussian fit */
+    struct GaussFitResult {
+        double norm{0.}; //!< height of the Gaussian
+        double mu{0.}; //!< mean
+        double mu_err{0.}; //!< error on the mean
+        double sigma{0.}; //!< width
+        double sigma_err{0.}; //!< error on the width
+        int status{1}; //!< 0 if fitted, 1 if not fitted, 2 if not converged
+    };
+
+    /**
+     * @brief Iterative Gaussian fit of a slice, following the same 
+     *        procedure as IterativeGaussFit(TH1*, ...) but with a 
+     *        self-contained chi2 fitter, so it can run on several threads.
+     * 
+     * @param slice The slice, rebinned on a copy if needed
+     * @param fastFitEntries Slices with at least this many entries are fitted
+     *        in closed form (weighted parabola fit of the log of the
+     *        contents) instead of iteratively minimized. 0 disables it.
+     * @return GaussFitResult 
+     */
+    GaussFitResult IterativeGaussFit(HistoSlice slice, double fastFitEntries = 0.);
+
+    /**
+     * @brief Fit all the slices with at least minEntries entries concurrently
+     * 
+     * @param slices 
+     * @param minEntries 
+     * @param nThreads Number of threads, 0 to use all the cores
+     * @param fastFitEntries See IterativeGaussFit(HistoSlice, double)
+     * @return Fit result of each slice
+     */
+    std::vector<GaussFitResult> fitSlices(const std::vector<HistoSlice>& slices, double minEntries,
+                                          int nThreads = 0, double fastFitEntries = 0.);
+
+    /**
+     * @brief Get the Y slice of a range of X bins of a 2D histogram, as 
+     *        TH2::ProjectionY
+     * 
+     * @param hist 
+     * @param firstx 
+     * @param lastx 
+     * @return HistoSlice 
+     */
+    HistoSlice getSliceY(TH2* hist, int firstx, int lastx);
+
+    /**
+     * @brief Get the Z slice of a range of X and Y bins of a 3D histogram, 
+     *        as TH3::ProjectionZ
+     * 
+     * @param hist 
+     * @param firstx 
+     * @param lastx 
+     * @param firsty 
+     * @param lasty 
+     * @return HistoSlice 
+     */
+    HistoSlice getSliceZ(TH3* hist, int firstx, int lastx, int firsty, int lasty);
+
     /**
      * @brief description
      * 
@@ -80,9 +165,16 @@ namespace HistogramHelpers {
      * @param sigma_graph 
      * @param num_bins 
      * @param m_PrintLevel 
+     * @param nThreads 1 fits the projections one by one with IterativeGaussFit(TH1*).
+     *        Other values opt into fitting the slices with IterativeGaussFit(HistoSlice, double)
+     *        on that many threads, 0 to use all the cores. The slice fitter prints its
+     *        results on print level >= 1 but doesn't wait for RETURN.
+     * @param fastFitEntries Entries above which slices are fitted in closed form, 0 to disable.
+     *        Only used by the slice fitter.
      */
     void profileYwithIterativeGaussFit(TH2* hist, TH1* mu_graph, TH1* sigma_graph,
-                                       int num_bins = 1, int m_PrintLevel = 0);
+                                       int num_bins = 1, int m_PrintLevel = 0,
+                                       int nThreads = 1, double fastFitEntries = 0.);
 
     /**
      * @brief description
@@ -93,9 +185,12 @@ namespace HistogramHelpers {
      * @param num_bins 
      * @param mu_err_graph 
      * @param sigma_err_graph 
+     * @param nThreads See profileYwithIterativeGaussFit
+     * @param fastFitEntries See profileYwithIterativeGaussFit
      */
     void profileZwithIterativeGaussFit(TH3* hist, TH2* mu_graph, TH2* sigma_graph,
-                                       int num_bins, TH2* mu_err_graph, TH2* sigma_err_graph);
+                                       int num_bins, TH2* mu_err_graph, TH2* sigma_err_graph,
+                                       int nThreads = 1, double fastFitEntries = 0.);
 
     /**
      * @brief description
@@ -118,7 +213,7 @@ namespace HistogramHelpers {
     void CloseProjectionFile();
 
     /** description */
-    TFile* outFile_for_projections;
+    extern TFile* outFile_for_projections;
 } 
   
 #endif
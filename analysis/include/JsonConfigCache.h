@@ -0,0 +1,49 @@
+#ifndef JSONCONFIGCACHE_H
+#define JSONCONFIGCACHE_H
+
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include "json.hpp"
+
+// for convenience
+using json = nlohmann::json;
+
+/**
+ * @brief Process-wide cache of parsed JSON configuration files.
+ * 
+ * Histogram and selection configurations are typically shared by many 
+ * regions and processors, so each file is parsed once and handed out as a 
+ * copy afterwards. An entry is parsed again if the modification time of the 
+ * file changes. Access is thread safe.
+ */
+class JsonConfigCache {
+
+    public:
+        /**
+         * @brief Get the parsed content of a JSON file.
+         * 
+         * @param fileName Path of the JSON file
+         * @return json Parsed content of the file
+         */
+        static json get(const std::string& fileName);
+
+        /** @brief Drop all the cached entries. */
+        static void clear();
+
+    private:
+        /**
+         * @struct Entry
+         * @brief Parsed content of a file and the modification time it was parsed at.
+         */
+        struct Entry {
+            std::time_t mtime_{0};
+            json content_;
+        };
+
+        static std::mutex mutex_; //!< protects the cache
+        static std::map<std::string, Entry> entries_; //!< cached files by path
+};
+
+#endif
@@ -0,0 +1,164 @@
+/** 
+ * @file  MCGenealogy.h
+ * @brief Event level navigation of the MC particle genealogy
+ */
+
+#ifndef MCGENEALOGY_H
+#define MCGENEALOGY_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// HPSTR
+#include "MCParticle.h"
+
+/**
+ * @brief Mother and daughter navigation of the MC particles of an event.
+ * 
+ * Uses the particle, mother and daughter indices written by 
+ * MCParticleProcessor with writeGenealogy. Built once per event, it also 
+ * indexes the particles by ID and by PDG so that truth lookups don't scan 
+ * the particle collection. Mother and daughter navigation returns nothing 
+ * on files written without the genealogy.
+ */
+class MCGenealogy {
+
+    public:
+        /**
+         * @brief Build the index for the current event.
+         * 
+         * @param parts MC particles of the event
+         * @param daughters Daughter indices of the event, the "<collection>_daughters" branch
+         */
+        void build(const std::vector<MCParticle*>* parts, const std::vector<int>* daughters = nullptr);
+
+        /** @brief Clear the index */
+        void clear();
+
+        /** @return Number of particles in the event */
+        int size() const { return parts_ ? parts_->size() : 0; }
+
+        /**
+         * @brief Get a MC particle by index
+         * 
+         * @param index Index of the particle in the collection
+         * @return MCParticle* The particle, or nullptr if out of range
+         */
+        MCParticle* getParticle(int index) const {
+            return index >= 0 && index < size() ? (*parts_)[index] : nullptr;
+        }
+
+        /**
+         * @brief Get the index of a MC particle from its ID
+         * 
+         * @param partID ID of the MC particle
+         * @return The index, or -1 if not in the event
+         */
+        int getIndex(int partID) const;
+
+        /**
+         * @brief Get a MC particle by ID
+         * 
+         * @param partID ID of the MC particle
+         * @return MCParticle* The particle, or nullptr if not in the event
+         */
+        MCParticle* getParticleByID(int partID) const { return getParticle(getIndex(partID)); }
+
+        /**
+         * @brief Get the indices of the MC particles of a PDG ID
+         * 
+         * @param pdg PDG ID
+         * @return Indices of the particles, in collection order
+         */
+        std::vector<int> getIndicesWithPDG(int pdg) const;
+
+        /**
+         * @brief Get the last MC particle of a PDG ID in collection order
+         * 
+         * @param pdg PDG ID
+         * @return MCParticle* The particle, or nullptr if there is none
+         */
+        MCParticle* getLastWithPDG(int pdg) const;
+
+        /**
+         * @brief Get the mother of a particle
+         * 
+         * @param part The particle
+         * @return MCParticle* The mother, or nullptr if it has none
+         */
+        MCParticle* getMother(const MCParticle* part) const { return getParticle(part->getMomIndex()); }
+
+        /**
+         * @brief Get the ancestors of a particle, from its mother up
+         * 
+         * @param part The particle
+         * @return The ancestors
+         */
+        std::vector<MCParticle*> getAncestors(const MCParticle* part) const;
+
+        /**
+         * @brief Get the closest ancestor of a particle with a given PDG ID
+         * 
+         * @param part The particle
+         * @param pdg PDG ID of the ancestor
+         * @return MCParticle* The ancestor, or nullptr if there is none
+         */
+        MCParticle* getAncestorWithPDG(const MCParticle* part, int pdg) const;
+
+        /** @return Number of daughters of a particle */
+        int getNDaughters(const MCParticle* part) const { return daughters_ ? part->getNDaughterIndices() : 0; }
+
+        /**
+         * @brief Get a daughter of a particle
+         * 
+         * @param part The particle
+         * @param idaughter Position of the daughter, below getNDaughters()
+         * @return MCParticle* The daughter
+         */
+        MCParticle* getDaughter(const MCParticle* part, int idaughter) const {
+            return getParticle((*daughters_)[part->getDaughterBegin()+idaughter]);
+        }
+
+        /**
+         * @brief Visit the decay chain of a particle, depth first. The 
+         *        particle itself is not visited.
+         * 
+         * @param part The particle
+         * @param visit Called with each descendant and its generation, 1 for 
+         *        the daughters. Returning false skips the descendants of the 
+         *        particle visited.
+         */
+        template <typename Visitor>
+            void visitDecayChain(const MCParticle* part, Visitor visit) const {
+                if (!daughters_) 
+                    return;
+                // Daughters are pushed in reverse so they are visited in order
+                std::vector<std::pair<MCParticle*, int>> stack;
+                auto push = [&](const MCParticle* mother, int generation) {
+                    // Guard against loops in corrupted genealogies
+                    if (generation > size()) 
+                        return;
+                    for (int idaughter = getNDaughters(mother)-1; idaughter >= 0; --idaughter) {
+                        if (MCParticle* daughter = getDaughter(mother, idaughter))
+                            stack.emplace_back(daughter, generation);
+                    }
+                };
+                push(part, 1);
+                while (!stack.empty()) {
+                    MCParticle* daughter = stack.back().first;
+                    int generation = stack.back().second;
+                    stack.pop_back();
+                    if (visit(daughter, generation))
+                        push(daughter, generation+1);
+                }
+            }
+
+    private:
+        const std::vector<MCParticle*>* parts_{nullptr}; //!< MC particles of the event
+        const std::vector<int>* daughters_{nullptr}; //!< daughter indices of the event
+        std::unordered_map<int, int> indices_; //!< particle indices by ID
+        std::vector<std::pair<int, int>> pdg_indices_; //!< (PDG ID, index) sorted by PDG ID
+};
+
+#endif
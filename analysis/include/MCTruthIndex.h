@@ -0,0 +1,87 @@
+/** 
+ * @file  MCTruthIndex.h
+ * @brief Event level index of the MC truth of the tracker hits
+ */
+
+#ifndef MCTRUTHINDEX_H
+#define MCTRUTHINDEX_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// HPSTR
+#include "MCParticle.h"
+#include "Track.h"
+#include "TrackerHit.h"
+
+/**
+ * @brief Index of the MC particles contributing to each tracker hit, and of 
+ *        the MC particles by ID.
+ * 
+ * Built once per event, it replaces the maps rebuilt for every track when 
+ * matching tracks to their MC truth.
+ */
+class MCTruthIndex {
+
+    public:
+        /** Iterator over the (hit ID, MC particle ID) pairs of the index */
+        typedef std::vector<std::pair<int, int>>::const_iterator const_iterator;
+
+        /**
+         * @brief Build the index for the current event.
+         * 
+         * @param hits Tracker hits of the event
+         * @param parts MC particles of the event
+         */
+        void build(const std::vector<TrackerHit*>* hits, const std::vector<MCParticle*>* parts);
+
+        /** @brief Clear the index */
+        void clear();
+
+        /**
+         * @brief Get the MC particle IDs of a hit
+         * 
+         * @param hitID ID of the tracker hit
+         * @return Range of (hit ID, MC particle ID) pairs of the hit
+         */
+        std::pair<const_iterator, const_iterator> getMCPartIDs(int hitID) const;
+
+        /**
+         * @brief Check if a MC particle contributed to a hit
+         * 
+         * @param hitID ID of the tracker hit
+         * @param partID ID of the MC particle
+         * @return true if the particle contributed to the hit
+         */
+        bool hasMCPart(int hitID, int partID) const;
+
+        /**
+         * @brief Get a MC particle by ID
+         * 
+         * @param partID ID of the MC particle
+         * @return MCParticle* The particle, or nullptr if not in the event
+         */
+        MCParticle* getParticle(int partID) const;
+
+        /**
+         * @brief Get the MC particle contributing to the largest number of hits 
+         *        of a track. Ties are resolved in favour of the lowest ID.
+         * 
+         * @param track The track
+         * @param hits Tracker hits used to resolve index based hit references
+         * @param nHits Number of hits of the track from the particle, if not null
+         * @return int ID of the particle, 0 if no hit has truth information
+         */
+        int getMajorityParticle(const Track* track, const std::vector<TrackerHit*>* hits = nullptr, 
+                                int* nHits = nullptr) const;
+
+    private:
+        /** Maximum number of distinct particles counted on a track */
+        static const int MAX_TRACK_PARTS = 64;
+
+        std::vector<std::pair<int, int>> hit_parts_; //!< (hit ID, MC particle ID) sorted by hit ID
+        std::unordered_map<int, MCParticle*> parts_; //!< MC particles by ID
+};
+
+#endif
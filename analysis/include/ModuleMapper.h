@@ -6,6 +6,9 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <utility>
+
+#include "HistoFamily.h"
 
 
 class ModuleMapper {
@@ -64,6 +67,49 @@ class ModuleMapper {
          */
         std::string getStringFromSw(const std::string& key)  {return sw_to_string[key];};
 
+        /**
+         * @brief Get the feb and hybrid of a sensor without string lookups
+         *
+         * @param layer
+         * @param module
+         * @param feb Set to the feb, or -1 if the sensor is unknown
+         * @param hybrid Set to the hybrid, or -1 if the sensor is unknown
+         */
+        void getFebHybridFromSw(int layer, int module, int& feb, int& hybrid) const {
+            int index = layer*nModules_ + module;
+            bool known = layer >= 0 && module >= 0 && module < nModules_ && index < (int)sw_to_febhyb.size();
+            feb = known ? sw_to_febhyb[index].first : -1;
+            hybrid = known ? sw_to_febhyb[index].second : -1;
+        }
+
+        /**
+         * @brief Index a family of per-sensor histograms by (layer, module)
+         *
+         * @param family Family from HistoManager::getFamily
+         * @param strings Names the family was defined with, from getStrings
+         */
+        void setFamilySw(HistoFamily& family, const std::vector<std::string>& strings);
+
+        /**
+         * @brief Parse a sw name
+         *
+         * @param sw Name "ly<layer>_m<module>"
+         * @param layer
+         * @param module
+         * @return Whether the name could be parsed
+         */
+        static bool parseSw(const std::string& sw, int& layer, int& module);
+
+        /**
+         * @brief Parse a hw name
+         *
+         * @param hw Name "F<feb>H<hybrid>"
+         * @param feb
+         * @param hybrid
+         * @return Whether the name could be parsed
+         */
+        static bool parseHw(const std::string& hw, int& feb, int& hybrid);
+
         /**
          * @brief Get the Hybrid Strings
          *
@@ -170,6 +216,9 @@ class ModuleMapper {
 
         typedef std::map<std::string,std::string>::iterator strmap_it; //!< description
 
+        int nModules_{0}; //!< modules per layer in sw_to_febhyb
+        std::vector<std::pair<int,int>> sw_to_febhyb; //!< (feb, hybrid) by layer*nModules_+module
+
         std::map<std::string,std::map<std::string,std::vector<int>>> apvChannelMap_; //!< description
         std::map<std::string, std::vector<int>> thresholdsIn_; //!< description
 };
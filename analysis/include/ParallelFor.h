@@ -0,0 +1,26 @@
+/** 
+ * @file  ParallelFor.h
+ * @brief Run independent iterations of a loop on several threads
+ */
+
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief Call fn(i) for every i in [0, n) on up to nThreads threads.
+ * 
+ * Iterations are handed out one at a time in increasing order, and the 
+ * calling thread takes part in the work. Iterations must not depend on 
+ * each other.
+ * 
+ * @param n Number of iterations
+ * @param nThreads Number of threads, 0 or negative to use all the cores
+ * @param fn Body of the loop
+ * @throw The first exception thrown by fn, once all the threads finished
+ */
+void parallelFor(size_t n, int nThreads, const std::function<void(size_t)>& fn);
+
+#endif
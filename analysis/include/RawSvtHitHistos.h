@@ -29,6 +29,15 @@ class RawSvtHitHistos : public HistoManager{
         void FillHistograms(RawSvtHit* rawSvtHit,float weight = 1.,int Ireg=0,unsigned int nhit = 0,Float_t TimeDiff = -42069.0,Float_t AmpDiff = -42069.0);
         void saveHistosSVT(TFile* outF,std::string folder);
     private:
+        /** Per hybrid histograms, in the order of their json keys in hybridKeys */
+        enum HybridHisto {
+            FIT_N, T0, AM, CHI_SQR, ADC_COUNT, ADC_COUNT_DESHIFT, T0_ERR, AM_ERR, AM_T0,
+            AM_ERR_T0_ERR, AM_T0_ERR, AM_ERR_T0, PT1_PT2, TD, T0_TD, AM_ERR_TD, AMP_TD,
+            AMP12, AD_TD, N_HYBRID_HISTOS
+        };
+
+        HistoFamily hybridHistos_; //!< per hybrid histograms by (layer, module)
+        int hybridIndex_[N_HYBRID_HISTOS]; //!< index of each HybridHisto in hybridHistos_
 
         int Event_number=0;
 
@@ -47,7 +56,6 @@ class RawSvtHitHistos : public HistoManager{
         std::vector<std::string> regions_;
         std::vector<std::string> hybridNames;
         std::vector<std::string> hybridNames2;
-        std::string swTag;
 };
 
 
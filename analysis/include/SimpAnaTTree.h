@@ -19,7 +19,7 @@ class SimpAnaTTree : public MutableTTree {
     public:
 
         SimpAnaTTree(TFile* infile, std::string tree_name) : MutableTTree(infile,tree_name){};
-        ~SimpAnaTTree();
+        ~SimpAnaTTree(){};
 
         /**
          *@brief New Variables
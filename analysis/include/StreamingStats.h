@@ -0,0 +1,234 @@
+/**
+ * @file  StreamingStats.h
+ * @brief Mergeable accumulators of summary statistics, filled one value at a time
+ */
+
+#ifndef STREAMINGSTATS_H
+#define STREAMINGSTATS_H
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/** Number of SVT channels, the size of a per channel StatsArray */
+constexpr int N_SVT_CHANNELS = 24576;
+
+/** Number of SVT hybrids, the size of a per hybrid StatsArray indexed by feb*4+hybrid */
+constexpr int N_SVT_HYBRIDS = 40;
+
+/**
+ * @brief Index of an SVT channel, in the order of the baseline and time
+ *        profile files: FEBs 0-1 have 512 channels per hybrid, the others 640.
+ *
+ * @param feb
+ * @param hybrid
+ * @param channel
+ * @return The index, between 0 and N_SVT_CHANNELS-1
+ */
+inline int getSvtChannel(int feb, int hybrid, int channel) {
+    return feb < 2 ? feb*2048 + hybrid*512 + channel : 4096 + (feb-2)*2560 + hybrid*640 + channel;
+}
+
+/**
+ * @brief Mean, variance and range of a stream of values, with Welford's
+ *        update so that long runs don't lose precision.
+ *
+ * Accumulators filled separately, e.g. by several threads or from several
+ * files, are combined with merge().
+ */
+class RunningMoments {
+
+    public:
+        /**
+         * @brief Add a value
+         *
+         * @param value
+         * @param weight
+         */
+        void fill(double value, double weight = 1.);
+
+        /**
+         * @brief Add the values of another accumulator
+         *
+         * @param other
+         */
+        void merge(const RunningMoments& other);
+
+        /** @return Number of values */
+        long getEntries() const { return entries_; }
+
+        /** @return Sum of the weights */
+        double getSumW() const { return sumw_; }
+
+        /** @return Weighted mean, 0 if empty */
+        double getMean() const { return mean_; }
+
+        /** @return Weighted variance, normalized to the sum of weights as TH1::GetRMS */
+        double getVariance() const { return sumw_ > 0. ? m2_/sumw_ : 0.; }
+
+        /** @return Square root of the variance */
+        double getRMS() const;
+
+        /** @return Smallest value */
+        double getMin() const { return min_; }
+
+        /** @return Largest value */
+        double getMax() const { return max_; }
+
+    private:
+        long entries_{0}; //!< number of values
+        double sumw_{0.}; //!< sum of the weights
+        double mean_{0.}; //!< weighted mean
+        double m2_{0.}; //!< weighted sum of squared deviations from the mean
+        double min_{0.}; //!< smallest value
+        double max_{0.}; //!< largest value
+};
+
+/**
+ * @brief Counts of a stream of values in fixed bins.
+ *
+ * Quantiles are read from the cumulative counts, with the resolution of
+ * the binning, and the statistics follow TH1: under/overflows are counted
+ * but left out of the mean, RMS and quantiles. Counts with the same
+ * binning are combined exactly with merge().
+ */
+class BinnedCounts {
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param nbins Number of bins
+         * @param min Lower edge of the first bin
+         * @param max Upper edge of the last bin
+         */
+        BinnedCounts(int nbins, double min, double max);
+
+        /** @return The bin of a value, 0 for underflow and nbins+1 for overflow, as TAxis::FindBin */
+        int findBin(double value) const {
+            if (value < min_) return 0;
+            if (!(value < max_)) return nbins_+1;
+            return 1 + int(nbins_*(value-min_)/(max_-min_));
+        }
+
+        /**
+         * @brief Add a value
+         *
+         * @param value
+         * @param weight
+         */
+        void fill(double value, double weight = 1.);
+
+        /**
+         * @brief Add the counts of another accumulator with the same binning
+         *
+         * @param other
+         */
+        void merge(const BinnedCounts& other);
+
+        /** @return Number of bins, without under/overflow */
+        int getNbins() const { return nbins_; }
+
+        /** @return Center of a bin, as TAxis::GetBinCenter */
+        double getBinCenter(int bin) const { return min_ + (bin-0.5)*(max_-min_)/nbins_; }
+
+        /** @return Content of a bin, 0 and nbins+1 being the under/overflow */
+        double getBinContent(int bin) const { return counts_.at(bin); }
+
+        /** @return Number of values, including under/overflows */
+        long getEntries() const { return entries_; }
+
+        /** @return Mean of the values in range, as TH1::GetMean */
+        double getMean() const { return sumw_ > 0. ? sumwx_/sumw_ : 0.; }
+
+        /** @return RMS of the values in range, as TH1::GetRMS */
+        double getRMS() const;
+
+        /**
+         * @brief Get the statistics in the layout of TH1::GetStats, so that
+         *        a TH1 with the same binning can take them with PutStats
+         *
+         * @param stats Sum of weights, of squared weights, of weighted values and of weighted squared values
+         */
+        void getStats(double stats[4]) const {
+            stats[0] = sumw_;
+            stats[1] = sumw2_;
+            stats[2] = sumwx_;
+            stats[3] = sumwx2_;
+        }
+
+        /**
+         * @brief Get a quantile of the values in range, interpolating
+         *        linearly inside the bin where it falls
+         *
+         * @param fraction Between 0 and 1, e.g. 0.5 for the median
+         * @return The quantile, 0 if empty
+         */
+        double getQuantile(double fraction) const;
+
+        /** @return First bin in range above a threshold, -1 if none, as TH1::FindFirstBinAbove */
+        int findFirstBinAbove(double threshold) const;
+
+        /** @return Last bin in range above a threshold, -1 if none, as TH1::FindLastBinAbove */
+        int findLastBinAbove(double threshold) const;
+
+    private:
+        int nbins_; //!< number of bins
+        double min_; //!< lower edge
+        double max_; //!< upper edge
+        std::vector<double> counts_; //!< content of each bin, with under/overflow
+        long entries_{0}; //!< number of values
+        double sumw_{0.}; //!< sum of the weights in range
+        double sumw2_{0.}; //!< sum of the squared weights in range
+        double sumwx_{0.}; //!< sum of the weighted values in range
+        double sumwx2_{0.}; //!< sum of the weighted squared values in range
+};
+
+/**
+ * @brief One accumulator per channel, hybrid or any other dense index,
+ *        merged element by element.
+ *
+ *     StatsArray<RunningMoments> adcs(N_SVT_CHANNELS);
+ *     adcs[getSvtChannel(feb, hybrid, strip)].fill(adc);
+ *     StatsArray<BinnedCounts> times(N_SVT_HYBRIDS, BinnedCounts(200, -100., 100.));
+ */
+template <typename Accumulator>
+class StatsArray {
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * @param size Number of accumulators
+         * @param prototype Initial state of each accumulator, e.g. its binning
+         */
+        explicit StatsArray(size_t size, const Accumulator& prototype = Accumulator()) :
+            stats_(size, prototype) {}
+
+        /** @return The accumulator at an index */
+        Accumulator& operator[](size_t index) { return stats_[index]; }
+
+        /** @return The accumulator at an index */
+        const Accumulator& operator[](size_t index) const { return stats_[index]; }
+
+        /** @return Number of accumulators */
+        size_t size() const { return stats_.size(); }
+
+        /**
+         * @brief Merge the accumulators of another array of the same size
+         *
+         * @param other
+         */
+        void merge(const StatsArray& other) {
+            if (other.size() != size())
+                throw std::runtime_error("[ StatsArray ]: Can't merge "+std::to_string(other.size())
+                        +" accumulators into "+std::to_string(size()));
+            for (size_t index = 0; index < stats_.size(); ++index)
+                stats_[index].merge(other.stats_[index]);
+        }
+
+    private:
+        std::vector<Accumulator> stats_; //!< accumulator of each index
+};
+
+#endif
@@ -9,10 +9,12 @@
 #include "TH1.h"
 #include "TrackerHit.h"
 #include "RawSvtHit.h"
+#include "RawSvtHitArrays.h"
 
 #include "ModuleMapper.h"
 
 #include <string>
+#include <vector>
 
 /**
  * @brief description
@@ -45,13 +47,71 @@ class Svt2DBlHistos : public HistoManager{
          */
         void FillHistograms(std::vector<RawSvtHit*> *rawSvtHits_,float weight = 1.);
 
+        /**
+         * @brief Fill the histograms from raw hits stored as flat arrays
+         *
+         * @param rawSvtHits
+         * @param weight
+         */
+        void FillHistograms(const RawSvtHitArrays& rawSvtHits,float weight = 1.);
+
+        /**
+         * @brief Fill the per hybrid baseline histograms from several threads.
+         *
+         * The ADC samples of the raw hits are buffered per hybrid and, once
+         * enough are buffered, the threads fill the histograms of whole
+         * hybrids. Each histogram is filled by a single thread in the order
+         * of the hits, so the output is identical to the serial one.
+         *
+         * @param nThreads Number of threads, 0 to use all the cores, 1 to fill serially
+         */
+        void setThreads(int nThreads);
+
+        /**
+         * @brief Fill the buffered ADC samples into the histograms
+         */
+        void flush();
+
+        /**
+         * @brief Flush, then save the histograms
+         *
+         * @param outF
+         * @param folder
+         */
+        virtual void saveHistos(TFile* outF = nullptr, std::string folder = "");
+
 
     private:
 
+        /**
+         * @brief Fill the histograms from nhits hits, hitAt(i) giving access 
+         *        to the i-th hit through operator->
+         */
+        template <typename HitAt>
+            void fillHits(int nhits, HitAt hitAt, float weight);
+
         int Event_number=0; //!< description
         int debug_ = 1; //!< description
 
         TH1F* svtCondHisto{nullptr}; //!< description 
+
+        HistoFamily hybridHistos_; //!< per hybrid histograms by (layer, module)
+        int hitNIndex_{-1}; //!< index of SvtHybridsHitN_h in hybridHistos_
+        int s0Index_{-1}; //!< index of SvtHybrids_s0_hh in hybridHistos_
+        int s3Index_{-1}; //!< index of SvtHybrids_s3_hh in hybridHistos_
+
+        /** ADC samples of a raw hit, buffered until they are filled */
+        struct BlSample {
+            float strip; //!< strip number
+            float adc0; //!< sample 0
+            float adc3; //!< sample 3
+            float weight; //!< weight
+        };
+
+        int nThreads_{1}; //!< threads filling the baseline histograms
+        std::vector<std::vector<BlSample>> samples_; //!< buffered samples of each hybrid
+        size_t nSamples_{0}; //!< number of buffered samples
+        size_t maxSamples_{1<<22}; //!< number of samples buffered before filling
         //ModuleMapper
         ModuleMapper* mmapper_; //!< description
 };
@@ -6,6 +6,9 @@
 #include "TrackerHit.h"
 #include "Vertex.h"
 #include "Particle.h"
+#include "VertexCandidate.h"
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -51,14 +54,38 @@ class TrackHistos : public HistoManager {
          */
         void DefineTrkHitHistos();
 
+        /**
+         * @brief Delete the histograms and drop the fill plans
+         * 
+         */
+        virtual void Clear();
+
         /**
          * @brief Fill 1D track.
          * 
+         * The histograms of each prefix are looked up once, at its first
+         * fill, so they must be defined before. Variables without a
+         * histogram in the config are skipped.
+         * 
          * @param track 
          * @param weight 
          * @param trkname 
+         * @param hits TrackerHit collection used to resolve index based hit references
          */
-        void Fill1DTrack(Track* track, float weight = 1., const std::string& trkname = "");
+        void Fill1DTrack(Track* track, float weight = 1., const std::string& trkname = "",
+                         const std::vector<TrackerHit*>* hits = nullptr);
+
+        /**
+         * @brief Fill 1D track, with its number of 2D hits already computed.
+         * 
+         * @param track 
+         * @param n_hits_2d 
+         * @param weight 
+         * @param trkname 
+         * @param hits TrackerHit collection used to resolve index based hit references
+         */
+        void Fill1DTrack(Track* track, int n_hits_2d, float weight, const std::string& trkname,
+                         const std::vector<TrackerHit*>* hits = nullptr);
         
         /**
          * @brief Fill 2D track.
@@ -78,8 +105,10 @@ class TrackHistos : public HistoManager {
          * @param ly 
          * @param res 
          * @param sigma 
+         * @param hits TrackerHit collection used to resolve index based hit references
          */
-        void FillResidualHistograms(Track* track, int ly, double res, double sigma);
+        void FillResidualHistograms(Track* track, int ly, double res, double sigma,
+                                    const std::vector<TrackerHit*>* hits = nullptr);
         
         /**
          * @brief description
@@ -100,8 +129,21 @@ class TrackHistos : public HistoManager {
          * @param ele_trk 
          * @param pos_trk 
          * @param weight 
+         * @param hits TrackerHit collection used to resolve index based hit references
+         */
+        void Fill1DVertex(Vertex* vtx, Particle* ele, Particle* pos, Track* ele_trk, Track* pos_trk, float weight = 1.,
+                          const std::vector<TrackerHit*>* hits = nullptr);
+
+        /**
+         * @brief Fill the vertex, its tracks and the electron/positron 
+         *        variables from the precomputed variables of the vertex.
+         * 
+         * @param cand 
+         * @param weight 
+         * @param hits TrackerHit collection used to resolve index based hit references
          */
-        void Fill1DVertex(Vertex* vtx, Particle* ele, Particle* pos, Track* ele_trk, Track* pos_trk, float weight = 1.);
+        void Fill1DVertex(const VertexCandidate& cand, float weight = 1., 
+                          const std::vector<TrackerHit*>* hits = nullptr);
 
         /**
          * @brief Fill 1D histograms.
@@ -146,6 +188,77 @@ class TrackHistos : public HistoManager {
         void doTrackComparisonPlots(bool doplots) { doTrkCompPlots = doplots; };
 
     private:
+        /** Value of a track variable, given the track and its number of 2D hits */
+        typedef double (*TrackGetter)(Track* track, int n_hits_2d);
+
+        /** Value of a vertex variable, given the vertex and its position in the SVT frame */
+        typedef double (*VertexGetter)(Vertex* vtx, const TVector3& svtPos);
+
+        /** 1D histogram of a track variable */
+        struct TrackFill1D {
+            TH1* histo; //!< histogram
+            TrackGetter get; //!< value
+        };
+
+        /** 2D histogram of a pair of track variables */
+        struct TrackFill2D {
+            TH2* histo; //!< histogram
+            TrackGetter getX; //!< x value
+            TrackGetter getY; //!< y value
+        };
+
+        /** 1D histogram of a vertex variable */
+        struct VertexFill1D {
+            TH1* histo; //!< histogram
+            VertexGetter get; //!< value
+            bool weighted; //!< fill with the weight of the vertex
+        };
+
+        /** 2D histogram of a pair of vertex variables */
+        struct VertexFill2D {
+            TH2* histo; //!< histogram
+            VertexGetter getX; //!< x value
+            VertexGetter getY; //!< y value
+        };
+
+        /** Histograms of the tracks of one prefix, without those missing from the config */
+        struct TrackPlan {
+            std::vector<TrackFill1D> fills1d; //!< plain 1D variables of Fill1DTrack
+            std::vector<TrackFill2D> fills2d; //!< 2D variables of Fill1DTrack
+            std::vector<TrackFill2D> fills2dTrack; //!< 2D variables of Fill2DTrack
+            TH1* topZ0{nullptr}; //!< z0 of the top tracks
+            TH1* botZ0{nullptr}; //!< z0 of the bottom tracks
+            TH1* hitLayer{nullptr}; //!< layer of the hits on track
+            TH1* sharingHits{nullptr}; //!< shared hits category
+            TH1* strategy{nullptr}; //!< seeding strategy
+        };
+
+        /** Histograms of Fill1DVertex(Vertex*), without those missing from the config */
+        struct VertexPlan {
+            std::vector<VertexFill1D> fills1d; //!< 1D variables
+            std::vector<VertexFill2D> fills2d; //!< 2D variables
+        };
+
+        /**
+         * @brief Get the plan of a track prefix, building it at the first call
+         * 
+         * @param trkname Prefix of the histogram names, e.g. "ele_"
+         * @return The plan
+         */
+        const TrackPlan& getTrackPlan(const std::string& trkname);
+
+        /** @return The 1D histogram of a name without m_name, nullptr if it isn't defined */
+        TH1* find1DHisto(const std::string& histoName) const;
+
+        /** @return The 2D histogram of a name without m_name, nullptr if it isn't defined */
+        TH2* find2DHisto(const std::string& histoName) const;
+
+        /** Plan of each track prefix */
+        std::map<std::string, TrackPlan> trackPlans_;
+
+        /** Plan of the vertex variables, built at the first vertex fill */
+        std::unique_ptr<VertexPlan> vertexPlan_;
+
         /** Vertices */
         std::vector<std::string> vPs{"vtx_chi2", "vtx_X", "vtx_Y", "vtx_Z", "vtx_sigma_X","vtx_sigma_Y","vtx_sigma_Z","vtx_InvM","vtx_InvMErr"};
 
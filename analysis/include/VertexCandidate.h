@@ -0,0 +1,138 @@
+/**
+ * @file  VertexCandidate.h
+ * @brief Derived analysis variables of a vertex and its daughters
+ */
+
+#ifndef VERTEXCANDIDATE_H
+#define VERTEXCANDIDATE_H
+
+#include <string>
+#include <vector>
+
+// HPSTR
+#include "Particle.h"
+#include "Track.h"
+#include "TrackerHit.h"
+#include "Vertex.h"
+
+class AnaHelpers;
+
+/**
+ * @brief A vertex with its electron and positron, and the variables derived
+ *        from them.
+ *
+ * The variables are computed once per vertex and stored in a flat array.
+ * They are read by index by the selections, the histograms and the flat
+ * tuples, so a new variable only has to be added to the list below and
+ * computed in build().
+ */
+class VertexCandidate {
+
+    public:
+        /** Index of the derived variables */
+        enum Variable {
+            ELE_E,              //!< electron energy
+            POS_E,              //!< positron energy
+            E_SUM,              //!< electron + positron energy
+            ELE_CLUS_E,         //!< electron cluster energy
+            POS_CLUS_E,         //!< positron cluster energy
+            CLUS_E_SUM,         //!< electron + positron cluster energy
+            ELE_PX,             //!< electron track momentum x
+            ELE_PY,             //!< electron track momentum y
+            ELE_PZ,             //!< electron track momentum z
+            ELE_P,              //!< electron track momentum magnitude
+            POS_PX,             //!< positron track momentum x
+            POS_PY,             //!< positron track momentum y
+            POS_PZ,             //!< positron track momentum z
+            POS_P,              //!< positron track momentum magnitude
+            P_SUM,              //!< sum of the track momentum magnitudes
+            VTX_P,              //!< magnitude of the sum of the track momenta
+            ELE_TRK_TIME,       //!< electron track time
+            POS_TRK_TIME,       //!< positron track time
+            ELE_CLUS_CORR_TIME, //!< electron cluster time minus the time offset
+            POS_CLUS_CORR_TIME, //!< positron cluster time minus the time offset
+            BOT_CLUS_TIME,      //!< time of the cluster in the bottom half
+            ELE_POS_CLUS_DT,    //!< electron - positron corrected cluster time
+            ELE_TRK_CLUS_DT,    //!< electron track - corrected cluster time
+            POS_TRK_CLUS_DT,    //!< positron track - corrected cluster time
+            ELE_TRK_CLUS_MATCH, //!< electron track-cluster match goodness
+            POS_TRK_CLUS_MATCH, //!< positron track-cluster match goodness
+            ELE_N2D_HITS,       //!< electron 2D hits
+            POS_N2D_HITS,       //!< positron 2D hits
+            ELE_CHI2,           //!< electron track chi2
+            POS_CHI2,           //!< positron track chi2
+            ELE_CHI2NDF,        //!< electron track chi2/ndf
+            POS_CHI2NDF,        //!< positron track chi2/ndf
+            ELE_NSHARED,        //!< electron track shared hits
+            POS_NSHARED,        //!< positron track shared hits
+            ELE_L1,             //!< electron track has a hit in the innermost layer
+            ELE_L2,             //!< electron track has a hit in the second innermost layer
+            POS_L1,             //!< positron track has a hit in the innermost layer
+            POS_L2,             //!< positron track has a hit in the second innermost layer
+            N_VARIABLES
+        };
+
+        /**
+         * @brief Compute the variables of a vertex.
+         *
+         * The tracks are the ones used in the analysis, after any correction,
+         * and must outlive the candidate. The innermost layer flags are left
+         * at 0 until checkInnermostLayers() is called.
+         *
+         * @param vtx The vertex
+         * @param ele The electron
+         * @param pos The positron
+         * @param ele_trk Track of the electron
+         * @param pos_trk Track of the positron
+         * @param timeOffset Offset subtracted from the cluster times
+         */
+        void build(Vertex* vtx, Particle* ele, Particle* pos, Track* ele_trk, Track* pos_trk,
+                   double timeOffset);
+
+        /**
+         * @brief Set the innermost layer flags of the tracks.
+         *
+         * @param ah Helper used to check the hits of the tracks
+         * @param hits TrackerHit collection used to resolve index based hit references
+         */
+        void checkInnermostLayers(AnaHelpers& ah, const std::vector<TrackerHit*>* hits = nullptr);
+
+        /** @return The value of a variable */
+        double operator[](Variable var) const { return values_[var]; }
+
+        /** @return The value of a variable */
+        double get(Variable var) const { return values_[var]; }
+
+        Vertex* getVertex() const { return vtx_; }
+        Particle* getElectron() const { return ele_; }
+        Particle* getPositron() const { return pos_; }
+        Track* getEleTrack() const { return ele_trk_; }
+        Track* getPosTrack() const { return pos_trk_; }
+
+        /**
+         * @brief Get the name of a variable
+         *
+         * @param var The variable
+         * @return Its name, e.g. "ele_trk_clus_dt"
+         */
+        static const std::string& getName(Variable var);
+
+        /**
+         * @brief Get the index of a variable from its name
+         *
+         * @param name Name of the variable
+         * @return The index, or -1 if there is no such variable
+         */
+        static int getIndex(const std::string& name);
+
+    private:
+        Vertex* vtx_{nullptr}; //!< the vertex
+        Particle* ele_{nullptr}; //!< the electron
+        Particle* pos_{nullptr}; //!< the positron
+        Track* ele_trk_{nullptr}; //!< track of the electron
+        Track* pos_trk_{nullptr}; //!< track of the positron
+
+        double values_[N_VARIABLES]{}; //!< derived variables
+};
+
+#endif
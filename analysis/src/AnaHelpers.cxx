@@ -23,15 +23,16 @@ std::string AnaHelpers::getFileName(std::string filePath, bool withExtension)
     return "";
 }
 
-void AnaHelpers::InnermostLayerCheck(Track* trk, bool& foundL1, bool& foundL2) {
+void AnaHelpers::InnermostLayerCheck(Track* trk, bool& foundL1, bool& foundL2, const std::vector<TrackerHit*>* hits) {
 
     bool isKF = trk->isKalmanTrack();
     int innerCount = 0;
     bool hasL1 = false;
     bool hasL2 = false;
     bool hasL3 = false;
-    for (int ihit=0; ihit<trk->getSvtHits().GetEntries();++ihit) {
-        TrackerHit* hit3d = (TrackerHit*) trk->getSvtHits().At(ihit);
+    for (int ihit=0; ihit<trk->getNSvtHits();++ihit) {
+        TrackerHit* hit3d = trk->getSvtHit(ihit, hits);
+        if (!hit3d) continue;
         if(isKF){
             if (hit3d->getLayer() == 0 ) {
                 innerCount++;
@@ -89,25 +90,27 @@ bool AnaHelpers::MatchToGBLTracks(int ele_id, int pos_id, Track* & ele_trk, Trac
 
 
 //TODO clean bit up 
-bool AnaHelpers::GetParticlesFromVtx(Vertex* vtx, Particle*& ele, Particle*& pos) {
+bool AnaHelpers::GetParticlesFromVtx(Vertex* vtx, Particle*& ele, Particle*& pos, const std::vector<Particle*>* parts) {
 
 
     bool foundele = false;
     bool foundpos = false;
 
-    for (int ipart = 0; ipart < vtx->getParticles().GetEntries(); ++ipart) {
+    for (int ipart = 0; ipart < vtx->getNParticles(); ++ipart) {
 
+        Particle* part = vtx->getParticle(ipart, parts);
+        if (!part) continue;
 
-        int pdg_id = ((Particle*)vtx->getParticles().At(ipart))->getPDG();
+        int pdg_id = part->getPDG();
         if (debug_) std::cout<<"In Loop "<<pdg_id<< " "<< ipart<<std::endl;
 
         if (pdg_id == 11) {
-            ele =  ((Particle*)vtx->getParticles().At(ipart));
+            ele = part;
             foundele=true;
             if (debug_) std::cout<<"found ele "<< (int)foundele<<std::endl;
         }
         else if (pdg_id == -11) {
-            pos = (Particle*)vtx->getParticles().At(ipart);
+            pos = part;
             foundpos=true;
             if  (debug_) std::cout<<"found pos "<<(int)foundpos<<std::endl;
 
@@ -1,4 +1,5 @@
 #include "BaseSelector.h"
+#include "JsonConfigCache.h"
 #include <fstream>
 #include <iostream>
 
@@ -39,8 +40,7 @@ bool BaseSelector::LoadSelection(){
         return false;
     }
     
-    std::ifstream i_file(m_cfgFile);
-    i_file >> _h_selections;
+    _h_selections = JsonConfigCache::get(m_cfgFile);
     if (debug_) {
         for (auto& el : _h_selections.items())
             std::cout<<el.key() << " : " << el.value() << "\n";
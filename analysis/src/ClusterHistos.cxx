@@ -1,10 +1,38 @@
 #include "ClusterHistos.h"
 #include <math.h>
+#include <algorithm>
 #include "TCanvas.h"
 
+namespace {
+
+    /** Names of the half module histograms, in the order of ClusterHistos::HalfModuleHisto */
+    const std::vector<std::string> halfModuleKeys = {
+        "charge",
+        "cluSize",
+        "charge_vs_stripPos",
+        "charge_vs_globRad",
+        "charge_corrected_vs_stripPos",
+        "sample0_vs_stripPos",
+        "sample1_vs_stripPos",
+        "sample0_vs_Amp",
+        "sample1_vs_Amp",
+        "stripPos_vs_gy"
+    };
+
+    /** Strips per sensor. L0-1 sensors only use the first 512 */
+    const int nStrips = 640;
+}
+
 ClusterHistos::ClusterHistos(const std::string& inputName):HistoManager(inputName) {
     m_name = inputName;
     mmapper_ = new ModuleMapper(2016);
+
+    mmapper_->getStrings(half_module_names);
+    hmHistos_ = HistoFamily(halfModuleKeys, half_module_names.size());
+    mmapper_->setFamilySw(hmHistos_, half_module_names);
+    cluSums_.resize(half_module_names.size());
+    touched_.reserve(half_module_names.size());
+    baselines_.assign(half_module_names.size()*nStrips, -999.);
 }
 
 ClusterHistos::~ClusterHistos() {
@@ -19,18 +47,9 @@ ClusterHistos::~ClusterHistos() {
        }
        */
 
-    cluSizeMap.clear();
-    chargeMap.clear();
-    chargeCorrectedMap.clear();
-    cluPositionMap.clear();
-    for (std::map<std::string, TGraphErrors*>::iterator it = baselineGraphs.begin(); 
-            it!=baselineGraphs.end(); ++it) {
-        if (it->second) {
-            delete (it->second);
-            it->second = nullptr;
-        }
-    }
-    baselineGraphs.clear();
+    cluSums_.clear();
+    touched_.clear();
+    baselines_.clear();
 }
 
 
@@ -42,17 +61,13 @@ void ClusterHistos::Define1DHistos() {
     //Cluster position
     histos1d[m_name+"_gz"] = plot1D(m_name+"_gz","Global Z [mm]",20000,-1000,2000);
 
-    mmapper_->getStrings(half_module_names);
-
     for (unsigned int ihm = 0; ihm<half_module_names.size(); ihm++) {
         h_name = m_name+"_"+half_module_names[ihm]+"_charge";
         histos1d[h_name] = plot1D(h_name,"charge",100,0,10000);
+        hmHistos_.setHisto(ihm, CHARGE, histos1d[h_name]);
         h_name = m_name+"_"+half_module_names[ihm]+"_cluSize";
         histos1d[h_name] = plot1D(h_name,"cluSize",10,0,10);
-        cluSizeMap[h_name]          = 0.;
-        chargeMap[h_name]           = 0.;
-        chargeCorrectedMap[h_name]  = 0.;
-        cluPositionMap[h_name]      = 0.;
+        hmHistos_.setHisto(ihm, CLU_SIZE, histos1d[h_name]);
     }//half module plots
 }
 
@@ -106,29 +121,34 @@ void ClusterHistos::Define2DHistos() {
         histos2d[h_name] = plot2D(h_name,
                 "Strip Position",640,0,640,
                 "charge",100,0,10000);
+        hmHistos_.setHisto(ihm, CHARGE_VS_STRIPPOS, histos2d[h_name]);
 
         h_name = m_name+"_"+half_module_names[ihm]+"_charge_vs_globRad";
 
         histos2d[h_name] = plot2D(h_name,
                 "#sqrt{x^{2} + y^{2}}",600,0,150,
                 "charge",100,0,10000);
+        hmHistos_.setHisto(ihm, CHARGE_VS_GLOBRAD, histos2d[h_name]);
 
         //Charge with baseline substracted
         h_name = m_name+"_"+half_module_names[ihm]+"_charge_corrected_vs_stripPos";
         histos2d[h_name] = plot2D(h_name,
                 "Strip Position",640,0,640,
                 "corrected charge",100,0,10000);
+        hmHistos_.setHisto(ihm, CHARGE_CORRECTED_VS_STRIPPOS, histos2d[h_name]);
 
         //sample 0 vs Strip
         h_name = m_name+"_"+half_module_names[ihm]+"_sample0_vs_stripPos";
         histos2d[h_name] = plot2D(h_name,
                 "Strip Position",640,0,640,
                 "sample0",200,-2000,2000);
+        hmHistos_.setHisto(ihm, SAMPLE0_VS_STRIPPOS, histos2d[h_name]);
 
         h_name = m_name+"_"+half_module_names[ihm]+"_sample1_vs_stripPos";
         histos2d[h_name] = plot2D(h_name,
                 "Strip Position",640,0,640,
                 "sample1",200,-2000,2000);
+        hmHistos_.setHisto(ihm, SAMPLE1_VS_STRIPPOS, histos2d[h_name]);
 
 
         //adc[0] (Sample 0) vs Amplitude
@@ -136,6 +156,7 @@ void ClusterHistos::Define2DHistos() {
         histos2d[h_name] = plot2D(h_name,
                 "Amp",    100,0,10000,
                 "Sample0",200,-2000,2000);
+        hmHistos_.setHisto(ihm, SAMPLE0_VS_AMP, histos2d[h_name]);
 
 
         //adc[1] (Sample 1) vs Amplitude
@@ -143,12 +164,14 @@ void ClusterHistos::Define2DHistos() {
         histos2d[h_name] = plot2D(h_name,
                 "Amp",    100,0,10000,
                 "Sample1",200,-2000,2000);
+        hmHistos_.setHisto(ihm, SAMPLE1_VS_AMP, histos2d[h_name]);
 
 
         h_name = m_name+"_"+half_module_names[ihm]+"_stripPos_vs_gy";
         histos2d[h_name] = plot2D(h_name,
                 "Global Y [mm]", nbins, startY, (nbins+1)* pitch,
                 "strip Pos", 640,0,640);
+        hmHistos_.setHisto(ihm, STRIPPOS_VS_GY, histos2d[h_name]);
 
     }
 }
@@ -170,8 +193,10 @@ bool ClusterHistos::LoadOfflineBaselines(const std::string& baselineFits) {
             std::string grname = gr->GetName();
             std::cout << "Loading baselines from graph " << grname << std::endl;
             grname = grname.substr(0,grname.find("_baseline_0"));
-            baselineGraphs[grname] = gr;
+            if (!setBaselines(grname, gr))
+                std::cout << "WARNING: no half module for baselines " << grname << std::endl;
             std::cout << grname << std::endl;
+            delete gr;
         }
     }
 
@@ -210,19 +235,11 @@ bool ClusterHistos::LoadBaselineHistos(const std::string& baselinesIn) {
         //x values go from 0 to 639 (640 points) for other layers
         std::string graph_key = key->GetName();
         graph_key = graph_key.substr(graph_key.find("F"),4);
-        baselineGraphs[graph_key] = (TGraphErrors*) (dir->Get(key->GetName()));
+        TGraphErrors* gr = (TGraphErrors*) (dir->Get(key->GetName()));
+        setBaselines(graph_key, gr);
+        delete gr;
     }
 
-    //for (std::map<std::string,TGraphErrors*>::iterator it = baselineGraphs.begin(); it!=baselineGraphs.end(); ++it)
-    //std::cout<<it->first<<" " <<it->second->GetN()<<std::endl;
-    //
-    //for (int point = 0 ; point < baselineGraphs["F5H1"]->GetN();point++) {
-    //Double_t x=-999;
-    //Double_t y=-999;
-    //baselineGraphs["F5H1"]->GetPoint(point,x,y);
-    //std::cout<<point<<" x "<<x<<" y "<<y<<std::endl;
-    //}
-
     baselinesFile->Close();
     delete baselinesFile;
     baselinesFile = nullptr;
@@ -230,112 +247,101 @@ bool ClusterHistos::LoadBaselineHistos(const std::string& baselinesIn) {
     return true;
 }
 
+bool ClusterHistos::setBaselines(const std::string& name, const TGraphErrors* graph) {
+    if (!graph)
+        return false;
 
+    for (unsigned int ihm = 0; ihm<half_module_names.size(); ihm++) {
+        if (name != half_module_names[ihm] && name != mmapper_->getHwFromString(half_module_names[ihm]))
+            continue;
+
+        //Points are copied since the graphs go away with their file
+        double* baselines = &baselines_[ihm*nStrips];
+        int npoints = std::min(graph->GetN(), nStrips);
+        for (int point = 0; point < npoints; point++)
+            baselines[point] = graph->GetY()[point];
+        return true;
+    }
+    return false;
+}
 
+void ClusterHistos::FillHistograms(TrackerHit* hit,float weight, const std::vector<RawSvtHit*>* rawhits) {
 
+    for (int irh = 0; irh < hit->getNRawHits(); ++irh) {
 
-void ClusterHistos::FillHistograms(TrackerHit* hit,float weight) {
-
-    TRefArray rawhits_ = hit->getRawHits();
-    //int  iv      = -1;   // 0 top, 1 bottom
-    //int  it      = -1;   // 0 axial, 1 stereo
-    //int  ily     = -1;   // 0-6
-
-    //TODO do this better
-
-    //std::cout<<"Size:" <<rawhits_->GetEntries()<<std::endl;
-
-    std::string swTag = "";
-
-    for (unsigned int irh = 0; irh < rawhits_.GetEntries(); ++irh) {
-
-        RawSvtHit * rawhit  = static_cast<RawSvtHit*>(rawhits_.At(irh));
+        RawSvtHit * rawhit  = hit->getRawHit(irh, rawhits);
+        if (!rawhit)
+            continue;
         //rawhit layers go from 1 to 14. Example: RawHit->Layer1 is layer0 axial on top and layer0 stereo in bottom.
 
-        swTag = "ly"+std::to_string(rawhit->getLayer())+"_m"+std::to_string(rawhit->getModule());
+        int ihm = hmHistos_.getMember(rawhit->getLayer(), rawhit->getModule());
+        if (ihm < 0)
+            continue;
+        HistoFamily::Member histos = hmHistos_.at(ihm);
+        ClusterSums& sums = cluSums_[ihm];
+        if (sums.cluSize == 0)
+            touched_.push_back(ihm);
 
-        std::string key = mmapper_->getStringFromSw(swTag);
-        //std::cout<<"----"<<std::endl;
-        //std::cout<<"From Mapper      "<<mmapper_->getStringFromSw(swTag)<<std::endl;
-        //std::cout<<"----"<<std::endl;
+        double amp = rawhit->getAmp(0);
+        int    strip = rawhit->getStrip();
 
         //2D cluster charge
-        chargeMap     [m_name+"_"+key+"_charge"]  += rawhit->getAmp(0);
+        sums.charge += amp;
 
         double baseline = -999;
-        double strip    = -999;
 
         /*
         //2D cluster corrected charge
-        if (baselineGraphs[mmapper_->getHwFromString(key)])
-            baselineGraphs[mmapper_->getHwFromString(key)]->GetPoint(rawhit->getStrip(),strip,baseline);
+        if (strip >= 0 && strip < nStrips)
+            baseline = baselines_[ihm*nStrips+strip];
             */
 
         float sample0 = baseline - rawhit->getADCs()[0];
         float sample1 = baseline - rawhit->getADCs()[1]; 
 
-        chargeCorrectedMap[m_name+"_"+key+"_charge"]  += (rawhit->getAmp(0) + sample0);
+        sums.chargeCorrected += (amp + sample0);
 
-        histos2d[m_name+"_"+key+"_sample0_vs_Amp"]->Fill(rawhit->getAmp(0),sample0,weight);
-        histos2d[m_name+"_"+key+"_sample1_vs_Amp"]->Fill(rawhit->getAmp(0),sample1,weight);
-
-        histos2d[m_name+"_"+key+"_sample0_vs_stripPos"]->Fill(rawhit->getStrip(),-sample0,weight);
-        histos2d[m_name+"_"+key+"_sample1_vs_stripPos"]->Fill(rawhit->getStrip(),-sample1,weight);
+        histos.fill(SAMPLE0_VS_AMP,amp,sample0,weight);
+        histos.fill(SAMPLE1_VS_AMP,amp,sample1,weight);
 
+        histos.fill(SAMPLE0_VS_STRIPPOS,strip,-sample0,weight);
+        histos.fill(SAMPLE1_VS_STRIPPOS,strip,-sample1,weight);
 
         //2D cluster size1
-        cluSizeMap    [m_name+"_"+key+"_cluSize"] ++;
+        sums.cluSize++;
 
         //2D Weighted position numerator
-        cluPositionMap[m_name+"_"+key+"_charge"]  += rawhit->getAmp(0)*rawhit->getStrip();
-        //std::cout<<"rawhit->getStrip()::"<<rawhit->getStrip()<<std::endl;
+        sums.position += amp*strip;
     }
 
-    //TODO make this more efficient: useless to loop all over the possibilities
+    //Only the half modules the hit went through are filled and reset
+    double globRad = sqrt(hit->getGlobalX() * hit->getGlobalX() + hit->getGlobalY()+hit->getGlobalY());
+    for (int ihm : touched_) {
+        HistoFamily::Member histos = hmHistos_.at(ihm);
+        ClusterSums& sums = cluSums_[ihm];
 
-    for (std::map<std::string, int>::iterator it = cluSizeMap.begin(); it!=cluSizeMap.end(); ++it ) {
-        if (it->second != 0) {
-            //std::cout<<"Filling..."<<it->first<<" "<<histos1d[it->first]<<std::endl;
-            histos1d[it->first]->Fill(it->second,weight);
-            cluSizeMap[it->first]= 0;
-        }
-    }// fills the maps
+        histos.fill(CLU_SIZE,sums.cluSize,weight);
 
-    //TODO make this more efficient: useless to loop all over the possibilities
-    for (std::map<std::string, double>::iterator it = chargeMap.begin(); it!=chargeMap.end(); ++it ) {
         //TODO make it better
         //Avoid comparing to 0.0 and check if there is a charge deposit on this 
-        if (it->second > 1e-6) {
-
-
-            std::string plotID = (it->first).substr(0,(it->first).find("_charge"));
-
-            //it->second holds the charge
-            //it->first =  charge histogram name.
-            double charge = it->second;
-            histos1d[it->first]->Fill(charge,weight);
-            double weighted_pos = cluPositionMap[it->first] / (charge);
-            double chargeCorrected = chargeCorrectedMap[it->first];
-            //std::cout<<"weighted pos "<<weighted_pos<<std::endl;
-            histos2d[it->first+"_vs_stripPos"]->Fill(weighted_pos,charge,weight);
+        if (sums.charge > 1e-6) {
+            double charge = sums.charge;
+            histos.fill(CHARGE,charge,weight);
+            double weighted_pos = sums.position / (charge);
+            histos.fill(CHARGE_VS_STRIPPOS,weighted_pos,charge,weight);
 
             // Fill the baseline corrected charge
-            histos2d[it->first+"_corrected_vs_stripPos"]->Fill(weighted_pos,chargeCorrected,weight);
+            histos.fill(CHARGE_CORRECTED_VS_STRIPPOS,weighted_pos,sums.chargeCorrected,weight);
 
             //Fill local vs global
+            histos.fill(STRIPPOS_VS_GY,fabs(hit->getGlobalY()),weighted_pos,weight);
 
-            histos2d[plotID+"_stripPos_vs_gy"]->Fill(fabs(hit->getGlobalY()),weighted_pos,weight);
-
-            double globRad = sqrt(hit->getGlobalX() * hit->getGlobalX() + hit->getGlobalY()+hit->getGlobalY());
-            histos2d[it->first+"_vs_globRad"]->Fill(globRad,charge,weight);
-
-
-            chargeMap[it->first]          = 0.0;
-            chargeCorrectedMap[it->first] = 0.0;
-            cluPositionMap[it->first]     = 0.0;
-
-        } 
+            histos.fill(CHARGE_VS_GLOBRAD,globRad,charge,weight);
+        }
+        sums = ClusterSums();
     }
+    touched_.clear();
+
     histos1d[m_name+"_gz"]->Fill(hit->getGlobalZ(),weight);
     //1D
     //histos1d[m_name+"_charge"]->Fill(hit->getCharge(),weight);
@@ -9,6 +9,7 @@
  */
 
 #include <FlatTupleMaker.h>
+#include <algorithm>
 
 FlatTupleMaker::FlatTupleMaker(std::string file_name, std::string tree_name) { 
     
@@ -78,6 +79,57 @@ std::vector<double> FlatTupleMaker::getVector(std::string variable_name) {
     return vectors[variable_name];
 }
 
+template <typename T>
+int FlatTupleMaker::addScalar(std::vector<T>& buffer, std::vector<std::string>& names, 
+        const std::string& name, const T& value, const std::string& leaf) {
+
+    const T* data = buffer.data();
+    buffer.push_back(value);
+    names.push_back(name);
+    tree->Branch(name.c_str(), &buffer.back(), (name + leaf).c_str());
+
+    // The buffer moved, so the previously declared columns are bound again
+    if (data != nullptr && data != buffer.data()) {
+        for (size_t i = 0; i + 1 < buffer.size(); ++i)
+            tree->SetBranchAddress(names[i].c_str(), static_cast<void*>(&buffer[i]));
+    }
+    return buffer.size() - 1;
+}
+
+FlatTupleMaker::Slot<double> FlatTupleMaker::addDouble(const std::string& name) {
+    return {addScalar(doubles_, double_names_, name, -9999., "/D")};
+}
+
+FlatTupleMaker::Slot<float> FlatTupleMaker::addFloat(const std::string& name) {
+    return {addScalar(floats_, float_names_, name, -9999.f, "/F")};
+}
+
+FlatTupleMaker::Slot<int> FlatTupleMaker::addInt(const std::string& name) {
+    return {addScalar(ints_, int_names_, name, -9999, "/I")};
+}
+
+FlatTupleMaker::Slot<bool> FlatTupleMaker::addBool(const std::string& name) {
+    return {addScalar(bools_, bool_names_, name, BoolValue(), "/O")};
+}
+
+FlatTupleMaker::Slot<std::vector<double>> FlatTupleMaker::addDoubleVector(const std::string& name) {
+    double_vectors_.emplace_back();
+    tree->Branch(name.c_str(), &double_vectors_.back());
+    return {int(double_vectors_.size()) - 1};
+}
+
+FlatTupleMaker::Slot<std::vector<float>> FlatTupleMaker::addFloatVector(const std::string& name) {
+    float_vectors_.emplace_back();
+    tree->Branch(name.c_str(), &float_vectors_.back());
+    return {int(float_vectors_.size()) - 1};
+}
+
+FlatTupleMaker::Slot<std::vector<int>> FlatTupleMaker::addIntVector(const std::string& name) {
+    int_vectors_.emplace_back();
+    tree->Branch(name.c_str(), &int_vectors_.back());
+    return {int(int_vectors_.size()) - 1};
+}
+
 void FlatTupleMaker::fill() { 
     
     // Fill the event with the current variables.
@@ -91,4 +143,12 @@ void FlatTupleMaker::fill() {
     for (auto& element : vectors) { 
         element.second.clear();
     }
+
+    std::fill(doubles_.begin(), doubles_.end(), -9999.);
+    std::fill(floats_.begin(), floats_.end(), -9999.f);
+    std::fill(ints_.begin(), ints_.end(), -9999);
+    std::fill(bools_.begin(), bools_.end(), BoolValue());
+    for (auto& vec : double_vectors_) vec.clear();
+    for (auto& vec : float_vectors_) vec.clear();
+    for (auto& vec : int_vectors_) vec.clear();
 }
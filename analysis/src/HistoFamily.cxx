@@ -0,0 +1,35 @@
+#include "HistoFamily.h"
+
+#include <algorithm>
+
+HistoFamily::HistoFamily(const std::vector<std::string>& keys, int nmembers) :
+    keys_(keys), nmembers_(nmembers), histos1d_(keys.size()*nmembers, nullptr),
+    histos2d_(keys.size()*nmembers, nullptr) {
+
+    for (size_t index = 0; index < keys_.size(); ++index)
+        indices_[keys_[index]] = index;
+}
+
+int HistoFamily::getIndex(const std::string& key) const {
+    auto it = indices_.find(key);
+    return it == indices_.end() ? -1 : it->second;
+}
+
+void HistoFamily::setMember(int i, int j, int member) {
+    if (i < 0 || j < 0)
+        return;
+
+    // Grow the index space, keeping the members already set
+    if (i >= ni_ || j >= nj_) {
+        int ni = std::max(ni_, i+1);
+        int nj = std::max(nj_, j+1);
+        std::vector<int> members(ni*nj, -1);
+        for (int oi = 0; oi < ni_; ++oi)
+            for (int oj = 0; oj < nj_; ++oj)
+                members[oi*nj+oj] = members_[oi*nj_+oj];
+        members_.swap(members);
+        ni_ = ni;
+        nj_ = nj;
+    }
+    members_[i*nj_+j] = member;
+}
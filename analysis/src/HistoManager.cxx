@@ -1,4 +1,5 @@
 #include "HistoManager.h"
+#include "JsonConfigCache.h"
 #include <iostream>
 #include "TKey.h"
 #include "TClass.h"
@@ -152,6 +153,35 @@ void HistoManager::DefineHistos(std::vector<std::string> histoCopyNames, std::st
     }//loop on config
 }
 
+HistoFamily HistoManager::getFamily(const std::vector<std::string>& histoCopyNames,
+        const std::string& makeCopyJsonTag) {
+
+    // Same naming as DefineHistos, which only makes copies of several names
+    bool copies = histoCopyNames.size() > 1;
+    std::vector<std::string> keys;
+    for (auto hist : _h_configs.items()) {
+        if (std::string(hist.key()).find(makeCopyJsonTag) != std::string::npos)
+            keys.push_back(hist.key());
+    }
+
+    HistoFamily family(keys, copies ? histoCopyNames.size() : 1);
+    for (int member = 0; member < family.getNMembers(); ++member) {
+        for (int index = 0; index < keys.size(); ++index) {
+            std::string h_name = copies ? m_name+"_"+histoCopyNames[member]+"_"+keys[index] 
+                : m_name+"_"+keys[index];
+            auto it1 = histos1d.find(h_name);
+            if (it1 != histos1d.end()) {
+                family.setHisto(member, index, it1->second);
+                continue;
+            }
+            auto it2 = histos2d.find(h_name);
+            if (it2 != histos2d.end())
+                family.setHisto(member, index, it2->second);
+        }
+    }
+    return family;
+}
+
 void HistoManager::GetHistosFromFile(TFile* inFile, const std::string& name, const std::string& folder) {
 
     //Todo: use name as regular expression.
@@ -345,13 +375,11 @@ void HistoManager::Fill1DHisto(const std::string& histoName,float value, float w
 
 void HistoManager::loadHistoConfig(const std::string histoConfigFile) {
 
-    std::ifstream i_file(histoConfigFile);
-    i_file >> _h_configs;
+    _h_configs = JsonConfigCache::get(histoConfigFile);
     if (debug_) {
         for (auto& el : _h_configs.items()) 
             std::cout << el.key() << " : " << el.value() << "\n";
     }
-    i_file.close();
 
 }
 
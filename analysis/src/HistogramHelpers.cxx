@@ -2,6 +2,440 @@
 
 #include "HistogramHelpers.h"
 #include "TMath.h" 
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+  //Inverse of a symmetric 3x3 matrix. Returns false if singular.
+  bool invert3(const double m[3][3], double inv[3][3]) {
+    double c00 = m[1][1]*m[2][2] - m[1][2]*m[2][1];
+    double c01 = m[1][2]*m[2][0] - m[1][0]*m[2][2];
+    double c02 = m[1][0]*m[2][1] - m[1][1]*m[2][0];
+    double det = m[0][0]*c00 + m[0][1]*c01 + m[0][2]*c02;
+    if (!(fabs(det) > 0) || !std::isfinite(det)) return false;
+    inv[0][0] = c00/det;
+    inv[0][1] = (m[0][2]*m[2][1] - m[0][1]*m[2][2])/det;
+    inv[0][2] = (m[0][1]*m[1][2] - m[0][2]*m[1][1])/det;
+    inv[1][0] = c01/det;
+    inv[1][1] = (m[0][0]*m[2][2] - m[0][2]*m[2][0])/det;
+    inv[1][2] = (m[0][2]*m[1][0] - m[0][0]*m[1][2])/det;
+    inv[2][0] = c02/det;
+    inv[2][1] = (m[0][1]*m[2][0] - m[0][0]*m[2][1])/det;
+    inv[2][2] = (m[0][0]*m[1][1] - m[0][1]*m[1][0])/det;
+    return true;
+  }
+
+  //Bins entering a fit: non empty bins, with their center in the range if one is given
+  struct FitPoints {
+    std::vector<double> x, y, e;
+  };
+
+  FitPoints getFitPoints(const HistogramHelpers::HistoSlice& slice, bool useRange, double lo, double hi) {
+    FitPoints pts;
+    for (int i = 1; i <= slice.getNbins(); ++i) {
+      if (slice.sumw[i] == 0) continue;
+      double x = 0.5*(slice.edges[i-1] + slice.edges[i]);
+      if (useRange && (x < lo || x > hi)) continue;
+      pts.x.push_back(x);
+      pts.y.push_back(slice.sumw[i]);
+      pts.e.push_back(slice.sumw2[i] > 0 ? sqrt(slice.sumw2[i]) : sqrt(fabs(slice.sumw[i])));
+    }
+    return pts;
+  }
+
+  //Chi2 of a Gaussian, with its gradient terms if jtj/jtr are given
+  double gaussChi2(const FitPoints& pts, const double p[3], double jtj[3][3] = nullptr, double jtr[3] = nullptr) {
+    double chi2 = 0;
+    if (jtj) {
+      for (int a = 0; a < 3; ++a) {
+        jtr[a] = 0;
+        for (int b = 0; b < 3; ++b) jtj[a][b] = 0;
+      }
+    }
+    for (size_t i = 0; i < pts.x.size(); ++i) {
+      double z = (pts.x[i] - p[1])/p[2];
+      double g = exp(-0.5*z*z);
+      double r = (pts.y[i] - p[0]*g)/pts.e[i];
+      chi2 += r*r;
+      if (!jtj) continue;
+      double j[3] = { g/pts.e[i], p[0]*g*z/p[2]/pts.e[i], p[0]*g*z*z/p[2]/pts.e[i] };
+      for (int a = 0; a < 3; ++a) {
+        jtr[a] += j[a]*r;
+        for (int b = 0; b < 3; ++b) jtj[a][b] += j[a]*j[b];
+      }
+    }
+    return chi2;
+  }
+
+  //Chi2 fit of a Gaussian, Levenberg-Marquardt. The parameters are left
+  //untouched if the fit can't be done. Returns 0 on success.
+  int fitGauss(const FitPoints& pts, double p[3], double perr[3]) {
+    if (pts.x.size() < 3 || p[2] == 0) return 1;
+
+    const int max_iterations = 200;
+    double q[3] = {p[0], p[1], p[2]};
+    double jtj[3][3], jtr[3];
+    double chi2 = gaussChi2(pts, q, jtj, jtr);
+    double lambda = 1e-3;
+    bool converged = false;
+
+    for (int iter = 0; iter < max_iterations && !converged; ++iter) {
+      bool stepped = false;
+      while (lambda < 1e10) {
+        double a[3][3], inv[3][3];
+        for (int r = 0; r < 3; ++r)
+          for (int c = 0; c < 3; ++c)
+            a[r][c] = jtj[r][c] + (r == c ? lambda*jtj[r][c] : 0.);
+        if (!invert3(a, inv)) {
+          lambda *= 10;
+          continue;
+        }
+        double trial[3];
+        for (int r = 0; r < 3; ++r)
+          trial[r] = q[r] + inv[r][0]*jtr[0] + inv[r][1]*jtr[1] + inv[r][2]*jtr[2];
+        if (trial[2] == 0) {
+          lambda *= 10;
+          continue;
+        }
+        double trial_chi2 = gaussChi2(pts, trial);
+        if (std::isfinite(trial_chi2) && trial_chi2 <= chi2) {
+          converged = chi2 - trial_chi2 < 1e-9*(chi2 + 1e-12);
+          for (int r = 0; r < 3; ++r) q[r] = trial[r];
+          chi2 = gaussChi2(pts, q, jtj, jtr);
+          lambda = std::max(lambda/10, 1e-12);
+          stepped = true;
+          break;
+        }
+        lambda *= 10;
+      }
+      if (!stepped) converged = true; //no step lowers the chi2: at the minimum
+    }
+
+    double cov[3][3];
+    if (!invert3(jtj, cov)) return 2;
+
+    p[0] = q[0];
+    p[1] = q[1];
+    p[2] = fabs(q[2]);
+    for (int r = 0; r < 3; ++r) perr[r] = sqrt(fabs(cov[r][r]));
+    return converged ? 0 : 3;
+  }
+
+  //Closed form Gaussian fit: weighted least squares parabola fit of the
+  //logarithm of the contents. Returns 0 on success.
+  int fitGaussClosedForm(const FitPoints& pts, double p[3], double perr[3]) {
+    if (pts.x.size() < 3) return 1;
+
+    //Center the abscissa to keep the normal equations well conditioned
+    double x0 = 0;
+    for (double x : pts.x) x0 += x;
+    x0 /= pts.x.size();
+
+    double m[3][3] = {{0}}, v[3] = {0};
+    for (size_t i = 0; i < pts.x.size(); ++i) {
+      if (pts.y[i] <= 0) return 1;
+      double x = pts.x[i] - x0;
+      double w = pts.y[i]*pts.y[i]/(pts.e[i]*pts.e[i]);
+      double l = log(pts.y[i]);
+      double f[3] = {1., x, x*x};
+      for (int a = 0; a < 3; ++a) {
+        v[a] += w*l*f[a];
+        for (int b = 0; b < 3; ++b) m[a][b] += w*f[a]*f[b];
+      }
+    }
+
+    double cov[3][3];
+    if (!invert3(m, cov)) return 2;
+    double c[3];
+    for (int a = 0; a < 3; ++a) c[a] = cov[a][0]*v[0] + cov[a][1]*v[1] + cov[a][2]*v[2];
+    if (c[2] >= 0) return 2;
+
+    p[0] = exp(c[0] - c[1]*c[1]/(4*c[2]));
+    p[1] = x0 - c[1]/(2*c[2]);
+    p[2] = sqrt(-1./(2*c[2]));
+
+    //Propagate the covariance of the parabola to mu and sigma
+    double dmu[3] = {0., -1./(2*c[2]), c[1]/(2*c[2]*c[2])};
+    double dsigma[3] = {0., 0., pow(-2*c[2], -1.5)};
+    double var_mu = 0, var_sigma = 0;
+    for (int a = 0; a < 3; ++a)
+      for (int b = 0; b < 3; ++b) {
+        var_mu += dmu[a]*cov[a][b]*dmu[b];
+        var_sigma += dsigma[a]*cov[a][b]*dsigma[b];
+      }
+    perr[0] = 0;
+    perr[1] = sqrt(var_mu);
+    perr[2] = sqrt(var_sigma);
+    return 0;
+  }
+
+  //HistogramConditioning on a slice
+  void conditionSlice(HistogramHelpers::HistoSlice& slice) {
+    double MinEntriesMPB = 15;
+    int NGroupBins = 2;
+
+    int MostPopulatedBin = 1;
+    for (int i = 2; i <= slice.getNbins(); ++i)
+      if (slice.sumw[i] > slice.sumw[MostPopulatedBin]) MostPopulatedBin = i;
+
+    double EntriesMPB = slice.sumw[MostPopulatedBin];
+    if (EntriesMPB < MinEntriesMPB) {
+      if ((EntriesMPB + slice.sumw[MostPopulatedBin+1] + slice.sumw[MostPopulatedBin-1]) > MinEntriesMPB)
+        NGroupBins = 2;
+      else
+        NGroupBins = 3;
+      while (slice.getNbins() % NGroupBins != 0) NGroupBins++;
+      slice.rebin(NGroupBins);
+    }
+  }
+
+  //Statistics of the in range bins of a slice
+  void setSliceStats(HistogramHelpers::HistoSlice& slice) {
+    double sumw = 0, sumwx = 0, sumwx2 = 0;
+    slice.entries = 0;
+    for (int i = 0; i <= slice.getNbins()+1; ++i) {
+      slice.entries += slice.sumw[i];
+      if (i == 0 || i == slice.getNbins()+1) continue;
+      double x = 0.5*(slice.edges[i-1] + slice.edges[i]);
+      sumw += slice.sumw[i];
+      sumwx += slice.sumw[i]*x;
+      sumwx2 += slice.sumw[i]*x*x;
+    }
+    if (sumw == 0) return;
+    slice.mean = sumwx/sumw;
+    slice.rms = sqrt(fabs(sumwx2/sumw - slice.mean*slice.mean));
+  }
+
+  std::vector<double> getEdges(const TAxis* axis) {
+    std::vector<double> edges(axis->GetNbins()+1);
+    for (int i = 1; i <= axis->GetNbins(); ++i) edges[i-1] = axis->GetBinLowEdge(i);
+    edges.back() = axis->GetBinUpEdge(axis->GetNbins());
+    return edges;
+  }
+
+  //Write a fitted slice to the debug projection file
+  void writeProjection(const std::string& name, const std::string& title,
+                       const HistogramHelpers::HistoSlice& slice, const HistogramHelpers::GaussFitResult& fit) {
+    TH1D proj(name.c_str(), title.c_str(), slice.getNbins(), slice.edges.data());
+    proj.SetDirectory(nullptr);
+    for (int i = 0; i <= slice.getNbins()+1; ++i) {
+      proj.SetBinContent(i, slice.sumw[i]);
+      proj.SetBinError(i, sqrt(slice.sumw2[i]));
+    }
+    proj.SetEntries(slice.entries);
+    TF1 fit_func("fit_func", "gaus", slice.edges.front(), slice.edges.back());
+    fit_func.SetParameters(fit.norm, fit.mu, fit.sigma);
+
+    TCanvas q;
+    q.cd();
+    proj.Draw();
+    fit_func.Draw("same");
+    std::string str = "";
+    HistogramHelpers::outFile_for_projections->cd();
+    q.Write((str+"_"+name).c_str());
+  }
+
+  //ROOT fit of a projection with IterativeGaussFit(TH1*), which also writes
+  //and pauses on it as configured. The projection is deleted.
+  HistogramHelpers::GaussFitResult fitProjection(TH1D* proj, double minEntries, int m_PrintLevel) {
+    HistogramHelpers::GaussFitResult result;
+    if (proj->GetEntries() >= minEntries) {
+      HistogramHelpers::IterativeGaussFit(proj, result.mu, result.mu_err, result.sigma, result.sigma_err, m_PrintLevel);
+      result.status = 0;
+    }
+    delete proj;
+    return result;
+  }
+}
+
+void HistogramHelpers::HistoSlice::rebin(int ngroup) {
+  int nbins = getNbins();
+  if (ngroup <= 1 || ngroup > nbins) return;
+  int newbins = nbins/ngroup;
+
+  std::vector<double> new_edges(newbins+1);
+  std::vector<double> new_sumw(newbins+2, 0.);
+  std::vector<double> new_sumw2(newbins+2, 0.);
+  new_sumw[0] = sumw[0];
+  new_sumw2[0] = sumw2[0];
+  for (int ib = 1; ib <= newbins; ++ib) {
+    new_edges[ib-1] = edges[(ib-1)*ngroup];
+    for (int i = (ib-1)*ngroup+1; i <= ib*ngroup; ++i) {
+      new_sumw[ib] += sumw[i];
+      new_sumw2[ib] += sumw2[i];
+    }
+  }
+  new_edges[newbins] = edges[newbins*ngroup];
+  //Bins left over go to the overflow, as in TH1::Rebin
+  for (int i = newbins*ngroup+1; i <= nbins+1; ++i) {
+    new_sumw[newbins+1] += sumw[i];
+    new_sumw2[newbins+1] += sumw2[i];
+  }
+  edges.swap(new_edges);
+  sumw.swap(new_sumw);
+  sumw2.swap(new_sumw2);
+}
+
+HistogramHelpers::HistoSlice HistogramHelpers::getSliceY(TH2* hist, int firstx, int lastx) {
+  HistoSlice slice;
+  slice.edges = getEdges(hist->GetYaxis());
+  int nbinsy = hist->GetYaxis()->GetNbins();
+  slice.sumw.assign(nbinsy+2, 0.);
+  slice.sumw2.assign(nbinsy+2, 0.);
+  bool hasSumw2 = hist->GetSumw2N() > 0;
+  for (int ix = firstx; ix <= lastx; ++ix) {
+    for (int iy = 0; iy <= nbinsy+1; ++iy) {
+      int bin = hist->GetBin(ix, iy);
+      double w = hist->GetBinContent(bin);
+      slice.sumw[iy] += w;
+      slice.sumw2[iy] += hasSumw2 ? hist->GetSumw2()->At(bin) : fabs(w);
+    }
+  }
+  setSliceStats(slice);
+  return slice;
+}
+
+HistogramHelpers::HistoSlice HistogramHelpers::getSliceZ(TH3* hist, int firstx, int lastx, int firsty, int lasty) {
+  HistoSlice slice;
+  slice.edges = getEdges(hist->GetZaxis());
+  int nbinsz = hist->GetZaxis()->GetNbins();
+  slice.sumw.assign(nbinsz+2, 0.);
+  slice.sumw2.assign(nbinsz+2, 0.);
+  bool hasSumw2 = hist->GetSumw2N() > 0;
+  for (int ix = firstx; ix <= lastx; ++ix) {
+    for (int iy = firsty; iy <= lasty; ++iy) {
+      for (int iz = 0; iz <= nbinsz+1; ++iz) {
+        int bin = hist->GetBin(ix, iy, iz);
+        double w = hist->GetBinContent(bin);
+        slice.sumw[iz] += w;
+        slice.sumw2[iz] += hasSumw2 ? hist->GetSumw2()->At(bin) : fabs(w);
+      }
+    }
+  }
+  setSliceStats(slice);
+  return slice;
+}
+
+HistogramHelpers::GaussFitResult HistogramHelpers::IterativeGaussFit(HistoSlice slice, double fastFitEntries) {
+
+  //constants for fitting algorithm, as in IterativeGaussFit(TH1*, ...)
+  const int iteration_limit = 20;
+  const float percent_limit = 0.01;
+  const float fit_range_multiplier = 1.5;
+  const int minEntries = 25;
+
+  GaussFitResult result;
+  if (slice.entries < minEntries || slice.getNbins() < 1) return result;
+
+  conditionSlice(slice);
+
+  bool closedForm = fastFitEntries > 0 && slice.entries >= fastFitEntries;
+  double par[3] = {0., slice.mean, slice.rms};
+  double err[3] = {0., 0., 0.};
+  for (int i = 1; i <= slice.getNbins(); ++i) par[0] = std::max(par[0], slice.sumw[i]);
+
+  auto fit = [&](bool useRange, double lo, double hi) {
+    FitPoints pts = getFitPoints(slice, useRange, lo, hi);
+    if (closedForm && fitGaussClosedForm(pts, par, err) == 0) return 0;
+    return fitGauss(pts, par, err);
+  };
+  auto binWidth = [&]() { return slice.edges[1] - slice.edges[0]; };
+  double xmin = slice.edges.front();
+  double xmax = slice.edges.back();
+
+  int bad_fit = fit(false, 0., 0.);
+
+  double last_mu = par[1];
+  double last_sigma = par[2];
+  double current_mu = 0;
+  double current_sigma = 0;
+
+  if (bad_fit) last_mu = slice.mean;
+
+  // check as well that the value of last_mu is reasonable
+  if (fabs(last_mu - slice.mean) > 3*binWidth()) {
+    last_mu = slice.mean;
+    last_sigma = slice.rms;
+  }
+
+  int iteration = 0;
+  while ( iteration < iteration_limit ) {
+
+    iteration++;
+
+    double FitRangeLower = last_mu-fit_range_multiplier*last_sigma;
+    double FitRangeUpper = last_mu+fit_range_multiplier*last_sigma;
+
+    // if range is to narrow --> broaden it
+    if ((FitRangeUpper-FitRangeLower)/binWidth() < 5) {
+      FitRangeLower -= binWidth();
+      FitRangeUpper += binWidth();
+    }
+
+    bad_fit = fit(true, FitRangeLower, FitRangeUpper);
+    // 1) the mean must be within the histogram range
+    if (par[1] < xmin || par[1] > xmax) bad_fit = 1;
+    // 2) the sigma can not be broader than the histogram range
+    if (par[2] > xmax-xmin) bad_fit = 1;
+
+    if (bad_fit) { // in case the fit looks odd, then rebin the histogram and refit with smallest divisor.
+      int rebinFactor = 1;
+      for (int i_div = 2; i_div < (slice.getNbins()/2)+1; ++i_div)
+        if ((slice.getNbins() % i_div) == 0) {
+          rebinFactor = i_div;
+          break;
+        }
+      slice.rebin(rebinFactor);
+      fit(true, FitRangeLower, FitRangeUpper);
+    }
+
+    // extract the correction for this iteration
+    current_mu = par[1];
+    current_sigma = par[2];
+
+    float average_mu = (last_mu+current_mu)/2;
+    float average_sigma = (last_sigma+current_sigma)/2;
+
+    if (average_mu == 0) average_mu = current_mu;
+    if (average_sigma == 0) average_sigma = current_sigma;
+
+    double mu_percent_diff = fabs((last_mu-current_mu)/average_mu);
+    double sigma_percent_diff = fabs((last_sigma-current_sigma)/average_sigma);
+
+    if ( mu_percent_diff < percent_limit && sigma_percent_diff < percent_limit ) break;
+
+    if (iteration != iteration_limit) {
+      last_mu = current_mu;
+      last_sigma = current_sigma;
+    }
+    // check as well that the last_mu is reasonable
+    if (fabs(last_mu - slice.mean) > 5*binWidth()) last_mu = slice.mean;
+  }
+
+  result.norm = par[0];
+  result.mu = current_mu;
+  result.mu_err = err[1];
+  result.sigma = current_sigma;
+  result.sigma_err = err[2];
+  result.status = iteration == iteration_limit ? 2 : 0;
+  return result;
+}
+
+std::vector<HistogramHelpers::GaussFitResult> HistogramHelpers::fitSlices(const std::vector<HistoSlice>& slices,
+        double minEntries, int nThreads, double fastFitEntries) {
+
+  std::vector<GaussFitResult> results(slices.size());
+  parallelFor(slices.size(), nThreads, [&](size_t islice) {
+    if (slices[islice].entries >= minEntries)
+      results[islice] = IterativeGaussFit(slices[islice], fastFitEntries);
+  });
+
+  return results;
+}
+
 
 double HistogramHelpers::GaussExpTails_f(double* x, double *par) {
   //core Gaussian with exponential tails starting K
@@ -75,7 +509,8 @@ double HistogramHelpers::twoGauss_f(double *x, double *par){
 
   
 //-------------------------------------------------------------
-void HistogramHelpers::profileZwithIterativeGaussFit(TH3* hist, TH2* mu_graph, TH2* sigma_graph, int num_bins, TH2* mu_err_graph, TH2* sigma_err_graph)
+void HistogramHelpers::profileZwithIterativeGaussFit(TH3* hist, TH2* mu_graph, TH2* sigma_graph, int num_bins, TH2* mu_err_graph, TH2* sigma_err_graph,
+                                                     int nThreads, double fastFitEntries)
 {
   if (!hist) {
     cout<< "ProfileZwithIterativeGaussFit(): No histogram supplied!"<<endl;
@@ -94,76 +529,76 @@ void HistogramHelpers::profileZwithIterativeGaussFit(TH3* hist, TH2* mu_graph, T
   double num_not_converged = 0;
   int num_skipped = 0;
 
-  double max_sigma = 0;
-  double min_sigma = 0;
-
-  double max_mu = 0;
-  double min_mu = 0;
-
-  TH1D* current_proj;
   if (fDebug || false) std::cout << " ** profileZwithIterativeGaussFit ** target: " << mu_graph->GetName() << " ** " << std::endl; 
 
+  //With one thread the projections are fitted by ROOT one by one, otherwise 
+  //the slices are collected first, then fitted concurrently
+  std::vector<std::pair<int,int> > firstBins;
+  std::vector<HistoSlice> slices;
+  std::vector<GaussFitResult> fits;
   for (int i = 1; i < num_bins_x+(num_bins==1); i+=num_bins) {
-
     for (int j = 1; j < num_bins_y+(num_bins==1); j+=num_bins) {
-      
-      int index = i/num_bins;
-      int index_y = j/num_bins;
-
-      current_proj = hist->ProjectionZ(Form("%s_GaussProjection_%i_%i",hist->GetName(),index, index_y),i,i+num_bins-1,j,j+num_bins-1);
-      current_proj->SetTitle(Form("%s - Bin %i x %i",hist->GetName(), index,index_y));
-
-      double current_mu,current_err_mu, current_sigma, current_err_sigma;
-
-      if(current_proj->GetEntries() < minEntries) {
-	//if (m_PrintLevel >= 3) cout << " ** profileZwithIterativeGaussFit ** fitting " << hist->GetName() << "  bin (" << index << ", " << index_y << ") "
-	//			    << " Not enough entries " << current_proj->GetEntries() << " < " << minEntries << endl;
-	//current_mu = -999;
-	current_mu = 0;
-	current_sigma = 0;
-	current_err_mu = 1;
-	current_err_sigma = 1;
-	
-	if (fDebug) std::cout<<"WARNING: Only "<<current_proj->GetEntries()<<" entries in bin "<<index<<","<<index_y<< " in histogram " <<hist->GetName()<< std::endl;
-	num_skipped++;
+      firstBins.push_back(std::make_pair(i,j));
+      if (nThreads == 1) {
+        TH1D* proj = hist->ProjectionZ(Form("%s_GaussProjection_%i_%i",hist->GetName(),i/num_bins, j/num_bins),i,i+num_bins-1,j,j+num_bins-1);
+        proj->SetTitle(Form("%s - Bin %i x %i",hist->GetName(), i/num_bins,j/num_bins));
+        fits.push_back(fitProjection(proj, minEntries, 0));
+      }
+      else
+        slices.push_back(getSliceZ(hist,i,i+num_bins-1,j,j+num_bins-1));
+    }
+  }
 
-      } 
-      else {
-	//if (m_PrintLevel >= 3) cout << " ** profileZwithIterativeGaussFit ** fitting " << hist->GetName() 
-	//			    << "  bin (" << index << ", " << index_y << ") "
-	//			    << "  entries: "<< current_proj->GetEntries()
-	//			    << endl;
-	
-	IterativeGaussFit(current_proj, current_mu, current_err_mu, current_sigma, current_err_sigma);
-	
-	if (current_sigma > max_sigma || max_sigma == 0) max_sigma = current_sigma;
-	if (current_sigma < min_sigma || min_sigma == 0) min_sigma = current_sigma;
-	if (current_mu > max_mu || max_mu == 0) max_mu = current_mu;
-	if (current_mu < min_mu || min_mu == 0) min_mu = current_mu;
+  if (nThreads != 1) fits = fitSlices(slices, minEntries, nThreads, fastFitEntries);
+
+  for (size_t islice = 0; islice < fits.size(); ++islice) {
+
+    int i = firstBins[islice].first;
+    int j = firstBins[islice].second;
+    int index = i/num_bins;
+    int index_y = j/num_bins;
+
+    double current_mu,current_err_mu, current_sigma, current_err_sigma;
+
+    if (fits[islice].status == 1) {
+      current_mu = 0;
+      current_sigma = 0;
+      current_err_mu = 1;
+      current_err_sigma = 1;
 	
-      }//end if entries < minEntries
+      if (fDebug) std::cout<<"WARNING: Not enough entries in bin "<<index<<","<<index_y<< " in histogram " <<hist->GetName()<< std::endl;
+      num_skipped++;
+    } 
+    else {
+      current_mu = fits[islice].mu;
+      current_err_mu = fits[islice].mu_err;
+      current_sigma = fits[islice].sigma;
+      current_err_sigma = fits[islice].sigma_err;
+
+      if (!slices.empty() && outFile_for_projections && outFile_for_projections->IsOpen())
+        writeProjection(Form("%s_GaussProjection_%i_%i",hist->GetName(),index, index_y),
+                        Form("%s - Bin %i x %i",hist->GetName(), index,index_y), slices[islice], fits[islice]);
+    }//end if entries < minEntries
       
-      float x_coord = (hist->GetXaxis()->GetBinLowEdge(i) + hist->GetXaxis()->GetBinUpEdge(i+num_bins-1))/2;
-      float y_coord = (hist->GetYaxis()->GetBinLowEdge(j) + hist->GetYaxis()->GetBinUpEdge(j+num_bins-1))/2;
+    float x_coord = (hist->GetXaxis()->GetBinLowEdge(i) + hist->GetXaxis()->GetBinUpEdge(i+num_bins-1))/2;
+    float y_coord = (hist->GetYaxis()->GetBinLowEdge(j) + hist->GetYaxis()->GetBinUpEdge(j+num_bins-1))/2;
       
-      int binx = mu_graph->GetXaxis()->FindBin(x_coord);
-      int biny = mu_graph->GetYaxis()->FindBin(y_coord);
-      if (mu_graph) {
-	mu_graph->Fill(x_coord,y_coord,current_mu);
-	mu_graph->SetBinError(binx,biny, current_err_mu);
-	if (fDebug || false) std::cout << " ** profileZwithIterativeGaussFit ** target: " << mu_graph->GetName()
-				       << " bin(" << binx << ", " << biny << ") = " << current_mu
-				       << " +- " << current_err_mu << std::endl;
-      }
-      //should probably be replace bin content, not fill?
-      if (sigma_graph)         sigma_graph->SetBinContent(binx, biny, current_sigma);
-      if (sigma_err_graph) sigma_err_graph->SetBinContent(binx, biny, current_err_sigma);
-      if (mu_err_graph)       mu_err_graph->SetBinContent(binx, biny,current_err_mu);
-      
-      delete current_proj;
+    int binx = mu_graph->GetXaxis()->FindBin(x_coord);
+    int biny = mu_graph->GetYaxis()->FindBin(y_coord);
+    if (mu_graph) {
+      mu_graph->Fill(x_coord,y_coord,current_mu);
+      mu_graph->SetBinError(binx,biny, current_err_mu);
+      if (fDebug || false) std::cout << " ** profileZwithIterativeGaussFit ** target: " << mu_graph->GetName()
+				     << " bin(" << binx << ", " << biny << ") = " << current_mu
+				     << " +- " << current_err_mu << std::endl;
+    }
+    //should probably be replace bin content, not fill?
+    if (sigma_graph)         sigma_graph->SetBinContent(binx, biny, current_sigma);
+    if (sigma_err_graph) sigma_err_graph->SetBinContent(binx, biny, current_err_sigma);
+    if (mu_err_graph)       mu_err_graph->SetBinContent(binx, biny,current_err_mu);
       
-    } //end loop on j (y)
-  } //end loop on i (x)
+  } //end loop on slices
+  
   
   if (mu_graph) {
     mu_graph->GetXaxis()->SetTitle(hist->GetXaxis()->GetTitle());
@@ -222,7 +657,8 @@ void HistogramHelpers::profileZwithIterativeGaussFit(TH3* hist, TH2* mu_graph, T
 
 
 //-----------------------------------------------------------------------------
-void HistogramHelpers::profileYwithIterativeGaussFit(TH2* hist, TH1* mu_graph, TH1* sigma_graph, int num_bins,int m_PrintLevel)
+void HistogramHelpers::profileYwithIterativeGaussFit(TH2* hist, TH1* mu_graph, TH1* sigma_graph, int num_bins,int m_PrintLevel,
+                                                     int nThreads, double fastFitEntries)
 {
   
   if (!hist) {
@@ -252,25 +688,33 @@ void HistogramHelpers::profileYwithIterativeGaussFit(TH2* hist, TH1* mu_graph, T
   errs_sigma[0] = 0;
   errs_sigma[num_bins_x/num_bins + 1] = 0;
 
-  double min_sigma = 0;
-  double max_sigma = 0;
-  double min_mu = 0;
-  double max_mu = 0;
-
   int num_skipped = 0;
 
-  TH1D* current_proj;
-
+  //With one thread the projections are fitted by ROOT one by one, otherwise 
+  //the slices are collected first, then fitted concurrently
+  std::vector<int> firstBins;
+  std::vector<HistoSlice> slices;
+  std::vector<GaussFitResult> fits;
   for (int i = 1; i < (num_bins_x + (num_bins == 1)); i+=num_bins) {
+    firstBins.push_back(i);
+    if (nThreads == 1)
+      fits.push_back(fitProjection(hist->ProjectionY(Form("%s_projection_%i",hist->GetName(),i/num_bins - (num_bins == 1)),i,i+num_bins-1),
+                                   minEntries, m_PrintLevel));
+    else
+      slices.push_back(getSliceY(hist,i,i+num_bins-1));
+  }
+
+  if (nThreads != 1) fits = fitSlices(slices, minEntries, nThreads, fastFitEntries);
+
+  for (size_t islice = 0; islice < fits.size(); ++islice) {
 
+    int i = firstBins[islice];
     int index = i/num_bins;
     if (num_bins == 1) index--;
 
-    current_proj = hist->ProjectionY(Form("%s_projection_%i",hist->GetName(),index),i,i+num_bins-1);
-
     double mu, mu_err, sigma, sigma_err;
 
-    if(current_proj->GetEntries() < minEntries) {
+    if (fits[islice].status == 1) {
       mu = 0;
       mu_err = 0;
       sigma = 0;
@@ -279,13 +723,19 @@ void HistogramHelpers::profileYwithIterativeGaussFit(TH2* hist, TH1* mu_graph, T
       if ( fDebug ) std::cout<<"WARNING: Not enough entries in bin "<<index<<std::endl;
     } else {
 
-      IterativeGaussFit(current_proj, mu, mu_err, sigma, sigma_err,m_PrintLevel);
+      mu = fits[islice].mu;
+      mu_err = fits[islice].mu_err;
+      sigma = fits[islice].sigma;
+      sigma_err = fits[islice].sigma_err;
 
-      if (sigma > max_sigma || max_sigma == 0) max_sigma = sigma;
-      if (sigma < min_sigma || min_sigma == 0) min_sigma = sigma;
-      if (mu > max_mu || max_mu == 0) max_mu = mu;
-      if (mu < min_mu || min_mu == 0) min_mu = mu;
+      if (!slices.empty() && m_PrintLevel >= 1)
+        cout << " ** IterativeGaussFit ** fit result: histo name " << Form("%s_projection_%i",hist->GetName(),index) << endl
+             << "    mu = " << mu << " +- " << mu_err << endl
+             << " sigma = " << sigma << " +- " << sigma_err
+             << endl;
 
+      if (!slices.empty() && outFile_for_projections && outFile_for_projections->IsOpen())
+        writeProjection(Form("%s_projection_%i",hist->GetName(),index), hist->GetTitle(), slices[islice], fits[islice]);
     }
 
     double value_x = (hist->GetXaxis()->GetBinLowEdge(i) + hist->GetXaxis()->GetBinUpEdge(i+num_bins-1))/2;
@@ -297,13 +747,6 @@ void HistogramHelpers::profileYwithIterativeGaussFit(TH2* hist, TH1* mu_graph, T
         
     errs_mu[index + 1] = mu_err;
     errs_sigma[index + 1] = sigma_err;
-    
-    /*
-    std::cout<<hist->GetName()<<" "<<index+1<<"  mu = " <<mu<<"+/-"<<mu_err<<std::endl;
-    std::cout<<hist->GetName()<<" "<<index+1<<"  sigma = " <<sigma<<"+/-"<<sigma_err<<std::endl;
-    */
-
-    delete current_proj;
   }
 
   if (sigma_graph) {
@@ -538,7 +981,7 @@ int HistogramHelpers::IterativeGaussFit(TH1* hist, double &mu, double &mu_err, d
   }
   
   
-  if (outFile_for_projections->IsOpen()) {
+  if (outFile_for_projections && outFile_for_projections->IsOpen()) {
       TCanvas q; 
       q.cd();
       hist->Draw();
@@ -552,13 +995,15 @@ int HistogramHelpers::IterativeGaussFit(TH1* hist, double &mu, double &mu_err, d
   return 0;
 }
 
+TFile* HistogramHelpers::outFile_for_projections = nullptr;
+
 void HistogramHelpers::OpenProjectionFile() {
     outFile_for_projections = new TFile("debug_projections_histogramHelpers.root","RECREATE");
 }
 
 void HistogramHelpers::CloseProjectionFile() {
     
-    if (outFile_for_projections->IsOpen())  
+    if (outFile_for_projections && outFile_for_projections->IsOpen())  
         outFile_for_projections->Close();
 }
 
@@ -0,0 +1,33 @@
+#include "JsonConfigCache.h"
+#include <fstream>
+#include <stdexcept>
+#include <sys/stat.h>
+
+std::mutex JsonConfigCache::mutex_;
+std::map<std::string, JsonConfigCache::Entry> JsonConfigCache::entries_;
+
+json JsonConfigCache::get(const std::string& fileName) {
+
+    struct stat st;
+    if (stat(fileName.c_str(), &st) != 0)
+        throw std::runtime_error("[ JsonConfigCache ]: Unable to open " + fileName);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(fileName);
+    if (it != entries_.end() && it->second.mtime_ == st.st_mtime)
+        return it->second.content_;
+
+    std::ifstream i_file(fileName);
+    if (!i_file.is_open())
+        throw std::runtime_error("[ JsonConfigCache ]: Unable to open " + fileName);
+
+    Entry& entry = entries_[fileName];
+    i_file >> entry.content_;
+    entry.mtime_ = st.st_mtime;
+    return entry.content_;
+}
+
+void JsonConfigCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
@@ -0,0 +1,66 @@
+#include "MCGenealogy.h"
+
+#include <algorithm>
+#include <climits>
+
+void MCGenealogy::clear() {
+    parts_ = nullptr;
+    daughters_ = nullptr;
+    indices_.clear();
+    pdg_indices_.clear();
+}
+
+void MCGenealogy::build(const std::vector<MCParticle*>* parts, const std::vector<int>* daughters) {
+    clear();
+    if (!parts)
+        return;
+
+    parts_ = parts;
+    // Files written without the genealogy have no daughter indices
+    if (daughters && !daughters->empty())
+        daughters_ = daughters;
+
+    indices_.reserve(parts->size());
+    pdg_indices_.reserve(parts->size());
+    for (int ipart = 0; ipart < (int)parts->size(); ipart++) {
+        indices_.emplace((*parts)[ipart]->getID(), ipart);
+        pdg_indices_.emplace_back((*parts)[ipart]->getPDG(), ipart);
+    }
+    std::sort(pdg_indices_.begin(), pdg_indices_.end());
+}
+
+int MCGenealogy::getIndex(int partID) const {
+    auto it = indices_.find(partID);
+    return it == indices_.end() ? -1 : it->second;
+}
+
+std::vector<int> MCGenealogy::getIndicesWithPDG(int pdg) const {
+    std::vector<int> indices;
+    auto it = std::lower_bound(pdg_indices_.begin(), pdg_indices_.end(), std::make_pair(pdg, INT_MIN));
+    for (; it != pdg_indices_.end() && it->first == pdg; ++it)
+        indices.push_back(it->second);
+    return indices;
+}
+
+MCParticle* MCGenealogy::getLastWithPDG(int pdg) const {
+    auto it = std::lower_bound(pdg_indices_.begin(), pdg_indices_.end(), std::make_pair(pdg, INT_MAX));
+    if (it == pdg_indices_.begin() || (it-1)->first != pdg)
+        return nullptr;
+    return getParticle((it-1)->second);
+}
+
+std::vector<MCParticle*> MCGenealogy::getAncestors(const MCParticle* part) const {
+    std::vector<MCParticle*> ancestors;
+    for (MCParticle* mother = getMother(part); mother && (int)ancestors.size() < size(); mother = getMother(mother))
+        ancestors.push_back(mother);
+    return ancestors;
+}
+
+MCParticle* MCGenealogy::getAncestorWithPDG(const MCParticle* part, int pdg) const {
+    int generation = 0;
+    for (MCParticle* mother = getMother(part); mother && generation < size(); mother = getMother(mother), generation++) {
+        if (mother->getPDG() == pdg)
+            return mother;
+    }
+    return nullptr;
+}
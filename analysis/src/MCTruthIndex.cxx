@@ -0,0 +1,82 @@
+#include "MCTruthIndex.h"
+
+#include <algorithm>
+#include <climits>
+
+void MCTruthIndex::clear() {
+    hit_parts_.clear();
+    parts_.clear();
+}
+
+void MCTruthIndex::build(const std::vector<TrackerHit*>* hits, const std::vector<MCParticle*>* parts) {
+    clear();
+
+    if (hits) {
+        for (auto hit : *hits) {
+            for (auto partID : hit->getMCPartIDs())
+                hit_parts_.emplace_back(hit->getID(), partID);
+        }
+        // Hits shared by several tracks are stored once per track
+        std::sort(hit_parts_.begin(), hit_parts_.end());
+        hit_parts_.erase(std::unique(hit_parts_.begin(), hit_parts_.end()), hit_parts_.end());
+    }
+
+    if (parts) {
+        parts_.reserve(parts->size());
+        for (auto part : *parts)
+            parts_.emplace(part->getID(), part);
+    }
+}
+
+std::pair<MCTruthIndex::const_iterator, MCTruthIndex::const_iterator> MCTruthIndex::getMCPartIDs(int hitID) const {
+    auto first = std::lower_bound(hit_parts_.begin(), hit_parts_.end(), std::make_pair(hitID, INT_MIN));
+    auto last = first;
+    while (last != hit_parts_.end() && last->first == hitID)
+        ++last;
+    return std::make_pair(first, last);
+}
+
+bool MCTruthIndex::hasMCPart(int hitID, int partID) const {
+    return std::binary_search(hit_parts_.begin(), hit_parts_.end(), std::make_pair(hitID, partID));
+}
+
+MCParticle* MCTruthIndex::getParticle(int partID) const {
+    auto it = parts_.find(partID);
+    return it == parts_.end() ? nullptr : it->second;
+}
+
+int MCTruthIndex::getMajorityParticle(const Track* track, const std::vector<TrackerHit*>* hits, int* nHits) const {
+
+    int ids[MAX_TRACK_PARTS];
+    int counts[MAX_TRACK_PARTS];
+    int nParts = 0;
+
+    for (int ihit = 0; ihit < track->getNSvtHits(); ihit++) {
+        TrackerHit* hit = track->getSvtHit(ihit, hits);
+        if (!hit) continue;
+        auto range = getMCPartIDs(hit->getID());
+        for (auto it = range.first; it != range.second; ++it) {
+            int ipart = 0;
+            while (ipart < nParts && ids[ipart] != it->second) 
+                ipart++;
+            if (ipart == nParts) {
+                if (nParts == MAX_TRACK_PARTS) continue;
+                ids[nParts] = it->second;
+                counts[nParts++] = 0;
+            }
+            counts[ipart]++;
+        }
+    }
+
+    int maxID = 0;
+    int maxNHits = 0;
+    for (int ipart = 0; ipart < nParts; ipart++) {
+        if (counts[ipart] > maxNHits || (counts[ipart] == maxNHits && ids[ipart] < maxID)) {
+            maxNHits = counts[ipart];
+            maxID = ids[ipart];
+        }
+    }
+
+    if (nHits) *nHits = maxNHits;
+    return maxID;
+}
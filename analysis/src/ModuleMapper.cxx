@@ -1,4 +1,6 @@
 #include "ModuleMapper.h"
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
 #include "TString.h"
 ModuleMapper::ModuleMapper(const int year) {
@@ -500,8 +502,42 @@ ModuleMapper::ModuleMapper(const int year) {
     {
         std::cout << "ERROR: Module Mapper cannot be setup for this year " << year_ << std::endl;
     }
+
+    // Dense sw to hw table, to look sensors up by number
+    int nLayers = 0;
+    for (strmap_it it = sw_to_hw.begin(); it != sw_to_hw.end(); ++it) {
+        int layer, module;
+        if (parseSw(it->first, layer, module)) {
+            nLayers = std::max(nLayers, layer+1);
+            nModules_ = std::max(nModules_, module+1);
+        }
+    }
+    sw_to_febhyb.assign(nLayers*nModules_, std::make_pair(-1, -1));
+    for (strmap_it it = sw_to_hw.begin(); it != sw_to_hw.end(); ++it) {
+        int layer, module, feb, hybrid;
+        if (parseSw(it->first, layer, module) && parseHw(it->second, feb, hybrid))
+            sw_to_febhyb[layer*nModules_+module] = std::make_pair(feb, hybrid);
+    }
 } 
 
+void ModuleMapper::setFamilySw(HistoFamily& family, const std::vector<std::string>& strings) {
+    for (int member = 0; member < (int)strings.size(); ++member) {
+        int layer, module;
+        if (parseSw(string_to_sw[strings[member]], layer, module))
+            family.setMember(layer, module, member);
+    }
+}
+
+bool ModuleMapper::parseSw(const std::string& sw, int& layer, int& module) {
+    char end;
+    return std::sscanf(sw.c_str(), "ly%d_m%d%c", &layer, &module, &end) == 2 && layer >= 0 && module >= 0;
+}
+
+bool ModuleMapper::parseHw(const std::string& hw, int& feb, int& hybrid) {
+    char end;
+    return std::sscanf(hw.c_str(), "F%dH%d%c", &feb, &hybrid, &end) == 2 && feb >= 0 && hybrid >= 0;
+}
+
 std::map<std::string, std::map<int,int>> ModuleMapper::buildChannelSvtIDMap(){
 
     std::map<std::string, std::map<int,int>> channel_map;
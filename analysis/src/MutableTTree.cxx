@@ -6,10 +6,20 @@ MutableTTree::MutableTTree(TFile* infile, std::string tree_name){
    if(tree_ == nullptr)
        std::cout << "[MutableTTree]::ERROR READING TREE " << tree_name << " from file " << std::endl;
    initializeFlatTuple(tree_, tuple_);
+   //Held in memory, independently of the input file
    newtree_ = new TTree();
+   newtree_->SetDirectory(nullptr);
    copyTTree();
 }
 
+MutableTTree::~MutableTTree(){
+    if(newtree_ != tree_)
+        delete newtree_;
+    delete tree_;
+    for(std::map<std::string,double*>::iterator it = tuple_.begin(); it != tuple_.end(); it++)
+        delete it->second;
+}
+
 double MutableTTree::getValue(std::string branch_name){
     if(tuple_.find(branch_name) == tuple_.end()){
         return -9999.9;
@@ -0,0 +1,36 @@
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+void parallelFor(size_t n, int nThreads, const std::function<void(size_t)>& fn) {
+
+    if (nThreads <= 0) nThreads = std::max(1u, std::thread::hardware_concurrency());
+    nThreads = std::min<size_t>(nThreads, n);
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto work = [&]() {
+        try {
+            for (size_t i = next++; i < n; i = next++)
+                fn(i);
+        } catch (...) {
+            // Stop handing out iterations and keep the first error
+            next = n;
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int ithread = 1; ithread < nThreads; ++ithread) workers.emplace_back(work);
+    work();
+    for (auto& worker : workers) worker.join();
+
+    if (error) std::rethrow_exception(error);
+}
@@ -0,0 +1,125 @@
+#include "StreamingStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+void RunningMoments::fill(double value, double weight) {
+    if (weight == 0.)
+        return;
+
+    // Start from the first value itself: value*weight/weight may be off by
+    // a rounding, which the update below would scale by the value.
+    if (entries_ == 0) {
+        entries_ = 1;
+        sumw_ = weight;
+        mean_ = value;
+        min_ = max_ = value;
+        return;
+    }
+
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    ++entries_;
+
+    // Weighted Welford update
+    sumw_ += weight;
+    double delta = value - mean_;
+    mean_ += delta*weight/sumw_;
+    m2_ += weight*delta*(value - mean_);
+}
+
+void RunningMoments::merge(const RunningMoments& other) {
+    if (other.entries_ == 0)
+        return;
+    if (entries_ == 0) {
+        *this = other;
+        return;
+    }
+
+    // Pairwise combination of Chan et al.
+    double sumw = sumw_ + other.sumw_;
+    double delta = other.mean_ - mean_;
+    mean_ += delta*other.sumw_/sumw;
+    m2_ += other.m2_ + delta*delta*sumw_*other.sumw_/sumw;
+    sumw_ = sumw;
+    entries_ += other.entries_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+double RunningMoments::getRMS() const {
+    return std::sqrt(std::max(getVariance(), 0.));
+}
+
+BinnedCounts::BinnedCounts(int nbins, double min, double max) :
+    nbins_(nbins), min_(min), max_(max), counts_(nbins+2, 0.) {
+
+    if (nbins <= 0 || !(min < max))
+        throw std::runtime_error("[ BinnedCounts ]: Invalid binning "+std::to_string(nbins)
+                +" bins in ["+std::to_string(min)+", "+std::to_string(max)+"]");
+}
+
+void BinnedCounts::fill(double value, double weight) {
+    int bin = findBin(value);
+    counts_[bin] += weight;
+    ++entries_;
+
+    // Under/overflows don't enter the statistics, as in TH1::Fill
+    if (bin < 1 || bin > nbins_)
+        return;
+    sumw_ += weight;
+    sumw2_ += weight*weight;
+    sumwx_ += weight*value;
+    sumwx2_ += weight*value*value;
+}
+
+void BinnedCounts::merge(const BinnedCounts& other) {
+    if (other.nbins_ != nbins_ || other.min_ != min_ || other.max_ != max_)
+        throw std::runtime_error("[ BinnedCounts ]: Can't merge counts with different binnings");
+
+    for (size_t bin = 0; bin < counts_.size(); ++bin)
+        counts_[bin] += other.counts_[bin];
+    entries_ += other.entries_;
+    sumw_ += other.sumw_;
+    sumw2_ += other.sumw2_;
+    sumwx_ += other.sumwx_;
+    sumwx2_ += other.sumwx2_;
+}
+
+double BinnedCounts::getRMS() const {
+    if (sumw_ == 0.)
+        return 0.;
+    double mean = sumwx_/sumw_;
+    return std::sqrt(std::fabs(sumwx2_/sumw_ - mean*mean));
+}
+
+double BinnedCounts::getQuantile(double fraction) const {
+    double total = 0.;
+    for (int bin = 1; bin <= nbins_; ++bin)
+        total += counts_[bin];
+    if (total <= 0.)
+        return 0.;
+
+    double width = (max_-min_)/nbins_;
+    double target = std::min(std::max(fraction, 0.), 1.)*total;
+    double cumulative = 0.;
+    for (int bin = 1; bin <= nbins_; ++bin) {
+        double content = counts_[bin];
+        if (content > 0. && cumulative + content >= target)
+            return min_ + (bin-1)*width + width*(target-cumulative)/content;
+        cumulative += content;
+    }
+    return max_;
+}
+
+int BinnedCounts::findFirstBinAbove(double threshold) const {
+    for (int bin = 1; bin <= nbins_; ++bin)
+        if (counts_[bin] > threshold) return bin;
+    return -1;
+}
+
+int BinnedCounts::findLastBinAbove(double threshold) const {
+    for (int bin = nbins_; bin >= 1; --bin)
+        if (counts_[bin] > threshold) return bin;
+    return -1;
+}
@@ -1,6 +1,9 @@
 #include "Svt2DBlHistos.h"
 #include <math.h>
+#include <algorithm>
+#include <thread>
 #include "TCanvas.h"
+#include "ParallelFor.h"
 
 Svt2DBlHistos::Svt2DBlHistos(const std::string& inputName, ModuleMapper* mmapper) {
     m_name = inputName;
@@ -24,13 +27,17 @@ void Svt2DBlHistos::DefineHistos(){
     std::string makeMultiplesTag = "SvtHybrids";
     HistoManager::DefineHistos(hybridNames, makeMultiplesTag );
 
+    // Resolve the hybrids and histograms once, so filling doesn't build names
+    hybridHistos_ = getFamily(hybridNames, makeMultiplesTag);
+    mmapper_->setFamilySw(hybridHistos_, hybridNames);
+    hitNIndex_ = hybridHistos_.getIndex("SvtHybridsHitN_h");
+    s0Index_ = hybridHistos_.getIndex("SvtHybrids_s0_hh");
+    s3Index_ = hybridHistos_.getIndex("SvtHybrids_s3_hh");
 }
 
-void Svt2DBlHistos::FillHistograms(std::vector<RawSvtHit*> *rawSvtHits_,float weight) {
+template <typename HitAt>
+void Svt2DBlHistos::fillHits(int nhits, HitAt hitAt, float weight) {
 
-    int nhits = rawSvtHits_->size();
-    std::vector<std::string> hybridStrings={};
-    std::string histokey;
     if(Event_number%10000 == 0) std::cout << "Event: " << Event_number 
         << " Number of RawSvtHits: " << nhits << std::endl;
 
@@ -38,7 +45,7 @@ void Svt2DBlHistos::FillHistograms(std::vector<RawSvtHit*> *rawSvtHits_,float we
     int svtHybMulti[4][15] = {0};
     for (int i = 0; i < nhits; i++)
     {
-        RawSvtHit* rawSvtHit = rawSvtHits_->at(i);
+        auto rawSvtHit = hitAt(i);
         int mod = rawSvtHit->getModule();
         int lay = rawSvtHit->getLayer();
         svtHybMulti[mod][lay]++;
@@ -50,9 +57,7 @@ void Svt2DBlHistos::FillHistograms(std::vector<RawSvtHit*> *rawSvtHits_,float we
         {
             if (!(j<9 && i>1))
             {   
-                std::string swTag = mmapper_->getStringFromSw("ly"+std::to_string(j)+"_m"+std::to_string(i));
-                hybridStrings.push_back(swTag);
-                Fill1DHisto(swTag+ "_SvtHybridsHitN_h", svtHybMulti[i][j],weight);
+                hybridHistos_.at(j, i).fill(hitNIndex_, svtHybMulti[i][j], weight);
             }
         }
     }
@@ -63,27 +68,75 @@ void Svt2DBlHistos::FillHistograms(std::vector<RawSvtHit*> *rawSvtHits_,float we
     //Populates histograms for each hybrid
     for (int i = 0; i < nhits; i++)
     {
-        RawSvtHit* rawSvtHit = rawSvtHits_->at(i);
-        auto mod = std::to_string(rawSvtHit->getModule());
-        auto lay = std::to_string(rawSvtHit->getLayer());
-        std::string swTag= mmapper_->getStringFromSw("ly"+lay+"_m"+mod);
+        auto rawSvtHit = hitAt(i);
+
+        //Buffer the samples, the threads fill them in flush
+        if (nThreads_ > 1) {
+            int member = hybridHistos_.getMember(rawSvtHit->getLayer(), rawSvtHit->getModule());
+            if (member < 0)
+                continue;
+            samples_[member].push_back({(float)rawSvtHit->getStrip(),
+                    (float)rawSvtHit->getADCs()[0],
+                    (float)rawSvtHit->getADCs()[3],
+                    weight});
+            nSamples_++;
+            continue;
+        }
+
+        HistoFamily::Member histos = hybridHistos_.at(rawSvtHit->getLayer(), rawSvtHit->getModule());
         
         //Manually select which baselines (0 - 6) are included. THIS MUST MATCH THE JSON FILE!
-        int ss = 0;
-        histokey = swTag + "_SvtHybrids_s"+std::to_string(ss)+"_hh";
-                    Fill2DHisto(histokey, 
+        histos.fill(s0Index_, 
                 (float)rawSvtHit->getStrip(),
-                (float)rawSvtHit->getADCs()[ss], 
+                (float)rawSvtHit->getADCs()[0], 
                 weight);
 
-        ss = 3;
-        histokey = swTag + "_SvtHybrids_s"+std::to_string(ss)+"_hh";
-                    Fill2DHisto(histokey, 
+        histos.fill(s3Index_, 
                 (float)rawSvtHit->getStrip(),
-                (float)rawSvtHit->getADCs()[ss], 
+                (float)rawSvtHit->getADCs()[3], 
                 weight);
         
     }
 
+    if (nSamples_ >= maxSamples_)
+        flush();
+
             Event_number++;
 }      
+
+void Svt2DBlHistos::FillHistograms(std::vector<RawSvtHit*> *rawSvtHits_,float weight) {
+    fillHits(rawSvtHits_->size(), [rawSvtHits_](int i) { return rawSvtHits_->at(i); }, weight);
+}
+
+void Svt2DBlHistos::FillHistograms(const RawSvtHitArrays& rawSvtHits,float weight) {
+    fillHits(rawSvtHits.size(), [&rawSvtHits](int i) { return rawSvtHits.at(i); }, weight);
+}
+
+void Svt2DBlHistos::setThreads(int nThreads) {
+    flush();
+    if (nThreads <= 0) nThreads = std::max(1u, std::thread::hardware_concurrency());
+    nThreads_ = nThreads;
+    samples_.assign(nThreads_ > 1 ? hybridHistos_.getNMembers() : 0, std::vector<BlSample>());
+}
+
+void Svt2DBlHistos::flush() {
+    if (nSamples_ == 0)
+        return;
+
+    //Each hybrid is filled by one thread, in the order of its samples
+    parallelFor(samples_.size(), nThreads_, [&](size_t member) {
+        HistoFamily::Member histos = hybridHistos_.at(member);
+        for (const BlSample& sample : samples_[member]) {
+            histos.fill(s0Index_, sample.strip, sample.adc0, sample.weight);
+            histos.fill(s3Index_, sample.strip, sample.adc3, sample.weight);
+        }
+        samples_[member].clear();
+    });
+
+    nSamples_ = 0;
+}
+
+void Svt2DBlHistos::saveHistos(TFile* outF, std::string folder) {
+    flush();
+    HistoManager::saveHistos(outF, folder);
+}
@@ -3,10 +3,133 @@
 #include "TVector3.h"
 #include <iostream>
 
+namespace {
+
+    /** Track variable of a plain 1D histogram, filled once per track */
+    struct TrackVariable {
+        const char* name; //!< histogram name without the prefix
+        double (*get)(Track* track, int n_hits_2d); //!< value
+    };
+
+    /** Pair of track variables of a 2D histogram */
+    struct TrackVariable2D {
+        const char* name; //!< histogram name without the prefix
+        double (*getX)(Track* track, int n_hits_2d); //!< x value
+        double (*getY)(Track* track, int n_hits_2d); //!< y value
+    };
+
+    double getD0(Track* track, int) { return track->getD0(); }
+    double getPhi(Track* track, int) { return track->getPhi(); }
+    double getTanLambda(Track* track, int) { return track->getTanLambda(); }
+    double getZ0(Track* track, int) { return track->getZ0(); }
+    double getP(Track* track, int) { return track->getP(); }
+
+    // xpos_at_ecal_h takes the three coordinates at the ECal
+    const TrackVariable trackVariables[] = {
+        {"d0_h",            getD0},
+        {"Phi_h",           getPhi},
+        {"Omega_h",         [](Track* track, int) { return track->getOmega(); }},
+        {"pT_h",            [](Track* track, int) { return -1*(double)track->getCharge()*track->getPt(); }},
+        {"p_h",             getP},
+        {"invpT_h",         [](Track* track, int) { return -1*(double)track->getCharge()/track->getPt(); }},
+        {"TanLambda_h",     getTanLambda},
+        {"Z0_h",            getZ0},
+        {"time_h",          [](Track* track, int) { return track->getTrackTime(); }},
+        {"chi2_h",          [](Track* track, int) { return track->getChi2(); }},
+        {"chi2ndf_h",       [](Track* track, int) { return track->getChi2Ndf(); }},
+        {"nShared_h",       [](Track* track, int) { return (double)track->getNShared(); }},
+        {"nHits_2d_h",      [](Track*, int n_hits_2d) { return (double)n_hits_2d; }},
+        {"track_xpos_h",    [](Track* track, int) { return track->getPosition().at(0); }},
+        {"track_ypos_h",    [](Track* track, int) { return track->getPosition().at(1); }},
+        {"track_zpos_h",    [](Track* track, int) { return track->getPosition().at(2); }},
+        {"xpos_at_ecal_h",  [](Track* track, int) { return track->getPositionAtEcal().at(0); }},
+        {"xpos_at_ecal_h",  [](Track* track, int) { return track->getPositionAtEcal().at(1); }},
+        {"xpos_at_ecal_h",  [](Track* track, int) { return track->getPositionAtEcal().at(2); }},
+        {"d0_err_h",        [](Track* track, int) { return track->getD0Err(); }},
+        {"Phi_err_h",       [](Track* track, int) { return track->getPhiErr(); }},
+        {"Omega_err_h",     [](Track* track, int) { return track->getOmegaErr(); }},
+        {"TanLambda_err_h", [](Track* track, int) { return track->getTanLambdaErr(); }},
+        {"Z0_err_h",        [](Track* track, int) { return track->getZ0Err(); }},
+        {"type_h",          [](Track* track, int) { return (double)track->getType(); }}
+    };
+
+    const TrackVariable2D trackVariables2D[] = {
+        {"TanLambda_vs_Phi_hh", getPhi,       getTanLambda},
+        {"p_vs_Phi_hh",         getPhi,       getP},
+        {"p_vs_TanLambda_hh",   getTanLambda, getP}
+    };
+
+    const TrackVariable2D trackVariables2DTrack[] = {
+        {"tanlambda_vs_phi0_hh", getPhi,       getTanLambda},
+        {"d0_vs_p_hh",           getP,         getD0},
+        {"d0_vs_phi0_hh",        getPhi,       getD0},
+        {"d0_vs_tanlambda_hh",   getTanLambda, getD0},
+        {"z0_vs_p_hh",           getP,         getZ0},
+        {"phi0_vs_p_hh",         getP,         getPhi},
+        {"z0_vs_phi0_hh",        getPhi,       getZ0},
+        {"z0_vs_tanlambda_hh",   getTanLambda, getZ0}
+    };
+
+    /** Vertex variable of a 1D histogram */
+    struct VertexVariable {
+        const char* name; //!< histogram name
+        double (*get)(Vertex* vtx, const TVector3& svtPos); //!< value
+        bool weighted; //!< fill with the weight of the vertex
+    };
+
+    /** Pair of vertex variables of a 2D histogram */
+    struct VertexVariable2D {
+        const char* name; //!< histogram name
+        double (*getX)(Vertex* vtx, const TVector3& svtPos); //!< x value
+        double (*getY)(Vertex* vtx, const TVector3& svtPos); //!< y value
+    };
+
+    double getVtxX(Vertex* vtx, const TVector3&) { return vtx->getX(); }
+    double getVtxY(Vertex* vtx, const TVector3&) { return vtx->getY(); }
+    double getSvtX(Vertex*, const TVector3& svtPos) { return svtPos.X(); }
+    double getSvtY(Vertex*, const TVector3& svtPos) { return svtPos.Y(); }
+
+    // The momentum histograms are filled without the weight of the vertex
+    // Covariance: 0 xx 1 xy 2 xz 3 yy 4 yz 5 zz
+    const VertexVariable vertexVariables[] = {
+        {"vtx_chi2_h",      [](Vertex* vtx, const TVector3&) { return vtx->getChi2(); }, true},
+        {"vtx_X_h",         getVtxX, true},
+        {"vtx_Y_h",         getVtxY, true},
+        {"vtx_Z_h",         [](Vertex* vtx, const TVector3&) { return vtx->getZ(); }, true},
+        {"vtx_X_svt_h",     getSvtX, true},
+        {"vtx_Y_svt_h",     getSvtY, true},
+        {"vtx_Z_svt_h",     [](Vertex*, const TVector3& svtPos) { return svtPos.Z(); }, true},
+        {"vtx_sigma_X_h",   [](Vertex* vtx, const TVector3&) { return (double)sqrt(vtx->getCovariance()[0]); }, true},
+        {"vtx_sigma_Y_h",   [](Vertex* vtx, const TVector3&) { return (double)sqrt(vtx->getCovariance()[3]); }, true},
+        {"vtx_sigma_Z_h",   [](Vertex* vtx, const TVector3&) { return (double)sqrt(vtx->getCovariance()[5]); }, true},
+        {"vtx_InvM_h",      [](Vertex* vtx, const TVector3&) { return (double)vtx->getInvMass(); }, true},
+        {"vtx_InvMErr_Z_h", [](Vertex* vtx, const TVector3&) { return (double)vtx->getInvMassErr(); }, true},
+        {"vtx_px_h",        [](Vertex* vtx, const TVector3&) { return vtx->getP().X(); }, false},
+        {"vtx_py_h",        [](Vertex* vtx, const TVector3&) { return vtx->getP().Y(); }, false},
+        {"vtx_pz_h",        [](Vertex* vtx, const TVector3&) { return vtx->getP().Z(); }, false},
+        {"vtx_p_h",         [](Vertex* vtx, const TVector3&) { return vtx->getP().Mag(); }, false}
+    };
+
+    const VertexVariable2D vertexVariables2D[] = {
+        {"vtx_XY_hh",     getVtxX, getVtxY},
+        {"vtx_XY_svt_hh", getSvtX, getSvtY}
+    };
+}
+
 void TrackHistos::BuildAxes(){}
 
+void TrackHistos::Clear() {
+    trackPlans_.clear();
+    vertexPlan_.reset();
+    HistoManager::Clear();
+}
+
 void TrackHistos::DefineTrkHitHistos(){
 
+    //The plans hold the histograms found at their first fill
+    trackPlans_.clear();
+    vertexPlan_.reset();
+
     std::vector<std::string> trkTypes;
     trkTypes.push_back("topEle");
     trkTypes.push_back("botEle");
@@ -94,39 +217,41 @@ void TrackHistos::Fill1DVertex(Vertex* vtx,
         Particle* pos, 
         Track* ele_trk,
         Track* pos_trk,
-        float weight) {
+        float weight,
+        const std::vector<TrackerHit*>* hits) {
 
-    Fill1DVertex(vtx,weight);
+    VertexCandidate cand;
+    cand.build(vtx, ele, pos, ele_trk, pos_trk, 0.);
+    Fill1DVertex(cand, weight, hits);
+}
 
-    CalCluster eleClus = ele->getCluster();
-    CalCluster posClus = pos->getCluster();
-
-    //TODO remove hardcode!
-    if (ele_trk)
-        Fill1DTrack(ele_trk,weight,"ele_");
-    if (pos_trk)
-        Fill1DTrack(pos_trk,weight,"pos_");
+void TrackHistos::Fill1DVertex(const VertexCandidate& cand, float weight, const std::vector<TrackerHit*>* hits) {
 
+    Vertex* vtx = cand.getVertex();
+    Fill1DVertex(vtx,weight);
 
-    TLorentzVector p_ele;
-    //p_ele.SetPxPyPzE(ele->getMomentum()[0], ele->getMomentum()[1],ele->getMomentum()[2],ele->getEnergy());
-    p_ele.SetPxPyPzE(ele_trk->getMomentum()[0],ele_trk->getMomentum()[1],ele_trk->getMomentum()[2],ele->getEnergy());
+    //TODO remove hardcode!
+    Fill1DTrack(cand.getEleTrack(), (int)cand[VertexCandidate::ELE_N2D_HITS], weight, "ele_", hits);
+    Fill1DTrack(cand.getPosTrack(), (int)cand[VertexCandidate::POS_N2D_HITS], weight, "pos_", hits);
 
-    TLorentzVector p_pos;
-    //p_pos.SetPxPyPzE(pos->getMomentum()[0], pos->getMomentum()[1],pos->getMomentum()[2],pos->getEnergy());
-    p_pos.SetPxPyPzE(pos_trk->getMomentum()[0],pos_trk->getMomentum()[1],pos_trk->getMomentum()[2],pos->getEnergy());
+    double eleClusE = cand[VertexCandidate::ELE_CLUS_E];
+    double posClusE = cand[VertexCandidate::POS_CLUS_E];
+    double ele_p = cand[VertexCandidate::ELE_P];
+    double pos_p = cand[VertexCandidate::POS_P];
 
     //Fill ele and pos information
-    //Fill1DHisto("ele_p_h",p_ele.P(),weight);
-    //Fill1DHisto("pos_p_h",p_pos.P(),weight);
-    Fill1DHisto("ele_clusE_h",eleClus.getEnergy(),weight);
-    Fill1DHisto("pos_clusE_h",posClus.getEnergy(),weight);
-    Fill1DHisto("ele_EoP_h",eleClus.getEnergy()/p_ele.P(),weight);
-    Fill1DHisto("pos_EoP_h",posClus.getEnergy()/p_pos.P(),weight);
-    Fill2DHisto("EoP_hh", eleClus.getEnergy()/p_ele.P(), posClus.getEnergy()/p_pos.P(),weight);
+    Fill1DHisto("ele_clusE_h",eleClusE,weight);
+    Fill1DHisto("pos_clusE_h",posClusE,weight);
+    Fill1DHisto("ele_EoP_h",eleClusE/ele_p,weight);
+    Fill1DHisto("pos_EoP_h",posClusE/pos_p,weight);
+    Fill2DHisto("EoP_hh", eleClusE/ele_p, posClusE/pos_p,weight);
 
 
     //Compute some extra variables 
+    TLorentzVector p_ele(cand[VertexCandidate::ELE_PX], cand[VertexCandidate::ELE_PY],
+            cand[VertexCandidate::ELE_PZ], cand[VertexCandidate::ELE_E]);
+    TLorentzVector p_pos(cand[VertexCandidate::POS_PX], cand[VertexCandidate::POS_PY],
+            cand[VertexCandidate::POS_PZ], cand[VertexCandidate::POS_E]);
 
     //TODO::Rotate them
     p_ele.RotateY(-0.0305);
@@ -161,12 +286,12 @@ void TrackHistos::Fill1DVertex(Vertex* vtx,
 
     //Esum
     Fill1DHisto("Pmiss_h", p_miss.P(),weight);
-    Fill1DHisto("Esum_h",ele->getEnergy() + pos->getEnergy(),weight);
-    Fill1DHisto("EsumClus_h",eleClus.getEnergy() + posClus.getEnergy(),weight);
-    Fill2DHisto("EClus_hh", eleClus.getEnergy() , posClus.getEnergy(),weight);
-    Fill2DHisto("InvM_eleP_hh", p_ele.P(), vtx->getInvMass(),weight);
-    Fill2DHisto("InvM_posP_hh", p_pos.P(), vtx->getInvMass(), weight);
-    Fill1DHisto("Psum_h",p_ele.P() + p_pos.P(),weight);
+    Fill1DHisto("Esum_h",cand[VertexCandidate::E_SUM],weight);
+    Fill1DHisto("EsumClus_h",cand[VertexCandidate::CLUS_E_SUM],weight);
+    Fill2DHisto("EClus_hh", eleClusE, posClusE,weight);
+    Fill2DHisto("InvM_eleP_hh", ele_p, vtx->getInvMass(),weight);
+    Fill2DHisto("InvM_posP_hh", pos_p, vtx->getInvMass(), weight);
+    Fill1DHisto("Psum_h",cand[VertexCandidate::P_SUM],weight);
     Fill1DHisto("PtAsym_h",pt_asym_val,weight);
     Fill1DHisto("thetax_v0_h",thetax_v0_val,weight);
     Fill1DHisto("thetax_pos_h",thetax_pos_val,weight);
@@ -181,113 +306,94 @@ void TrackHistos::Fill2DTrack(Track* track, float weight, const std::string& trk
 
     if (track) {
 
-        double d0 = track->getD0();
-        double z0 = track->getZ0();
-        Fill2DHisto(trkname+"tanlambda_vs_phi0_hh",track->getPhi(),track->getTanLambda(), weight);
-        Fill2DHisto(trkname+"d0_vs_p_hh",track->getP(),d0,weight);
-        Fill2DHisto(trkname+"d0_vs_phi0_hh",track->getPhi(),d0,weight);
-        Fill2DHisto(trkname+"d0_vs_tanlambda_hh",track->getTanLambda(),d0,weight);
-
-        Fill2DHisto(trkname+"z0_vs_p_hh",track->getP(),z0,weight);
-        Fill2DHisto(trkname+"phi0_vs_p_hh",track->getP(),track->getPhi(),weight);
-        Fill2DHisto(trkname+"z0_vs_phi0_hh",track->getPhi(),z0,weight);
-        Fill2DHisto(trkname+"z0_vs_tanlambda_hh",track->getTanLambda(),z0,weight);
+        for (const TrackFill2D& fill : getTrackPlan(trkname).fills2dTrack)
+            fill.histo->Fill((float)fill.getX(track, 0), (float)fill.getY(track, 0), weight);
 
     }
 }
 
-void TrackHistos::Fill1DTrack(Track* track, float weight, const std::string& trkname) {
-
-    double charge = (double) track->getCharge();
+void TrackHistos::Fill1DTrack(Track* track, float weight, const std::string& trkname, 
+        const std::vector<TrackerHit*>* hits) {
 
     //2D hits
     int n_hits_2d = track->getTrackerHitCount();
     if (!track->isKalmanTrack())
         n_hits_2d*=2;
 
-    Fill1DHisto(trkname+"d0_h"       ,track->getD0()          ,weight);
-    Fill1DHisto(trkname+"Phi_h"      ,track->getPhi()         ,weight);
-    Fill1DHisto(trkname+"Omega_h"    ,track->getOmega()       ,weight);
-    Fill1DHisto(trkname+"pT_h"       ,-1*charge*track->getPt(),weight);
-    Fill1DHisto(trkname+"p_h"        ,track->getP()           ,weight);
-    Fill1DHisto(trkname+"invpT_h"    ,-1*charge/track->getPt(),weight);
-    Fill1DHisto(trkname+"TanLambda_h",track->getTanLambda()   ,weight);
-    Fill1DHisto(trkname+"Z0_h"       ,track->getZ0()          ,weight);
-    Fill1DHisto(trkname+"time_h"     ,track->getTrackTime()   ,weight);
-    Fill1DHisto(trkname+"chi2_h"     ,track->getChi2()        ,weight);
-    Fill1DHisto(trkname+"chi2ndf_h"  ,track->getChi2Ndf()     ,weight);
-    Fill1DHisto(trkname+"nShared_h"  ,track->getNShared()     ,weight);
-    Fill1DHisto(trkname+"nHits_2d_h" ,n_hits_2d               ,weight);
-    Fill1DHisto(trkname+"track_xpos_h",track->getPosition().at(0) ,weight);
-    Fill1DHisto(trkname+"track_ypos_h",track->getPosition().at(1) ,weight);
-    Fill1DHisto(trkname+"track_zpos_h",track->getPosition().at(2) ,weight);
-    Fill1DHisto(trkname+"xpos_at_ecal_h",track->getPositionAtEcal().at(0) ,weight);
-    Fill1DHisto(trkname+"xpos_at_ecal_h",track->getPositionAtEcal().at(1) ,weight);
-    Fill1DHisto(trkname+"xpos_at_ecal_h",track->getPositionAtEcal().at(2) ,weight);
+    Fill1DTrack(track, n_hits_2d, weight, trkname, hits);
+}
+
+void TrackHistos::Fill1DTrack(Track* track, int n_hits_2d, float weight, const std::string& trkname, 
+        const std::vector<TrackerHit*>* hits) {
+
+    const TrackPlan& plan = getTrackPlan(trkname);
+
+    for (const TrackFill1D& fill : plan.fills1d)
+        fill.histo->Fill((float)fill.get(track, n_hits_2d), weight);
 
     //Top vs Bot
-    if(track->getTanLambda() > 0.0)
-        Fill1DHisto(trkname+"top_track_z0_h", track->getZ0(), weight);
-    else
-        Fill1DHisto(trkname+"bot_track_z0_h", track->getZ0(), weight);
-
-    //Track param errors
-    Fill1DHisto(trkname+"d0_err_h"       ,track->getD0Err()          ,weight);
-    Fill1DHisto(trkname+"Phi_err_h"      ,track->getPhiErr()         ,weight);
-    Fill1DHisto(trkname+"Omega_err_h"    ,track->getOmegaErr()       ,weight);
-    Fill1DHisto(trkname+"TanLambda_err_h",track->getTanLambdaErr()   ,weight);
-    Fill1DHisto(trkname+"Z0_err_h"       ,track->getZ0Err()          ,weight);
-
-    for (int ihit=0; ihit<track->getSvtHits().GetEntries();++ihit) 
-    {
-        TrackerHit* hit2d = (TrackerHit*) track->getSvtHits().At(ihit);
-        Fill1DHisto(trkname+"hit_lay_h",hit2d->getLayer()  ,weight);
+    TH1* z0Histo = track->getTanLambda() > 0.0 ? plan.topZ0 : plan.botZ0;
+    if (z0Histo)
+        z0Histo->Fill((float)track->getZ0(), weight);
+
+    if (plan.hitLayer) {
+        for (int ihit=0; ihit<track->getNSvtHits();++ihit) 
+        {
+            TrackerHit* hit2d = track->getSvtHit(ihit, hits);
+            if (!hit2d) continue;
+            plan.hitLayer->Fill(hit2d->getLayer(), weight);
+        }
     }
+
     //Fill 2D histos
-    Fill2DHisto(trkname+"TanLambda_vs_Phi_hh"      ,track->getPhi()  , track->getTanLambda()       ,weight);
-    Fill2DHisto(trkname+"p_vs_Phi_hh"      ,track->getPhi()  , track->getP()       ,weight);
-    Fill2DHisto(trkname+"p_vs_TanLambda_hh"      ,track->getTanLambda()  , track->getP()       ,weight);
+    for (const TrackFill2D& fill : plan.fills2d)
+        fill.histo->Fill((float)fill.getX(track, n_hits_2d), (float)fill.getY(track, n_hits_2d), weight);
 
     //All Tracks
-    Fill1DHisto(trkname+"sharingHits_h",0,weight);
-    if (track->getNShared() == 0)
-        Fill1DHisto(trkname+"sharingHits_h",1.,weight);
-    else {
-        //track has shared hits
-        if (track->getSharedLy0())
-            Fill1DHisto(trkname+"sharingHits_h",2.,weight);
-        if (track->getSharedLy1())
-            Fill1DHisto(trkname+"sharingHits_h",3.,weight);
-        if (track->getSharedLy0() && track->getSharedLy1())
-            Fill1DHisto(trkname+"sharingHits_h",4.,weight);
-        if (!track->getSharedLy0() && !track->getSharedLy1())
-            Fill1DHisto(trkname+"sharingHits_h",5.,weight);
+    if (TH1* sharingHits = plan.sharingHits) {
+        sharingHits->Fill(0.,weight);
+        if (track->getNShared() == 0)
+            sharingHits->Fill(1.,weight);
+        else {
+            //track has shared hits
+            if (track->getSharedLy0())
+                sharingHits->Fill(2.,weight);
+            if (track->getSharedLy1())
+                sharingHits->Fill(3.,weight);
+            if (track->getSharedLy0() && track->getSharedLy1())
+                sharingHits->Fill(4.,weight);
+            if (!track->getSharedLy0() && !track->getSharedLy1())
+                sharingHits->Fill(5.,weight);
+        }
     }
 
-    if (track -> is345Seed())
-        Fill1DHisto(trkname+"strategy_h",0,weight);
-    if (track-> is456Seed())
-        Fill1DHisto(trkname+"strategy_h",1,weight);
-    if (track-> is123SeedC4())
-        Fill1DHisto(trkname+"strategy_h",2,weight);
-    if (track->is123SeedC5())
-        Fill1DHisto(trkname+"strategy_h",3,weight);
-    if (track->isMatchedTrack())
-        Fill1DHisto(trkname+"strategy_h",4,weight);
-    if (track->isGBLTrack())
-        Fill1DHisto(trkname+"strategy_h",5,weight);
-
-
-    Fill1DHisto(trkname+"type_h",track->getType(),weight);
+    if (TH1* strategy = plan.strategy) {
+        if (track -> is345Seed())
+            strategy->Fill(0.,weight);
+        if (track-> is456Seed())
+            strategy->Fill(1.,weight);
+        if (track-> is123SeedC4())
+            strategy->Fill(2.,weight);
+        if (track->is123SeedC5())
+            strategy->Fill(3.,weight);
+        if (track->isMatchedTrack())
+            strategy->Fill(4.,weight);
+        if (track->isGBLTrack())
+            strategy->Fill(5.,weight);
+    }
 }
 
 void TrackHistos::Fill1DVertex(Vertex* vtx, float weight) {
 
-    Fill1DHisto("vtx_chi2_h"   ,vtx->getChi2(),weight);
-    Fill2DHisto("vtx_XY_hh",vtx->getX(),vtx->getY(),weight);
-    Fill1DHisto("vtx_X_h"      ,vtx->getX(),weight);
-    Fill1DHisto("vtx_Y_h"      ,vtx->getY(),weight);
-    Fill1DHisto("vtx_Z_h"      ,vtx->getZ(),weight);
+    if (!vertexPlan_) {
+        vertexPlan_.reset(new VertexPlan());
+        for (const VertexVariable& var : vertexVariables)
+            if (TH1* histo = find1DHisto(var.name))
+                vertexPlan_->fills1d.push_back({histo, var.get, var.weighted});
+        for (const VertexVariable2D& var : vertexVariables2D)
+            if (TH2* histo = find2DHisto(var.name))
+                vertexPlan_->fills2d.push_back({histo, var.getX, var.getY});
+    }
 
     TVector3 vtxPosSvt;
     vtxPosSvt.SetX(vtx->getX());
@@ -296,22 +402,44 @@ void TrackHistos::Fill1DVertex(Vertex* vtx, float weight) {
 
     vtxPosSvt.RotateY(-0.0305);
 
-    Fill2DHisto("vtx_XY_svt_hh",vtxPosSvt.X(),vtxPosSvt.Y(),weight);
-    Fill1DHisto("vtx_X_svt_h",vtxPosSvt.X(),weight);
-    Fill1DHisto("vtx_Y_svt_h",vtxPosSvt.Y(),weight);
-    Fill1DHisto("vtx_Z_svt_h",vtxPosSvt.Z(),weight);
-
-
-    // 0 xx 1 xy 2 xz 3 yy 4 yz 5 zz
-    Fill1DHisto("vtx_sigma_X_h",sqrt(vtx->getCovariance()[0]),weight);
-    Fill1DHisto("vtx_sigma_Y_h",sqrt(vtx->getCovariance()[3]),weight);
-    Fill1DHisto("vtx_sigma_Z_h",sqrt(vtx->getCovariance()[5]),weight);
-    Fill1DHisto("vtx_InvM_h"   ,vtx->getInvMass(),weight);
-    Fill1DHisto("vtx_InvMErr_Z_h",vtx->getInvMassErr(),weight);
-    Fill1DHisto("vtx_px_h",vtx->getP().X());
-    Fill1DHisto("vtx_py_h",vtx->getP().Y());
-    Fill1DHisto("vtx_pz_h",vtx->getP().Z());
-    Fill1DHisto("vtx_p_h" ,vtx->getP().Mag());
+    for (const VertexFill1D& fill : vertexPlan_->fills1d)
+        fill.histo->Fill((float)fill.get(vtx, vtxPosSvt), fill.weighted ? weight : 1.f);
+    for (const VertexFill2D& fill : vertexPlan_->fills2d)
+        fill.histo->Fill((float)fill.getX(vtx, vtxPosSvt), (float)fill.getY(vtx, vtxPosSvt), weight);
+}
+
+const TrackHistos::TrackPlan& TrackHistos::getTrackPlan(const std::string& trkname) {
+
+    auto it = trackPlans_.find(trkname);
+    if (it != trackPlans_.end())
+        return it->second;
+
+    TrackPlan& plan = trackPlans_[trkname];
+    for (const TrackVariable& var : trackVariables)
+        if (TH1* histo = find1DHisto(trkname+var.name))
+            plan.fills1d.push_back({histo, var.get});
+    for (const TrackVariable2D& var : trackVariables2D)
+        if (TH2* histo = find2DHisto(trkname+var.name))
+            plan.fills2d.push_back({histo, var.getX, var.getY});
+    for (const TrackVariable2D& var : trackVariables2DTrack)
+        if (TH2* histo = find2DHisto(trkname+var.name))
+            plan.fills2dTrack.push_back({histo, var.getX, var.getY});
+    plan.topZ0 = find1DHisto(trkname+"top_track_z0_h");
+    plan.botZ0 = find1DHisto(trkname+"bot_track_z0_h");
+    plan.hitLayer = find1DHisto(trkname+"hit_lay_h");
+    plan.sharingHits = find1DHisto(trkname+"sharingHits_h");
+    plan.strategy = find1DHisto(trkname+"strategy_h");
+    return plan;
+}
+
+TH1* TrackHistos::find1DHisto(const std::string& histoName) const {
+    auto it = histos1d.find(m_name+"_"+histoName);
+    return it == histos1d.end() ? nullptr : it->second;
+}
+
+TH2* TrackHistos::find2DHisto(const std::string& histoName) const {
+    auto it = histos2d.find(m_name+"_"+histoName);
+    return it == histos2d.end() ? nullptr : it->second;
 }
 
 void TrackHistos::Fill1DHistograms(Track *track, Vertex* vtx, float weight ) {
@@ -435,16 +563,17 @@ void TrackHistos::FillTrackComparisonHistograms(Track* track_x, Track* track_y,
 //Residual Plots ============ They should probably go somewhere else ====================
 
 
-void TrackHistos::FillResidualHistograms(Track* track, int ly, double res, double sigma) {
+void TrackHistos::FillResidualHistograms(Track* track, int ly, double res, double sigma, 
+        const std::vector<TrackerHit*>* hits) {
 
     double trk_mom = track->getP();
     std::string lyr = std::to_string(ly);
 
     TrackerHit* hit = nullptr;
     //Get the hits on track 
-    for (int ihit = 0; ihit<track->getSvtHits().GetEntries();++ihit) {
-        TrackerHit* tmphit = (TrackerHit*) track->getSvtHits().At(ihit);
-        if (tmphit->getLayer() == ly) {
+    for (int ihit = 0; ihit<track->getNSvtHits();++ihit) {
+        TrackerHit* tmphit = track->getSvtHit(ihit, hits);
+        if (tmphit && tmphit->getLayer() == ly) {
             hit = tmphit;
             break;
         }
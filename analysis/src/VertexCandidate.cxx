@@ -0,0 +1,143 @@
+#include "VertexCandidate.h"
+#include "AnaHelpers.h"
+
+#include <cmath>
+
+namespace {
+
+    /** Names of the variables, in the order of VertexCandidate::Variable */
+    const std::string variableNames[VertexCandidate::N_VARIABLES] = {
+        "ele_E",
+        "pos_E",
+        "eSum",
+        "ele_clusE",
+        "pos_clusE",
+        "clusESum",
+        "ele_px",
+        "ele_py",
+        "ele_pz",
+        "ele_p",
+        "pos_px",
+        "pos_py",
+        "pos_pz",
+        "pos_p",
+        "pSum",
+        "vtx_p",
+        "ele_trk_t",
+        "pos_trk_t",
+        "ele_clus_corr_t",
+        "pos_clus_corr_t",
+        "bot_clus_t",
+        "ele_pos_clus_dt",
+        "ele_trk_clus_dt",
+        "pos_trk_clus_dt",
+        "ele_trk_clus_match",
+        "pos_trk_clus_match",
+        "ele_n2dhits",
+        "pos_n2dhits",
+        "ele_chi2",
+        "pos_chi2",
+        "ele_chi2ndf",
+        "pos_chi2ndf",
+        "ele_nshared",
+        "pos_nshared",
+        "ele_L1",
+        "ele_L2",
+        "pos_L1",
+        "pos_L2"
+    };
+
+    /** 2D hits of a track: GBL tracks count 3D hits */
+    int get2DHits(const Track* trk) {
+        int n2dHits = trk->getTrackerHitCount();
+        if (!trk->isKalmanTrack())
+            n2dHits*=2;
+        return n2dHits;
+    }
+}
+
+void VertexCandidate::build(Vertex* vtx, Particle* ele, Particle* pos, Track* ele_trk, Track* pos_trk,
+                            double timeOffset) {
+    vtx_ = vtx;
+    ele_ = ele;
+    pos_ = pos;
+    ele_trk_ = ele_trk;
+    pos_trk_ = pos_trk;
+
+    CalCluster eleClus = ele->getCluster();
+    CalCluster posClus = pos->getCluster();
+
+    values_[ELE_E] = ele->getEnergy();
+    values_[POS_E] = pos->getEnergy();
+    values_[E_SUM] = values_[ELE_E] + values_[POS_E];
+    values_[ELE_CLUS_E] = eleClus.getEnergy();
+    values_[POS_CLUS_E] = posClus.getEnergy();
+    values_[CLUS_E_SUM] = values_[ELE_CLUS_E] + values_[POS_CLUS_E];
+
+    std::vector<double> ele_mom = ele_trk->getMomentum();
+    std::vector<double> pos_mom = pos_trk->getMomentum();
+    values_[ELE_PX] = ele_mom[0];
+    values_[ELE_PY] = ele_mom[1];
+    values_[ELE_PZ] = ele_mom[2];
+    values_[ELE_P] = std::sqrt(ele_mom[0]*ele_mom[0] + ele_mom[1]*ele_mom[1] + ele_mom[2]*ele_mom[2]);
+    values_[POS_PX] = pos_mom[0];
+    values_[POS_PY] = pos_mom[1];
+    values_[POS_PZ] = pos_mom[2];
+    values_[POS_P] = std::sqrt(pos_mom[0]*pos_mom[0] + pos_mom[1]*pos_mom[1] + pos_mom[2]*pos_mom[2]);
+    values_[P_SUM] = values_[ELE_P] + values_[POS_P];
+    double vtx_px = ele_mom[0] + pos_mom[0];
+    double vtx_py = ele_mom[1] + pos_mom[1];
+    double vtx_pz = ele_mom[2] + pos_mom[2];
+    values_[VTX_P] = std::sqrt(vtx_px*vtx_px + vtx_py*vtx_py + vtx_pz*vtx_pz);
+
+    values_[ELE_TRK_TIME] = ele_trk->getTrackTime();
+    values_[POS_TRK_TIME] = pos_trk->getTrackTime();
+    values_[ELE_CLUS_CORR_TIME] = eleClus.getTime() - timeOffset;
+    values_[POS_CLUS_CORR_TIME] = posClus.getTime() - timeOffset;
+    values_[BOT_CLUS_TIME] = eleClus.getPosition().at(1) < 0.0 ? eleClus.getTime() : posClus.getTime();
+    values_[ELE_POS_CLUS_DT] = values_[ELE_CLUS_CORR_TIME] - values_[POS_CLUS_CORR_TIME];
+    values_[ELE_TRK_CLUS_DT] = values_[ELE_TRK_TIME] - values_[ELE_CLUS_CORR_TIME];
+    values_[POS_TRK_CLUS_DT] = values_[POS_TRK_TIME] - values_[POS_CLUS_CORR_TIME];
+    values_[ELE_TRK_CLUS_MATCH] = ele->getGoodnessOfPID();
+    values_[POS_TRK_CLUS_MATCH] = pos->getGoodnessOfPID();
+
+    values_[ELE_N2D_HITS] = get2DHits(ele_trk);
+    values_[POS_N2D_HITS] = get2DHits(pos_trk);
+    values_[ELE_CHI2] = ele_trk->getChi2();
+    values_[POS_CHI2] = pos_trk->getChi2();
+    values_[ELE_CHI2NDF] = ele_trk->getChi2Ndf();
+    values_[POS_CHI2NDF] = pos_trk->getChi2Ndf();
+    values_[ELE_NSHARED] = ele_trk->getNShared();
+    values_[POS_NSHARED] = pos_trk->getNShared();
+
+    values_[ELE_L1] = 0;
+    values_[ELE_L2] = 0;
+    values_[POS_L1] = 0;
+    values_[POS_L2] = 0;
+}
+
+void VertexCandidate::checkInnermostLayers(AnaHelpers& ah, const std::vector<TrackerHit*>* hits) {
+    bool foundL1 = false;
+    bool foundL2 = false;
+    ah.InnermostLayerCheck(ele_trk_, foundL1, foundL2, hits);
+    values_[ELE_L1] = foundL1;
+    values_[ELE_L2] = foundL2;
+
+    foundL1 = false;
+    foundL2 = false;
+    ah.InnermostLayerCheck(pos_trk_, foundL1, foundL2, hits);
+    values_[POS_L1] = foundL1;
+    values_[POS_L2] = foundL2;
+}
+
+const std::string& VertexCandidate::getName(Variable var) {
+    return variableNames[var];
+}
+
+int VertexCandidate::getIndex(const std::string& name) {
+    for (int ivar = 0; ivar < N_VARIABLES; ++ivar) {
+        if (variableNames[ivar] == name)
+            return ivar;
+    }
+    return -1;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file parallel_for.cxx
+ * @brief Check that parallelFor runs every iteration once and propagates
+ *        the exceptions of its threads.
+ */
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//-----------//
+//   hpstr   //
+//-----------//
+#include "ParallelFor.h"
+
+namespace {
+
+    int failures{0};
+
+    void check(bool ok, const std::string& what) {
+        if (ok) return;
+        ++failures;
+        std::cerr << "---- [ parallel-for ]: " << what << std::endl;
+    }
+
+    /** Every iteration runs exactly once, whatever the number of threads */
+    void checkIterations(size_t n, int nThreads) {
+        std::vector<std::atomic<int>> calls(n);
+        for (auto& count : calls) count = 0;
+        parallelFor(n, nThreads, [&](size_t i) { calls[i]++; });
+
+        std::string what = std::to_string(n) + " iterations on " + std::to_string(nThreads) + " threads";
+        for (size_t i = 0; i < n; ++i)
+            check(calls[i] == 1, what + ": iteration " + std::to_string(i)
+                    + " ran " + std::to_string(calls[i]) + " times");
+    }
+
+    /** The exception of an iteration is rethrown once the threads are done */
+    void checkException(int nThreads) {
+        const size_t n = 100000;
+        std::atomic<size_t> ran(0);
+        std::string what = "exception on " + std::to_string(nThreads) + " threads";
+        bool caught = false;
+        try {
+            parallelFor(n, nThreads, [&](size_t i) {
+                ran++;
+                if (i == 100) throw std::runtime_error("iteration 100");
+            });
+        } catch (const std::runtime_error& error) {
+            caught = true;
+            check(std::string(error.what()) == "iteration 100", what + ": wrong exception " + error.what());
+        } catch (...) {
+            caught = true;
+            check(false, what + ": wrong exception type");
+        }
+        check(caught, what + ": not propagated");
+        // No new iteration starts after the failure
+        check(ran < n, what + ": the loop didn't stop");
+    }
+
+    /** The first of several exceptions is rethrown, and only one */
+    void checkSeveralExceptions() {
+        bool caught = false;
+        try {
+            parallelFor(64, 8, [](size_t i) { throw std::runtime_error(std::to_string(i)); });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        check(caught, "several exceptions: not propagated");
+    }
+}
+
+int main(int, char**) {
+    for (size_t n : {0, 1, 7, 1000}) {
+        for (int nThreads : {0, 1, 3, 64})
+            checkIterations(n, nThreads);
+    }
+
+    for (int nThreads : {1, 4})
+        checkException(nThreads);
+    checkSeveralExceptions();
+
+    if (failures) {
+        std::cerr << "---- [ parallel-for ]: " << failures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "---- [ parallel-for ]: OK" << std::endl;
+    return 0;
+}
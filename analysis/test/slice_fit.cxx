@@ -0,0 +1,161 @@
+/**
+ * @file slice_fit.cxx
+ * @brief Check the slice fitter of HistogramHelpers against known
+ *        Gaussians and against the ROOT fit of IterativeGaussFit(TH1*).
+ */
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TH1D.h"
+
+//-----------//
+//   hpstr   //
+//-----------//
+#include "HistogramHelpers.h"
+
+namespace {
+
+    int failures{0};
+
+    void check(bool ok, const std::string& what) {
+        if (ok) return;
+        ++failures;
+        std::cerr << "---- [ slice-fit ]: " << what << std::endl;
+    }
+
+    /** Samples of a Gaussian */
+    std::vector<double> sample(std::mt19937& rng, double mu, double sigma, int n) {
+        std::normal_distribution<double> gauss(mu, sigma);
+        std::vector<double> values(n);
+        for (double& value : values) value = gauss(rng);
+        return values;
+    }
+
+    /** Slice of nbins bins between lo and hi holding the values, as getSliceY builds it */
+    HistogramHelpers::HistoSlice makeSlice(const std::vector<double>& values, int nbins, double lo, double hi) {
+        HistogramHelpers::HistoSlice slice;
+        for (int i = 0; i <= nbins; ++i) slice.edges.push_back(lo + i*(hi-lo)/nbins);
+        slice.sumw.assign(nbins+2, 0.);
+        slice.sumw2.assign(nbins+2, 0.);
+        for (double value : values) {
+            int bin = value < lo ? 0 : value >= hi ? nbins+1 : 1 + int(nbins*(value-lo)/(hi-lo));
+            slice.sumw[bin] += 1.;
+            slice.sumw2[bin] += 1.;
+        }
+        double sumw = 0, sumwx = 0, sumwx2 = 0;
+        for (int i = 0; i <= nbins+1; ++i) {
+            slice.entries += slice.sumw[i];
+            if (i == 0 || i == nbins+1) continue;
+            double x = 0.5*(slice.edges[i-1] + slice.edges[i]);
+            sumw += slice.sumw[i];
+            sumwx += slice.sumw[i]*x;
+            sumwx2 += slice.sumw[i]*x*x;
+        }
+        slice.mean = sumwx/sumw;
+        slice.rms = std::sqrt(std::fabs(sumwx2/sumw - slice.mean*slice.mean));
+        return slice;
+    }
+
+    /** 
+     * The fit finds the generated mean and width within its errors. Fits 
+     * that reach the iteration limit (status 2) are kept, as by the ROOT 
+     * path: the relative convergence test on mu may never pass for mu ~ 0.
+     */
+    void checkTruth(const HistogramHelpers::GaussFitResult& fit, double mu, double sigma, const std::string& what) {
+        check(fit.status != 1, what + ": not fitted");
+        check(fit.mu_err > 0 && fit.sigma_err > 0, what + ": no fit errors");
+        check(std::fabs(fit.mu - mu) < 4*fit.mu_err,
+                what + ": mu " + std::to_string(fit.mu) + " +- " + std::to_string(fit.mu_err)
+                + ", generated " + std::to_string(mu));
+        check(std::fabs(fit.sigma - sigma) < 4*fit.sigma_err,
+                what + ": sigma " + std::to_string(fit.sigma) + " +- " + std::to_string(fit.sigma_err)
+                + ", generated " + std::to_string(sigma));
+    }
+
+    /** Fit slices of known Gaussians, iteratively and in closed form */
+    void checkKnownGaussians() {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<double> uniform(0., 1.);
+        for (int itest = 0; itest < 50; ++itest) {
+            double mu = -2. + 4.*uniform(rng);
+            double sigma = 0.5 + 1.5*uniform(rng);
+            int n = 2000 + int(20000*uniform(rng));
+            HistogramHelpers::HistoSlice slice = makeSlice(sample(rng, mu, sigma, n), 200, -10., 10.);
+            std::string what = "Gaussian " + std::to_string(itest);
+            checkTruth(HistogramHelpers::IterativeGaussFit(slice), mu, sigma, what);
+            checkTruth(HistogramHelpers::IterativeGaussFit(slice, 1.), mu, sigma, what + " (closed form)");
+        }
+
+        // Too few entries are not fitted
+        HistogramHelpers::HistoSlice sparse = makeSlice(sample(rng, 0., 1., 10), 200, -10., 10.);
+        check(HistogramHelpers::IterativeGaussFit(sparse).status == 1, "sparse slice was fitted");
+    }
+
+    /** fitSlices gives the same results on any number of threads */
+    void checkThreads() {
+        std::mt19937 rng(5678);
+        std::vector<HistogramHelpers::HistoSlice> slices;
+        for (int islice = 0; islice < 64; ++islice)
+            slices.push_back(makeSlice(sample(rng, 0.1*islice, 1., islice % 8 == 0 ? 30 : 5000), 100, -5., 12.));
+
+        std::vector<HistogramHelpers::GaussFitResult> serial = HistogramHelpers::fitSlices(slices, 50, 1);
+        std::vector<HistogramHelpers::GaussFitResult> threaded = HistogramHelpers::fitSlices(slices, 50, 4);
+        for (size_t islice = 0; islice < slices.size(); ++islice) {
+            std::string what = "slice " + std::to_string(islice);
+            check((serial[islice].status == 1) == (islice % 8 == 0), what + ": wrong status");
+            check(serial[islice].status == threaded[islice].status
+                    && serial[islice].mu == threaded[islice].mu
+                    && serial[islice].sigma == threaded[islice].sigma,
+                    what + ": threaded fit differs");
+        }
+    }
+
+    /** The slice fitter agrees with the ROOT fit of the same histogram */
+    void compareWithRoot() {
+        std::mt19937 rng(91011);
+        std::uniform_real_distribution<double> uniform(0., 1.);
+        for (int itest = 0; itest < 20; ++itest) {
+            double mu = -2. + 4.*uniform(rng);
+            double sigma = 0.5 + 1.5*uniform(rng);
+            std::vector<double> values = sample(rng, mu, sigma, 5000 + int(20000*uniform(rng)));
+
+            TH1D hist(("slice_fit_" + std::to_string(itest)).c_str(), "", 200, -10., 10.);
+            hist.SetDirectory(nullptr);
+            for (double value : values) hist.Fill(value);
+            double root_mu, root_mu_err, root_sigma, root_sigma_err;
+            HistogramHelpers::IterativeGaussFit(&hist, root_mu, root_mu_err, root_sigma, root_sigma_err);
+
+            HistogramHelpers::GaussFitResult fit = HistogramHelpers::IterativeGaussFit(makeSlice(values, 200, -10., 10.));
+            std::string what = "ROOT comparison " + std::to_string(itest);
+            check(std::fabs(fit.mu - root_mu) < 0.5*root_mu_err,
+                    what + ": mu " + std::to_string(fit.mu) + ", ROOT " + std::to_string(root_mu));
+            check(std::fabs(fit.sigma - root_sigma) < 0.5*root_sigma_err,
+                    what + ": sigma " + std::to_string(fit.sigma) + ", ROOT " + std::to_string(root_sigma));
+            check(std::fabs(fit.mu_err - root_mu_err) < 0.1*root_mu_err,
+                    what + ": mu error " + std::to_string(fit.mu_err) + ", ROOT " + std::to_string(root_mu_err));
+        }
+    }
+}
+
+int main(int, char**) {
+    checkKnownGaussians();
+    checkThreads();
+    compareWithRoot();
+
+    if (failures) {
+        std::cerr << "---- [ slice-fit ]: " << failures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "---- [ slice-fit ]: OK" << std::endl;
+    return 0;
+}
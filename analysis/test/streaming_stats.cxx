@@ -0,0 +1,202 @@
+/**
+ * @file streaming_stats.cxx
+ * @brief Check the streaming accumulators against the statistics of the
+ *        stored values, and that merging them matches a single fill.
+ */
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//-----------//
+//   hpstr   //
+//-----------//
+#include "StreamingStats.h"
+
+namespace {
+
+    int failures{0};
+
+    void check(bool ok, const std::string& what) {
+        if (ok) return;
+        ++failures;
+        std::cerr << "---- [ streaming-stats ]: " << what << std::endl;
+    }
+
+    bool close(double value, double expected, double tolerance) {
+        return std::fabs(value - expected) <= tolerance*std::max(1., std::fabs(expected));
+    }
+
+    /** Weighted mean and variance computed from the stored values, in two passes */
+    void twoPass(const std::vector<double>& values, const std::vector<double>& weights, double& mean, double& variance) {
+        double sumw = 0., sumwx = 0.;
+        for (size_t i = 0; i < values.size(); ++i) {
+            sumw += weights[i];
+            sumwx += weights[i]*values[i];
+        }
+        mean = sumwx/sumw;
+        double sumwd2 = 0.;
+        for (size_t i = 0; i < values.size(); ++i)
+            sumwd2 += weights[i]*(values[i] - mean)*(values[i] - mean);
+        variance = sumwd2/sumw;
+    }
+
+    /** Welford's moments match two passes, even far from 0, and merged parts match the whole */
+    void checkRunningMoments() {
+        std::mt19937 rng(2468);
+        std::uniform_real_distribution<double> weight(0.5, 2.);
+        for (double offset : {0., 1e9}) {
+            std::normal_distribution<double> gauss(offset, 3.);
+            std::vector<double> values(100000), weights(values.size());
+            RunningMoments all;
+            std::vector<RunningMoments> parts(7);
+            for (size_t i = 0; i < values.size(); ++i) {
+                values[i] = gauss(rng);
+                weights[i] = weight(rng);
+                all.fill(values[i], weights[i]);
+                parts[(i*i) % parts.size()].fill(values[i], weights[i]);
+            }
+            double mean, variance;
+            twoPass(values, weights, mean, variance);
+
+            std::string what = "moments with offset " + std::to_string(offset);
+            check(all.getEntries() == long(values.size()), what + ": wrong entries");
+            check(close(all.getMean(), mean, 1e-12), what + ": mean " + std::to_string(all.getMean())
+                    + ", two passes " + std::to_string(mean));
+            check(close(all.getVariance(), variance, 1e-6), what + ": variance " + std::to_string(all.getVariance())
+                    + ", two passes " + std::to_string(variance));
+            check(all.getMin() == *std::min_element(values.begin(), values.end()), what + ": wrong min");
+            check(all.getMax() == *std::max_element(values.begin(), values.end()), what + ": wrong max");
+
+            RunningMoments merged;
+            for (const RunningMoments& part : parts) merged.merge(part);
+            merged.merge(RunningMoments());
+            check(merged.getEntries() == all.getEntries(), what + ": merged entries differ");
+            check(close(merged.getSumW(), all.getSumW(), 1e-12), what + ": merged sum of weights differs");
+            check(close(merged.getMean(), all.getMean(), 1e-12), what + ": merged mean differs");
+            check(close(merged.getVariance(), all.getVariance(), 1e-6), what + ": merged variance "
+                    + std::to_string(merged.getVariance()) + ", single fill " + std::to_string(all.getVariance()));
+            check(merged.getMin() == all.getMin() && merged.getMax() == all.getMax(), what + ": merged range differs");
+        }
+
+        RunningMoments empty;
+        check(empty.getMean() == 0. && empty.getRMS() == 0., "empty moments not 0");
+    }
+
+    /** Binned counts match the stored values, and merged counts match a single fill exactly */
+    void checkBinnedCounts() {
+        std::mt19937 rng(1357);
+        std::normal_distribution<double> gauss(3., 10.);
+        const int nbins = 400;
+        const double min = -50., max = 50., width = (max-min)/nbins;
+
+        std::vector<double> values(200000);
+        BinnedCounts all(nbins, min, max);
+        std::vector<BinnedCounts> parts(5, BinnedCounts(nbins, min, max));
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = gauss(rng);
+            all.fill(values[i]);
+            parts[i % parts.size()].fill(values[i]);
+        }
+
+        BinnedCounts merged(nbins, min, max);
+        for (const BinnedCounts& part : parts) merged.merge(part);
+        bool same = merged.getEntries() == all.getEntries();
+        for (int bin = 0; bin <= nbins+1; ++bin)
+            same = same && merged.getBinContent(bin) == all.getBinContent(bin);
+        check(same, "merged counts differ");
+        check(close(merged.getMean(), all.getMean(), 1e-12), "merged mean differs");
+        check(close(merged.getRMS(), all.getRMS(), 1e-12), "merged RMS differs");
+
+        // Quantiles of the values in range, within the bin width
+        std::vector<double> inRange;
+        for (double value : values)
+            if (value >= min && value < max) inRange.push_back(value);
+        std::sort(inRange.begin(), inRange.end());
+        for (double fraction : {0.01, 0.16, 0.5, 0.84, 0.99}) {
+            double expected = inRange[size_t(fraction*(inRange.size()-1))];
+            check(std::fabs(all.getQuantile(fraction) - expected) < width,
+                    "quantile " + std::to_string(fraction) + " is " + std::to_string(all.getQuantile(fraction))
+                    + ", sorted values give " + std::to_string(expected));
+        }
+        check(all.getQuantile(0.) >= min && all.getQuantile(1.) <= max, "quantiles out of range");
+
+        double mean = 0.;
+        for (double value : inRange) mean += value;
+        mean /= inRange.size();
+        check(std::fabs(all.getMean() - mean) < 1e-9, "mean " + std::to_string(all.getMean())
+                + ", values give " + std::to_string(mean));
+
+        bool thrown = false;
+        try {
+            all.merge(BinnedCounts(nbins, min, 2*max));
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        check(thrown, "counts with another binning merged");
+
+        check(BinnedCounts(10, 0., 1.).getQuantile(0.5) == 0., "empty quantile not 0");
+    }
+
+    /** Arrays merge element by element, and only with the same size */
+    void checkStatsArray() {
+        StatsArray<RunningMoments> first(N_SVT_HYBRIDS), second(N_SVT_HYBRIDS), all(N_SVT_HYBRIDS);
+        for (int i = 0; i < 1000; ++i) {
+            (i % 3 ? first : second)[i % N_SVT_HYBRIDS].fill(i);
+            all[i % N_SVT_HYBRIDS].fill(i);
+        }
+        first.merge(second);
+        bool same = true;
+        for (int index = 0; index < N_SVT_HYBRIDS; ++index)
+            same = same && first[index].getEntries() == all[index].getEntries()
+                && close(first[index].getMean(), all[index].getMean(), 1e-12);
+        check(same, "merged arrays differ");
+
+        bool thrown = false;
+        try {
+            first.merge(StatsArray<RunningMoments>(N_SVT_CHANNELS));
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        check(thrown, "arrays of different sizes merged");
+
+        StatsArray<BinnedCounts> times(N_SVT_HYBRIDS, BinnedCounts(200, -100., 100.));
+        check(times.size() == size_t(N_SVT_HYBRIDS) && times[N_SVT_HYBRIDS-1].getNbins() == 200,
+                "arrays don't copy the prototype");
+    }
+
+    /** SVT channel indices cover 0 to N_SVT_CHANNELS-1 once */
+    void checkSvtChannels() {
+        std::set<int> channels;
+        for (int feb = 0; feb < 10; ++feb) {
+            for (int hybrid = 0; hybrid < 4; ++hybrid) {
+                for (int channel = 0; channel < (feb < 2 ? 512 : 640); ++channel)
+                    channels.insert(getSvtChannel(feb, hybrid, channel));
+            }
+        }
+        check(channels.size() == size_t(N_SVT_CHANNELS) && *channels.begin() == 0
+                && *channels.rbegin() == N_SVT_CHANNELS-1, "SVT channel indices don't cover the channels once");
+    }
+}
+
+int main(int, char**) {
+    checkRunningMoments();
+    checkBinnedCounts();
+    checkStatsArray();
+    checkSvtChannels();
+
+    if (failures) {
+        std::cerr << "---- [ streaming-stats ]: " << failures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "---- [ streaming-stats ]: OK" << std::endl;
+    return 0;
+}
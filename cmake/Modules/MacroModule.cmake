@@ -21,7 +21,8 @@
 # - The C++ source files are in a directory 'src' and have the extension '.cxx'.
 #
 # - Test programs are in the 'test' directory and define an executable 'main' 
-#   function and also have the '.cxx' extension.
+#   function and also have the '.cxx' extension.  They are registered with 
+#   CTest and must return non-zero on failure.
 #
 # The names of the output executables and test programs will be derived from
 # the source file names using the file's base name stripped of its extension,
@@ -128,6 +129,7 @@ macro(MODULE)
     add_executable(${test_program} ${test_source})
     target_link_libraries(${test_program} ${MODULE_BIN_LIBRARIES})
     install(TARGETS ${test_program} DESTINATION bin)
+    add_test(NAME ${test_program} COMMAND ${test_program})
     if(MODULE_DEBUG)
       message("building test program: ${test_program}")
     endif()
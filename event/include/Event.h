@@ -11,7 +11,14 @@
 //----------------//
 //   C++ StdLib   //
 //----------------//
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 //----------//
 //   LCIO   //
@@ -31,6 +38,7 @@
 #include "Collections.h"
 #include "IEvent.h"
 #include "EventHeader.h"
+#include "LCConversionCache.h"
 
 class Event : public IEvent {
 
@@ -55,12 +63,63 @@ class Event : public IEvent {
          */
         void addCollection(const std::string name, TClonesArray* collection);
 
-        /**  TODO fix docu
-         * Add a collection (std::vector) of objects to the event. */
+        /**
+         * Add a collection (std::vector) of objects to the event. The 
+         * collection stays owned by the caller, which clears it, but its 
+         * memory is tracked and bounded by the event like the TClonesArray 
+         * collections.
+         *
+         * @param name Name of the collection
+         * @param collection The std::vector containing the objects.
+         */
+        template<typename T>
+            void addCollection(const std::string& name, std::vector<T>* collection ){
+                branches_[name] = tree_->Branch(name.c_str(), collection,
+                        getBasketSize(name, 32000), getSplitLevel(name, 99));
+                trackCollection(name, collection);};
 
+        /**
+         * Add an object owned by the caller to the event. 
+         *
+         * @param name Name of the branch
+         * @param object Address of the pointer to the object.
+         */
         template<typename T>
-            void addCollection(const std::string& name, std::vector<T*>* collection ){
-                branches_[name] = tree_->Branch(name.c_str(),&collection);};
+            void addObject(const std::string& name, T** object) {
+                branches_[name] = tree_->Branch(name.c_str(), object,
+                        getBasketSize(name, 32000), getSplitLevel(name, 99));};
+
+        /**
+         * Set the basket size and split level used when collections are 
+         * added to the event. Negative values keep the defaults.
+         *
+         * @param basket_size Basket size in bytes.
+         * @param split_level Split level.
+         */
+        void setBranchSettings(int basket_size, int split_level) {
+            basket_size_ = basket_size; 
+            split_level_ = split_level; 
+        };
+
+        /**
+         * Override the basket size of a given collection.
+         *
+         * @param name Name of the collection, wildcards allowed
+         * @param basket_size Basket size in bytes.
+         */
+        void setBasketSize(const std::string& name, int basket_size) { 
+            basket_sizes_[name] = basket_size; 
+        }; 
+
+        /**
+         * Override the split level of a given collection.
+         *
+         * @param name Name of the collection, wildcards allowed
+         * @param split_level Split level.
+         */
+        void setSplitLevel(const std::string& name, int split_level) { 
+            split_levels_[name] = split_level; 
+        }; 
 
         /** 
          * @param name Name of the collection
@@ -79,10 +138,28 @@ class Event : public IEvent {
         bool exists(const std::string name);
 
         /**
-         * Clear all of the collections in the event 
+         * Clear all of the collections in the event. In bounded memory 
+         * mode, collections whose capacity stayed mostly unused are also 
+         * shrunk. 
          */
         void Clear();
 
+        /**
+         * Enable the bounded memory mode. A collection, TClonesArray or 
+         * std::vector, whose capacity is more than twice the largest number 
+         * of entries it held during the last n_events events is shrunk to 
+         * that size.
+         *
+         * @param n_events Number of events in the window. 0 disables it. 
+         */
+        void setShrinkAfter(int n_events) { shrink_after_ = n_events; }; 
+
+        /**
+         * Print the entries, capacity and approximate memory held by each 
+         * collection of the event, and the peak resident memory of the job. 
+         */
+        void printMemoryReport() const;
+
         /** @return Get a mutable copy of the EventHeader. */
         EventHeader& getEventHeaderMutable() const { return *event_header_; }
 
@@ -92,23 +169,83 @@ class Event : public IEvent {
         /** @return The ROOT tree containing the event. */
         TTree* getTree() { return tree_; }
 
-        /** Set the LCIO event. */
-        void setLCEvent(EVENT::LCEvent* lc_event) { lc_event_ = lc_event; }; 
+        /** 
+         * Set the LCIO event and index its collections by name. This is 
+         * done once per event, so the collection lookups below don't go 
+         * through the LCIO collection names or exceptions. 
+         */
+        void setLCEvent(EVENT::LCEvent* lc_event); 
 
         /** @return LCIO event. */
         EVENT::LCEvent* getLCEvent() { return lc_event_; };
 
-        /** Get the LCIO event. */
-        EVENT::LCCollection* getLCCollection(std::string name) { 
-            return static_cast<EVENT::LCCollection*>(lc_event_->getCollection(name)); 
+        /** 
+         * Get an LCIO collection.
+         *
+         * @param name Name of the collection
+         * 
+         * @return The collection. If it doesn't exist, 
+         *         EVENT::DataNotAvailableException is thrown. 
+         */
+        EVENT::LCCollection* getLCCollection(const std::string& name) { 
+            EVENT::LCCollection* collection = tryGetLCCollection(name); 
+            if (collection) return collection; 
+            return lc_event_->getCollection(name); 
         };
 
+        /**
+         * Get an LCIO collection if the event has it. Unlike 
+         * getLCCollection, this never throws. 
+         *
+         * @param name Name of the collection
+         *
+         * @return The collection, or nullptr if it doesn't exist. 
+         */
+        EVENT::LCCollection* tryGetLCCollection(const std::string& name) const; 
+
+        /**
+         * Get an LCIO collection by ID. 
+         *
+         * @param id ID of the collection name from getLCCollectionID.
+         *
+         * @return The collection, or nullptr if it doesn't exist. 
+         */
+        EVENT::LCCollection* tryGetLCCollection(int id) const; 
+
+        /**
+         * Get a stable ID for an LCIO collection name, registering it if 
+         * needed. Processors resolve the names of their input collections 
+         * once, typically in initialize, and then look them up by ID, which 
+         * is a plain array access. IDs are shared by all the events of the 
+         * job. 
+         *
+         * @param name Name of the collection
+         *
+         * @return The ID of the name. 
+         */
+        static int getLCCollectionID(const std::string& name); 
+
+        /** 
+         * @return The cache of the LCIO objects converted in the current 
+         *         event. It is cleared together with the event. 
+         */
+        LCConversionCache& getConversionCache() { return conversion_cache_; }; 
+
         /**
          * Check if an LCEvent has a collection of the given name.  
          *
          * @return True if the collection exists, False otherwise.
          */
-        bool hasLCCollection(const std::string name); 
+        bool hasLCCollection(const std::string& name) const { 
+            return tryGetLCCollection(name) != nullptr; 
+        }; 
+
+        /**
+         * Check if an LCEvent has a collection of the given ID.  
+         *
+         * @return True if the collection exists, False otherwise.
+         */
+        bool hasLCCollection(int id) const { return tryGetLCCollection(id) != nullptr; }; 
 
         /**
          * Set the current entry. 
@@ -117,6 +254,12 @@ class Event : public IEvent {
          */
         void setEntry(const int entry) { entry_ = entry; }; 
 
+        /** @return The basket size to use for the given collection. */
+        int getBasketSize(const std::string& name, int default_size) const;
+
+        /** @return The split level to use for the given collection. */
+        int getSplitLevel(const std::string& name, int default_level) const;
+
     private: 
 
         /** The event headeer object (as pointer). */
@@ -128,15 +271,83 @@ class Event : public IEvent {
         /** Object used to load all of current LCIO event information. */
         EVENT::LCEvent* lc_event_{nullptr};
 
+        /** LCIO collections of the current event by name. */
+        std::unordered_map<std::string, EVENT::LCCollection*> lc_collections_;
+
+        /** LCIO collections of the current event by ID. */
+        std::vector<EVENT::LCCollection*> lc_collections_by_id_;
+
+        /** LCIO objects converted in the current event. */
+        LCConversionCache conversion_cache_;
+
         /** Container with all TClonesArray collections. */
         std::map<std::string, TObject*> objects_;
 
+        /** 
+         * Memory usage of a collection. The accessors hide whether it is a 
+         * TClonesArray or a std::vector. 
+         */
+        struct CollectionStats { 
+            std::function<int()> entries; //!< Number of entries held
+            std::function<int()> capacity; //!< Number of entries allocated
+            std::function<long()> bytes; //!< Approximate memory held
+            std::function<void(int)> shrink; //!< Reduce the capacity, keeping the entries
+            int peak{0}; //!< Largest number of entries seen
+            int window_peak{0}; //!< Largest number of entries in the current window
+            int window_events{0}; //!< Events in the current window
+            int shrinks{0}; //!< Times the capacity was reduced
+        };
+
+        /** 
+         * Memory usage of the collections. The counters are kept when a 
+         * collection is added again for the next file. 
+         */
+        std::map<std::string, CollectionStats> collection_stats_;
+
+        /** 
+         * Track the memory of a std::vector collection. Only the fixed size 
+         * of the entries is counted, plus the objects pointed to by the 
+         * current entries of a vector of pointers. 
+         */
+        template<typename T>
+            void trackCollection(const std::string& name, std::vector<T>* collection) { 
+                CollectionStats& stats = collection_stats_[name]; 
+                stats.entries = [collection]() { return int(collection->size()); }; 
+                stats.capacity = [collection]() { return int(collection->capacity()); }; 
+                stats.bytes = [collection]() { 
+                    return long(collection->capacity()*sizeof(T)) + long(collection->size()*(std::is_pointer<T>::value 
+                                ? sizeof(typename std::remove_pointer<T>::type) : 0)); 
+                }; 
+                // The vector object stays in place, as its branch points to it
+                stats.shrink = [collection](int size) { 
+                    std::vector<T> shrunk; 
+                    shrunk.reserve(std::max(size_t(size), collection->size())); 
+                    shrunk.assign(collection->begin(), collection->end()); 
+                    collection->swap(shrunk); 
+                }; 
+            }
+
+        /** Events after which an unused capacity is released. 0 disables it. */
+        int shrink_after_{0};
+
         /** Container will all branches. */
         std::map<std::string, TBranch*> branches_; 
 
         /** The current entry. */
         int entry_{0};  
 
+        /** Default basket size of the collections. Negative uses the branch default. */
+        int basket_size_{-1};
+
+        /** Default split level of the collections. Negative uses the branch default. */
+        int split_level_{-1};
+
+        /** Per-collection basket sizes. */
+        std::map<std::string, int> basket_sizes_; 
+
+        /** Per-collection split levels. */
+        std::map<std::string, int> split_levels_; 
+
 }; // Event
 
 #endif // __EVENT_H__
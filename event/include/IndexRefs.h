@@ -0,0 +1,63 @@
+/**
+ * @file IndexRefs.h
+ * @brief Record of the collections referenced by index in an output tree.
+ */
+
+#ifndef __INDEX_REFS_H__
+#define __INDEX_REFS_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <string>
+
+//----------//
+//   ROOT   //
+//----------//
+#include <TTree.h>
+
+/**
+ * When a converter writes its references as indices instead of TRefs, the
+ * name of the sibling collection the indices point into is stored in the 
+ * user info of the tree. Readers, including analysis macros, use it to 
+ * find the collection to pass to Track::getSvtHit, TrackerHit::getRawHit 
+ * and Vertex::getParticle. Files written with TRefs carry no record.
+ */
+namespace IndexRefs {
+
+    /**
+     * Record that the objects of a collection reference a sibling 
+     * collection by index.
+     *
+     * @param tree The output tree
+     * @param collection The referencing collection
+     * @param target The referenced collection
+     */
+    void setTarget(TTree* tree, const std::string& collection, const std::string& target);
+
+    /**
+     * @param tree The input tree
+     * @param collection The referencing collection
+     * @return The collection referenced by index, empty if the collection 
+     *         uses TRefs.
+     */
+    std::string getTarget(TTree* tree, const std::string& collection);
+
+    /**
+     * Resolve the sibling collection a reader needs and check up front 
+     * that the tree holds it.
+     *
+     * @param tree The input tree
+     * @param collection The referencing collection
+     * @param configured The collection configured by the user, if any
+     * @return The configured collection if given, otherwise the recorded 
+     *         one, empty if the collection uses TRefs.
+     * @throw std::runtime_error if the collection is referenced by index 
+     *        and the sibling branch isn't in the tree.
+     */
+    std::string findTarget(TTree* tree, const std::string& collection, 
+            const std::string& configured = "");
+
+} // IndexRefs
+
+#endif // __INDEX_REFS_H__
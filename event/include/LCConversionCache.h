@@ -0,0 +1,92 @@
+/**
+ * @file LCConversionCache.h
+ * @brief Event scoped cache of the LCIO objects converted to hpstr objects.
+ */
+
+#ifndef __LC_CONVERSION_CACHE_H__
+#define __LC_CONVERSION_CACHE_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+//----------//
+//   LCIO   //
+//----------//
+#include <EVENT/Cluster.h>
+#include <EVENT/LCCollection.h>
+#include <EVENT/Track.h>
+#include <UTIL/LCRelationNavigator.h>
+
+//-----------//
+//   hpstr   //
+//-----------//
+#include "CalCluster.h"
+#include "Track.h"
+
+/**
+ * Cache of the conversions of LCIO tracks and clusters, and of the relation
+ * navigators used by them, shared by all the converters of an event. 
+ * Each LCIO object is converted once per event; the cache owns the 
+ * converted objects and must be cleared before the next LCIO event is read.
+ */
+class LCConversionCache {
+
+    public:
+
+        /**
+         * @return The converted track or nullptr if it hasn't been converted.
+         *
+         * @param lc_track The LCIO track
+         * @param trackstate_location Track state the parameters are taken at
+         * @param gbl_kink_data GBL kink data relations used by the conversion
+         * @param track_data Track data relations used by the conversion
+         */
+        Track* getTrack(EVENT::Track* lc_track, const std::string& trackstate_location,
+                EVENT::LCCollection* gbl_kink_data, EVENT::LCCollection* track_data) const;
+
+        /**
+         * Add a converted track to the cache. The cache takes ownership of it.
+         */
+        void addTrack(EVENT::Track* lc_track, const std::string& trackstate_location,
+                EVENT::LCCollection* gbl_kink_data, EVENT::LCCollection* track_data, 
+                Track* track);
+
+        /** @return The converted cluster or nullptr if it hasn't been converted. */
+        CalCluster* getCluster(EVENT::Cluster* lc_cluster) const;
+
+        /** Add a converted cluster to the cache. The cache takes ownership of it. */
+        void addCluster(EVENT::Cluster* lc_cluster, CalCluster* cluster);
+
+        /**
+         * @return The navigator of a LCRelation collection, created on first use.
+         *
+         * @param relations The LCRelation collection
+         */
+        UTIL::LCRelationNavigator* getNavigator(EVENT::LCCollection* relations);
+
+        /** Delete all the cached objects. */
+        void clear();
+
+    private:
+
+        /** Key of a converted track. */
+        typedef std::tuple<EVENT::Track*, std::string, EVENT::LCCollection*, EVENT::LCCollection*> TrackKey;
+
+        /** Converted tracks. */
+        std::map<TrackKey, std::unique_ptr<Track>> tracks_;
+
+        /** Converted clusters. */
+        std::unordered_map<EVENT::Cluster*, std::unique_ptr<CalCluster>> clusters_;
+
+        /** Navigators of the LCRelation collections. */
+        std::unordered_map<EVENT::LCCollection*, std::unique_ptr<UTIL::LCRelationNavigator>> navigators_;
+
+}; // LCConversionCache
+
+#endif // __LC_CONVERSION_CACHE_H__
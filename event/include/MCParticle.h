@@ -45,6 +45,34 @@ class MCParticle : public TObject {
          */
         TRefArray* getDaughters() const { return daughters_; }; 
 
+        /**
+         * Set the position of this particle in the MC particle collection 
+         * of the event.
+         *
+         * @param index Index of the particle
+         */
+        void setIndex(const int index) { index_ = index; };
+
+        /**
+         * Set the index of the mother of this particle, the same parent 
+         * the mother PDG is taken from.
+         *
+         * @param momIndex Index of the mother, -1 if it has none
+         */
+        void setMomIndex(const int momIndex) { mom_index_ = momIndex; };
+
+        /**
+         * Set the range of the daughter indices of this particle in the 
+         * daughter index collection of the event.
+         *
+         * @param begin Position of the first daughter index
+         * @param end Position after the last daughter index
+         */
+        void setDaughterRange(const int begin, const int end) { 
+            daughter_begin_ = begin; 
+            daughter_end_ = end; 
+        };
+
         /**
          * Set the charge of the particle.
          *
@@ -151,6 +179,21 @@ class MCParticle : public TObject {
         
         /** @return The particle ID of the mother. */
         int getMomPDG() const { return momPDG_; }; 
+
+        /** @return The index of the particle in its collection, -1 if not set. */
+        int getIndex() const { return index_; }; 
+
+        /** @return The index of the mother, -1 if it has none or it wasn't set. */
+        int getMomIndex() const { return mom_index_; }; 
+
+        /** @return Position of the first daughter index in the daughter index collection. */
+        int getDaughterBegin() const { return daughter_begin_; }; 
+
+        /** @return Position after the last daughter index in the daughter index collection. */
+        int getDaughterEnd() const { return daughter_end_; }; 
+
+        /** @return Number of daughters in the daughter index collection. */
+        int getNDaughterIndices() const { return daughter_end_ - daughter_begin_; }; 
         
         /** @return The particle generator status. */
         int getGenStatus() const { return gen_; }; 
@@ -179,7 +222,7 @@ class MCParticle : public TObject {
         /** @return The vertex position of the particle. */
         std::vector<double> getEndPoint() const;
 
-        ClassDef(MCParticle, 1);
+        ClassDef(MCParticle, 2);
 
     private:
 
@@ -192,6 +235,18 @@ class MCParticle : public TObject {
         /** The LCIO ID of this particle */
         int id_{-9999}; 
 
+        /** The index of this particle in its collection */
+        int index_{-1}; 
+
+        /** The index of the mother of this particle */
+        int mom_index_{-1}; 
+
+        /** Position of the first daughter index in the daughter index collection */
+        int daughter_begin_{0}; 
+
+        /** Position after the last daughter index in the daughter index collection */
+        int daughter_end_{0}; 
+
         /** The number of daughters associated with this particle */    
         int n_daughters_{0};
 
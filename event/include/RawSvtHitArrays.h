@@ -0,0 +1,188 @@
+/**
+ * @file RawSvtHitArrays.h
+ * @brief Raw svt hit information stored as flat arrays
+ */
+
+#ifndef _RAW_SVT_HIT_ARRAYS_H_
+#define _RAW_SVT_HIT_ARRAYS_H_
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <string>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include <TTree.h>
+
+class RawSvtHitView;
+
+/**
+ * Raw svt hits of an event stored as a structure of arrays. Each array is 
+ * written to its own branch, "<name>_<field>", so events with thousands of 
+ * hits are filled and read without creating an object per hit.
+ */
+class RawSvtHitArrays { 
+
+    public: 
+
+        /** Number of adc samples per hit */
+        static const int N_ADCS = 6;
+
+        /** Maximum number of fits per hit */
+        static const int N_FITS = 2;
+
+        /** Number of parameters per fit: t0, t0 err, amplitude, amplitude err, chi2 */
+        static const int N_FIT_PARS = 5;
+
+        /** Remove all the hits. */
+        void clear();
+
+        /** Reserve space for the given number of hits. */
+        void reserve(std::size_t nhits);
+
+        /** @return The number of hits. */
+        std::size_t size() const { return strip_.size(); }
+
+        /**
+         * Add a hit without fits.
+         *
+         * @return The index of the hit.
+         */
+        std::size_t addHit(int system, int barrel, int layer, int module, 
+                int sensor, int side, int strip, const short* adcs);
+
+        /** Set the fit parameters of a hit */
+        void setFit(std::size_t ihit, int fitI, const double fit[N_FIT_PARS]);
+
+        /** Set the fit multiplicity of a hit */
+        void setFitN(std::size_t ihit, int fitN) { fitN_[ihit] = fitN; }
+
+        /** @return A view of the given hit. */
+        RawSvtHitView at(std::size_t ihit) const;
+
+        /**
+         * Create the branches of the arrays in a tree.
+         *
+         * @param tree The output tree
+         * @param name Prefix of the branch names
+         */
+        void branch(TTree* tree, const std::string& name);
+
+        /**
+         * Read the arrays from the branches of a tree.
+         *
+         * @param tree The input tree
+         * @param name Prefix of the branch names
+         */
+        void setBranchAddresses(TTree* tree, const std::string& name);
+
+        /**
+         * @param name Prefix of the branch names
+         * @return The names of the branches created by branch()
+         */
+        static std::vector<std::string> branchNames(const std::string& name);
+
+    private: 
+
+        friend class RawSvtHitView;
+
+        std::vector<int> system_; 
+        std::vector<int> barrel_; 
+        std::vector<int> layer_; 
+        std::vector<int> module_; 
+        std::vector<int> sensor_; 
+        std::vector<int> side_; 
+        std::vector<int> strip_; 
+
+        /** The raw adcs, N_ADCS per hit. */
+        std::vector<short> adcs_; 
+
+        /** The fit multiplicity of each hit. */
+        std::vector<int> fitN_; 
+
+        /** The fit parameters, N_FITS x N_FIT_PARS per hit. */
+        std::vector<double> fit_; 
+
+        /** Addresses of the vectors handed to the tree when reading. */
+        std::vector<int>* int_addresses_[8]{}; 
+        std::vector<short>* adcs_address_{nullptr}; 
+        std::vector<double>* fit_address_{nullptr}; 
+
+}; // RawSvtHitArrays
+
+/**
+ * Read only access to a hit of RawSvtHitArrays with the interface of 
+ * RawSvtHit. The view is only valid while the arrays aren't modified.
+ */
+class RawSvtHitView { 
+
+    public: 
+
+        RawSvtHitView(const RawSvtHitArrays* arrays, std::size_t ihit) 
+            : arrays_(arrays), ihit_(ihit) {}
+
+        /** Allows the view to be used where a RawSvtHit* is expected. */
+        const RawSvtHitView* operator->() const { return this; }
+
+        /** Get the fit multi */
+        int getFitN() const { return arrays_->fitN_[ihit_]; }
+
+        /** Get the fit paramters */
+        const double* getFit(int fitI) const { 
+            return &arrays_->fit_[(ihit_*RawSvtHitArrays::N_FITS + fitI)*RawSvtHitArrays::N_FIT_PARS]; 
+        }
+
+        /** Get the adc values */
+        const short* getADCs() const { return &arrays_->adcs_[ihit_*RawSvtHitArrays::N_ADCS]; }
+
+        /** Get the system */
+        int getSystem() const { return arrays_->system_[ihit_]; }
+
+        /** Get the barrel */
+        int getBarrel() const { return arrays_->barrel_[ihit_]; }
+
+        /** Get the layer */
+        int getLayer() const { return arrays_->layer_[ihit_]; }
+
+        /** Get the module */
+        int getModule() const { return arrays_->module_[ihit_]; }
+
+        /** Get the sensor */
+        int getSensor() const { return arrays_->sensor_[ihit_]; }
+
+        /** Get the side */
+        int getSide() const { return arrays_->side_[ihit_]; }
+
+        /** Get the strip */
+        int getStrip() const { return arrays_->strip_[ihit_]; }
+
+        /** Get the t0 fit parameter */
+        double getT0(int fitI) const { return getFit(fitI)[0]; }
+
+        /** Get the t0 err fit parameter */
+        double getT0err(int fitI) const { return getFit(fitI)[1]; }
+
+        /** Get the amplitude fit parameter */
+        double getAmp(int fitI) const { return getFit(fitI)[2]; }
+
+        /** Get the amplitude error fit parameter */
+        double getAmpErr(int fitI) const { return getFit(fitI)[3]; }
+
+        /** Get the chiSq probability */
+        double getChiSq(int fitI) const { return getFit(fitI)[4]; }
+
+    private: 
+
+        const RawSvtHitArrays* arrays_; 
+        std::size_t ihit_; 
+
+}; // RawSvtHitView
+
+inline RawSvtHitView RawSvtHitArrays::at(std::size_t ihit) const { 
+    return RawSvtHitView(this, ihit); 
+}
+
+#endif
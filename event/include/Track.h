@@ -24,6 +24,8 @@
 #include "TRef.h"
 
 
+class TrackerHit;
+
 //TODO static?
 namespace TRACKINFO {
     enum STRATEGY  {MATCH = 0, S345, S456, S123C4, S123C5, GBL};
@@ -48,6 +50,15 @@ class Track : public TObject {
          * @param hit : A TrackerHit object
          */
         void addHit(TObject* hit); 
+
+        /**
+         * Add a TrackerHit by its index in the hit collection of the same 
+         * event. Unlike addHit, this doesn't register the hit in the 
+         * TProcessID object table.
+         *
+         * @param index : Index of the hit in the sibling TrackerHit collection
+         */
+        void addHitIndex(const int index); 
         
         /**
          * Set the reference to a truth object
@@ -61,7 +72,27 @@ class Track : public TObject {
         /** 
          * @return A reference to the hits associated with this track. 
          */
-        TRefArray getSvtHits() const { return tracker_hits_; };
+        const TRefArray& getSvtHits() const { return tracker_hits_; };
+
+        /** @return The indices of the hits in the sibling TrackerHit collection. */
+        const std::vector<int>& getSvtHitIndices() const { return hit_indices_; };
+
+        /** @return Number of hits referenced by this track. */
+        int getNSvtHits() const; 
+
+        /**
+         * Get a hit associated with this track. Index based references are 
+         * resolved in the given hit collection. Tracks written with TRefs 
+         * are resolved through the TRefArray.
+         *
+         * @param ihit : Position of the hit on the track
+         * @param hits : The TrackerHit collection the track was written with
+         * @return The hit, nullptr if its TRef can't be resolved.
+         * @throw std::runtime_error if the hits are referenced by index 
+         *        and the collection is missing or doesn't hold them.
+         *        IndexRefs::getTarget gives the collection to read.
+         */
+        TrackerHit* getSvtHit(const int ihit, const std::vector<TrackerHit*>* hits = nullptr) const;
         
         /**
          * Set the track parameters.
@@ -355,6 +386,9 @@ class Track : public TObject {
         /** Reference to the 3D hits associated with this track. */
         TRefArray tracker_hits_{}; 
 
+        /** Indices of the 3D hits in the TrackerHit collection of the event. */
+        std::vector<int> hit_indices_; 
+
         /** Reference to the reconstructed particle associated with this track. */
         TRef particle_;
 
@@ -463,7 +497,7 @@ class Track : public TObject {
         /** Reference to MC Particle. */
         TRef mcp_link_;
         
-        ClassDef(Track, 1);
+        ClassDef(Track, 2);
 }; // Track
 
 #endif // __TRACK_H__
@@ -11,6 +11,7 @@
 //   C++ StdLib   //
 //----------------//
 #include <iostream>
+#include <vector>
 
 //----------//
 //   ROOT   //
@@ -19,6 +20,8 @@
 #include <TClonesArray.h>
 #include <TRefArray.h>
 
+class RawSvtHit;
+
 class TrackerHit : public TObject { 
 
     public: 
@@ -33,7 +36,27 @@ class TrackerHit : public TObject {
         void Clear(Option_t *option="");
 
         /** Get the references to the raw hits associated with this tracker hit */
-        TRefArray getRawHits() const {return raw_hits_;};
+        const TRefArray& getRawHits() const {return raw_hits_;};
+
+        /** @return The indices of the raw hits in the sibling RawSvtHit collection. */
+        const std::vector<int>& getRawHitIndices() const {return raw_hit_indices_;};
+
+        /** @return Number of raw hits referenced by this hit. */
+        int getNRawHits() const;
+
+        /**
+         * Get a raw hit associated with this tracker hit. Index based 
+         * references are resolved in the given raw hit collection. Hits 
+         * written with TRefs are resolved through the TRefArray.
+         *
+         * @param irawhit Position of the raw hit on this hit
+         * @param rawhits The RawSvtHit collection the hit was written with
+         * @return The raw hit, nullptr if its TRef can't be resolved.
+         * @throw std::runtime_error if the raw hits are referenced by index 
+         *        and the collection is missing or doesn't hold them.
+         *        IndexRefs::getTarget gives the collection to read.
+         */
+        RawSvtHit* getRawHit(const int irawhit, const std::vector<RawSvtHit*>* rawhits = nullptr) const;
 
         /**
          * Set the hit position.
@@ -117,6 +140,12 @@ class TrackerHit : public TObject {
             raw_hits_.Add(rawhit);
         }
 
+        /** Add raw hit by its index in the RawSvtHit collection of the same event */
+        void addRawHitIndex(const int index) {
+            ++n_rawhits_;
+            raw_hit_indices_.push_back(index);
+        }
+
         //TODO: I use this to get the shared hits. Not sure if useful. 
         /** LCIO id */
         void setID(const int id) {id_=id;};
@@ -132,7 +161,7 @@ class TrackerHit : public TObject {
         /** Set rawhit strips on hit */
         void setRawHitStripNumbers(std::vector<int> rawhit_strips){rawhit_strips_ = rawhit_strips;};
 
-        ClassDef(TrackerHit, 1);	
+        ClassDef(TrackerHit, 2);	
 
     private:
 
@@ -165,6 +194,9 @@ class TrackerHit : public TObject {
         /** The raw hits */
         TRefArray raw_hits_{TRefArray{}};
 
+        /** Indices of the raw hits in the RawSvtHit collection of the event */
+        std::vector<int> raw_hit_indices_;
+
         /** Layer (Axial + Stereo). 1-6 in 2015/2016 geometry, 0-7 in 2019 geometry */
         int layer_{-999};
 
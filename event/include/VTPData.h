@@ -134,14 +134,59 @@ class VTPData : public TObject {
 
         std::vector<hpsFEETrig> feetrigger;  // Cluster multiplicity.
 
+        std::vector<int> words; // Raw VTP words, only kept when requested. See decode().
+
+        // Sub-banks that can be decoded, one bit per expansion subtype
+        enum SubBank {
+            CLUSTERS      = 1 << 2,
+            SINGLE_TRIGS  = 1 << 3,
+            PAIR_TRIGS    = 1 << 4,
+            CALIB_TRIGS   = 1 << 5,
+            CLUSTER_MULT  = 1 << 6,
+            FEE_TRIGS     = 1 << 7,
+            ALL_SUB_BANKS = CLUSTERS | SINGLE_TRIGS | PAIR_TRIGS | CALIB_TRIGS | CLUSTER_MULT | FEE_TRIGS
+        };
+
     public:
         VTPData();
         ~VTPData();
 
         void print();
 
+        /**
+         * Decode VTP words into the headers, the trigger time and the
+         * selected sub-banks. The sub-banks that aren't selected are left
+         * empty, and their words skipped. The raw words are left as they
+         * are: Clear() resets them.
+         *
+         * @param data The VTP words
+         * @param nwords Number of words
+         * @param subBanks Sub-banks to decode, a mask of SubBank
+         */
+        void decode(const int* data, int nwords, int subBanks = ALL_SUB_BANKS);
+
+        /**
+         * Decode the stored raw words, e.g. when reading a tree written
+         * with the raw words and no decoded sub-banks.
+         *
+         * @param subBanks Sub-banks to decode, a mask of SubBank
+         */
+        void decode(int subBanks = ALL_SUB_BANKS) { decode(words.data(), words.size(), subBanks); };
+
+        /**
+         * Reset the sub-banks and the raw words for the next event. The
+         * vectors keep their capacity, so that decoding the next event
+         * only allocates when it holds more words than any before.
+         */
         void Clear(){
             TObject::Clear();
+            clearSubBanks();
+            words.clear();
+        };
+
+    private:
+        /** Reset the decoded sub-banks, keeping the raw words to decode. */
+        void clearSubBanks(){
             clusters.clear();
             singletrigs.clear();
             pairtrigs.clear();
@@ -150,7 +195,7 @@ class VTPData : public TObject {
             feetrigger.clear();
         };
 
-        ClassDef(VTPData, 1);
+        ClassDef(VTPData, 2);
 
 };
 
@@ -16,6 +16,8 @@
 #include <TRef.h>
 #include <TVector3.h>
 
+class Particle;
+
 //TODO make float/doubles accordingly.
 
 class Vertex : public TObject {
@@ -39,6 +41,14 @@ class Vertex : public TObject {
 
         void addParticle(TObject* part);
 
+        /** 
+         * Add a Particle by its index in the particle collection of the same 
+         * event, without registering it in the TProcessID object table.
+         * 
+         * @param index Index of the particle in the sibling Particle collection
+         */
+        void addParticleIndex(const int index);
+
         //TODO unify
         /** Set the chi2 */
         void setChi2(const double chi2) {chi2_ = chi2;}
@@ -83,7 +93,26 @@ class Vertex : public TObject {
         /** Set the probability */
         void setProbability(const float probability) {probability_ = probability;}
 
-        TRefArray getParticles(){return parts_;}; 
+        const TRefArray& getParticles() const {return parts_;}; 
+
+        /** @return The indices of the particles in the sibling Particle collection. */
+        const std::vector<int>& getParticleIndices() const {return part_indices_;};
+
+        /** @return Number of particles referenced by this vertex. */
+        int getNParticles() const;
+
+        /** 
+         * Get a particle of this vertex. Index based references are resolved in 
+         * the given particle collection, TRefs through the TRefArray.
+         * 
+         * @param ipart Position of the particle in the vertex
+         * @param parts The Particle collection the vertex was written with
+         * @return The particle, nullptr if its TRef can't be resolved.
+         * @throw std::runtime_error if the particles are referenced by index 
+         *        and the collection is missing or doesn't hold them.
+         *        IndexRefs::getTarget gives the collection to read.
+         */
+        Particle* getParticle(const int ipart, const std::vector<Particle*>* parts = nullptr) const;
 
         /** Returns the covariance matrix as a simple vector of values */
         const std::vector<float>& getCovariance() const {return covariance_;}
@@ -147,7 +176,7 @@ class Vertex : public TObject {
         /** Get the Target Constrained Y */
         double getTgtConstrY() const {return parameters_[20];}
         
-        ClassDef(Vertex,1);
+        ClassDef(Vertex,2);
 
     private:
 
@@ -163,6 +192,7 @@ class Vertex : public TObject {
         int id_;
         std::string type_{""};
         TRefArray parts_;
+        std::vector<int> part_indices_;
         int n_parts_{0};
         std::vector<float> parameters_;
 
@@ -7,11 +7,53 @@
 
 #include "Event.h"
 
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+
+#include <sys/resource.h>
+
 /*~~~~~~~~~~*/
 /*   LCIO   */
 /*~~~~~~~~~~*/
 #include <EVENT/LCCollection.h>
 
+/*~~~~~~~~~~*/
+/*   ROOT   */
+/*~~~~~~~~~~*/
+#include "TRegexp.h"
+#include "TString.h"
+
+namespace { 
+
+    /** 
+     * Find the per-collection setting of a collection. An exact name wins, 
+     * otherwise the keys are matched as wildcards, as TTree::SetBasketSize does. 
+     */
+    const int* findBranchSetting(const std::map<std::string, int>& settings, const std::string& name) { 
+        auto it = settings.find(name); 
+        if (it != settings.end()) return &it->second; 
+        TString tname(name.c_str()); 
+        for (auto& setting : settings) { 
+            if (tname.Index(TRegexp(setting.first.c_str(), kTRUE)) != kNPOS) return &setting.second; 
+        }
+        return nullptr; 
+    }
+
+    /** Names of the LCIO collections registered with Event::getLCCollectionID. */
+    struct LCCollectionRegistry { 
+        std::mutex mutex; 
+        std::unordered_map<std::string, int> ids; 
+        std::vector<std::string> names; 
+    };
+
+    LCCollectionRegistry& lcCollectionRegistry() { 
+        static LCCollectionRegistry registry; 
+        return registry; 
+    }
+}
+
 Event::Event() {
     
     // Create the tree
@@ -48,10 +90,18 @@ void Event::addCollection(const std::string name, TClonesArray* collection) {
     if (objects_.find(name) != objects_.end()) return; 
 
     // Add a branch with the given name to the event tree.
-    branches_[name] = tree_->Branch(name.c_str(), collection, 1000000, 3); 
+    branches_[name] = tree_->Branch(name.c_str(), collection, 
+            getBasketSize(name, 1000000), getSplitLevel(name, 3)); 
 
     // Keep track of which collections were added to the event
     objects_[name] = collection;  
+    CollectionStats& stats = collection_stats_[name]; 
+    stats.entries = [collection]() { return collection->GetEntriesFast(); }; 
+    stats.capacity = [collection]() { return collection->GetSize(); }; 
+    // Only the fixed size of the objects, not the memory they point to
+    stats.bytes = [collection]() { return long(collection->GetSize())*collection->GetClass()->Size(); }; 
+    // The objects kept beyond the new size are deleted by TClonesArray::Expand
+    stats.shrink = [collection](int size) { collection->Expand(size); }; 
 }
 
 TClonesArray* Event::getCollection(const std::string name) { 
@@ -70,6 +120,20 @@ TClonesArray* Event::getCollection(const std::string name) {
     }
 }
 
+int Event::getBasketSize(const std::string& name, int default_size) const { 
+    
+    if (const int* size = findBranchSetting(basket_sizes_, name)) return *size;
+    if (basket_size_ > 0) return basket_size_;  
+    return default_size; 
+}
+
+int Event::getSplitLevel(const std::string& name, int default_level) const { 
+    
+    if (const int* level = findBranchSetting(split_levels_, name)) return *level;
+    if (split_level_ >= 0) return split_level_;  
+    return default_level; 
+}
+
 bool Event::exists(const std::string name) {  
     
     // Search the list of collections to find if it exist. 
@@ -81,21 +145,113 @@ bool Event::exists(const std::string name) {
 
 void Event::Clear() { 
     
+    // Record how many entries the collections held in the previous event
+    for (auto& entry : collection_stats_) { 
+        CollectionStats& stats = entry.second; 
+        int n_entries = stats.entries(); 
+        stats.peak = std::max(stats.peak, n_entries); 
+        stats.window_peak = std::max(stats.window_peak, n_entries); 
+        ++stats.window_events; 
+    }
+
     for (auto& collection : objects_) { 
         collection.second->Clear("C"); 
     }
+
+    // Release the capacity that stayed unused over the last window. The 
+    // std::vector collections still hold the previous event, which the 
+    // processors clear themselves, and keep it.
+    if (shrink_after_ > 0) { 
+        const int min_capacity = 16; 
+        for (auto& entry : collection_stats_) { 
+            CollectionStats& stats = entry.second; 
+            if (stats.window_events < shrink_after_) continue; 
+            int capacity = std::max(stats.window_peak, min_capacity); 
+            if (stats.capacity() > 2*capacity) { 
+                stats.shrink(capacity); 
+                ++stats.shrinks; 
+            }
+            stats.window_peak = 0; 
+            stats.window_events = 0; 
+        }
+    }
+
+    // The LCIO objects of the previous event are gone
+    conversion_cache_.clear(); 
+}
+
+void Event::printMemoryReport() const { 
+
+    std::cout << "---- [ hpstr ][ Event ]: Memory held by the collections" << std::endl;
+    std::cout << std::left << std::setw(40) << "Collection" 
+        << std::right << std::setw(12) << "Peak" << std::setw(12) << "Capacity" 
+        << std::setw(16) << "Approx. [B]" << std::setw(10) << "Shrinks" << std::endl;
+    long total = 0; 
+    for (auto& entry : collection_stats_) { 
+        const CollectionStats& stats = entry.second; 
+        long bytes = stats.bytes(); 
+        total += bytes; 
+        std::cout << std::left << std::setw(40) << entry.first 
+            << std::right << std::setw(12) << stats.peak << std::setw(12) << stats.capacity() 
+            << std::setw(16) << bytes << std::setw(10) << stats.shrinks << std::endl;
+    }
+    std::cout << std::left << std::setw(40) << "Total" 
+        << std::right << std::setw(40) << total << std::endl;
+
+    struct rusage usage; 
+    if (getrusage(RUSAGE_SELF, &usage) == 0) 
+        std::cout << "---- [ hpstr ][ Event ]: Peak resident memory: " 
+            << usage.ru_maxrss/1024 << " MB" << std::endl;
 }
 
-bool Event::hasLCCollection(const std::string name) {
+void Event::setLCEvent(EVENT::LCEvent* lc_event) { 
+
+    lc_event_ = lc_event; 
     
-    // Attempt to get the collection of the given name from the event. If it 
-    // doesn't exist, an exemption will be thrown. In this case, the exception 
-    // will be handled and the method will return false.  Otherwise, the 
-    // method returns true.  
-    try { 
-        getLCCollection(name); 
-    } catch (EVENT::DataNotAvailableException e) {
-        return false; 
+    lc_collections_.clear(); 
+    if (lc_event_) { 
+        const std::vector<std::string>* names = lc_event_->getCollectionNames(); 
+        for (const std::string& name : *names) 
+            lc_collections_[name] = lc_event_->getCollection(name); 
     }
-    return true; 
+
+    // Resolve the registered IDs once for the event
+    LCCollectionRegistry& registry = lcCollectionRegistry(); 
+    std::lock_guard<std::mutex> lock(registry.mutex); 
+    lc_collections_by_id_.resize(registry.names.size()); 
+    for (size_t id = 0; id < registry.names.size(); ++id) { 
+        auto it = lc_collections_.find(registry.names[id]); 
+        lc_collections_by_id_[id] = it != lc_collections_.end() ? it->second : nullptr; 
+    }
+}
+
+EVENT::LCCollection* Event::tryGetLCCollection(const std::string& name) const { 
+    auto it = lc_collections_.find(name); 
+    return it != lc_collections_.end() ? it->second : nullptr; 
+}
+
+EVENT::LCCollection* Event::tryGetLCCollection(int id) const { 
+    if (id >= 0 && id < int(lc_collections_by_id_.size())) 
+        return lc_collections_by_id_[id]; 
+
+    // Registered after the event was set
+    LCCollectionRegistry& registry = lcCollectionRegistry(); 
+    std::string name; 
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex); 
+        if (id < 0 || id >= int(registry.names.size())) return nullptr; 
+        name = registry.names[id]; 
+    }
+    return tryGetLCCollection(name); 
+}
+
+int Event::getLCCollectionID(const std::string& name) { 
+    LCCollectionRegistry& registry = lcCollectionRegistry(); 
+    std::lock_guard<std::mutex> lock(registry.mutex); 
+    auto it = registry.ids.find(name); 
+    if (it != registry.ids.end()) return it->second; 
+    int id = registry.names.size(); 
+    registry.ids[name] = id; 
+    registry.names.push_back(name); 
+    return id; 
 }
@@ -0,0 +1,49 @@
+/**
+ * @file IndexRefs.cxx
+ * @brief Record of the collections referenced by index in an output tree.
+ */
+
+#include "IndexRefs.h"
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <stdexcept>
+
+//----------//
+//   ROOT   //
+//----------//
+#include <TList.h>
+#include <TNamed.h>
+
+namespace {
+
+    std::string recordName(const std::string& collection) { 
+        return "IndexRefs:" + collection; 
+    }
+}
+
+void IndexRefs::setTarget(TTree* tree, const std::string& collection, const std::string& target) {
+    TList* info = tree->GetUserInfo();
+    TObject* record = info->FindObject(recordName(collection).c_str());
+    if (record) {
+        info->Remove(record);
+        delete record;
+    }
+    info->Add(new TNamed(recordName(collection).c_str(), target.c_str()));
+}
+
+std::string IndexRefs::getTarget(TTree* tree, const std::string& collection) {
+    TObject* record = tree->GetUserInfo()->FindObject(recordName(collection).c_str());
+    return record ? record->GetTitle() : "";
+}
+
+std::string IndexRefs::findTarget(TTree* tree, const std::string& collection, 
+        const std::string& configured) {
+    std::string target = configured.empty() ? getTarget(tree, collection) : configured;
+    if (!target.empty() && !tree->FindBranch(target.c_str())) {
+        throw std::runtime_error("[ IndexRefs ]: " + collection + " references " + target 
+                + " by index but the tree has no such branch.");
+    }
+    return target;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file LCConversionCache.cxx
+ * @brief Event scoped cache of the LCIO objects converted to hpstr objects.
+ */
+
+#include "LCConversionCache.h"
+
+Track* LCConversionCache::getTrack(EVENT::Track* lc_track, const std::string& trackstate_location,
+        EVENT::LCCollection* gbl_kink_data, EVENT::LCCollection* track_data) const { 
+
+    auto it = tracks_.find(std::make_tuple(lc_track, trackstate_location, gbl_kink_data, track_data)); 
+    if (it == tracks_.end()) return nullptr; 
+    return it->second.get(); 
+}
+
+void LCConversionCache::addTrack(EVENT::Track* lc_track, const std::string& trackstate_location,
+        EVENT::LCCollection* gbl_kink_data, EVENT::LCCollection* track_data, 
+        Track* track) { 
+
+    tracks_[std::make_tuple(lc_track, trackstate_location, gbl_kink_data, track_data)].reset(track); 
+}
+
+CalCluster* LCConversionCache::getCluster(EVENT::Cluster* lc_cluster) const { 
+
+    auto it = clusters_.find(lc_cluster); 
+    if (it == clusters_.end()) return nullptr; 
+    return it->second.get(); 
+}
+
+void LCConversionCache::addCluster(EVENT::Cluster* lc_cluster, CalCluster* cluster) { 
+    clusters_[lc_cluster].reset(cluster); 
+}
+
+UTIL::LCRelationNavigator* LCConversionCache::getNavigator(EVENT::LCCollection* relations) { 
+
+    auto& nav = navigators_[relations]; 
+    if (!nav) nav.reset(new UTIL::LCRelationNavigator(relations)); 
+    return nav.get(); 
+}
+
+void LCConversionCache::clear() { 
+    tracks_.clear(); 
+    clusters_.clear(); 
+    navigators_.clear(); 
+}
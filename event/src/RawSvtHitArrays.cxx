@@ -0,0 +1,94 @@
+/**
+ * @file RawSvtHitArrays.cxx
+ * @brief Raw svt hit information stored as flat arrays
+ */
+
+#include "RawSvtHitArrays.h"
+
+#include <algorithm>
+
+void RawSvtHitArrays::clear() { 
+    system_.clear(); 
+    barrel_.clear(); 
+    layer_.clear(); 
+    module_.clear(); 
+    sensor_.clear(); 
+    side_.clear(); 
+    strip_.clear(); 
+    adcs_.clear(); 
+    fitN_.clear(); 
+    fit_.clear(); 
+}
+
+void RawSvtHitArrays::reserve(std::size_t nhits) { 
+    system_.reserve(nhits); 
+    barrel_.reserve(nhits); 
+    layer_.reserve(nhits); 
+    module_.reserve(nhits); 
+    sensor_.reserve(nhits); 
+    side_.reserve(nhits); 
+    strip_.reserve(nhits); 
+    adcs_.reserve(nhits*N_ADCS); 
+    fitN_.reserve(nhits); 
+    fit_.reserve(nhits*N_FITS*N_FIT_PARS); 
+}
+
+std::size_t RawSvtHitArrays::addHit(int system, int barrel, int layer, int module, 
+        int sensor, int side, int strip, const short* adcs) { 
+
+    system_.push_back(system); 
+    barrel_.push_back(barrel); 
+    layer_.push_back(layer); 
+    module_.push_back(module); 
+    sensor_.push_back(sensor); 
+    side_.push_back(side); 
+    strip_.push_back(strip); 
+    adcs_.insert(adcs_.end(), adcs, adcs + N_ADCS); 
+    fitN_.push_back(0); 
+    // Same defaults as RawSvtHit
+    fit_.insert(fit_.end(), N_FITS*N_FIT_PARS, -999.9); 
+    return strip_.size() - 1; 
+}
+
+void RawSvtHitArrays::setFit(std::size_t ihit, int fitI, const double fit[N_FIT_PARS]) { 
+    std::copy(fit, fit + N_FIT_PARS, fit_.begin() + (ihit*N_FITS + fitI)*N_FIT_PARS); 
+}
+
+void RawSvtHitArrays::branch(TTree* tree, const std::string& name) { 
+    tree->Branch((name + "_system").c_str(), &system_); 
+    tree->Branch((name + "_barrel").c_str(), &barrel_); 
+    tree->Branch((name + "_layer").c_str(), &layer_); 
+    tree->Branch((name + "_module").c_str(), &module_); 
+    tree->Branch((name + "_sensor").c_str(), &sensor_); 
+    tree->Branch((name + "_side").c_str(), &side_); 
+    tree->Branch((name + "_strip").c_str(), &strip_); 
+    tree->Branch((name + "_adcs").c_str(), &adcs_); 
+    tree->Branch((name + "_fitN").c_str(), &fitN_); 
+    tree->Branch((name + "_fit").c_str(), &fit_); 
+}
+
+std::vector<std::string> RawSvtHitArrays::branchNames(const std::string& name) { 
+    std::vector<std::string> names; 
+    for (const char* field : {"_system", "_barrel", "_layer", "_module", "_sensor", 
+            "_side", "_strip", "_adcs", "_fitN", "_fit"}) 
+        names.push_back(name + field); 
+    return names; 
+}
+
+void RawSvtHitArrays::setBranchAddresses(TTree* tree, const std::string& name) { 
+
+    // The tree needs the address of a pointer to each vector, which must 
+    // stay valid while the tree is read.
+    std::vector<int>* ints[8] = {&system_, &barrel_, &layer_, &module_, 
+        &sensor_, &side_, &strip_, &fitN_}; 
+    const char* fields[8] = {"_system", "_barrel", "_layer", "_module", 
+        "_sensor", "_side", "_strip", "_fitN"}; 
+    for (int i = 0; i < 8; ++i) { 
+        int_addresses_[i] = ints[i]; 
+        tree->SetBranchAddress((name + fields[i]).c_str(), &int_addresses_[i]); 
+    }
+    adcs_address_ = &adcs_; 
+    tree->SetBranchAddress((name + "_adcs").c_str(), &adcs_address_); 
+    fit_address_ = &fit_; 
+    tree->SetBranchAddress((name + "_fit").c_str(), &fit_address_); 
+}
@@ -5,6 +5,9 @@
  */
 
 #include "Track.h"
+#include "TrackerHit.h"
+
+#include <stdexcept>
 
 ClassImp(Track)
 
@@ -26,6 +29,7 @@ void Track::Clear(Option_t* /* option */) {
     //   tracker_hits_->Delete();
     memset(isolation_, 0, sizeof(isolation_)); 
     n_hits_ = 0; 
+    hit_indices_.clear();
 }
 
 void Track::setTrackParameters(double d0, double phi0, double omega,
@@ -88,6 +92,31 @@ void Track::addHit(TObject* hit) {
     tracker_hits_.Add(hit); 
 }
 
+void Track::addHitIndex(const int index) {
+    ++n_hits_; 
+    hit_indices_.push_back(index); 
+}
+
+int Track::getNSvtHits() const {
+    if (!hit_indices_.empty()) 
+        return hit_indices_.size();
+    return tracker_hits_.GetEntries(); 
+}
+
+TrackerHit* Track::getSvtHit(const int ihit, const std::vector<TrackerHit*>* hits) const {
+    if (!hit_indices_.empty()) {
+        if (!hits) 
+            throw std::runtime_error("[ Track ]: The hits are referenced by index, "
+                    "the TrackerHit collection is needed to resolve them.");
+        int index = hit_indices_.at(ihit);
+        if (index < 0 || static_cast<size_t>(index) >= hits->size()) 
+            throw std::runtime_error("[ Track ]: Hit index " + std::to_string(index) 
+                    + " is outside the TrackerHit collection.");
+        return hits->at(index);
+    }
+    return static_cast<TrackerHit*>(tracker_hits_.At(ihit)); 
+}
+
 void Track::applyCorrection(std::string var, double correction){
     if(var == "z0"){
         z0_ = z0_ - correction;
@@ -5,6 +5,9 @@
  */
 
 #include "TrackerHit.h"
+#include "RawSvtHit.h"
+
+#include <stdexcept>
 
 ClassImp(TrackerHit)
 
@@ -18,6 +21,27 @@ TrackerHit::~TrackerHit() {
 
 void TrackerHit::Clear(Option_t* /* options */) { 
     TObject::Clear(); 
+    raw_hit_indices_.clear();
+}
+
+int TrackerHit::getNRawHits() const {
+    if (!raw_hit_indices_.empty()) 
+        return raw_hit_indices_.size();
+    return raw_hits_.GetEntries();
+}
+
+RawSvtHit* TrackerHit::getRawHit(const int irawhit, const std::vector<RawSvtHit*>* rawhits) const {
+    if (!raw_hit_indices_.empty()) {
+        if (!rawhits) 
+            throw std::runtime_error("[ TrackerHit ]: The raw hits are referenced by index, "
+                    "the RawSvtHit collection is needed to resolve them.");
+        int index = raw_hit_indices_.at(irawhit);
+        if (index < 0 || static_cast<size_t>(index) >= rawhits->size()) 
+            throw std::runtime_error("[ TrackerHit ]: Raw hit index " + std::to_string(index) 
+                    + " is outside the RawSvtHit collection.");
+        return rawhits->at(index);
+    }
+    return static_cast<RawSvtHit*>(raw_hits_.At(irawhit));
 }
 
 void TrackerHit::setPosition(const double* position, bool rotate, int type) {
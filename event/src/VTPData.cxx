@@ -20,6 +20,163 @@ VTPData::~VTPData(){
     Clear();
 }
 
+void VTPData::decode(const int* data_words, int nwords, int subBanks)
+{ 
+    // First Clear out all the old data. The data may be the raw words, so keep them.
+    clearSubBanks();
+    for(int i=0; i<nwords/2; ++i)
+    {
+        int data = data_words[i];
+        int secondWord = data_words[i+1];
+        if(!(data & 1<<31)) continue;
+        int type = (data>>27)&0x0F;
+        int subtype;
+        switch (type)
+        {
+            case 0:  // Block Header
+                blockHeader.blocklevel = (data      )&0x00FF;
+                blockHeader.blocknum   = (data >>  8)&0x03FF;
+                blockHeader.nothing    = (data >> 18)&0x00FF;
+                blockHeader.slotid     = (data >> 22)&0x001F;
+                blockHeader.type       = (data >> 27)&0x000F;
+                blockHeader.istype     = (data >> 31)&0x0001;
+                //std::cout << i << " BlockHeader " << blockHeader.type << std::endl;
+                break;
+            case 1: //  Block Tail
+                blockTail.nwords       = (data      )&0x03FFFFF;
+                blockTail.slotid       = (data >> 22)&0x000001F;
+                blockTail.type         = (data >> 27)&0x000000F;
+                blockTail.istype       = (data >> 31)&0x0000001;
+                //std::cout << i << " BlockTail " << blockTail.type << std::endl;
+                break;
+            case 2:  // Event Header
+                eventHeader.eventnum   = (data      )&0x07FFFFFF;
+                eventHeader.type       = (data >> 27)&0x0000000F;
+                eventHeader.istype     = (data >> 31)&0x00000001;
+                //std::cout << i << " EventHeader " << eventHeader.eventnum << std::endl;
+                break;
+            case 3:  // Trigger time
+                trigTime = (data & 0x00FFFFFF) + ((secondWord & 0x00FFFFFF )<<24);
+                //std::cout << i << "&" << i+1 << " trigTime = " << trigTime << std::endl;
+                i++;
+                break;
+            case 12:  // Expansion type
+                subtype = (data>>23)&0x0F;
+                // Skip the sub-banks that aren't selected. Clusters take two words
+                if (subtype >= 2 && subtype <= 7 && !((subBanks >> subtype) & 1)) {
+                    if (subtype == 2) i++;
+                    break;
+                }
+                switch(subtype){
+                    case 2: // HPS Cluster
+                        VTPData::hpsCluster  clus;
+                        clus.X        = (data      )&0x0003F;
+                        // If the first bit of the index is 1, then it is a negative number
+                        if((clus.X >> 5 & 0x1) == 0x1) clus.X = -((clus.X ^ 0x3F) + 1);
+                        clus.Y        = (data >>  6)&0x0000F;
+                       // If the first bit of the index is 1, then it is a negative number
+                        if((clus.Y  >> 3 & 0x1) == 0x1) clus.Y  = -((clus.Y ^ 0xF) + 1);
+                        clus.E        = (data >> 10)&0x01FFF;
+                        clus.subtype  = (data >> 23)&0x0000F;
+                        clus.type     = (data >> 27)&0x0000F;
+                        clus.istype   = (data >> 31)&0x00001;
+                        clus.T        = (secondWord      )&0x003FF;
+                        clus.N        = (secondWord >> 10)&0x0000F;
+                        clus.nothing  = (secondWord >> 14)&0x3FFFF;
+                        clusters.push_back(clus);
+                        //std::cout << i << "&" << i+1 << " HPS Cluster " << clus.E << std::endl;
+                        i++;
+                        break;
+                    case 3: // HPS Single Trigger
+                        VTPData::hpsSingleTrig strig;
+                        strig.T        = (data      )&0x003FF;
+                        strig.emin     = (data >> 10)&0x00001;
+                        strig.emax     = (data >> 11)&0x00001;
+                        strig.nmin     = (data >> 12)&0x00001;
+                        strig.xmin     = (data >> 13)&0x00001;
+                        strig.pose     = (data >> 14)&0x00001;
+                        strig.hodo1c   = (data >> 15)&0x00001;
+                        strig.hodo2c   = (data >> 16)&0x00001;
+                        strig.hodogeo  = (data >> 17)&0x00001;
+                        strig.hodoecal = (data >> 18)&0x00001;
+                        strig.topnbot  = (data >> 19)&0x00001;
+                        strig.inst     = (data >> 20)&0x00007;
+                        strig.subtype  = (data >> 23)&0x0000F;
+                        strig.type     = (data >> 27)&0x0000F;
+                        strig.istype   = (data >> 31)&0x00001;
+                        //std::cout << i << " HPS Single Trigger " << strig.subtype << std::endl;
+                        singletrigs.push_back(strig);
+                        break;
+                    case 4: // HPS Pair Trigger
+                        VTPData::hpsPairTrig ptrig;
+                        ptrig.T          = (data      )&0x003FF;
+                        ptrig.clusesum   = (data >> 10)&0x00001;
+                        ptrig.clusedif   = (data >> 11)&0x00001;
+                        ptrig.eslope     = (data >> 12)&0x00001;
+                        ptrig.coplane    = (data >> 13)&0x00001;
+                        ptrig.dummy      = (data >> 14)&0x0001F;
+                        ptrig.topnbot    = (data >> 19)&0x00001;
+                        ptrig.inst       = (data >> 20)&0x00007;
+                        ptrig.subtype    = (data >> 23)&0x0000F;
+                        ptrig.type       = (data >> 27)&0x0000F;
+                        ptrig.istype     = (data >> 31)&0x00001;
+                        //std::cout << i << " HPS Pair Trigger " << ptrig.subtype << std::endl;
+                        pairtrigs.push_back(ptrig);
+                        break;
+                    case 5: // HPS Calibration Trigger
+                        VTPData::hpsCalibTrig ctrig;
+                        ctrig.T          = (data      )&0x003FF;
+                        ctrig.reserved   = (data >> 10)&0x001FF;
+                        ctrig.cosmicTrig = (data >> 19)&0x00001;
+                        ctrig.LEDTrig    = (data >> 20)&0x00001;
+                        ctrig.hodoTrig   = (data >> 21)&0x00001;
+                        ctrig.pulserTrig = (data >> 22)&0x00001;
+                        ctrig.subtype    = (data >> 23)&0x0000F;
+                        ctrig.type       = (data >> 27)&0x0000F;
+                        ctrig.istype     = (data >> 31)&0x00001;
+                        //std::cout << i << " HPS Cal Trigger " << ctrig.subtype << std::endl;
+                        calibtrigs.push_back(ctrig);
+                        break;
+                    case 6: // HPS Cluster Multiplicity Trigger
+                        VTPData::hpsClusterMult clmul;
+                        clmul.T          = (data      )&0x003FF;
+                        clmul.multtop    = (data >> 10)&0x0000F;
+                        clmul.multbot    = (data >> 14)&0x0000F;
+                        clmul.multtot    = (data >> 18)&0x0000F;
+                        clmul.bitinst    = (data >> 22)&0x00001;
+                        clmul.subtype    = (data >> 23)&0x0000F;
+                        clmul.type       = (data >> 27)&0x0000F;
+                        clmul.istype     = (data >> 31)&0x00001;
+                        //std::cout << i << " HPS Clus Mult Trigger " << clmul.subtype << std::endl;
+                        clustermult.push_back(clmul);
+                        break;
+                    case 7: // HPS FEE Trigger
+                        VTPData::hpsFEETrig fee;
+                        fee.T          = (data      )&0x003FF;
+                        fee.region     = (data >> 10)&0x0007F;
+                        fee.reserved   = (data >> 17)&0x0003F;
+                        fee.subtype    = (data >> 23)&0x0000F;
+                        fee.type       = (data >> 27)&0x0000F;
+                        fee.istype     = (data >> 31)&0x00001;
+                        //std::cout << i << " HPS FEE Trigger " << fee.subtype << std::endl;
+                        feetrigger.push_back(fee);
+                        break;
+                    default:
+                        std::cout << "At " << i << " invalid HPS type: " << type << " subtype: " << subtype << std::endl;
+                        break;
+                }
+
+                break;
+            case 14:
+                std::cout << i << "VTP data type not valid: " << type << std::endl;
+                break;
+            default:
+                std::cout << i << "I was not expecting a VTP data type of " << type << std::endl;
+                break;
+        }
+    }
+} //VTPData::decode(const int* data_words, int nwords, int subBanks)
+
 void VTPData::print(){
     using namespace std;
     cout << "blockHeader.blocklevel: " << blockHeader.blocklevel << endl;
@@ -6,7 +6,9 @@
  */
 
 #include "Vertex.h"
+#include "Particle.h"
 #include <iostream>
+#include <stdexcept>
 
 ClassImp(Vertex)
 
@@ -23,6 +25,7 @@ void Vertex::Clear(Option_t *option) {
     p1_.Clear();
     p2_.Clear();
     //parts_->Delete();
+    part_indices_.clear();
     TObject::Clear();
 }
 
@@ -32,6 +35,32 @@ void Vertex::addParticle(TObject* part)
     parts_.Add(part);
 }
 
+void Vertex::addParticleIndex(const int index)
+{ 
+    n_parts_++;
+    part_indices_.push_back(index);
+}
+
+int Vertex::getNParticles() const {
+    if (!part_indices_.empty())
+        return part_indices_.size();
+    return parts_.GetEntries();
+}
+
+Particle* Vertex::getParticle(const int ipart, const std::vector<Particle*>* parts) const {
+    if (!part_indices_.empty()) {
+        if (!parts) 
+            throw std::runtime_error("[ Vertex ]: The particles are referenced by index, "
+                    "the Particle collection is needed to resolve them.");
+        int index = part_indices_.at(ipart);
+        if (index < 0 || static_cast<size_t>(index) >= parts->size()) 
+            throw std::runtime_error("[ Vertex ]: Particle index " + std::to_string(index) 
+                    + " is outside the Particle collection.");
+        return parts->at(index);
+    }
+    return static_cast<Particle*>(parts_.At(ipart));
+}
+
 void Vertex::setCovariance( const std::vector<float>& vec){ 
     covariance_ = vec;
 }
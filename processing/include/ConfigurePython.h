@@ -18,6 +18,7 @@
 //----------------//
 #include <exception>
 #include <iostream>
+#include <map>
 #include <stdexcept>
 #include <vector>
 
@@ -36,6 +37,14 @@ class ConfigurePython {
          * @brief Class constructor.
          *
          * This method contains all the parsing and execution of the python script.
+         * If the HPSTR_CONFIG_CACHE environment variable points to a directory, the 
+         * resulting configuration is stored there in binary form, keyed by a hash of 
+         * the script and its arguments, and later jobs with the same script and 
+         * arguments load it without starting the python interpreter. The cache also 
+         * records the content of every python source imported by the script, e.g. 
+         * HpstrConf or shared configuration fragments, and is ignored once any of 
+         * them changes. Environment variables read by the script are not tracked, 
+         * so the cache directory should be cleared after changing them.
          *
          * @param pythonScript Filename location of the python script.
          * @param args Commandline arguments to be passed to the python script.
@@ -51,8 +60,56 @@ class ConfigurePython {
         /** Create a process object based on the python file information. */
         Process* makeProcess();
 
+        /** @return True if the configuration was loaded from the cache. */
+        bool fromCache() const { return from_cache_; }
+
     private: 
 
+        /**
+         * @brief Execute the python script and extract the configuration.
+         *
+         * @param pythonScript Filename location of the python script.
+         * @param args Commandline arguments to be passed to the python script.
+         * @param nargs Number of commandline arguments.
+         */
+        void runScript(const std::string& pythonScript, char* args[], int nargs);
+
+        /**
+         * @brief Load the configuration from a cache file.
+         *
+         * @param cacheFile Name of the cache file.
+         * @return True if the cache file exists, matches the current format and 
+         *         none of the python sources it was made from changed. A damaged 
+         *         cache is reported and ignored.
+         */
+        bool readCache(const std::string& cacheFile);
+
+        /**
+         * @brief Load the configuration from a cache stream.
+         *
+         * @param in Stream positioned at the start of the cache.
+         * @return False if the cache has another format or is stale.
+         * @throw std::runtime_error if the cache is truncated or corrupted.
+         */
+        bool readCache(std::istream& in);
+
+        /**
+         * @brief Store the configuration in a cache file.
+         *
+         * @param cacheFile Name of the cache file.
+         * @return True if the cache file was written.
+         */
+        bool writeCache(const std::string& cacheFile) const;
+
+        /** True if the python interpreter was started. */
+        bool py_initialized_{false};
+
+        /** True if the python script was executed successfully. */
+        bool configured_{false};
+
+        /** True if the configuration was loaded from the cache. */
+        bool from_cache_{false};
+
         /** 
          * The run mode of the process:
          *  0: LCIO to ROOT
@@ -67,6 +124,42 @@ class ConfigurePython {
         /** The maximum number of events to process, if provided in python file. */
         int event_limit_{-1};
 
+        /** Output compression algorithm name (zlib, lzma, lz4, zstd). Empty keeps the ROOT default. */
+        std::string compression_algorithm_{""};
+
+        /** Output compression level. Negative keeps the ROOT default. */
+        int compression_level_{-1};
+
+        /** Default basket size of collections added through Event. Negative keeps the default. */
+        int basket_size_{-1};
+
+        /** Default split level of collections added through Event. Negative keeps the default. */
+        int split_level_{-1};
+
+        /** Per-branch basket size overrides. */
+        std::map<std::string, int> branch_basket_sizes_;
+
+        /** Per-branch split level overrides. */
+        std::map<std::string, int> branch_split_levels_;
+
+        /** TTree AutoFlush setting. 0 keeps the ROOT default. */
+        long auto_flush_{0};
+
+        /** Number of implicit-MT threads. 0 disables implicit MT. */
+        int imt_threads_{0};
+
+        /** Print per-branch bytes written when closing the output file. */
+        int io_report_{0};
+
+        /** Events after which unused collection capacity is released. 0 disables it. */
+        int shrink_after_{0};
+
+        /** Number of workers processing input files concurrently. */
+        int n_workers_{1};
+
+        /** Name of the file the outputs are merged into. Empty disables merging. */
+        std::string merge_output_{""};
+
         /** List of input files to process in the job, if provided in python file. */
         std::vector<std::string> input_files_;
             
@@ -74,6 +74,30 @@ class EventFile : public IEventFile {
          */
         void resetOutputFileDir();
 
+        /**
+         * @brief Set the compression of the output file. This needs to be 
+         *        called before the event tree is created.
+         *
+         * @param algorithm Compression algorithm: zlib, lzma, lz4 or zstd. 
+         *                  An empty string keeps the ROOT default.
+         * @param level Compression level. Negative keeps the ROOT default.
+         */
+        void setCompression(const std::string& algorithm, int level);
+
+        /**
+         * @brief Print the bytes written per branch, and the memory held by 
+         *        the event collections, when the file is closed.
+         *
+         * @param io_report True to enable the report.
+         */
+        void setIOReport(bool io_report) { io_report_ = io_report; }
+
+        /** 
+         * Print the total and compressed bytes written for each branch of 
+         * the event tree.
+         */
+        void printIOReport();
+
     private:
         /** The ROOT file to which event data will be written to. */
         TFile* ofile_{nullptr}; 
@@ -95,6 +119,9 @@ class EventFile : public IEventFile {
         /** Number used to reset object count in TProcessID */
         int objNumRoot_{0};
 
+        /** Print per-branch bytes written on close */
+        bool io_report_{false};
+
 }; // EventFile
 
 #endif // __EVENT_FILE_H__
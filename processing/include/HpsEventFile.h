@@ -53,6 +53,13 @@ class HpsEventFile : public IEventFile {
          */
         TFile* getOutputFile() { return ofile_;}
 
+        /**
+         * @brief Get the input file.
+         * 
+         * @return TFile* 
+         */
+        TFile* getInputFile() { return rootfile_;}
+
         /**
          * @brief description
          * 
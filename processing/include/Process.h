@@ -11,8 +11,14 @@
 //----------------//
 //   C++ StdLib   //
 //----------------//
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
 #include <vector>
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
 
 //----------//
@@ -25,6 +31,11 @@
 //   hpstr   //
 //-----------//
 #include "Processor.h"
+#include "ParameterSet.h"
+#include "json.hpp"
+
+// for convenience
+using json = nlohmann::json;
 
 class Process {
 
@@ -41,6 +52,18 @@ class Process {
          */
         void addToSequence(Processor* event_proc);
 
+        /**
+         * @brief Create and configure an event processor and add it to the 
+         *        sequence. The configuration is kept so that isolated copies of 
+         *        the sequence can be created for parallel workers.
+         * 
+         * @param classname Class name of the processor
+         * @param instancename Instance name of the processor
+         * @param params Parameters used to configure the processor
+         */
+        void addToSequence(const std::string& classname, const std::string& instancename, 
+                           const ParameterSet& params);
+
         /**
          * @brief Add an input file name to the list.
          * 
@@ -95,6 +118,121 @@ class Process {
             event_limit_ = event_limit;
         }
 
+        /**
+         * @brief Set the number of workers used to process independent 
+         *        input/output file pairs concurrently (run modes 1 and 2).
+         * 
+         * @param n_workers Number of workers. 1 processes files serially.
+         */
+        void setNWorkers(int n_workers = 1) {
+            n_workers_ = n_workers;
+        }
+
+        /**
+         * @brief Set the name of the file the output files are merged into
+         *        once all files are processed (run modes 1 and 2).
+         * 
+         * @param merge_output Merged file name. Empty disables merging.
+         */
+        void setMergeOutput(const std::string& merge_output) {
+            merge_output_ = merge_output;
+        }
+
+        /**
+         * @brief Set the compression of the output file.
+         * 
+         * @param algorithm Compression algorithm: zlib, lzma, lz4 or zstd.
+         *                  An empty string keeps the ROOT default.
+         * @param level Compression level. Negative keeps the ROOT default.
+         */
+        void setCompression(const std::string& algorithm, int level = -1) {
+            compression_algorithm_ = algorithm;
+            compression_level_ = level;
+        }
+
+        /**
+         * @brief Set the basket size used for the output branches.
+         * 
+         * @param basket_size Basket size in bytes. Negative keeps the default.
+         */
+        void setBasketSize(int basket_size = -1) {
+            basket_size_ = basket_size;
+        }
+
+        /**
+         * @brief Set the split level of the output branches.
+         * 
+         * @param split_level Split level. Negative keeps the default.
+         */
+        void setSplitLevel(int split_level = -1) {
+            split_level_ = split_level;
+        }
+
+        /**
+         * @brief Set per-branch basket sizes. Branch names may contain wildcards.
+         * 
+         * @param basket_sizes Map of branch name to basket size.
+         */
+        void setBranchBasketSizes(const std::map<std::string, int>& basket_sizes) {
+            branch_basket_sizes_ = basket_sizes;
+        }
+
+        /**
+         * @brief Set per-branch split levels. Branch names may contain wildcards.
+         * 
+         * @param split_levels Map of branch name to split level.
+         */
+        void setBranchSplitLevels(const std::map<std::string, int>& split_levels) {
+            branch_split_levels_ = split_levels;
+        }
+
+        /**
+         * @brief Set the AutoFlush of the output tree.
+         * 
+         * @param auto_flush TTree::SetAutoFlush argument. 0 keeps the ROOT default.
+         */
+        void setAutoFlush(long auto_flush = 0) {
+            auto_flush_ = auto_flush;
+        }
+
+        /**
+         * @brief Set the number of implicit-MT threads used to compress baskets.
+         * 
+         * @param n_threads Number of threads. 0 disables implicit MT.
+         */
+        void setImplicitMTThreads(int n_threads = 0) {
+            imt_threads_ = n_threads;
+        }
+
+        /**
+         * @brief Enable the per-branch report of bytes written.
+         * 
+         * @param io_report True to print the report when the output is closed.
+         */
+        void setIOReport(bool io_report) {
+            io_report_ = io_report;
+        }
+
+        /**
+         * @brief Set the number of events after which the unused capacity 
+         *        of the event collections is released.
+         * 
+         * @param n_events Number of events. 0 disables it.
+         */
+        void setShrinkAfter(int n_events = 0) {
+            shrink_after_ = n_events;
+        }
+
+        /**
+         * @brief Enable the report of the time elapsed until the first event.
+         * 
+         * @param start Start time of the job.
+         */
+        void setStartTime(const std::chrono::steady_clock::time_point& start) {
+            start_time_ = start;
+            report_first_event_ = true;
+        }
+
         /**
          * @brief Get the run mode of the process.
          * 
@@ -123,8 +261,123 @@ class Process {
         /** Request that the processing finish with this event. */ 
         void requestFinish() { event_limit_ = 0; }
 
+        /**
+         * @brief Run the ROOT to Histo or Histo Analysis sequence once per request.
+         * 
+         * Each request is a JSON object on a single line, e.g.
+         * {"input": "in.root", "output": "out.root", "params": {"instance": {"name": value}}}
+         * Missing input and output file names default to the first ones of the 
+         * configuration. The parameters override the ones of the configuration 
+         * for that request only. A status line is printed after each request, and 
+         * {"quit": true} or the end of the stream stops the server. Input files 
+         * opened through openInputFile stay open between requests.
+         * 
+         * @param requests Stream the requests are read from.
+         */
+        void runServer(std::istream& requests);
+
+        /** @return True if the process is serving requests. */
+        bool isServerMode() const { return server_mode_; }
+
+        /**
+         * @brief Open an input file for reading. In server mode the file is kept
+         *        open and the same file is returned to later requests.
+         * 
+         * @param filename Name of the input file
+         * @return TFile* The input file, owned by the Process in server mode.
+         */
+        TFile* openInputFile(const std::string& filename);
+
+        /**
+         * @brief Close an input file opened with openInputFile. Files kept 
+         *        open in server mode are closed when the server stops.
+         * 
+         * @param file The input file
+         */
+        void closeInputFile(TFile* file);
+
     private:
 
+        /**
+         * @brief Run the ROOT to Histo sequence on one input file.
+         * 
+         * @param ifile Name of the input file.
+         * @param ofile Name of the output file.
+         * @param sequence Processor sequence to run.
+         */
+        void processRootFile(const std::string& ifile, const std::string& ofile, 
+                             std::vector<Processor*>& sequence);
+
+        /**
+         * @brief Run the Histo Analysis sequence on one input file.
+         * 
+         * @param ifile Name of the input file.
+         * @param ofile Name of the output file.
+         * @param sequence Processor sequence to run.
+         */
+        void processHistoFile(const std::string& ifile, const std::string& ofile, 
+                              std::vector<Processor*>& sequence);
+
+        /**
+         * @brief Lock the ROOT process IDs of the objects stored in an input file.
+         * 
+         * TRef and TRefArray are resolved through the object table of the 
+         * TProcessID of the job that wrote the file, which is global and not 
+         * locked by ROOT. Files written by the same job share it, so the workers 
+         * process them one at a time, while files written by different jobs are 
+         * processed concurrently. Locks are taken in a fixed order, so workers 
+         * can't deadlock.
+         * 
+         * @param file The input file
+         * @return The locks, held until they go out of scope
+         */
+        std::vector<std::unique_lock<std::mutex>> lockProcessIDs(TFile* file);
+
+        /** @return True if the input files should be distributed among workers. */
+        bool useWorkers() const;
+
+        /** @return A new, configured copy of the processor sequence. */
+        std::vector<Processor*> makeSequence();
+
+        /**
+         * @brief Distribute the input files among the workers, each one 
+         *        running its own copy of the processor sequence. A file 
+         *        that fails doesn't stop the others.
+         * 
+         * @param processFile Function processing a single file.
+         * @throw std::runtime_error if any of the files failed.
+         */
+        void runOnWorkers(const std::function<void(size_t, std::vector<Processor*>&)>& processFile);
+
+        /** Merge the output files into the merge output file, if requested. */
+        void mergeOutputFiles();
+
+        /** Print the time elapsed since the start of the job, once. */
+        void reportFirstEvent();
+
+        /**
+         * @brief Set a parameter from its JSON value. Integers are stored as 
+         *        doubles if the parameter is already defined as a double.
+         * 
+         * @param params The parameters to modify
+         * @param name Name of the parameter
+         * @param value JSON value of the parameter
+         */
+        static void insertParameter(ParameterSet& params, const std::string& name, const json& value);
+
+        /** Close the input files kept open in server mode. */
+        void closeResidentFiles();
+
+        /**
+         * @struct ProcessorConfig
+         * @brief Configuration used to create a Processor of the sequence.
+         */
+        struct ProcessorConfig {
+            std::string classname_;
+            std::string instancename_;
+            ParameterSet params_;
+        };
+
         /* Reader used to parse either binary or EVIO files. */
         //DataRead* data_reader{nullptr}; 
 
@@ -134,12 +387,75 @@ class Process {
         /** Number of events to skip. */
         int skip_events_{-1};
 
-        /** Limit on events to process. */
-        int event_limit_{-1};
+        /** Limit on events to process. Lowered by requestFinish from any worker. */
+        std::atomic<int> event_limit_{-1};
+
+        /** Number of events processed, shared among the workers. */
+        std::atomic<int> n_events_processed_{0};
+
+        /** Number of workers processing files concurrently. */
+        int n_workers_{1};
+
+        /** Locks of the ROOT process IDs of the input files, by UUID. */
+        std::map<std::string, std::unique_ptr<std::mutex>> process_id_mutexes_;
+
+        /** Guards process_id_mutexes_. */
+        std::mutex process_id_mutexes_mutex_;
+
+        /** Name of the file the outputs are merged into. */
+        std::string merge_output_{""};
+
+        /** Compression algorithm of the output file. */
+        std::string compression_algorithm_{""};
+
+        /** Compression level of the output file. */
+        int compression_level_{-1};
+
+        /** Basket size of the output branches. */
+        int basket_size_{-1};
+
+        /** Split level of the output branches. */
+        int split_level_{-1};
+
+        /** Per-branch basket sizes. */
+        std::map<std::string, int> branch_basket_sizes_;
+
+        /** Per-branch split levels. */
+        std::map<std::string, int> branch_split_levels_;
+
+        /** AutoFlush setting of the output tree. */
+        long auto_flush_{0};
+
+        /** Number of implicit-MT threads. */
+        int imt_threads_{0};
+
+        /** Print per-branch bytes written. */
+        bool io_report_{false};
+
+        /** Events after which unused collection capacity is released. */
+        int shrink_after_{0};
+
+        /** Start time of the job. */
+        std::chrono::steady_clock::time_point start_time_;
+
+        /** Report the time elapsed until the first event. */
+        std::atomic<bool> report_first_event_{false};
+
+        /** True while serving requests. */
+        bool server_mode_{false};
+
+        /** Input files kept open in server mode. */
+        std::map<std::string, TFile*> resident_files_;
+
+        /** Protects the resident input files. */
+        std::mutex resident_files_mutex_;
 
         /** Ordered list of Processors to execute. */
         std::vector<Processor*> sequence_;
 
+        /** Configuration of the Processors in the sequence. */
+        std::vector<ProcessorConfig> sequence_configs_;
+
         /** List of input files to process. May be empty if this Process will generate new events. */
         std::vector<std::string> input_files_;
 
@@ -11,16 +11,23 @@
 //   C++ StdLib   //
 //----------------//
 #include <map>
+#include <string>
+#include <vector>
+
+//----------//
+//   ROOT   //
+//----------//
+#include "TTree.h"
 
 //-----------//
 //   hpstr   //
 //-----------//
+#include "Event.h"
 #include "ParameterSet.h"
 
 // Forward declarations
 class Process;
 class Processor;
-class TTree;
 class TFile;
 class IEvent;
 
@@ -87,6 +94,13 @@ class Processor {
          */
         virtual void setFile(TFile* outFile) {outF_ = outFile;};
 
+        /**
+         * @brief Set the Event whose tree is passed to initialize(TTree*)
+         * 
+         * @param event The event, nullptr if the tree isn't the one of an Event
+         */
+        void setEvent(Event* event) {event_ = event;};
+
         /**
          * @brief Process the histograms and generate analysis output.
          * 
@@ -118,12 +132,49 @@ class Processor {
         static void declare(const std::string& classname, ProcessorMaker*);
 
     protected:
+        /**
+         * @brief Add a branch for a collection owned by the processor. On the 
+         *        tree of the Event, the branch follows the basket size and split 
+         *        level settings of the job.
+         * 
+         * @param tree The tree passed to initialize(TTree*)
+         * @param name Name of the branch
+         * @param collection The collection
+         */
+        template <typename T>
+            void addCollection(TTree* tree, const std::string& name, std::vector<T>* collection) {
+                if (event_ && event_->getTree() == tree)
+                    event_->addCollection(name, collection);
+                else
+                    tree->Branch(name.c_str(), collection);
+            }
+
+        /**
+         * @brief Add a branch for an object owned by the processor. On the 
+         *        tree of the Event, the branch follows the basket size and split 
+         *        level settings of the job.
+         * 
+         * @param tree The tree passed to initialize(TTree*)
+         * @param name Name of the branch
+         * @param object Address of the pointer to the object
+         */
+        template <typename T>
+            void addObject(TTree* tree, const std::string& name, T** object) {
+                if (event_ && event_->getTree() == tree)
+                    event_->addObject(name, object);
+                else
+                    tree->Branch(name.c_str(), object);
+            }
+
         /** Handle to the Process. */
         Process& process_;
 
         /** output file pointer */
         TFile* outF_{nullptr};
 
+        /** Event whose tree the branches are added to, if any */
+        Event* event_{nullptr};
+
         /** The name of the Processor. */
         std::string name_;
 
@@ -27,6 +27,31 @@ class Process:
         self.output_files = []
         self.sequence = []
         self.libraries = []
+
+        # Number of input/output file pairs processed concurrently (run modes 1 and 2)
+        self.n_workers = 1
+        # If set, the output files are merged into this file at the end of the job
+        self.merge_output = ""
+
+        # Output tuning for LCIO -> ROOT jobs. Unset values keep the ROOT defaults.
+        # compression_algorithm: one of "zlib", "lzma", "lz4", "zstd"
+        self.compression_algorithm = ""
+        self.compression_level = -1
+        # Basket size and split level of the output branches
+        self.basket_size = -1
+        self.split_level = -1
+        # Per-branch overrides {branch name (wildcards allowed): value}
+        self.branch_basket_sizes = {}
+        self.branch_split_levels = {}
+        # TTree::SetAutoFlush argument, 0 keeps the ROOT default
+        self.auto_flush = 0
+        # Number of implicit-MT threads used for basket compression, 0 disables it
+        self.imt_threads = 0
+        # Print the bytes written per branch when the output file is closed
+        self.io_report = 0
+        # Release the collection capacity left unused for this many events, 0 disables it
+        self.shrink_after = 0
+
         Process.lastProcess = self
 
     def add_library(self, lib):
@@ -64,6 +89,18 @@ class Process:
                     print("Output file:", self.output_files[0])
         elif len(self.output_files) > 0:
             print("Output file:", self.output_files[0])
+        if self.n_workers > 1:
+            print("Workers: %d" % (self.n_workers))
+        if self.merge_output:
+            print("Merged output file: %s" % (self.merge_output))
+        if self.compression_algorithm or self.compression_level >= 0:
+            print("Output compression: %s level %d" % (self.compression_algorithm or "default", self.compression_level))
+        if self.auto_flush != 0:
+            print("Output AutoFlush: %d" % (self.auto_flush))
+        if self.imt_threads > 0:
+            print("Implicit MT threads: %d" % (self.imt_threads))
+        if self.shrink_after > 0:
+            print("Shrink collections after: %d events" % (self.shrink_after))
         if len(self.libraries) > 0:
             print("Shared libraries to load:")
             for afile in self.libraries:
@@ -7,6 +7,15 @@
 
 #include "ConfigurePython.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
 static std::string stringMember(PyObject* owner, const std::string& name) {
 
     std::string retval;
@@ -37,8 +46,239 @@ static long intMember(PyObject* owner, const std::string& name) {
 }
 
 
+static long intMember(PyObject* owner, const std::string& name, long defaultValue) {
+
+    if (!PyObject_HasAttrString(owner, name.c_str())) return defaultValue;
+    return intMember(owner, name);
+}
+
+
+static std::string stringMember(PyObject* owner, const std::string& name, const std::string& defaultValue) {
+
+    if (!PyObject_HasAttrString(owner, name.c_str())) return defaultValue;
+    return stringMember(owner, name);
+}
+
+
+static std::map<std::string, int> intDictMember(PyObject* owner, const std::string& name) {
+
+    std::map<std::string, int> retval;
+    if (!PyObject_HasAttrString(owner, name.c_str())) return retval;
+
+    PyObject* temp = PyObject_GetAttrString(owner, name.c_str());
+    if (temp != 0 && PyDict_Check(temp)) {
+        PyObject *key(0), *value(0);
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(temp, &pos, &key, &value)) {
+#if PY_MAJOR_VERSION >= 3
+            PyObject* pyStr = PyUnicode_AsEncodedString(key, "utf-8","Error ~");
+            retval[PyBytes_AS_STRING(pyStr)] = int(PyLong_AsLong(value));
+            Py_XDECREF(pyStr);
+#else
+            retval[PyString_AsString(key)] = int(PyInt_AsLong(value));
+#endif
+        }
+    }
+    Py_XDECREF(temp);
+    return retval;
+}
+
+
+static void hashUpdate(uint64_t& hash, const std::string& str) {
+
+    // FNV-1a, with a separator so that consecutive strings can't alias
+    for (unsigned char c : str) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    hash ^= 0xff;
+    hash *= 1099511628211ULL;
+}
+
+
+static std::string hashHex(uint64_t hash) {
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    return hex;
+}
+
+
+static std::string hashFile(const std::string& file_name) {
+
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file.is_open()) return "";
+    std::stringstream content;
+    content << file.rdbuf();
+
+    uint64_t hash = 14695981039346656037ULL;
+    hashUpdate(hash, content.str());
+    return hashHex(hash);
+}
+
+
+static std::string hashConfiguration(const std::string& python_script, char* args[], int nargs) {
+
+    std::string content_hash = hashFile(python_script);
+    if (content_hash.empty()) return "";
+
+    // Hash of the script, its content and the arguments passed to it
+    uint64_t hash = 14695981039346656037ULL;
+    hashUpdate(hash, python_script);
+    hashUpdate(hash, content_hash);
+    for (int i = 0; i < nargs; i++) hashUpdate(hash, args[i]);
+    return hashHex(hash);
+}
+
+
+static std::vector<std::string> importedSources() {
+
+    std::vector<std::string> sources;
+    PyObject* modules = PyImport_GetModuleDict();
+    PyObject *key(0), *module(0);
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(modules, &pos, &key, &module)) {
+        // Built-in modules have no file
+        PyObject* file = PyObject_GetAttrString(module, "__file__");
+        if (file == 0) {
+            PyErr_Clear();
+            continue;
+        }
+        std::string name;
+#if PY_MAJOR_VERSION >= 3
+        if (PyUnicode_Check(file)) {
+            PyObject* pyStr = PyUnicode_AsEncodedString(file, "utf-8","Error ~");
+            if (pyStr != 0) name = PyBytes_AS_STRING(pyStr);
+            Py_XDECREF(pyStr);
+        }
+#else
+        if (PyString_Check(file)) name = PyString_AsString(file);
+#endif
+        Py_DECREF(file);
+
+        // Python 2 reports the bytecode of modules that were compiled before
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".pyc") == 0) name.pop_back();
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, ".py") == 0) sources.push_back(name);
+    }
+    return sources;
+}
+
+
+/** Largest element count accepted from a cache file. */
+static const long MAX_CACHE_ENTRIES = 1L << 24;
+
+
+static void writeInt(std::ostream& out, long value) {
+    int64_t val = value;
+    out.write(reinterpret_cast<const char*>(&val), sizeof(val));
+}
+
+
+static long readInt(std::istream& in) {
+    int64_t val = 0;
+    in.read(reinterpret_cast<char*>(&val), sizeof(val));
+    if (!in) throw std::runtime_error("[ ConfigurePython ]: Truncated configuration cache");
+    return val;
+}
+
+
+static long readSize(std::istream& in) {
+    long size = readInt(in);
+    if (size < 0 || size > MAX_CACHE_ENTRIES) 
+        throw std::runtime_error("[ ConfigurePython ]: Corrupted configuration cache");
+    return size;
+}
+
+
+static double readDouble(std::istream& in) {
+    double val = 0;
+    in.read(reinterpret_cast<char*>(&val), sizeof(val));
+    if (!in) throw std::runtime_error("[ ConfigurePython ]: Truncated configuration cache");
+    return val;
+}
+
+
+static void writeString(std::ostream& out, const std::string& str) {
+    writeInt(out, str.size());
+    out.write(str.data(), str.size());
+}
+
+
+static std::string readString(std::istream& in) {
+    std::string str(readSize(in), '\0');
+    in.read(&str[0], str.size());
+    if (!in) throw std::runtime_error("[ ConfigurePython ]: Truncated configuration cache");
+    return str;
+}
+
+
+static void writeStrings(std::ostream& out, const std::vector<std::string>& strs) {
+    writeInt(out, strs.size());
+    for (auto& str : strs) writeString(out, str);
+}
+
+
+static std::vector<std::string> readStrings(std::istream& in) {
+    std::vector<std::string> strs(readSize(in));
+    for (auto& str : strs) str = readString(in);
+    return strs;
+}
+
+
+static void writeIntMap(std::ostream& out, const std::map<std::string, int>& vals) {
+    writeInt(out, vals.size());
+    for (auto& val : vals) {
+        writeString(out, val.first);
+        writeInt(out, val.second);
+    }
+}
+
+
+static std::map<std::string, int> readIntMap(std::istream& in) {
+    std::map<std::string, int> vals;
+    long size = readSize(in);
+    for (long i = 0; i < size; i++) {
+        std::string key = readString(in);
+        vals[key] = readInt(in);
+    }
+    return vals;
+}
+
+
+static const char CACHE_MAGIC[8] = {'H', 'P', 'S', 'T', 'R', 'C', 'F', 'G'};
+static const long CACHE_VERSION = 3;
+
+
 ConfigurePython::ConfigurePython(const std::string& python_script, char* args[], int nargs) {
 
+    // The configuration is cached only if a cache directory is provided
+    std::string cache_file;
+    const char* cache_dir = std::getenv("HPSTR_CONFIG_CACHE");
+    if (cache_dir != nullptr && *cache_dir != '\0') {
+        std::string hash = hashConfiguration(python_script, args, nargs);
+        if (!hash.empty()) {
+            std::string name = python_script.substr(python_script.rfind("/") + 1);
+            cache_file = std::string(cache_dir) + "/" + name.substr(0, name.find(".py")) + "_" + hash + ".cfg";
+        }
+    }
+
+    if (!cache_file.empty() && readCache(cache_file)) {
+        from_cache_ = true;
+        std::cout << "---- [ hpstr ][ ConfigurePython ]: Configuration loaded from " 
+            << cache_file << std::endl;
+        return;
+    }
+
+    runScript(python_script, args, nargs);
+
+    if (!cache_file.empty() && configured_ && writeCache(cache_file)) {
+        std::cout << "---- [ hpstr ][ ConfigurePython ]: Configuration cached in " 
+            << cache_file << std::endl;
+    }
+}
+
+
+void ConfigurePython::runScript(const std::string& python_script, char* args[], int nargs) {
+
     std::string path(".");
     std::string cmd = python_script;
 
@@ -51,6 +291,7 @@ ConfigurePython::ConfigurePython(const std::string& python_script, char* args[],
 
     // Initialize the python interpreter. 
     Py_Initialize();
+    py_initialized_ = true;
 
     // Set the command line arguments passed to the python script to be 
     // executed. Note that the first parameter in the list or arguments 
@@ -131,6 +372,20 @@ ConfigurePython::ConfigurePython(const std::string& python_script, char* args[],
     run_mode_    = intMember(p_process, "run_mode");
     skip_events_    = intMember(p_process, "skip_events");
 
+    // Output I/O settings. Older configurations may not define them.
+    compression_algorithm_ = stringMember(p_process, "compression_algorithm", compression_algorithm_);
+    compression_level_     = intMember(p_process, "compression_level", compression_level_);
+    basket_size_           = intMember(p_process, "basket_size", basket_size_);
+    split_level_           = intMember(p_process, "split_level", split_level_);
+    auto_flush_            = intMember(p_process, "auto_flush", auto_flush_);
+    imt_threads_           = intMember(p_process, "imt_threads", imt_threads_);
+    io_report_             = intMember(p_process, "io_report", io_report_);
+    shrink_after_          = intMember(p_process, "shrink_after", shrink_after_);
+    n_workers_             = intMember(p_process, "n_workers", n_workers_);
+    merge_output_          = stringMember(p_process, "merge_output", merge_output_);
+    branch_basket_sizes_   = intDictMember(p_process, "branch_basket_sizes");
+    branch_split_levels_   = intDictMember(p_process, "branch_split_levels");
+
     PyObject* p_sequence = PyObject_GetAttrString(p_process, "sequence");
     if (!PyList_Check(p_sequence)) {
         throw std::runtime_error("[ ConfigurePython ]: Sequence is not a python list as expected."); 
@@ -287,14 +542,181 @@ ConfigurePython::ConfigurePython(const std::string& python_script, char* args[],
     }
     Py_DECREF(py_list);
 
+    configured_ = true;
+
     } catch (std::exception& e) { 
         std::cout << e.what() << std::endl;
     }
 
 }
 
+bool ConfigurePython::readCache(const std::string& cache_file) {
+
+    std::ifstream in(cache_file, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    // Read into a copy so that a damaged cache leaves this configuration 
+    // untouched and the script can be run instead.
+    ConfigurePython cached(*this);
+    try {
+        if (!cached.readCache(in)) return false;
+    } catch (std::exception& e) {
+        std::cout << "---- [ hpstr ][ ConfigurePython ]: Ignoring configuration cache " 
+            << cache_file << ": " << e.what() << std::endl;
+        return false;
+    }
+    *this = cached;
+    return true;
+}
+
+bool ConfigurePython::readCache(std::istream& in) {
+
+    char magic[sizeof(CACHE_MAGIC)];
+    in.read(magic, sizeof(magic));
+    if (!in || std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 || readInt(in) != CACHE_VERSION) 
+        return false;
+
+    // The cache is stale if any python source imported by the script changed
+    long n_sources = readSize(in);
+    for (long i = 0; i < n_sources; i++) {
+        std::string source = readString(in);
+        if (hashFile(source) != readString(in)) {
+            std::cout << "---- [ hpstr ][ ConfigurePython ]: " << source 
+                << " changed since the configuration was cached" << std::endl;
+            return false;
+        }
+    }
+
+    run_mode_              = readInt(in);
+    skip_events_           = readInt(in);
+    event_limit_           = readInt(in);
+    compression_algorithm_ = readString(in);
+    compression_level_     = readInt(in);
+    basket_size_           = readInt(in);
+    split_level_           = readInt(in);
+    branch_basket_sizes_   = readIntMap(in);
+    branch_split_levels_   = readIntMap(in);
+    auto_flush_            = readInt(in);
+    imt_threads_           = readInt(in);
+    io_report_             = readInt(in);
+    shrink_after_          = readInt(in);
+    n_workers_             = readInt(in);
+    merge_output_          = readString(in);
+    input_files_           = readStrings(in);
+    libraries_             = readStrings(in);
+    output_files_          = readStrings(in);
+
+    long n_processors = readSize(in);
+    for (long i = 0; i < n_processors; i++) {
+        ProcessorInfo pi;
+        pi.classname_ = readString(in);
+        pi.instancename_ = readString(in);
+        long n_params = readSize(in);
+        for (long j = 0; j < n_params; j++) {
+            std::string key = readString(in);
+            long type = readInt(in);
+            if (type == ParameterSet::et_Integer) {
+                pi.params_.insert(key, int(readInt(in)));
+            } else if (type == ParameterSet::et_Double) {
+                pi.params_.insert(key, readDouble(in));
+            } else if (type == ParameterSet::et_String) {
+                pi.params_.insert(key, readString(in));
+            } else if (type == ParameterSet::et_VInteger) {
+                std::vector<int> vals(readSize(in));
+                for (auto& val : vals) val = readInt(in);
+                pi.params_.insert(key, vals);
+            } else if (type == ParameterSet::et_VDouble) {
+                std::vector<double> vals(readSize(in));
+                for (auto& val : vals) val = readDouble(in);
+                pi.params_.insert(key, vals);
+            } else if (type == ParameterSet::et_VString) {
+                pi.params_.insert(key, readStrings(in));
+            } else {
+                throw std::runtime_error("[ ConfigurePython ]: Unknown parameter type in configuration cache");
+            }
+        }
+        sequence_.push_back(pi);
+    }
+    return true;
+}
+
+bool ConfigurePython::writeCache(const std::string& cache_file) const {
+
+    // Write to a temporary file first so that concurrent jobs never read a 
+    // partially written cache.
+    std::string tmp_file = cache_file + "." + std::to_string(getpid()) + ".tmp";
+    std::ofstream out(tmp_file, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+
+    out.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    writeInt(out, CACHE_VERSION);
+
+    std::vector<std::string> sources = importedSources();
+    writeInt(out, sources.size());
+    for (auto& source : sources) {
+        writeString(out, source);
+        writeString(out, hashFile(source));
+    }
+
+    writeInt(out, run_mode_);
+    writeInt(out, skip_events_);
+    writeInt(out, event_limit_);
+    writeString(out, compression_algorithm_);
+    writeInt(out, compression_level_);
+    writeInt(out, basket_size_);
+    writeInt(out, split_level_);
+    writeIntMap(out, branch_basket_sizes_);
+    writeIntMap(out, branch_split_levels_);
+    writeInt(out, auto_flush_);
+    writeInt(out, imt_threads_);
+    writeInt(out, io_report_);
+    writeInt(out, shrink_after_);
+    writeInt(out, n_workers_);
+    writeString(out, merge_output_);
+    writeStrings(out, input_files_);
+    writeStrings(out, libraries_);
+    writeStrings(out, output_files_);
+
+    writeInt(out, sequence_.size());
+    bool supported = true;
+    for (auto& pi : sequence_) {
+        writeString(out, pi.classname_);
+        writeString(out, pi.instancename_);
+        writeInt(out, pi.params_.elements_.size());
+        for (auto& param : pi.params_.elements_) {
+            const ParameterSet::Element& el = param.second;
+            writeString(out, param.first);
+            writeInt(out, el.et_);
+            if (el.et_ == ParameterSet::et_Integer) {
+                writeInt(out, el.intval_);
+            } else if (el.et_ == ParameterSet::et_Double) {
+                out.write(reinterpret_cast<const char*>(&el.doubleval_), sizeof(double));
+            } else if (el.et_ == ParameterSet::et_String) {
+                writeString(out, el.strval_);
+            } else if (el.et_ == ParameterSet::et_VInteger) {
+                writeInt(out, el.ivecVal_.size());
+                for (auto val : el.ivecVal_) writeInt(out, val);
+            } else if (el.et_ == ParameterSet::et_VDouble) {
+                writeInt(out, el.dvecVal_.size());
+                out.write(reinterpret_cast<const char*>(el.dvecVal_.data()), el.dvecVal_.size()*sizeof(double));
+            } else if (el.et_ == ParameterSet::et_VString) {
+                writeStrings(out, el.svecVal_);
+            } else {
+                supported = false;
+            }
+        }
+    }
+    out.close();
+
+    if (!supported || !out || std::rename(tmp_file.c_str(), cache_file.c_str()) != 0) {
+        std::remove(tmp_file.c_str());
+        return false;
+    }
+    return true;
+}
+
 ConfigurePython::~ConfigurePython() {
-    Py_Finalize();
+    if (py_initialized_) Py_Finalize();
 }
 
 Process* ConfigurePython::makeProcess() { 
@@ -305,12 +727,7 @@ Process* ConfigurePython::makeProcess() {
     }
 
     for (auto proc : sequence_) {
-        Processor* ep = ProcessorFactory::instance().createProcessor(proc.classname_, proc.instancename_, *p);
-        if (ep == 0) {
-            throw std::runtime_error("[ ConfigurePython ]: Unable to create instance of " + proc.instancename_); 
-        }
-        ep->configure(proc.params_);
-        p->addToSequence(ep);    
+        p->addToSequence(proc.classname_, proc.instancename_, proc.params_);    
     }
         
     for (auto file : input_files_) {
@@ -324,6 +741,17 @@ Process* ConfigurePython::makeProcess() {
     p->setEventLimit(event_limit_);
     p->setRunMode(run_mode_);
     p->setSkipEvents(skip_events_);
+    p->setCompression(compression_algorithm_, compression_level_);
+    p->setBasketSize(basket_size_);
+    p->setSplitLevel(split_level_);
+    p->setBranchBasketSizes(branch_basket_sizes_);
+    p->setBranchSplitLevels(branch_split_levels_);
+    p->setAutoFlush(auto_flush_);
+    p->setImplicitMTThreads(imt_threads_);
+    p->setIOReport(io_report_ != 0);
+    p->setShrinkAfter(shrink_after_);
+    p->setNWorkers(n_workers_);
+    p->setMergeOutput(merge_output_);
 
     return p; 
 }
@@ -7,6 +7,9 @@
 
 #include "EventFile.h"
 #include "TProcessID.h"
+#include "Compression.h"
+
+#include <iomanip>
 
 EventFile::EventFile(const std::string ifilename, const std::string& ofilename) { 
 
@@ -51,6 +54,43 @@ void EventFile::resetOutputFileDir() {
   ofile_->cd();
 }
 
+void EventFile::setCompression(const std::string& algorithm, int level) {
+
+    if (!algorithm.empty()) {
+        int ialgo{ROOT::RCompressionSetting::EAlgorithm::kUseGlobal};
+        if (algorithm == "zlib") ialgo = ROOT::RCompressionSetting::EAlgorithm::kZLIB;
+        else if (algorithm == "lzma") ialgo = ROOT::RCompressionSetting::EAlgorithm::kLZMA;
+        else if (algorithm == "lz4") ialgo = ROOT::RCompressionSetting::EAlgorithm::kLZ4;
+        else if (algorithm == "zstd") ialgo = ROOT::RCompressionSetting::EAlgorithm::kZSTD;
+        else throw std::runtime_error("Unknown compression algorithm " + algorithm);
+        ofile_->SetCompressionAlgorithm(ialgo);
+    }
+    if (level >= 0) ofile_->SetCompressionLevel(level);
+}
+
+void EventFile::printIOReport() {
+
+    TTree* tree = event_->getTree();
+    std::cout << "---- [ hpstr ][ EventFile ]: Bytes written per branch to " 
+        << ofile_->GetName() << " (compression " << ofile_->GetCompressionSettings() << ")" << std::endl;
+    std::cout << std::left << std::setw(40) << "Branch" 
+        << std::right << std::setw(16) << "Total [B]" << std::setw(16) << "Zipped [B]" 
+        << std::setw(10) << "Ratio" << std::setw(10) << "Baskets" << std::endl;
+    TIter next(tree->GetListOfBranches());
+    while (TBranch* branch = static_cast<TBranch*>(next())) {
+        Long64_t tot = branch->GetTotBytes("*");
+        Long64_t zip = branch->GetZipBytes("*");
+        std::cout << std::left << std::setw(40) << branch->GetName() 
+            << std::right << std::setw(16) << tot << std::setw(16) << zip 
+            << std::setw(10) << std::setprecision(3) << (zip > 0 ? double(tot)/zip : 0.) 
+            << std::setw(10) << branch->GetWriteBasket() << std::endl;
+    }
+    std::cout << std::left << std::setw(40) << "Total" 
+        << std::right << std::setw(16) << tree->GetTotBytes() << std::setw(16) << tree->GetZipBytes() 
+        << std::setw(10) << std::setprecision(3) 
+        << (tree->GetZipBytes() > 0 ? double(tree->GetTotBytes())/tree->GetZipBytes() : 0.) << std::endl;
+}
+
 void EventFile::close() { 
     
     // Close the LCIO file that was being processed
@@ -59,6 +99,11 @@ void EventFile::close() {
     // Write the ROOT tree to disk
     ofile_->cd();
     event_->getTree()->Write();  
+
+    if (io_report_) { 
+        printIOReport(); 
+        event_->printMemoryReport(); 
+    }
     
     // Close the ROOT file
     ofile_->Close(); 
@@ -9,84 +9,251 @@
 #include "Process.h"
 #include "EventFile.h"
 #include "HpsEventFile.h"
+#include "ProcessorFactory.h"
 #include "TH1.h"
+#include "TROOT.h"
+#include "TFileMerger.h"
+#include "TProcessID.h"
 
-Process::Process() {}
+#include <algorithm>
+#include <set>
+#include <thread>
 
-//TODO Fix this better
+Process::Process() {}
 
 void Process::runOnHisto() {
     try {
-        int cfile = 0;
-        for (auto ifile : input_files_) {
-            std::cout << "Processing file " << ifile << std::endl;
-
-            for (auto module : sequence_) {
-                module->initialize(ifile, output_files_[cfile]);
-                module->process();
-                module->finalize();
-            }
-            //Pass to next file
-            ++cfile;
-
-        } //ifile
+        if (useWorkers()) {
+            runOnWorkers([this](size_t cfile, std::vector<Processor*>& sequence) {
+                    processHistoFile(input_files_[cfile], output_files_[cfile], sequence);
+                    });
+        }
+        else {
+            for (size_t cfile = 0; cfile < input_files_.size(); ++cfile)
+                processHistoFile(input_files_[cfile], output_files_[cfile], sequence_);
+        }
+        mergeOutputFiles();
     } catch (std::exception& e) {
         std::cerr<<"Error:"<<e.what()<<std::endl;
+        throw;
     }
 } //Process::runOnHisto
 
-void Process::runOnRoot() {
-    try {
-        int n_events_processed = 0;
-        HpsEvent event;
-        TH1D * event_h = new TH1D("event_h","Number of Events Processed;;Events", 21, -10.5, 10.5);
-        int cfile =0 ;
-        for (auto ifile : input_files_) {
-            std::cout<<"Processing file "<<ifile<<std::endl;
-            HpsEventFile* file(nullptr);
-            if (!output_files_.empty()) {
-                file = new HpsEventFile(ifile, output_files_[cfile]);
-                file->setupEvent(&event);
-            }
-            for (auto module : sequence_) {
-                module->initialize(event.getTree());
-                module->setFile(file->getOutputFile());
-            }
-            while (file->nextEvent() && (event_limit_ < 0 || (n_events_processed < event_limit_))) {
-                if (n_events_processed%1000 == 0)
-                    std::cout<<"Event:"<<n_events_processed<<std::endl;
+void Process::processHistoFile(const std::string& ifile, const std::string& ofile, 
+        std::vector<Processor*>& sequence) {
+    std::cout << "Processing file " << ifile << std::endl;
 
-                //In this way if the processing fails (like an event doesn't pass the selection, the other modules aren't run on that event)
-                for (auto module : sequence_) {
-                    module->process(&event);
-                }
-                //event.Clear();
-                event_h->Fill(0.0);
-                ++n_events_processed;
-            }
-            //Pass to next file
-            ++cfile;
-            // Finalize all modules
+    for (auto module : sequence) {
+        module->initialize(ifile, ofile);
+        reportFirstEvent();
+        module->process();
+        module->finalize();
+    }
+}
 
-            //Select the output file for storing the results of the processors.
-            file->resetOutputFileDir();
-            event_h->Write();
-            for (auto module : sequence_) {
-                //TODO:Change the finalize method
-                module->finalize();
-            }
-            // TODO Check all these destructors
-            if (file) {
-                file->close();
-                delete file;
-                file = nullptr;
-                delete event_h;
-                event_h = nullptr;
-            }
+void Process::runOnRoot() {
+    try {
+        n_events_processed_ = 0;
+        if (useWorkers()) {
+            runOnWorkers([this](size_t cfile, std::vector<Processor*>& sequence) {
+                    processRootFile(input_files_[cfile], output_files_[cfile], sequence);
+                    });
         }
+        else {
+            for (size_t cfile = 0; cfile < input_files_.size(); ++cfile)
+                processRootFile(input_files_[cfile], output_files_.empty() ? "" : output_files_[cfile], sequence_);
+        }
+        mergeOutputFiles();
     } catch (std::exception& e) {
         std::cerr<<"Error:"<<e.what()<<std::endl;
+        throw;
+    }
+}
+
+void Process::processRootFile(const std::string& ifile, const std::string& ofile, 
+        std::vector<Processor*>& sequence) {
+    std::cout<<"Processing file "<<ifile<<std::endl;
+
+    if (ofile.empty())
+        throw std::runtime_error("[ Process ]: No output file given for " + ifile);
+
+    HpsEvent event;
+    HpsEventFile* file = new HpsEventFile(ifile, ofile);
+    file->setupEvent(&event);
+
+    // Held until the file is closed, references may be resolved in finalize
+    std::vector<std::unique_lock<std::mutex>> process_id_locks = lockProcessIDs(file->getInputFile());
+
+    // Kept out of the output directory so that closing the file doesn't delete it
+    TH1D * event_h = new TH1D("event_h","Number of Events Processed;;Events", 21, -10.5, 10.5);
+    event_h->SetDirectory(nullptr);
+
+    for (auto module : sequence) {
+        module->initialize(event.getTree());
+        module->setFile(file->getOutputFile());
+    }
+    while (file->nextEvent()) {
+        // Reserve the event before processing it, so that the workers 
+        // sharing the counter can't overshoot the limit together
+        int event_limit = event_limit_;
+        int n_events_processed = n_events_processed_.fetch_add(1);
+        if (event_limit >= 0 && n_events_processed >= event_limit)
+            break;
+        reportFirstEvent();
+        if (n_events_processed%1000 == 0)
+            std::cout<<"Event:"<<n_events_processed<<std::endl;
+
+        //In this way if the processing fails (like an event doesn't pass the selection, the other modules aren't run on that event)
+        for (auto module : sequence) {
+            module->process(&event);
+        }
+        //event.Clear();
+        event_h->Fill(0.0);
+    }
+
+    //Select the output file for storing the results of the processors.
+    file->resetOutputFileDir();
+    event_h->Write();
+    // Finalize all modules
+    for (auto module : sequence) {
+        //TODO:Change the finalize method
+        module->finalize();
+    }
+    // TODO Check all these destructors
+    if (file) {
+        file->close();
+        delete file;
+        file = nullptr;
+    }
+    delete event_h;
+    event_h = nullptr;
+}
+
+std::vector<std::unique_lock<std::mutex>> Process::lockProcessIDs(TFile* file) {
+
+    std::vector<std::unique_lock<std::mutex>> locks;
+    if (file == nullptr || file->IsZombie())
+        return locks;
+
+    std::set<std::string> uuids;
+    for (int pidf = 0; pidf < file->GetNProcessIDs(); ++pidf) {
+        TProcessID* pid = file->ReadProcessID(pidf);
+        if (pid) uuids.insert(pid->GetTitle());
+    }
+
+    std::vector<std::mutex*> mutexes;
+    {
+        std::lock_guard<std::mutex> lock(process_id_mutexes_mutex_);
+        for (auto& uuid : uuids) {
+            std::unique_ptr<std::mutex>& mutex = process_id_mutexes_[uuid];
+            if (!mutex) mutex.reset(new std::mutex());
+            mutexes.push_back(mutex.get());
+        }
+    }
+
+    // In the order of the UUIDs
+    for (auto mutex : mutexes)
+        locks.emplace_back(*mutex);
+    return locks;
+}
+
+bool Process::useWorkers() const {
+    if (n_workers_ < 2 || input_files_.size() < 2)
+        return false;
+    if (output_files_.size() != input_files_.size()) {
+        std::cout << "---- [ hpstr ][ Process ]: WARNING: " << n_workers_ 
+            << " workers requested but the number of output files doesn't match the number" 
+            << " of input files. Processing files serially." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::vector<Processor*> Process::makeSequence() {
+    std::vector<Processor*> sequence;
+    for (auto& config : sequence_configs_) {
+        Processor* ep = ProcessorFactory::instance().createProcessor(config.classname_, config.instancename_, *this);
+        if (ep == 0) {
+            throw std::runtime_error("[ Process ]: Unable to create instance of " + config.instancename_); 
+        }
+        ep->configure(config.params_);
+        sequence.push_back(ep);
+    }
+    return sequence;
+}
+
+void Process::runOnWorkers(const std::function<void(size_t, std::vector<Processor*>&)>& processFile) {
+
+    if (sequence_configs_.size() != sequence_.size())
+        throw std::runtime_error("[ Process ]: Processors added without configuration can't be run on workers.");
+
+    // Covers ROOT's own global state, but not the TRef object tables, which 
+    // processRootFile locks per writing job with lockProcessIDs.
+    ROOT::EnableThreadSafety();
+
+    // Each worker owns an isolated copy of the processor sequence. The first 
+    // worker reuses the sequence created at configuration time.
+    size_t n_workers = std::min(static_cast<size_t>(n_workers_), input_files_.size());
+    std::vector<std::vector<Processor*>> sequences{sequence_};
+    for (size_t iworker = 1; iworker < n_workers; ++iworker)
+        sequences.push_back(makeSequence());
+
+    std::cout << "---- [ hpstr ][ Process ]: Processing " << input_files_.size() 
+        << " files on " << n_workers << " workers" << std::endl;
+
+    std::atomic<size_t> next_file{0};
+    std::atomic<size_t> n_failed{0};
+    std::vector<std::thread> workers;
+    for (size_t iworker = 0; iworker < n_workers; ++iworker) {
+        workers.emplace_back([&, iworker]() {
+                size_t cfile;
+                while ((cfile = next_file++) < input_files_.size()) {
+                    try {
+                        processFile(cfile, sequences[iworker]);
+                    } catch (std::exception& e) {
+                        ++n_failed;
+                        std::cerr << "---- [ hpstr ][ Process ]: Error processing " 
+                            << input_files_[cfile] << "! " << e.what() << std::endl;
+                    }
+                }
+            });
+    }
+    for (auto& worker : workers)
+        worker.join();
+
+    for (size_t iworker = 1; iworker < sequences.size(); ++iworker) {
+        for (auto module : sequences[iworker])
+            delete module;
     }
+
+    // The other files are still processed, but the job has to fail
+    if (n_failed > 0)
+        throw std::runtime_error("[ Process ]: Failed processing " + std::to_string(n_failed) 
+                + " of " + std::to_string(input_files_.size()) + " files");
+}
+
+void Process::mergeOutputFiles() {
+    if (merge_output_.empty() || output_files_.empty())
+        return;
+
+    std::cout << "---- [ hpstr ][ Process ]: Merging " << output_files_.size() 
+        << " output files into " << merge_output_ << std::endl;
+
+    TFileMerger merger(false);
+    merger.OutputFile(merge_output_.c_str(), "RECREATE");
+    for (auto& ofile : output_files_)
+        merger.AddFile(ofile.c_str());
+    if (!merger.Merge())
+        throw std::runtime_error("[ Process ]: Failed merging output files into " + merge_output_);
+}
+
+void Process::reportFirstEvent() {
+    if (!report_first_event_.exchange(false))
+        return;
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start_time_);
+    std::cout << "---- [ hpstr ][ Process ]: First event after " 
+        << elapsed.count() << " ms" << std::endl;
 }
 
 void Process::run() {
@@ -99,6 +266,9 @@ void Process::run() {
         if (input_files_.empty()) 
             throw std::runtime_error("Please specify files to process.");
 
+        // Parallel compression of the output baskets
+        if (imt_threads_ > 0) ROOT::EnableImplicitMT(imt_threads_);
+
         // Create an object used to manage the input and output files.
         Event event;  
 
@@ -115,16 +285,34 @@ void Process::run() {
             EventFile* file{nullptr};  
             if (!output_files_.empty()) { 
                 file = new EventFile(ifile, output_files_[cfile]);
+                // Compression has to be set before the tree and its branches are created
+                file->setCompression(compression_algorithm_, compression_level_);
+                file->setIOReport(io_report_);
                 file->setupEvent(&event);  
             }
 
             TTree* tree = new TTree("HPS_Event","HPS event tree");
             event.setTree(tree); 
+            event.setBranchSettings(basket_size_, split_level_);
+            event.setShrinkAfter(shrink_after_);
+            for (auto& split : branch_split_levels_) 
+                event.setSplitLevel(split.first, split.second);
+            for (auto& basket : branch_basket_sizes_) 
+                event.setBasketSize(basket.first, basket.second);
+
             // first, notify everyone that we are starting
             for (auto module : sequence_) {
+                module->setEvent(&event);
                 module->initialize(tree);
             }
 
+            // Branches created directly by the processors pick up the basket 
+            // sizes here, once they all exist.
+            if (basket_size_ > 0) tree->SetBasketSize("*", basket_size_);
+            for (auto& basket : branch_basket_sizes_) 
+                tree->SetBasketSize(basket.first.c_str(), basket.second);
+            if (auto_flush_ != 0) tree->SetAutoFlush(auto_flush_);
+
             //In the case of additional output files from the processors this restores the correct ProcessID storage
             file->resetOutputFileDir();
 
@@ -132,6 +320,7 @@ void Process::run() {
             while (file->nextEvent() && (event_limit_ < 0 || (n_events_processed < event_limit_))) {
                 if (n_events_processed%1000 == 0)
                     std::cout << "---- [ hpstr ][ Process ]: Event: " << n_events_processed << std::endl;
+                reportFirstEvent();
                 event.Clear(); 
                 bool passEvent = true;
                 
@@ -172,6 +361,123 @@ void Process::run() {
     }
 }
 
+void Process::runServer(std::istream& requests) {
+
+    if (sequence_configs_.size() != sequence_.size())
+        throw std::runtime_error("[ Process ]: Processors added without configuration can't be run in server mode.");
+    if (run_mode_ != 1 && run_mode_ != 2)
+        throw std::runtime_error("[ Process ]: Server mode requires run mode 1 or 2.");
+
+    server_mode_ = true;
+    std::cout << "---- [ hpstr ][ Process ]: Waiting for requests" << std::endl;
+
+    std::string line;
+    int n_requests = 0;
+    while (std::getline(requests, line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+
+        auto start = std::chrono::steady_clock::now();
+        json status;
+        status["request"] = n_requests++;
+        try {
+            json request = json::parse(line);
+            if (request.value("quit", false))
+                break;
+
+            std::string ifile = request.value("input", input_files_.empty() ? "" : input_files_[0]);
+            std::string ofile = request.value("output", output_files_.empty() ? "" : output_files_[0]);
+            json deltas = request.value("params", json::object());
+
+            // Each request starts from the configuration of the script
+            for (size_t iproc = 0; iproc < sequence_.size(); ++iproc) {
+                const ProcessorConfig& config = sequence_configs_[iproc];
+                ParameterSet params = config.params_;
+                if (deltas.count(config.instancename_)) {
+                    for (auto& param : deltas[config.instancename_].items())
+                        insertParameter(params, param.key(), param.value());
+                }
+                sequence_[iproc]->configure(params);
+            }
+
+            if (run_mode_ == 1) {
+                n_events_processed_ = 0;
+                processRootFile(ifile, ofile, sequence_);
+            } 
+            else {
+                processHistoFile(ifile, ofile, sequence_);
+            }
+            status["status"] = "ok";
+            status["output"] = ofile;
+        } catch (std::exception& e) {
+            status["status"] = "error";
+            status["error"] = e.what();
+        }
+        status["time_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        std::cout << "---- [ hpstr ][ Server ]: " << status.dump() << std::endl;
+    }
+
+    std::cout << "---- [ hpstr ][ Process ]: Processed " << n_requests << " requests" << std::endl;
+    closeResidentFiles();
+}
+
+void Process::insertParameter(ParameterSet& params, const std::string& name, const json& value) {
+
+    auto ptr = params.elements_.find(name);
+    ParameterSet::ElementType type = ptr == params.elements_.end() ? ParameterSet::et_NoType : ptr->second.et_;
+
+    if (value.is_boolean()) {
+        params.insert(name, int(value.get<bool>()));
+    } else if (value.is_number_integer() && type != ParameterSet::et_Double) {
+        params.insert(name, value.get<int>());
+    } else if (value.is_number()) {
+        params.insert(name, value.get<double>());
+    } else if (value.is_string()) {
+        params.insert(name, value.get<std::string>());
+    } else if (value.is_array() && !value.empty() && value[0].is_string()) {
+        params.insert(name, value.get<std::vector<std::string>>());
+    } else if (value.is_array()) {
+        bool integers = type != ParameterSet::et_VDouble;
+        for (auto& val : value) integers = integers && val.is_number_integer();
+        if (integers)
+            params.insert(name, value.get<std::vector<int>>());
+        else
+            params.insert(name, value.get<std::vector<double>>());
+    } else {
+        throw std::runtime_error("[ Process ]: Unsupported type for parameter '" + name + "'");
+    }
+}
+
+TFile* Process::openInputFile(const std::string& filename) {
+    if (!server_mode_)
+        return TFile::Open(filename.c_str(), "READ");
+
+    std::lock_guard<std::mutex> lock(resident_files_mutex_);
+    TFile*& file = resident_files_[filename];
+    if (file == nullptr || !file->IsOpen()) {
+        delete file;
+        file = TFile::Open(filename.c_str(), "READ");
+    }
+    return file;
+}
+
+void Process::closeInputFile(TFile* file) {
+    if (file == nullptr || server_mode_)
+        return;
+    file->Close();
+    delete file;
+}
+
+void Process::closeResidentFiles() {
+    std::lock_guard<std::mutex> lock(resident_files_mutex_);
+    for (auto& file : resident_files_) {
+        if (file.second) file.second->Close();
+        delete file.second;
+    }
+    resident_files_.clear();
+}
+
 void Process::addFileToProcess(const std::string& filename) {
     input_files_.push_back(filename);
 }
@@ -184,3 +490,14 @@ void Process::addToSequence(Processor* mod) {
     sequence_.push_back(mod);
 }
 
+void Process::addToSequence(const std::string& classname, const std::string& instancename, 
+        const ParameterSet& params) {
+    Processor* ep = ProcessorFactory::instance().createProcessor(classname, instancename, *this);
+    if (ep == 0) {
+        throw std::runtime_error("[ Process ]: Unable to create instance of " + instancename); 
+    }
+    ep->configure(params);
+    sequence_.push_back(ep);
+    sequence_configs_.push_back({classname, instancename, params});
+}
+
@@ -8,6 +8,7 @@
 //----------------//
 //   C++ StdLib   //
 //----------------//
+#include <chrono>
 #include <csignal>
 #include <cstdlib>
 #include <cstring>
@@ -25,16 +26,24 @@ void displayUsage();
 
 int main(int argc, char **argv) { 
 
+    auto start = std::chrono::steady_clock::now();
+
     if (argc < 2) {
         displayUsage(); 
         return EXIT_FAILURE;
     }
 
+    bool verbose = false;
+    bool server = false;
     int ptrpy = 1;
     for (ptrpy = 1; ptrpy < argc; ptrpy++) {
         std::cout << argv[ptrpy] << std::endl;
         if (strstr(argv[ptrpy], ".py"))
             break;
+        if (strcmp(argv[ptrpy], "-v") == 0)
+            verbose = true;
+        if (strcmp(argv[ptrpy], "-s") == 0)
+            server = true;
     }
 
     if (ptrpy == argc) {
@@ -47,15 +56,30 @@ int main(int argc, char **argv) {
 
         std::cout << "---- [ hpstr ]: Loading configuration --------" << std::endl;
         
+        auto config_start = std::chrono::steady_clock::now();
         ConfigurePython cfg(argv[ptrpy], argv + ptrpy + 1, argc - ptrpy -1);
+        auto config_end = std::chrono::steady_clock::now();
 
         std::cout << "---- [ hpstr ]: Configuration load complete  --------" << std::endl;
 
         Process* p = cfg.makeProcess();
         int run_mode = p->getRunMode();
+        auto process_end = std::chrono::steady_clock::now();
 
         std::cout << "---- [ hpstr ]: Process mode " << run_mode << " initialized.  --------" << std::endl;
 
+        if (verbose) {
+            auto ms = [](const std::chrono::steady_clock::duration& d) {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(d).count();
+            };
+            std::cout << "---- [ hpstr ]: Startup time breakdown  --------" << std::endl;
+            std::cout << "    Before configuration     : " << ms(config_start - start) << " ms" << std::endl;
+            std::cout << "    Configuration " << (cfg.fromCache() ? "(cached)  " : "(python)  ") 
+                << " : " << ms(config_end - config_start) << " ms" << std::endl;
+            std::cout << "    Libraries and processors : " << ms(process_end - config_end) << " ms" << std::endl;
+            p->setStartTime(start);
+        }
+
         // If Ctrl-c is used, immediately exit the application.
         struct sigaction act;
         memset (&act, '\0', sizeof(act));
@@ -67,7 +91,12 @@ int main(int argc, char **argv) {
         std::cout << "---- [ hpstr ]: Start of processing --------" << std::endl;
 
         //TODO Make this better
-        if (run_mode == 0) 
+        if (server)
+        {
+            std::cout<<"---- [ hpstr ]: Running Server Process --------" << std::endl;
+            p->runServer(std::cin);
+        }
+        else if (run_mode == 0) 
         {
             std::cout<<"---- [ hpstr ]: Running LCIO -> ROOT Process --------" << std::endl;
             p->run();
@@ -92,6 +121,7 @@ int main(int argc, char **argv) {
     } catch (exception& e) { 
         std::cerr << "Error! [" << e.what() << "] \n";
         std::cerr << "Program aborted. " << std::endl;
+        return EXIT_FAILURE;
 
     } 
 
@@ -102,4 +132,13 @@ int main(int argc, char **argv) {
 void displayUsage() {
     printf("Usage: hpstr [application arguments] {configuration_script.py}"
             " [arguments to configuration script]\n");
+    printf("Application arguments:\n");
+    printf("  -v    Print a breakdown of the startup time\n");
+    printf("  -s    Serve requests read from the standard input, one JSON object per line:\n");
+    printf("        {\"input\": ..., \"output\": ..., \"params\": {\"instance\": {\"name\": value}}}\n");
+    printf("Environment:\n");
+    printf("  HPSTR_CONFIG_CACHE    Directory used to cache the configuration of a script"
+            " and its arguments\n");
+    printf("                        Imported python sources are tracked, environment"
+            " variables are not\n");
 }
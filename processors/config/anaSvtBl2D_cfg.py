@@ -35,9 +35,20 @@ svtblana = HpstrConf.Processor('svtblana', 'SvtBl2DAnaProcessor')
 #SvtBl2D
 svtblana.parameters["debug"] = 1
 svtblana.parameters["rawSvtHitsColl"] = "SVTRawTrackerHits"
+#Set to 1 for input written with SvtRawDataProcessor flatOutput
+svtblana.parameters["flatRawHits"] = 0
+#Threads filling the baseline histograms, 0 to use all the cores
+svtblana.parameters["nThreads"] = 0
 svtblana.parameters["histCfg"] = os.environ['HPSTR_BASE']+'/analysis/plotconfigs/svt/Svt2DBl.json'
 svtblana.parameters["triggerBankColl"] = "TSBank"
 svtblana.parameters["triggerBankCfg"] = os.environ['HPSTR_BASE']+'/analysis/selections/triggerSelection.json'
+#Set to 1 to skip the triggers with "status" 0 in triggerBankCfg. By default the status is ignored.
+svtblana.parameters["triggerUseStatus"] = 0
+#Set to 1 to accept all events when triggerBankCfg is empty. By default they are all rejected.
+svtblana.parameters["acceptAllTriggers"] = 0
+#Set to 1 to read the raw hits only for events passing the trigger selection.
+#This disables the raw hit branches for any other processor in the sequence.
+svtblana.parameters["lazyRawHits"] = 0
 
 # Sequence which the processors will run.
 p.sequence = [svtblana]
@@ -45,6 +45,9 @@ vtxana.parameters["tsColl"] = "TSBank"
 vtxana.parameters["trkColl"] = "KalmanFullTracks"
 vtxana.parameters["hitColl"] = "SiClustersOnTrack"
 vtxana.parameters["vtxColl"] = "UnconstrainedV0Vertices_KF"
+#Particles of the vertices, only needed for DSTs written with useIndexRefs.
+#By default the collection recorded by the writer is used.
+#vtxana.parameters["partColl"] = "ParticlesOnUVertices_KF"
 vtxana.parameters["mcColl"] = "MCParticle"
 vtxana.parameters["analysis"] = "vertex"
 vtxana.parameters["vtxSelectionjson"] = os.environ['HPSTR_BASE']+'/analysis/selections/vertexSelection_2019.json'
@@ -35,6 +35,10 @@ clusters = HpstrConf.Processor('clusters', 'ClusterOnTrackAnaProcessor')
 clusters.parameters["debug"] = 1
 clusters.parameters["anaName"] = 'anaClusOnTrk'
 clusters.parameters["trkColl"] = 'KalmanFullTracks'
+#Hits and raw hits on track, only needed for DSTs written with useIndexRefs.
+#By default the collections recorded by the writer are used.
+#clusters.parameters["hitColl"] = 'SiClustersOnTrack'
+#clusters.parameters["rawHitColl"] = 'SVTRawHitsOnTrack_KF'
 #clusters.parameters["BaselineFits"] = "/home/alic/HPS/projects/baselines/jlab/clusters_on_track/"
 clusters.parameters["BaselineFits"] = "/home/alic/HPS/projects/baselines/jlab/clusters_on_track/hps_14552_offline_analysis.root"
 #clusters.parameters["BaselineFits"] = options.baselines
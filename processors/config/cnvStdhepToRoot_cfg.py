@@ -32,6 +32,8 @@ cnvStd = HpstrConf.Processor('cnvStd', 'StdhepMCParticleProcessor')
 cnvStd.parameters["mcPartCollStdhep"] = 'MCParticle'
 cnvStd.parameters["mcPartCollRoot"] = 'MCParticle'
 cnvStd.parameters["skipEvent"] = options.skip_events
+#Number of events read ahead while the previous ones are written
+cnvStd.parameters["batchSize"] = 1000
 if options.nevents > -1:
     cnvStd.parameters["maxEvent"] = options.skip_events+options.nevents
 else:
@@ -67,6 +67,10 @@ rawAnaSvt.parameters["regionDefinitions"] = [RegionPath+'OneFit.json',
 rawAnaSvt.parameters["MatchList"] = ['OneFit', 'CTFit', 'SecondFit']
 rawAnaSvt.parameters["timeref"] = 0.0
 rawAnaSvt.parameters["ampref"] = 0.0
+#Set to csv file names to write the hit time and amplitude of each channel, and the
+#hit time median and 68% window of each hybrid, for the hits passing each region
+#rawAnaSvt.parameters["channelStatsFile"] = 'svtChannelHitStats.csv'
+#rawAnaSvt.parameters["hybridStatsFile"] = 'svtHybridHitStats.csv'
 
 #os.environ['HPSTR_BASE']+'/analysis/plotconfigs/reco/basicRecoHit.json'
 #os.environ['HPSTR_BASE']+'/analysis/plotconfigs/svt/Svt2DBl.json'
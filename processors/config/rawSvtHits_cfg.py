@@ -46,6 +46,8 @@ rawsvt.parameters["debug"] = 0
 rawsvt.parameters["hitCollLcio"] = 'SVTRawTrackerHits'
 rawsvt.parameters["hitfitCollLcio"] = 'SVTFittedRawTrackerHits'
 rawsvt.parameters["hitCollRoot"] = 'SVTRawTrackerHits'
+#Set to 1 to write the hits as flat arrays SVTRawTrackerHits_<field>
+rawsvt.parameters["flatOutput"] = 0
 
 # Sequence which the processors will run.
 p.sequence = [header, rawsvt]
@@ -37,6 +37,10 @@ header.parameters["trigCollLcio"] = "TriggerBank"
 header.parameters["rfCollLcio"] = "RFHits"
 header.parameters["vtpCollLcio"] = "VTPBank"
 header.parameters["vtpCollRoot"] = "VTPBank"
+#VTP sub-banks to decode, a mask of VTPData::SubBank: 252 decodes all, 0 only the headers and trigger time
+header.parameters["vtpSubBanks"] = 252
+#Set to 1 to also write the raw VTP words, which VTPData::decode() decodes when reading
+header.parameters["vtpRawWords"] = 0
 header.parameters["tsCollLcio"] = "TSBank"
 header.parameters["tsCollRoot"] = "TSBank"
 
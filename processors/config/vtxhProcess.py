@@ -36,6 +36,12 @@ vtxPostProc = HpstrConf.Processor('vtxPostProc', 'VtxHistoProcessor')
 #MCParticles
 vtxPostProc.parameters["debug"] = 1
 vtxPostProc.parameters["rebin"] = 4
+#1 fits the projections with ROOT, as before. Other values fit them with the
+#hpstr slice fitter on that many threads (0: all cores); it prints the fit
+#results for print level >= 1 but no longer waits for RETURN after each one.
+vtxPostProc.parameters["nThreads"] = 1
+#Slice fitter only: projections with more entries are fitted in closed form
+vtxPostProc.parameters["fastFitEntries"] = 0.
 #KF
 #vtxPostProc.parameters["selection"] = "vtxana_kf_vtxSelection"
 #GBL
@@ -8,6 +8,7 @@
 #include "EventHeader.h"
 #include "RawSvtHit.h"
 #include "ModuleMapper.h"
+#include "StreamingStats.h"
 // #include "Apv25XtalkAnaHistos.h"
 
 // ROOT
@@ -70,12 +71,23 @@ class Apv25RoXtalkAnaProcessor : public Processor {
 
 
     private:
+        /** Read time statistics of a sync phase, for the low [0] and high [1] FEBs */
+        struct BuffResult {
+            double rms[2]{0., 0.}; //!< RMS of the read time minus event time
+            double lowCut[2]{0., 0.}; //!< lower read time cut
+            double highCut[2]{0., 0.}; //!< upper read time cut
+        };
+
         /**
-         * @brief description
+         * @brief Replay the recorded events through the APV25 read buffer
+         *        for a sync phase. Only reads the recorded events, so 
+         *        phases can be emulated concurrently.
          * 
-         * @param buffIter 
+         * @param buffIter Sync phase
+         * @param writeHistos Write the read time histograms of the phase
+         * @return The read time statistics of the phase
          */
-        void emulateApv25Buff(int buffIter);
+        BuffResult emulateApv25Buff(int buffIter, bool writeHistos) const;
 
         //Containers to hold histogrammer info
         //RecoHitAnaHistos* histos{nullptr};
@@ -97,18 +109,22 @@ class Apv25RoXtalkAnaProcessor : public Processor {
         int trigPhase_{8}; //!< description
         int trigDel_{6696}; //!< description
 
-        std::vector<long> reads; //!< description
-        std::vector<long> readEvs; //!< description
+        int nThreads_{0}; //!< Threads emulating the sync phases, 0 to use all the cores
+
+        /** Flags of an event with enough hits to time the reads of a group of FEBs */
+        enum FebFlag {
+            L_FEB_BUSY = 1, //!< more than 700 hits on FEBs 0-4
+            H_FEB_BUSY = 2  //!< more than 300 hits on FEBs 5-9
+        };
+
         std::vector<long> eventTimes; //!< description
-        std::vector<int>  hitMultis; //!< description
-        std::vector<int>  lFEBMultis; //!< description
+        std::vector<unsigned char> febFlags; //!< FebFlag of each event
+        TH1D* hitN_h_{nullptr}; //!< raw hit multiplicity
+        TH1D* lFEBN_h_{nullptr}; //!< raw hit multiplicity on FEBs 0-4
+        TH1D* hFEBN_h_{nullptr}; //!< raw hit multiplicity on FEBs 5-9
+        TH2D* FEBN_hh_{nullptr}; //!< FEBs 0-4 vs FEBs 5-9 raw hit multiplicity
         double  lFEBrms[210]; //!< description
-        double  lLowCut; //!< description
-        double  lHighCut; //!< description
-        std::vector<int>  hFEBMultis; //!< description
         double  hFEBrms[210]; //!< description
-        double  hLowCut; //!< description
-        double  hHighCut; //!< description
         double  sps[210]; //!< description
 
         int debug_{0}; //!< debug level
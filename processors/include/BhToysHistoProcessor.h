@@ -92,6 +92,8 @@ class BhToysHistoProcessor : public Processor {
         //std::string* signal_shape_h_file_{"/volatile/hallb/hps/mccarty/anaBhAp100.root"};
         std::string signal_shape_h_file_{""}; //!< The signal shpae histogram file path, if defined.
 
+        TFile* signal_shape_f_{nullptr}; //!< The signal shape histogram file, if defined.
+
         TH1* signal_shape_h_{nullptr}; //!< The signal shape histogram to use.
 
         double mass_hypo_{100.0}; //!< The signal hypothesis to use in the fit.
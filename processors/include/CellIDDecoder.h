@@ -0,0 +1,168 @@
+/**
+ * @file CellIDDecoder.h
+ * @brief Compile time decoders of the HPS detector cell IDs.
+ */
+
+#ifndef __CELLID_DECODER_H__
+#define __CELLID_DECODER_H__
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cstdint>
+
+/**
+ * Decoders of the cell IDs written by the HPS reconstruction. Each field
+ * mirrors the layout of the corresponding UTIL::BitField64 descriptor, but
+ * the shifts and masks are resolved at compile time so decoding a hit
+ * doesn't parse a descriptor or look up fields by name.
+ */
+namespace cellid {
+
+    /**
+     * @return The 64 bit cell ID built from its two 32 bit halves.
+     *
+     * @param cellID0 Lower 32 bits
+     * @param cellID1 Upper 32 bits
+     */
+    constexpr std::int64_t value(int cellID0, int cellID1) {
+        return std::int64_t((std::uint64_t(std::uint32_t(cellID1)) << 32) | std::uint32_t(cellID0));
+    }
+
+    /**
+     * A field of a cell ID. A negative width denotes a signed field, as in
+     * the BitField64 descriptors.
+     */
+    template <int Offset, int Width>
+        struct Field {
+            static constexpr int offset = Offset;
+            static constexpr int width = Width < 0 ? -Width : Width;
+            static constexpr bool is_signed = Width < 0;
+            static constexpr std::uint64_t mask = ((std::uint64_t(1) << width) - 1) << offset;
+
+            /** @return The value of the field in the given cell ID. */
+            static constexpr int decode(std::int64_t value) {
+                std::int64_t field = std::int64_t((std::uint64_t(value) & mask) >> offset);
+                if (is_signed && (field & (std::int64_t(1) << (width - 1))))
+                    field -= std::int64_t(1) << width;
+                return int(field);
+            }
+        };
+
+    /** Decoded SVT sensor/strip identifier. */
+    struct SvtID {
+        int system{0};
+        int barrel{0};
+        int layer{0};
+        int module{0};
+        int sensor{0};
+        int side{0};
+        int strip{0};
+    };
+
+    /** "system:6,barrel:3,layer:4,module:12,sensor:1,side:32:-2,strip:12" */
+    struct Svt {
+        typedef Field<0, 6>   system;
+        typedef Field<6, 3>   barrel;
+        typedef Field<9, 4>   layer;
+        typedef Field<13, 12> module;
+        typedef Field<25, 1>  sensor;
+        typedef Field<32, -2> side;
+        typedef Field<34, 12> strip;
+
+        /** @return All the fields of the given cell ID. */
+        static constexpr SvtID decode(std::int64_t value) {
+            SvtID id;
+            id.system = system::decode(value);
+            id.barrel = barrel::decode(value);
+            id.layer  = layer::decode(value);
+            id.module = module::decode(value);
+            id.sensor = sensor::decode(value);
+            id.side   = side::decode(value);
+            id.strip  = strip::decode(value);
+            return id;
+        }
+    };
+
+    /** Decoded ECal crystal identifier. */
+    struct EcalID {
+        int system{0};
+        int layer{0};
+        int ix{0};
+        int iy{0};
+    };
+
+    /** "system:6,layer:2,ix:-8,iy:-6" */
+    struct Ecal {
+        typedef Field<0, 6>   system;
+        typedef Field<6, 2>   layer;
+        typedef Field<8, -8>  ix;
+        typedef Field<16, -6> iy;
+
+        /** @return All the fields of the given cell ID. */
+        static constexpr EcalID decode(std::int64_t value) {
+            EcalID id;
+            id.system = system::decode(value);
+            id.layer  = layer::decode(value);
+            id.ix     = ix::decode(value);
+            id.iy     = iy::decode(value);
+            return id;
+        }
+    };
+
+    /** Decoded hodoscope tile identifier. */
+    struct HodoID {
+        int system{0};
+        int barrel{0};
+        int layer{0};
+        int ix{0};
+        int iy{0};
+        int hole{0};
+    };
+
+    /** "system:6,barrel:3,layer:4,ix:4,iy:-3,hole:-3" */
+    struct Hodo {
+        typedef Field<0, 6>   system;
+        typedef Field<6, 3>   barrel;
+        typedef Field<9, 4>   layer;
+        typedef Field<13, 4>  ix;
+        typedef Field<17, -3> iy;
+        typedef Field<20, -3> hole;
+
+        /** @return All the fields of the given cell ID. */
+        static constexpr HodoID decode(std::int64_t value) {
+            HodoID id;
+            id.system = system::decode(value);
+            id.barrel = barrel::decode(value);
+            id.layer  = layer::decode(value);
+            id.ix     = ix::decode(value);
+            id.iy     = iy::decode(value);
+            id.hole   = hole::decode(value);
+            return id;
+        }
+    };
+
+    // The layouts must match the BitField64 descriptors they replace.
+    static_assert(Svt::strip::mask == 0x3ffc00000000ULL && Svt::side::mask == 0x300000000ULL,
+            "SVT cell ID layout changed");
+    static_assert(Svt::decode(value(0x2a4a01, 0x191)).layer == 5
+            && Svt::decode(value(0x2a4a01, 0x191)).module == 0x152
+            && Svt::decode(value(0x2a4a01, 0x191)).side == 1
+            && Svt::decode(value(0x2a4a01, 0x191)).strip == 100
+            && Svt::decode(value(0x2a4a01, 0x193)).side == -1,
+            "SVT cell ID decoding is wrong");
+    static_assert(Ecal::decode(value(0xfdf7c1, 0)).ix == -9 && Ecal::decode(value(0xfdf7c1, 0)).iy == -3
+            && Ecal::decode(value(0x050b01, 0)).ix == 11 && Ecal::decode(value(0x050b01, 0)).iy == 5,
+            "ECal cell ID decoding is wrong");
+    static_assert(Hodo::ix::mask == 0x1e000ULL && Hodo::hole::mask == 0x700000ULL,
+            "Hodoscope cell ID layout changed");
+    static_assert(Hodo::decode(value(0x6e8681, 0)).barrel == 2 && Hodo::decode(value(0x6e8681, 0)).layer == 3
+            && Hodo::decode(value(0x6e8681, 0)).ix == 4 && Hodo::decode(value(0x6e8681, 0)).iy == -1
+            && Hodo::decode(value(0x6e8681, 0)).hole == -2
+            && Hodo::decode(value(0x132201, 0)).ix == 9 && Hodo::decode(value(0x132201, 0)).iy == 1
+            && Hodo::decode(value(0x132201, 0)).hole == 1,
+            "Hodoscope cell ID decoding is wrong");
+
+} // cellid
+
+#endif // __CELLID_DECODER_H__
@@ -82,11 +82,15 @@ class ClusterOnTrackAnaProcessor : public Processor {
 
         std::vector<Track*> *tracks_{}; //!< Containers for adding to the TTree
         TBranch*      btracks_{nullptr}; //!< description
-        std::vector<TrackerHit*> hits_{}; //!< description
+        std::vector<TrackerHit*> *hits_{}; //!< hits on track, used for index based references
         TBranch*      bhits_{nullptr}; //!< description
+        std::vector<RawSvtHit*> *rawHits_{}; //!< raw hits of the hits on track, used for index based references
+        TBranch*      brawHits_{nullptr}; //!< description
 
         std::string anaName_{"hitsOnTrack_2D"}; //!< description
         std::string trkColl_{"GBLTracks"}; //!< description
+        std::string hitColl_{""}; //!< hits on track collection, defaults to the one recorded for index based references
+        std::string rawHitColl_{""}; //!< raw hit collection, defaults to the one recorded for index based references
         std::string baselineFits_{""}; //!< description
         std::string baselineRun_{""}; //!< description
 
@@ -19,7 +19,6 @@
 #include <EVENT/CalorimeterHit.h>
 #include <IMPL/CalorimeterHitImpl.h>
 #include <IMPL/ClusterImpl.h>
-#include <UTIL/BitField64.h>
 
 //----------//
 //   ROOT   //
@@ -31,6 +30,7 @@
 //-----------//
 #include "CalCluster.h"
 #include "CalHit.h"
+#include "CellIDDecoder.h"
 #include "Collections.h"
 #include "Processor.h"
 
@@ -89,15 +89,6 @@ class ECalDataProcessor : public Processor {
 
     private: 
 
-        /**
-         * @brief Method to unpack field value from a calorimeter hit ID.
-         * 
-         * @param field The field ID to unpack
-         * @param hit The CalorimeterHit whose ID will be used to unpack the 
-         *            the field value. 
-         */
-        UTIL::BitFieldValue getIdentifierFieldValue(std::string field, EVENT::CalorimeterHit* hit);
-
         /** TClonesArray collection containing all ECal hits. */ 
         std::vector<CalHit*> cal_hits_; 
         std::string hitCollLcio_{"EcalCalHits"}; //!< description
@@ -108,9 +99,6 @@ class ECalDataProcessor : public Processor {
         std::string clusCollLcio_{"EcalClustersCorr"}; //!< description
         std::string clusCollRoot_{"RecoEcalClusters"}; //!< description
 
-        /** Encoding string describing cell ID. */
-        const std::string encoder_string_{"system:6,layer:2,ix:-8,iy:-6"};
-
         int debug_{0}; //!< Debug Level
 
 }; // ECalDataProcessor
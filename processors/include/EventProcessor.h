@@ -101,11 +101,16 @@ class EventProcessor : public Processor {
         VTPData* vtpData{nullptr};
         std::string vtpCollLcio_{"VTPBank"}; //!< description
         std::string vtpCollRoot_{"VTPBank"}; //!< description
+        int vtpCollID_{-1}; //!< ID of vtpCollLcio_, from Event::getLCCollectionID
+        int vtpSubBanks_{VTPData::ALL_SUB_BANKS}; //!< VTP sub-banks to decode, a mask of VTPData::SubBank
+        int vtpRawWords_{0}; //!< also write the raw VTP words, which can be decoded when reading
+        std::vector<int> vtpWords_; //!< VTP words of the event
 
         /** Containers for ts data */
         TSData* tsData{nullptr};
         std::string tsCollLcio_{"TSBank"}; //!< description
         std::string tsCollRoot_{"TSBank"}; //!< description
+        int tsCollID_{-1}; //!< ID of tsCollLcio_, from Event::getLCCollectionID
 
         /** Parsing method */
         void parseVTPData(EVENT::LCGenericObject* vtp_data_lcio);
@@ -100,9 +100,15 @@ class FinalStateParticleProcessor : public Processor {
         std::string kinkRelCollLcio_{"GBLKinkDataRelations"}; //!< description
         std::string trkRelCollLcio_{"TrackDataRelations"}; //!< description
         std::string hitFitsCollLcio_{"SVTFittedRawTrackerHits"};
+
+        int kinkRelCollID_{-1}; //!< Event::getLCCollectionID of kinkRelCollLcio_
+        int trkRelCollID_{-1}; //!< Event::getLCCollectionID of trkRelCollLcio_
+        int hitFitsCollID_{-1}; //!< Event::getLCCollectionID of hitFitsCollLcio_
         
         int debug_{0}; //!< Debug Level
 
+        int useIndexRefs_{0}; //!< Reference hits by index in their collection instead of TRef
+
 }; // FinalStateParticleProcessor
 
 #endif // __FINALSTATEPARTICLE_PROCESSOR_H__
@@ -13,6 +13,7 @@
 #include "Processor.h"
 #include "HodoHit.h"
 #include "HodoCluster.h"
+#include "CellIDDecoder.h"
 
 //----------//
 //   LCIO   //
@@ -22,7 +23,6 @@
 #include "IMPL/LCGenericObjectImpl.h"
 #include "IMPL/CalorimeterHitImpl.h"
 #include "IMPL/ClusterImpl.h"
-#include "UTIL/BitField64.h"
 
 // Forward declarations
 class TTree;
@@ -85,27 +85,12 @@ class HodoDataProcessor : public Processor {
       
     // private:
       
-        /**
-         * @brief Method to unpack field value from a hodoscope hit ID from the ID string.
-         * 
-         * The string itself comes from the detector description (in hps-java/detector-data/...),
-         * and should be identical to that one.
-         *
-         * @param field The field ID to unpack
-         * @param hit The CalorimeterHit whose ID will be used to unpack the
-         *            the field value.
-         */
-        UTIL::BitFieldValue getIdentifierFieldValue(std::string field, EVENT::CalorimeterHit* hit);
-        
         /** vector containing all ECal hits. */
         std::vector<HodoHit*> hits_;
         
         /** vector containing all ECal clusters. */
         std::vector<HodoCluster*> clusters_;
         
-        /** Encoding string describing cell ID. */
-        const std::string encoder_string_{"system:6,barrel:3,layer:4,ix:4,iy:-3,hole:-3"};
-        
         /** 
          * Configurable parameters.
          * Defaults are passed to the "configure" step, so can be set here as defaults.
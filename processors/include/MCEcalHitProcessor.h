@@ -33,6 +33,7 @@
 #include "Collections.h"
 #include "Processor.h"
 #include "MCEcalHit.h"
+#include "CellIDDecoder.h"
 #include "Event.h"
 
 /**
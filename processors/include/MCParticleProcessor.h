@@ -13,6 +13,7 @@
 //----------------//
 #include <iostream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -95,6 +96,12 @@ class MCParticleProcessor : public Processor {
         std::string mcPartCollLcio_{"MCParticle"}; //!< description
         std::string mcPartCollRoot_{"MCParticle"}; //!< description
 
+        /** Daughter indices of all the particles, each particle refers to a contiguous range */
+        std::vector<int> mc_daughters_{}; 
+        /** Index of the LCIO particles of the current event */
+        std::unordered_map<const EVENT::MCParticle*, int> lc_indices_{}; 
+        int writeGenealogy_{1}; //!< Write the mother and daughter indices of the particles
+
         int debug_{0}; //!< Debug level
 
 
@@ -28,6 +28,7 @@
 #include "Collections.h"
 #include "Processor.h"
 #include "MCTrackerHit.h"
+#include "CellIDDecoder.h"
 #include "Event.h"
 
 /**
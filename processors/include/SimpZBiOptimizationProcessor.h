@@ -149,6 +149,7 @@ class SimpZBiOptimizationProcessor : public Processor {
         std::string signal_pdgid_{""}; //<! description
         TH1F* signalSimZ_h_{nullptr}; //<! description
         SimpAnaTTree* signalMTT_{nullptr}; //<! description
+        std::string tupleKey_{""}; //<! inputs the mutable tuples were built from
         double signal_sf_ = 1.0; //<! description
         double signal_mass_; //<! description
         double logEps2_; //<! description
@@ -17,6 +17,8 @@
 #include <sstream>
 #include <memory>
 #include <vector>
+#include <future>
+#include <algorithm>
 
 //----------//
 //   LCIO   //
@@ -100,10 +102,36 @@ class StdhepMCParticleProcessor : public Processor {
 
 
     private: 
+        /**
+         * @brief Buffers of a batch of converted events. The MCParticles 
+         *        are reused from batch to batch.
+         */
+        struct EventBatch {
+            std::vector<std::vector<MCParticle*>> events; //!< particle buffers of each event
+            std::vector<int> nparts; //!< number of particles of each event
+            int nevents{0}; //!< number of events in the batch
+            bool end{false}; //!< true if the input ended with this batch
+        };
+
+        /**
+         * @brief Read the next batch of events from the stdhep file
+         * 
+         * @param rdr stdhep reader
+         * @param batch batch to fill
+         * @param count number of the next event, incremented for each event read
+         */
+        void readBatch(UTIL::LCStdHepRdr& rdr, EventBatch& batch, int& count);
+
+        /**
+         * @brief Copy a LCIO MCParticle into a MCParticle
+         */
+        void fillParticle(MCParticle* particle, IMPL::MCParticleImpl* lc_particle);
+
         std::string inFilename_; //!< stdhep input file
         std::string mcPartCollStdhep_{"MCParticle"}; //!< name temporary lcio collection
         int maxEvent_{-1}; //!< max stdhep event number to convert
         int skipEvent_{0};//!< skipped event numbers to convet
+        int batchSize_{1000}; //!< number of events read ahead on the reader thread
         TFile* outF_{nullptr}; //!< root tuple outfile
         std::string mcPartCollRoot_{"MCParticle"}; //!< name root collection
         std::vector<MCParticle*> mc_particles_{}; //!< list of converted MCParticles
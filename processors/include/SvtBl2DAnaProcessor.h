@@ -4,8 +4,10 @@
 //HPSTR
 #include "HpsEvent.h"
 #include "RawSvtHit.h"
+#include "RawSvtHitArrays.h"
 #include "ModuleMapper.h"
 #include "TSData.h"
+#include "TriggerSelection.h"
 
 //ROOT
 #include "Svt2DBlHistos.h"
@@ -74,16 +76,21 @@ class SvtBl2DAnaProcessor : public Processor {
         std::string rawSvtHitsColl_{"SVTRawTrackerHits"}; //!< description
         std::vector<RawSvtHit*>* rawSvtHits_{}; //!< description
         TBranch* brawSvtHits_{nullptr}; //!< description
+        RawSvtHitArrays rawSvtHitArrays_; //!< raw hits read from flat arrays
+        int flatRawHits_{0}; //!< read the raw hits written by SvtRawDataProcessor with flatOutput
+        int nThreads_{1}; //!< threads filling the baseline histograms, 0 to use all the cores
+        int lazyRawHits_{0}; //!< read the raw hits only for selected events. Disables their branches for other processors
         TTree* tree_; //!< description
 
         std::string triggerFilename_; //!< trigger selection
-        json        triggers_; //!< description
+        TriggerSelection triggerSelection_; //!< triggers to accept
+        int triggerUseStatus_{0}; //!< skip the triggers with status 0 in the trigger selection
+        int acceptAllTriggers_{0}; //!< accept all events when no trigger selection is given
         std::string triggerBankColl_{"TSBank"}; //!< description
 
         TBranch* btriggerBank_{nullptr}; //!< description
         TObject* triggerBank_{}; //!< description
-        std::map<std::string, bool> prescaledtriggerMap_; //!< description
-        std::map<std::string, bool> exttriggerMap_; //!< description
+        std::vector<TBranch*> hitBranches_; //!< raw hit branches, read only for selected events
 
         int debug_{0}; //!< Debug level
 
@@ -15,6 +15,7 @@
 #include "CalCluster.h"
 #include "Track.h"
 #include "TrackerHit.h"
+#include "StreamingStats.h"
 
 //#include <IMPL/TrackerHitImpl.h>"
 //ROOT
@@ -63,6 +64,25 @@ class SvtRawDataAnaProcessor : public Processor {
 
     private:
 
+        /** Summary of the hits passing a region selection, in constant memory whatever the run length */
+        struct RegionHitStats {
+            StatsArray<RunningMoments> t0{N_SVT_CHANNELS}; //!< hit time of each channel
+            StatsArray<RunningMoments> amp{N_SVT_CHANNELS}; //!< hit amplitude of each channel
+            StatsArray<BinnedCounts> hybridT0{N_SVT_HYBRIDS, BinnedCounts(200, -100., 100.)}; //!< hit time of each hybrid
+        };
+
+        /**
+         * Add a fit of a hit passing a region selection to the hit statistics.
+         *
+         * @param hit The raw hit
+         * @param region The region
+         * @param fit Index of the fit
+         */
+        void fillHitStats(RawSvtHit* hit, const std::string& region, int fit);
+
+        /** Write the per channel and per hybrid hit statistics of each region */
+        void writeHitStats() const;
+
         //Containers to hold histogrammer info
         RawSvtHitHistos* histos{nullptr};
         std::string  histCfgFilename_;
@@ -86,6 +106,8 @@ class SvtRawDataAnaProcessor : public Processor {
         TBranch* brecoClu_{nullptr};
         TBranch* bPart_{nullptr};
         TBranch* bTrk_{nullptr};
+        TBranch* bfspHits_{nullptr};
+        TBranch* bfspRawHits_{nullptr};
 
         TBranch* bevH_;
 
@@ -95,6 +117,10 @@ class SvtRawDataAnaProcessor : public Processor {
         std::vector<CalCluster*>* recoClu_{};
         std::vector<Track*>* Trk_{};
         std::vector<Particle*>* Part_{};
+        std::vector<TrackerHit*>* fspHits_{};
+        std::vector<RawSvtHit*>* fspRawHits_{};
+        std::string fspHitColl_{""}; //!< hits on track collection, defaults to the one recorded for index based references
+        std::string fspRawHitColl_{""}; //!< raw hit collection, defaults to the one recorded for index based references
         //std::vector<Track> Trk_{};
         EventHeader * evH_;
 
@@ -108,6 +134,9 @@ class SvtRawDataAnaProcessor : public Processor {
         std::string baselineFile_;
         std::string timeProfiles_;
         int tphase_{6};
+        std::string channelStatsFile_{""}; //!< csv file for the hit time and amplitude of each channel, none if empty
+        std::string hybridStatsFile_{""}; //!< csv file for the hit time median and quantiles of each hybrid, none if empty
+        std::map<std::string, std::unique_ptr<RegionHitStats>> hitStats_; //!< hit statistics of each region
 
         //Debug Level
         int debug_{0};
@@ -5,6 +5,7 @@
 //   C++  StdLib   //
 //-----------------//
 #include <iostream>
+#include <memory>
 #include <algorithm>
 #include <string>
 
@@ -29,6 +30,8 @@
 #include "Collections.h"
 #include "Processor.h"
 #include "RawSvtHit.h"
+#include "RawSvtHitArrays.h"
+#include "CellIDDecoder.h"
 #include "Event.h"
 
 class TTree; 
@@ -77,11 +80,25 @@ class SvtRawDataProcessor : public Processor {
         virtual void finalize();
 
     private: 
+        /**
+         * @brief Fill the flat arrays of raw hits in a single pass over the 
+         *        collection, without creating a RawSvtHit per hit.
+         * 
+         * @param raw_svt_hits LCIO raw hits
+         * @param fits_nav navigator of the hit fits, nullptr if not available
+         * @param decoder if given, the decoded cellids are checked against it
+         */
+        void fillArrays(EVENT::LCCollection* raw_svt_hits, 
+                UTIL::LCRelationNavigator* fits_nav, UTIL::BitField64* decoder);
+
         std::vector<RawSvtHit*> rawhits_; //!< Container to hold all TrackerHit objects.
+        RawSvtHitArrays rawhitArrays_; //!< Raw hits written as flat arrays if flatOutput_ is set
         std::string hitCollLcio_{"SVTRawTrackerHits"}; //!< collection name
         std::string hitfitCollLcio_{"SVTFittedRawTrackerHits"}; //!< collection name
+        int hitfitCollID_{-1}; //!< Event::getLCCollectionID of hitfitCollLcio_
         std::string hitCollRoot_{"SVTRawTrackerHits"}; //!< collection name
         
+        int flatOutput_{0}; //!< Write the raw hits as flat arrays "<hitCollRoot>_<field>" instead of RawSvtHit objects
         int debug_{0}; //!< Debug Level
 
 }; // SvtRawDataProcessor
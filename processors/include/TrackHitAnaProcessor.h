@@ -82,6 +82,11 @@ class TrackHitAnaProcessor : public Processor {
 
         std::string trkCollName_; //!< Track Collection name
 
+        /** Container to hold the hits on track, used for index based references. */
+        std::vector<TrackerHit*>* hits_{};
+        TBranch* bhits_{nullptr}; //!< description
+        std::string hitCollName_{""}; //!< Hits on track Collection name, defaults to the one recorded for index based references
+
         // Track Selector configuration
         std::string selectionCfg_;
         std::shared_ptr<BaseSelector> trkSelector_; //!< description
@@ -85,6 +85,9 @@ class Tracker2DHitProcessor : public Processor {
 
         std::string mcPartRelLcio_{"RotatedHelicalTrackMCRelations"};
 
+        int hitFitCollID_{-1}; //!< Event::getLCCollectionID of hitFitCollLcio_
+        int mcPartRelID_{-1}; //!< Event::getLCCollectionID of mcPartRelLcio_
+
         //Debug Level
         int debug_{0};
 
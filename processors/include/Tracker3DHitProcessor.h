@@ -84,6 +84,7 @@ class Tracker3DHitProcessor : public Processor {
         std::string hitCollRoot_{"RotatedHelicalTrackHits"}; //!< description
 
         std::string mcPartRelLcio_{"RotatedHelicalTrackMCRelations"}; //!< description
+        int mcPartRelID_{-1}; //!< Event::getLCCollectionID of mcPartRelLcio_
 
         int debug_{0}; //!< Debug Level
 
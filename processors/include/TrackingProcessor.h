@@ -114,6 +114,8 @@ class TrackingProcessor : public Processor {
         std::string trackStateLocation_{""}; //!< Specify track state used for track collection DEFAULT AtIP
         
         int debug_{false}; //!< Debug Level
+
+        int useIndexRefs_{0}; //!< Reference hits by index in their collection instead of TRef
         
         int doResiduals_{0}; //!< do Residuals
         std::string trackResDataLcio_{""}; //!< description
@@ -121,6 +123,12 @@ class TrackingProcessor : public Processor {
         std::string resCfgFilename_{""}; //!< description
         std::string resoutname_{""}; //!< description
 
+        int kinkRelCollID_{-1}; //!< Event::getLCCollectionID of kinkRelCollLcio_
+        int trkRelCollID_{-1}; //!< Event::getLCCollectionID of trkRelCollLcio_
+        int hitFitsCollID_{-1}; //!< Event::getLCCollectionID of hitFitsCollLcio_
+        int truthTracksCollID_{-1}; //!< Event::getLCCollectionID of truthTracksCollLcio_
+        int trackResDataID_{-1}; //!< Event::getLCCollectionID of trackResDataLcio_
+
         double bfield_{-1.}; //!< magnetic field
 
 }; // Tracking Processor
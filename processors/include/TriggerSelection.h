@@ -0,0 +1,123 @@
+/**
+ * @file  TriggerSelection.h
+ * @brief Selection of events from the bits of the trigger supervisor bank
+ */
+
+#ifndef TRIGGERSELECTION_H
+#define TRIGGERSELECTION_H
+
+#include <cstdint>
+#include <string>
+
+// HPSTR
+#include "TSData.h"
+#include "json.hpp"
+
+// for convenience
+using json = nlohmann::json;
+
+/**
+ * @brief Selection of events on the TS trigger bits, compiled once into a
+ *        bit mask.
+ *
+ * The trigger configuration lists the triggers to accept, by the names of
+ * the TSData::tsBits fields, e.g. analysis/selections/triggerSelection.json.
+ * Each entry may set "bits" to "prescaled" or "ext" to only accept one of
+ * the two words; both are accepted by default. An event passes if any
+ * accepted bit is set, which costs a single AND per event.
+ *
+ * As by the former trigger maps of SvtBl2DAnaProcessor, the "status" of
+ * the entries is ignored and a selection with no configuration loaded
+ * rejects all events. setUseStatus(true) skips the entries with "status"
+ * 0 and setAcceptAll(true) makes an empty selection accept all events.
+ */
+class TriggerSelection {
+
+    public:
+        /** Number of trigger bits in a TS word */
+        static const int N_TRIGGER_BITS = 20;
+
+        TriggerSelection() {}
+
+        /**
+         * @brief Constructor
+         *
+         * @param cfgFile Trigger configuration file
+         */
+        TriggerSelection(const std::string& cfgFile) { load(cfgFile); }
+
+        /**
+         * @brief Skip the triggers with "status" 0 in the next loaded
+         *        configuration. Off by default.
+         *
+         * @param useStatus True to honour the status of the triggers
+         */
+        void setUseStatus(bool useStatus) { useStatus_ = useStatus; }
+
+        /**
+         * @brief Accept all events while no configuration is loaded. Off by
+         *        default, when an empty selection rejects all events.
+         *
+         * @param acceptAll True to accept all events without a configuration
+         */
+        void setAcceptAll(bool acceptAll) { acceptAll_ = acceptAll; }
+
+        /**
+         * @brief Load the triggers to accept from a configuration file
+         *
+         * @param cfgFile Trigger configuration file
+         */
+        void load(const std::string& cfgFile);
+
+        /**
+         * @brief Load the triggers to accept from a parsed configuration
+         *
+         * @param triggers Trigger configuration
+         */
+        void load(const json& triggers);
+
+        /**
+         * @brief Check the trigger bits of an event
+         *
+         * @param tsdata The TS bank of the event
+         * @return true if the event fired an accepted trigger, or if the
+         *         selection is empty and accepts all events
+         */
+        bool pass(const TSData* tsdata) const {
+            std::uint64_t word = (std::uint64_t(std::uint32_t(tsdata->ext.intval)) << 32)
+                | std::uint32_t(tsdata->prescaled.intval);
+            return (word & mask_) != 0 || (!loaded_ && acceptAll_);
+        }
+
+        /** @return true if no trigger configuration was loaded */
+        bool empty() const { return !loaded_; }
+
+        /** @return Accepted bits of the prescaled word */
+        std::uint32_t getPrescaledMask() const { return std::uint32_t(mask_); }
+
+        /** @return Accepted bits of the ext word */
+        std::uint32_t getExtMask() const { return std::uint32_t(mask_ >> 32); }
+
+        /**
+         * @brief Get the bit of a trigger in the TS words
+         *
+         * @param name Name of the trigger. Surrounding spaces are ignored.
+         * @return The bit, or -1 if there is no such trigger
+         */
+        static int getBit(const std::string& name);
+
+    private:
+        /** Accepted bits: prescaled word in the low 32 bits, ext word in the high ones */
+        std::uint64_t mask_{0};
+
+        /** True once a trigger configuration was loaded */
+        bool loaded_{false};
+
+        /** Skip the triggers with "status" 0 */
+        bool useStatus_{false};
+
+        /** Accept all events while no configuration is loaded */
+        bool acceptAll_{false};
+};
+
+#endif
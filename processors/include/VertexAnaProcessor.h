@@ -19,6 +19,9 @@
 
 #include "FlatTupleMaker.h"
 #include "AnaHelpers.h"
+#include "MCGenealogy.h"
+#include "MCTruthIndex.h"
+#include "VertexCandidate.h"
 
 // ROOT
 #include "TFile.h"
@@ -85,6 +88,17 @@ class VertexAnaProcessor : public Processor {
         virtual void configure(const ParameterSet& parameters);
 
     private:
+        /**
+         * @brief Apply the vertex preselection cuts shared by the 
+         *        preselection and the regions.
+         * 
+         * @param selector Selector holding the cuts
+         * @param cand The vertex and its precomputed variables
+         * @param weight 
+         * @return true if the vertex passes the cuts
+         */
+        bool passVertexPreselection(BaseSelector& selector, const VertexCandidate& cand, double weight);
+
         std::shared_ptr<BaseSelector> vtxSelector; //!< description
         std::vector<std::string> regionSelections_; //!< description
 
@@ -93,8 +107,10 @@ class VertexAnaProcessor : public Processor {
         TBranch* bts_{nullptr}; //!< description
         TBranch* bvtxs_{nullptr}; //!< description
         TBranch* bhits_{nullptr}; //!< description
+        TBranch* bparts_{nullptr}; //!< description
         TBranch* btrks_{nullptr}; //!< description
         TBranch* bmcParts_{nullptr}; //!< description
+        TBranch* bmcDaughters_{nullptr}; //!< description
         TBranch* bevth_{nullptr}; //!< description
         TBranch* becal_{nullptr}; //!< description
 
@@ -104,12 +120,17 @@ class VertexAnaProcessor : public Processor {
         std::vector<Vertex*>* vtxs_{}; //!< description
         std::vector<Track*>* trks_{}; //!< description
         std::vector<TrackerHit*>* hits_{}; //!< description
+        std::vector<Particle*>* parts_{}; //!< particles of the vertices, used for index based references
         std::vector<MCParticle*>* mcParts_{}; //!< description
+        std::vector<int>* mcDaughters_{}; //!< daughter indices of the MC particles
+        MCTruthIndex truthIndex_; //!< MC truth of the hits of the current event
+        MCGenealogy mcGenealogy_; //!< MC particles by ID and PDG of the current event
 
         std::string anaName_{"vtxAna"}; //!< description
         std::string tsColl_{"TSBank"}; //!< description
         std::string vtxColl_{"Vertices"}; //!< description
         std::string hitColl_{"RotatedHelicalTrackHits"}; //!< description
+        std::string partColl_{""}; //!< particle collection of the vertices, defaults to the one recorded for index based references
         std::string trkColl_{"GBLTracks"}; //!< description
         std::string ecalColl_{"RecoEcalClusters"}; //!< description
         std::string mcColl_{"MCParticle"}; //!< description
@@ -126,6 +147,91 @@ class VertexAnaProcessor : public Processor {
         std::map<std::string, std::shared_ptr<MCAnaHistos>> _reg_mc_vtx_histos; //!< description
         std::map<std::string, std::shared_ptr<FlatTupleMaker>> _reg_tuples; //!< description
 
+        /**
+         * @struct VertexTupleSlots
+         * @brief Columns of the per-region vertex flat tuple.
+         */
+        struct VertexTupleSlots {
+            FlatTupleMaker::Slot<double> unc_vtx_mass;
+            FlatTupleMaker::Slot<double> unc_vtx_z;
+            FlatTupleMaker::Slot<double> unc_vtx_chi2;
+            FlatTupleMaker::Slot<double> unc_vtx_psum;
+            FlatTupleMaker::Slot<double> unc_vtx_px;
+            FlatTupleMaker::Slot<double> unc_vtx_py;
+            FlatTupleMaker::Slot<double> unc_vtx_pz;
+            FlatTupleMaker::Slot<double> unc_vtx_x;
+            FlatTupleMaker::Slot<double> unc_vtx_y;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_pos_clus_dt;
+            FlatTupleMaker::Slot<double> run_number;
+            FlatTupleMaker::Slot<double> unc_vtx_cxx;
+            FlatTupleMaker::Slot<double> unc_vtx_cyy;
+            FlatTupleMaker::Slot<double> unc_vtx_czz;
+            FlatTupleMaker::Slot<double> unc_vtx_cyx;
+            FlatTupleMaker::Slot<double> unc_vtx_czy;
+            FlatTupleMaker::Slot<double> unc_vtx_czx;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_p;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_t;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_d0;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_phi0;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_omega;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_tanLambda;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_z0;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_chi2ndf;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_clust_dt;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_z0Err;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_d0Err;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_tanLambdaErr;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_PhiErr;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_OmegaErr;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_L1_isolation;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_nhits;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_x;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_y;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_z;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_px;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_py;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_track_pz;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_clust_dt;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_p;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_t;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_d0;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_phi0;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_omega;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_tanLambda;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_z0;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_chi2ndf;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_z0Err;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_d0Err;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_tanLambdaErr;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_PhiErr;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_OmegaErr;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_L1_isolation;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_nhits;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_x;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_y;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_z;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_px;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_py;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_track_pz;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_clust_E;
+            FlatTupleMaker::Slot<double> unc_vtx_ele_clust_corr_t;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_clust_E;
+            FlatTupleMaker::Slot<double> unc_vtx_pos_clust_corr_t;
+            FlatTupleMaker::Slot<double> true_vtx_z;
+            FlatTupleMaker::Slot<double> true_vtx_mass;
+            FlatTupleMaker::Slot<double> ap_true_vtx_z;
+            FlatTupleMaker::Slot<double> ap_true_vtx_mass;
+            FlatTupleMaker::Slot<double> ap_true_vtx_energy;
+            FlatTupleMaker::Slot<double> vd_true_vtx_z;
+            FlatTupleMaker::Slot<double> vd_true_vtx_mass;
+            FlatTupleMaker::Slot<double> vd_true_vtx_energy;
+            FlatTupleMaker::Slot<double> hitCode;
+            FlatTupleMaker::Slot<double> L1hitCode;
+            FlatTupleMaker::Slot<double> L2hitCode;
+        };
+
+        std::map<std::string, VertexTupleSlots> _reg_tuple_slots; //!< columns of the flat tuple of each region
+
         std::vector<std::string> _regions; //!< description
 
         typedef std::map<std::string, std::shared_ptr<TrackHistos>>::iterator reg_it; //!< description
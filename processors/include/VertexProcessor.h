@@ -84,10 +84,14 @@ class VertexProcessor : public Processor {
         std::string partCollRoot_{"ParticlesOnVertices"}; //!< description
         std::string kinkRelCollLcio_{"GBLKinkDataRelations"}; //!< description
         std::string trkRelCollLcio_{"TrackDataRelations"}; //!< description
+        int kinkRelCollID_{-1}; //!< Event::getLCCollectionID of kinkRelCollLcio_
+        int trkRelCollID_{-1}; //!< Event::getLCCollectionID of trkRelCollLcio_
         std::string trackStateLocation_{""}; //!< select track state for tracks DEFAULT AtIP
 
         int debug_{0}; //!< Debug Level
 
+        int useIndexRefs_{0}; //!< Reference daughters by index in their collection instead of TRef
+
 }; // VertexProcessor
 
 #endif // __VERTEX_PROCESSOR_H__
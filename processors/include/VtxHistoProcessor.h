@@ -84,6 +84,8 @@ class VtxHistoProcessor : public Processor {
 
         int debug_{0}; //!< Debug Level
         int rebin_{1}; //!< Rebin factor
+        int nThreads_{1}; //!< 1 fits the projections with ROOT, other values with the slice fitter on that many threads, 0 to use all the cores
+        double fastFitEntries_{0.}; //!< Slice fitter projections with more entries are fitted in closed form, 0 to disable
 
         std::vector<std::string> selections_{}; //!< Selection folder
         std::vector<std::string> projections_; //!< 2D histos to project
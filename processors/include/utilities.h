@@ -28,6 +28,9 @@
 #include "Track.h"
 #include "Vertex.h"
 #include "RawSvtHit.h"
+#include "MCTruthIndex.h"
+#include "LCConversionCache.h"
+#include "CellIDDecoder.h"
 #include "CalCluster.h"
 #include "CalHit.h"
 #include "Event.h"
@@ -63,12 +66,14 @@ namespace utils {
      * @param lc_particle 
      * @param gbl_kink_data 
      * @param track_data 
+     * @param cache if given, the track and cluster conversions of the event are reused
      * @return Particle* 
      */
     Particle* buildParticle(EVENT::ReconstructedParticle* lc_particle, 
                             std::string trackstate_location,
                             EVENT::LCCollection* gbl_kink_data,
-                            EVENT::LCCollection* track_data);
+                            EVENT::LCCollection* track_data,
+                            LCConversionCache* cache = nullptr);
 
     /**
      * @brief description
@@ -76,12 +81,31 @@ namespace utils {
      * @param lc_track 
      * @param gbl_kink_data 
      * @param track_data 
+     * @param cache if given, the relation navigators of the event are reused
      * @return Track* 
      */
     Track* buildTrack(EVENT::Track* lc_track, 
                       std::string trackstate_location,
                       EVENT::LCCollection* gbl_kink_data, 
-                      EVENT::LCCollection* track_data);
+                      EVENT::LCCollection* track_data,
+                      LCConversionCache* cache = nullptr);
+
+    /**
+     * @brief Get the conversion of a LCIO track in the current event, 
+     *        converting it on first use. The track is owned by the cache.
+     * 
+     * @param lc_track 
+     * @param trackstate_location 
+     * @param gbl_kink_data 
+     * @param track_data 
+     * @param cache conversion cache of the event
+     * @return Track* 
+     */
+    Track* getTrack(EVENT::Track* lc_track, 
+                    std::string trackstate_location,
+                    EVENT::LCCollection* gbl_kink_data, 
+                    EVENT::LCCollection* track_data,
+                    LCConversionCache& cache);
 
 
     /**
@@ -115,6 +139,16 @@ namespace utils {
      */
     CalCluster* buildCalCluster(EVENT::Cluster* lc_cluster);
 
+    /**
+     * @brief Get the conversion of a LCIO cluster in the current event, 
+     *        converting it on first use. The cluster is owned by the cache.
+     * 
+     * @param lc_cluster 
+     * @param cache conversion cache of the event
+     * @return CalCluster* 
+     */
+    CalCluster* getCalCluster(EVENT::Cluster* lc_cluster, LCConversionCache& cache);
+
     /**
      * @brief description
      * 
@@ -123,13 +157,18 @@ namespace utils {
      * @param raw_svt_fits 
      * @param rawHits 
      * @param type 
+     * @param storeRawHit 
+     * @param rawHitOffset If non negative, the raw hits are referenced by their 
+     *                     index (rawHitOffset + position in rawHits) in the output 
+     *                     raw hit collection instead of by TRef.
      * @return true 
      * @return false 
      */
     bool addRawInfoTo3dHit(TrackerHit* tracker_hit,
                            IMPL::TrackerHitImpl* lc_tracker_hit,
                            EVENT::LCCollection* raw_svt_fits,
-                           std::vector<RawSvtHit*>* rawHits = nullptr, int type = 0, bool storeRawHit = true);
+                           std::vector<RawSvtHit*>* rawHits = nullptr, int type = 0, bool storeRawHit = true,
+                           int rawHitOffset = -1);
 
 
     /**
@@ -160,24 +199,34 @@ namespace utils {
      * @param vtx 
      * @param ele 
      * @param pos 
+     * @param parts Particle collection used to resolve index based particle references
      * @return true 
      * @return false 
      */
-    bool getParticlesFromVertex(Vertex* vtx, Particle* ele, Particle* pos);
+    bool getParticlesFromVertex(Vertex* vtx, Particle* ele, Particle* pos, 
+                                const std::vector<Particle*>* parts = nullptr);
     
     /**
-     * @brief description
+     * @brief Check a SVT cellid decoded by cellid::Svt against the LCIO 
+     *        decoder. Throws a runtime_error if any field differs.
      * 
-     * \todo extern?
+     * @param decoder LCIO decoder of the SVT cellids
+     * @param value the cellid
+     * @param id the decoded cellid
      */
-    static UTIL::BitField64 decoder("system:6,barrel:3,layer:4,module:12,sensor:1,side:32:-2,strip:12");
+    void checkSvtCellID(UTIL::BitField64& decoder, EVENT::long64 value, const cellid::SvtID& id);
 
     /**
      * @brief description
      * 
      * \todo extern?
+     * 
+     * @param track 
+     * @param siClusters 
+     * @param hits TrackerHit collection used to resolve index based hit references
      */
-    double getKalmanTrackL1Isolations(Track* track, std::vector<TrackerHit*>* siClusters);
+    double getKalmanTrackL1Isolations(Track* track, std::vector<TrackerHit*>* siClusters,
+                                      const std::vector<TrackerHit*>* hits = nullptr);
 
     /**
      * @brief description
@@ -185,6 +234,19 @@ namespace utils {
      * \todo extern?
      */
     void get2016KFMCTruthHitCodes(Track* ele_trk, Track* pos_trk, std::vector<TrackerHit*>* hits, int& L1L2hitCode, int& L1hitCode, int& L2hitCode);
+
+    /**
+     * @brief Get the 2016 KF MC truth hit codes using a prebuilt truth index
+     * 
+     * @param ele_trk electron track
+     * @param pos_trk positron track
+     * @param hits tracker hits of the event
+     * @param truthIndex MC truth index of the event
+     * @param L1L2hitCode truth ax+ster hit code in L1 and L2 for ele and pos
+     * @param L1hitCode truth hit code of L1 ele and pos axial and stereo
+     * @param L2hitCode truth hit code of L2 ele and pos axial and stereo
+     */
+    void get2016KFMCTruthHitCodes(Track* ele_trk, Track* pos_trk, std::vector<TrackerHit*>* hits, const MCTruthIndex& truthIndex, int& L1L2hitCode, int& L1hitCode, int& L2hitCode);
 }
 
 #endif //UTILITIES
@@ -4,8 +4,59 @@
  * @author Cameron Bravo, SLAC National Accelerator Laboratory
  */     
 #include "Apv25RoXtalkAnaProcessor.h"
+#include "ParallelFor.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <fstream>
+#include <memory>
+
+namespace {
+
+    /** 
+     * Reads queued in the APV25 buffer, oldest first. Reads are queued in 
+     * time order, so they also expire from the front. The capacity only 
+     * grows until it holds the deepest buffer of the run.
+     */
+    class ReadBuffer {
+
+        public:
+            ReadBuffer() : times_(64), events_(64) {}
+
+            bool empty() const { return size_ == 0; }
+            long frontTime() const { return times_[head_]; }
+            long frontEvent() const { return events_[head_]; }
+            long backTime() const { return times_[(head_+size_-1) & (times_.size()-1)]; }
+
+            void pop() { 
+                head_ = (head_+1) & (times_.size()-1); 
+                --size_; 
+            }
+
+            void push(long time, long event) { 
+                if (size_ == times_.size()) 
+                    grow(); 
+                size_t tail = (head_+size_) & (times_.size()-1); 
+                times_[tail] = time; 
+                events_[tail] = event; 
+                ++size_; 
+            }
+
+        private:
+            void grow() { 
+                std::rotate(times_.begin(), times_.begin()+head_, times_.end()); 
+                std::rotate(events_.begin(), events_.begin()+head_, events_.end()); 
+                head_ = 0; 
+                times_.resize(2*times_.size()); 
+                events_.resize(2*events_.size()); 
+            }
+
+            std::vector<long> times_; //!< read times, capacity is a power of 2
+            std::vector<long> events_; //!< time of the event of each read
+            size_t head_{0}; //!< oldest read
+            size_t size_{0}; //!< number of queued reads
+    };
+}
 
 Apv25RoXtalkAnaProcessor::Apv25RoXtalkAnaProcessor(const std::string& name, Process& process) : Processor(name,process){}
 
@@ -22,6 +73,7 @@ void Apv25RoXtalkAnaProcessor::configure(const ParameterSet& parameters) {
         syncPhase_       = parameters.getInteger("syncPhase");
         trigPhase_       = syncPhase_%24;
         trigDel_         = parameters.getInteger("trigDel");
+        nThreads_        = parameters.getInteger("nThreads", nThreads_);
         histCfgFilename_ = parameters.getString("histCfg");
     }
     catch (std::runtime_error& error)
@@ -38,6 +90,16 @@ void Apv25RoXtalkAnaProcessor::initialize(TTree* tree) {
     // init TTree
     tree_->SetBranchAddress(rawHitColl_.c_str() , &rawHits_ , &brawHits_ );
     tree_->SetBranchAddress("EventHeader"       , &evth_    , &bevth_    );
+    // Filled while reading, kept out of the input file
+    hitN_h_ = new TH1D("hitN_h", "hitN_h;Raw SVT Hit Multi;Events/10", 500, 0, 5000);
+    lFEBN_h_ = new TH1D("lFEBN_h", "lFEBN_h;Raw SVT Hit Multi;Events/10", 500, 0, 5000);
+    hFEBN_h_ = new TH1D("hFEBN_h", "hFEBN_h;Raw SVT Hit Multi;Events/10", 500, 0, 5000);
+    FEBN_hh_ = new TH2D("FEBN_hh", "FEBN_hh", 500, 0, 2000, 500, 0, 2000);
+    hitN_h_->SetDirectory(nullptr);
+    lFEBN_h_->SetDirectory(nullptr);
+    hFEBN_h_->SetDirectory(nullptr);
+    FEBN_hh_->SetDirectory(nullptr);
+
     for (int i = 0; i < 210; i++)
     {
         //////////////////lFEBrms[i] = 0.0;
@@ -54,20 +116,22 @@ bool Apv25RoXtalkAnaProcessor::process(IEvent* ievent) {
     //std::cout << "[Apv25RoXtalkAnaProcessor] ModMap Test: " << modMap_->getStringFromHw("F1H2") << std::endl;
 
     eventTimes.push_back(evth_->getEventTime());
-    hitMultis.push_back(rawHits_->size());
     int lFEBMulti = 0;
     int hFEBMulti = 0;
     for (int i = 0; i < rawHits_->size(); i++)
     {
-        int lay = rawHits_->at(i)->getLayer();
-        int mod = rawHits_->at(i)->getModule();
-        int feb = std::atoi(&modMap_->getHwFromSw(
-                    "ly"+std::to_string(lay)+"_m"+std::to_string(mod)).at(1) );
+        int feb, hyb;
+        modMap_->getFebHybridFromSw(rawHits_->at(i)->getLayer(), rawHits_->at(i)->getModule(), feb, hyb);
         if (feb > 4) hFEBMulti++;
         else lFEBMulti++;
     }
-    lFEBMultis.push_back(lFEBMulti);
-    hFEBMultis.push_back(hFEBMulti);
+
+    // The multiplicities are only kept as histograms, and as the flags the buffer emulation needs
+    hitN_h_->Fill(rawHits_->size());
+    lFEBN_h_->Fill(lFEBMulti);
+    hFEBN_h_->Fill(hFEBMulti);
+    FEBN_hh_->Fill(hFEBMulti, lFEBMulti);
+    febFlags.push_back((lFEBMulti > 700 ? L_FEB_BUSY : 0) | (hFEBMulti > 300 ? H_FEB_BUSY : 0));
 
     return true;
 }
@@ -75,25 +139,27 @@ bool Apv25RoXtalkAnaProcessor::process(IEvent* ievent) {
 void Apv25RoXtalkAnaProcessor::finalize() {
 
     std::cout << "[Apv25RoXtalkAnaProcessor] Finalizing" << std::endl;
-    TH1D * hitN_h = new TH1D("hitN_h", "hitN_h;Raw SVT Hit Multi;Events/10", 500, 0, 5000);
-    TH1D * lFEBN_h = new TH1D("lFEBN_h", "lFEBN_h;Raw SVT Hit Multi;Events/10", 500, 0, 5000);
-    TH1D * hFEBN_h = new TH1D("hFEBN_h", "hFEBN_h;Raw SVT Hit Multi;Events/10", 500, 0, 5000);
-    TH2D * FEBN_hh = new TH2D("FEBN_hh", "FEBN_hh", 500, 0, 2000, 500, 0, 2000);
-    for (int i = 0; i < hitMultis.size(); i++)
-    {
-        hitN_h->Fill(hitMultis[i]);
-        lFEBN_h->Fill(lFEBMultis[i]);
-        hFEBN_h->Fill(hFEBMultis[i]);
-        FEBN_hh->Fill(hFEBMultis[i], lFEBMultis[i]);
-    }
     outF_->cd();
-    hitN_h->Write();
-    lFEBN_h->Write();
-    hFEBN_h->Write();
-    FEBN_hh->Write();
-    for(int sp = 0; sp < 840; sp += 4)
+    hitN_h_->Write();
+    lFEBN_h_->Write();
+    hFEBN_h_->Write();
+    FEBN_hh_->Write();
+    delete hitN_h_;
+    delete lFEBN_h_;
+    delete hFEBN_h_;
+    delete FEBN_hh_;
+    // The 210 sync phases only read the recorded events, so they are 
+    // emulated concurrently. Only the selected phases write histograms.
+    std::vector<BuffResult> results(210);
+    parallelFor(results.size(), nThreads_, [&](size_t i) {
+        results[i] = emulateApv25Buff(i*4, false);
+    });
+
+    for(int i = 0; i < 210; i++)
     {
-        emulateApv25Buff(sp);
+        lFEBrms[i] = results[i].rms[0];
+        hFEBrms[i] = results[i].rms[1];
+        sps[i] = (double)(i*4);
     }
 
     TGraph lFEBreadRms_g(210, sps, lFEBrms);
@@ -125,18 +191,18 @@ void Apv25RoXtalkAnaProcessor::finalize() {
     }
 
     std::cout << "lFEBmin: " << lFEBminI*4 << std::endl;
-    emulateApv25Buff(lFEBminI*4);
+    BuffResult lFEBbest = emulateApv25Buff(lFEBminI*4, true);
     int phase0 = (int)lFEBminI*4;
-    int cut0L = (int)lLowCut;
-    int cut0H = (int)lHighCut;
-    std::cout << "lLowCut: " << lLowCut << "  lHighCut: " << lHighCut << std::endl;
+    int cut0L = (int)lFEBbest.lowCut[0];
+    int cut0H = (int)lFEBbest.highCut[0];
+    std::cout << "lLowCut: " << lFEBbest.lowCut[0] << "  lHighCut: " << lFEBbest.highCut[0] << std::endl;
 
     std::cout << "hFEBmin: " << hFEBminI*4 << std::endl;
-    emulateApv25Buff(hFEBminI*4);
+    BuffResult hFEBbest = hFEBminI == lFEBminI ? lFEBbest : emulateApv25Buff(hFEBminI*4, true);
     int phase1 = (int)hFEBminI*4;
-    int cut1L = (int)hLowCut;
-    int cut1H = (int)hHighCut;
-    std::cout << "hLowCut: " << hLowCut << "  hHighCut: " << hHighCut << std::endl;
+    int cut1L = (int)hFEBbest.lowCut[1];
+    int cut1H = (int)hFEBbest.highCut[1];
+    std::cout << "hLowCut: " << hFEBbest.lowCut[1] << "  hHighCut: " << hFEBbest.highCut[1] << std::endl;
 
     std::ofstream calFile("calApvXtalk.txt");
     calFile << "trigDel,phase0,phase1,cut0L,cut0H,cut1L,cut1H\n";
@@ -151,85 +217,85 @@ void Apv25RoXtalkAnaProcessor::finalize() {
 
 }
 
-void Apv25RoXtalkAnaProcessor::emulateApv25Buff(int buffIter) {
-    reads.clear();
-    readEvs.clear();
-    TH1D readN_h(Form("readN_iter%i_h", buffIter), Form("readN_iter%i_h", buffIter), 21, -0.5, 20.5);
-    TH2D lFEBread_hh(Form("lFEBread_iter%i_hh", buffIter), ";Read Time minus Event Time [ns];Read Event Time mod 840", 500, -2000.0, 14000.0, 210, 0, 35*24);
-    TH1D lFEBread_h(Form("lFEBread_iter%i_h", buffIter), ";Read Time minus Event Time [ns];Events / 8 ns", 500, -2000.0, 2000.0);
-    TH2D hFEBread_hh(Form("hFEBread_iter%i_hh", buffIter), ";Read Time minus Event Time [ns];Read Event Time mod 840", 500, -2000.0, 14000.0, 210, 0, 35*24);
-    TH1D hFEBread_h(Form("hFEBread_iter%i_h", buffIter), ";Read Time minus Event Time [ns];Events / 8 ns", 500, -2000.0, 2000.0);
-    syncPhase_ = buffIter;
-    trigPhase_ = syncPhase_%24;
-    for (int iEv = 0; iEv < hitMultis.size(); iEv++)
+Apv25RoXtalkAnaProcessor::BuffResult Apv25RoXtalkAnaProcessor::emulateApv25Buff(int buffIter, bool writeHistos) const {
+    ReadBuffer reads;
+    BinnedCounts lFEBread(500, -2000.0, 2000.0);
+    BinnedCounts hFEBread(500, -2000.0, 2000.0);
+
+    // The 2D histograms are only needed for the written phases
+    std::unique_ptr<TH2D> lFEBread_hh;
+    std::unique_ptr<TH2D> hFEBread_hh;
+    if (writeHistos)
+    {
+        lFEBread_hh.reset(new TH2D(Form("lFEBread_iter%i_hh", buffIter), ";Read Time minus Event Time [ns];Read Event Time mod 840", 500, -2000.0, 14000.0, 210, 0, 35*24));
+        hFEBread_hh.reset(new TH2D(Form("hFEBread_iter%i_hh", buffIter), ";Read Time minus Event Time [ns];Read Event Time mod 840", 500, -2000.0, 14000.0, 210, 0, 35*24));
+    }
+
+    int syncPhase = buffIter;
+    int trigPhase = syncPhase%24;
+    for (int iEv = 0; iEv < eventTimes.size(); iEv++)
     {
         // Calculate the relevant times wrt this event
         long evTime = eventTimes[iEv];
-        long trigArrT = evTime + trigDel_ + (24 - (evTime+trigPhase_)%24);
-        long trigSyncTime = trigArrT + (35*24 - (trigArrT+syncPhase_)%(35*24));
+        long trigArrT = evTime + trigDel_ + (24 - (evTime+trigPhase)%24);
+        long trigSyncTime = trigArrT + (35*24 - (trigArrT+syncPhase)%(35*24));
 
         // Remove reads from buffer which are in the past wrt this event
-        for (int ir = reads.size() - 1; ir >= 0; ir--)
-        {
-            if ( reads[ir] < evTime - 840 )
-            {
-                reads.erase(reads.begin() + ir);
-                readEvs.erase(readEvs.begin() + ir);
-            }
-        }
-        int buffNstart = reads.size();
-        //std::cout << "reads before adding: " << reads.size() << std::endl;
-        for (int ss = 0; ss < 6; ss++)
+        while (!reads.empty() && reads.frontTime() < evTime - 840) reads.pop();
+
+        if (reads.empty() || reads.backTime() + 3360 <= trigSyncTime)
+            reads.push(trigSyncTime, evTime);
+        else
+            reads.push(reads.backTime() + 3360, evTime);
+        for (int ss = 1; ss < 6; ss++)
+            reads.push(reads.backTime() + 3360, evTime);
+
+        if (febFlags[iEv] & L_FEB_BUSY) 
         {
-            if (ss > 0)
-            {
-                reads.push_back(reads[reads.size()-1] + 3360);
-                readEvs.push_back(evTime);
-            }
-            else
-            {
-                if (buffNstart == 0)
-                {
-                    reads.push_back(trigSyncTime);
-                    readEvs.push_back(evTime);
-                }
-                else if (reads[reads.size()-1] + 3360 > trigSyncTime)
-                {
-                    reads.push_back(reads[reads.size()-1] + 3360);
-                    readEvs.push_back(evTime);
-                }
-                else
-                {
-                    reads.push_back(trigSyncTime);
-                    readEvs.push_back(evTime);
-                }
-            }
+            lFEBread.fill(reads.frontTime() - evTime);
+            if (writeHistos) lFEBread_hh->Fill(reads.frontTime() - evTime, reads.frontEvent()%(24*35));
         }
-        //std::cout << "reads after adding: " << reads.size() << std::endl;
-        //readN_h.Fill((double)reads.size());
-        if (lFEBMultis[iEv] > 700) 
+        if (febFlags[iEv] & H_FEB_BUSY) 
         {
-            lFEBread_h.Fill( reads[0] - evTime);
-            lFEBread_hh.Fill( reads[0] - evTime, readEvs[0]%(24*35) );
+            hFEBread.fill(reads.frontTime() - evTime);
+            if (writeHistos) hFEBread_hh->Fill(reads.frontTime() - evTime, reads.frontEvent()%(24*35));
         }
-        if (hFEBMultis[iEv] > 300) 
+    }
+
+    BuffResult result;
+    result.rms[0] = lFEBread.getRMS();
+    result.lowCut[0] = lFEBread.getBinCenter(lFEBread.findFirstBinAbove(5.0)) - 28.0;
+    result.highCut[0] = lFEBread.getBinCenter(lFEBread.findLastBinAbove(5.0)) + 28.0;
+    result.rms[1] = hFEBread.getRMS();
+    result.lowCut[1] = hFEBread.getBinCenter(hFEBread.findFirstBinAbove(5.0)) - 12.0;
+    result.highCut[1] = hFEBread.getBinCenter(hFEBread.findLastBinAbove(5.0)) + 12.0;
+
+    if (writeHistos)
+    {
+        TH1D readN_h(Form("readN_iter%i_h", buffIter), Form("readN_iter%i_h", buffIter), 21, -0.5, 20.5);
+        TH1D lFEBread_h(Form("lFEBread_iter%i_h", buffIter), ";Read Time minus Event Time [ns];Events / 8 ns", 500, -2000.0, 2000.0);
+        TH1D hFEBread_h(Form("hFEBread_iter%i_h", buffIter), ";Read Time minus Event Time [ns];Events / 8 ns", 500, -2000.0, 2000.0);
+        for (int bin = 0; bin < lFEBread.getNbins()+2; bin++)
         {
-            hFEBread_h.Fill( reads[0] - evTime);
-            hFEBread_hh.Fill( reads[0] - evTime, readEvs[0]%(24*35) );
+            lFEBread_h.SetBinContent(bin, lFEBread.getBinContent(bin));
+            hFEBread_h.SetBinContent(bin, hFEBread.getBinContent(bin));
         }
+        double lStats[4];
+        double hStats[4];
+        lFEBread.getStats(lStats);
+        hFEBread.getStats(hStats);
+        lFEBread_h.PutStats(lStats);
+        hFEBread_h.PutStats(hStats);
+        lFEBread_h.SetEntries(lFEBread.getEntries());
+        hFEBread_h.SetEntries(hFEBread.getEntries());
+
+        readN_h.Write();
+        lFEBread_h.Write();
+        lFEBread_hh->Write();
+        hFEBread_h.Write();
+        hFEBread_hh->Write();
     }
-    lFEBrms[buffIter/4] = lFEBread_h.GetRMS();
-    lLowCut = lFEBread_h.GetXaxis()->GetBinCenter(lFEBread_h.FindFirstBinAbove(5.0)) - 28.0;
-    lHighCut = lFEBread_h.GetXaxis()->GetBinCenter(lFEBread_h.FindLastBinAbove(5.0)) + 28.0;
-    hFEBrms[buffIter/4] = hFEBread_h.GetRMS();
-    hLowCut = hFEBread_h.GetXaxis()->GetBinCenter(hFEBread_h.FindFirstBinAbove(5.0)) - 12.0;
-    hHighCut = hFEBread_h.GetXaxis()->GetBinCenter(hFEBread_h.FindLastBinAbove(5.0)) + 12.0;
-    sps[buffIter/4] = (double)buffIter;
-    readN_h.Write();
-    lFEBread_h.Write();
-    lFEBread_hh.Write();
-    hFEBread_h.Write();
-    hFEBread_hh.Write();
+    return result;
 }
 
 DECLARE_PROCESSOR(Apv25RoXtalkAnaProcessor);
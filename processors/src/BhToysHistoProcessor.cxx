@@ -5,6 +5,7 @@
  */
 
 #include "BhToysHistoProcessor.h"
+#include "Process.h"
 
 BhToysHistoProcessor::BhToysHistoProcessor(const std::string& name, Process& process)
     : Processor(name, process) { 
@@ -36,8 +37,9 @@ void BhToysHistoProcessor::configure(const ParameterSet& parameters) {
 }
 
 void BhToysHistoProcessor::initialize(std::string inFilename, std::string outFilename) {
-    // Init Files
-    inF_ = new TFile(inFilename.c_str());
+    // Init Files. In server mode the input files and the histograms read 
+    // from them stay in memory between requests.
+    inF_ = process_.openInputFile(inFilename);
 
     // Get mass spectrum from file
     mass_spec_h = (TH1*) inF_->Get(massSpectrum_.c_str());
@@ -46,8 +48,8 @@ void BhToysHistoProcessor::initialize(std::string inFilename, std::string outFil
     std::cout << "Signal Shape File :: " << signal_shape_h_file_ << std::endl;
     std::cout << "Signal Shape Hist :: " << signal_shape_h_name_ << std::endl;
     if(signal_shape_h_file_ != "" && signal_shape_h_name_ != "") {
-        TFile *file = new TFile(signal_shape_h_file_.c_str());
-        signal_shape_h_ = (TH1*) file->Get(signal_shape_h_name_.c_str());
+        signal_shape_f_ = process_.openInputFile(signal_shape_h_file_);
+        signal_shape_h_ = (TH1*) signal_shape_f_->Get(signal_shape_h_name_.c_str());
     } else if(signal_shape_h_file_ != "" && signal_shape_h_name_ == "") {
         std::cout << "[BumpHunter] :: !! WARNING !! Signal injection file, but no histogram, specified! Defaulting to Gaussian.";
     } else if(signal_shape_h_file_ == "" && signal_shape_h_name_ != "") {
@@ -247,10 +249,14 @@ bool BhToysHistoProcessor::process() {
 }
 
 void BhToysHistoProcessor::finalize() { 
-    inF_->Close();
-    delete inF_;
+    process_.closeInputFile(inF_);
+    inF_ = nullptr;
+    process_.closeInputFile(signal_shape_f_);
+    signal_shape_f_ = nullptr;
+    signal_shape_h_ = nullptr;
     //delete flat_tuple_;
     delete bump_hunter_;
+    bump_hunter_ = nullptr;
 }
 
 DECLARE_PROCESSOR(BhToysHistoProcessor); 
@@ -1,5 +1,6 @@
 #include "ClusterOnTrackAnaProcessor.h"
 #include "TBranch.h"
+#include "IndexRefs.h"
 
 ClusterOnTrackAnaProcessor::ClusterOnTrackAnaProcessor(const std::string& name, Process& process) : Processor(name,process){}
 //TODO CHECK THIS DESTRUCTOR
@@ -12,6 +13,8 @@ void ClusterOnTrackAnaProcessor::configure(const ParameterSet& parameters) {
     debug_        = parameters.getInteger("debug");
     anaName_      = parameters.getString("anaName");
     trkColl_      = parameters.getString("trkColl");
+    hitColl_      = parameters.getString("hitColl", hitColl_);
+    rawHitColl_   = parameters.getString("rawHitColl", rawHitColl_);
     baselineFits_ = parameters.getString("BaselineFits");
     baselineRun_  = parameters.getString("BaselineRun");
     if(debug_ > 0) std::cout << "Configured: " << baselineFits_ << " " << baselineRun_ << std::endl;
@@ -39,6 +42,14 @@ void ClusterOnTrackAnaProcessor::initialize(TTree* tree) {
 
     //TODO Change this.
     tree_->SetBranchAddress(trkColl_.c_str(),&tracks_,&btracks_);
+    // Hits are only needed to resolve index based track->hit->raw hit references
+    hitColl_ = IndexRefs::findTarget(tree_, trkColl_, hitColl_);
+    if (!hitColl_.empty())
+        rawHitColl_ = IndexRefs::findTarget(tree_, hitColl_, rawHitColl_);
+    if (!hitColl_.empty())
+        tree_->SetBranchAddress(hitColl_.c_str(),&hits_,&bhits_);
+    if (!rawHitColl_.empty())
+        tree_->SetBranchAddress(rawHitColl_.c_str(),&rawHits_,&brawHits_);
     if(debug_ > 0) std::cout << "Branch changed to " << trkColl_ << std::endl;
 
 }
@@ -49,14 +60,15 @@ bool ClusterOnTrackAnaProcessor::process(IEvent* ievent) {
     for (int itrack = 0; itrack<tracks_->size();itrack++) {
         Track *track = tracks_->at(itrack);
         //Loop on hits
-        if (track->getSvtHits().GetEntries()==0) {
+        if (track->getNSvtHits()==0) {
             std::cout<<"WARNING::track doesn't have hits associated to it"<<std::endl;
             return false;
         }
 
-        for (int ihit = 0; ihit<track->getSvtHits().GetEntries(); ++ihit) {
-            TrackerHit* hit3d = (TrackerHit*) track->getSvtHits().At(ihit);
-            clusterHistos->FillHistograms(hit3d, 1.);
+        for (int ihit = 0; ihit<track->getNSvtHits(); ++ihit) {
+            TrackerHit* hit3d = track->getSvtHit(ihit, hits_);
+            if (!hit3d) continue;
+            clusterHistos->FillHistograms(hit3d, 1., rawHits_);
         }
     }
     return true;
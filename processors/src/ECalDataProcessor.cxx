@@ -33,8 +33,8 @@ void ECalDataProcessor::configure(const ParameterSet& parameters) {
 
 void ECalDataProcessor::initialize(TTree* tree) {
     if (!hitCollRoot_.empty())
-        tree->Branch(hitCollRoot_.c_str(), &cal_hits_);
-    tree->Branch(clusCollRoot_.c_str(), &clusters_);
+        addCollection(tree, hitCollRoot_, &cal_hits_);
+    addCollection(tree, clusCollRoot_, &clusters_);
 }
 
 bool ECalDataProcessor::process(IEvent* ievent) {
@@ -90,8 +90,9 @@ bool ECalDataProcessor::process(IEvent* ievent) {
         cal_hit->setTime(lc_hit->getTime());
 
         // Set the indices of the crystal
-        int index_x = this->getIdentifierFieldValue("ix", lc_hit);
-        int index_y = this->getIdentifierFieldValue("iy", lc_hit);
+        cellid::EcalID id = cellid::Ecal::decode(cellid::value(lc_hit->getCellID0(), lc_hit->getCellID1()));
+        int index_x = id.ix;
+        int index_y = id.iy;
 
         cal_hit->setCrystalIndices(index_x, index_y);
         cal_hits_.push_back(cal_hit);
@@ -171,13 +172,4 @@ bool ECalDataProcessor::process(IEvent* ievent) {
 void ECalDataProcessor::finalize() { 
 }
 
-UTIL::BitFieldValue ECalDataProcessor::getIdentifierFieldValue(std::string field, EVENT::CalorimeterHit* hit){
-
-    UTIL::BitField64 decoder(encoder_string_);
-    long64 value = long64( hit->getCellID0() & 0xffffffff ) | ( long64( hit->getCellID1() ) << 32 ) ;
-    decoder.setValue(value); 
-
-    return decoder[field]; 
-}
-
 DECLARE_PROCESSOR(ECalDataProcessor); 
@@ -26,6 +26,8 @@ void EventProcessor::configure(const ParameterSet& parameters) {
         rfCollLcio_    = parameters.getString("rfCollLcio", rfCollLcio_ );
         vtpCollLcio_   = parameters.getString("vtpCollLcio", vtpCollLcio_);
         vtpCollRoot_   = parameters.getString("vtpCollRoot", vtpCollRoot_ );
+        vtpSubBanks_   = parameters.getInteger("vtpSubBanks", vtpSubBanks_);
+        vtpRawWords_   = parameters.getInteger("vtpRawWords", vtpRawWords_);
         tsCollLcio_  = parameters.getString("tsCollLcio", tsCollLcio_);
         tsCollRoot_  = parameters.getString("tsCollRoot", tsCollRoot_);
         
@@ -42,9 +44,11 @@ void EventProcessor::initialize(TTree* tree) {
     header_ = new EventHeader();
     vtpData = new VTPData();
     tsData = new TSData();
-    tree->Branch(headCollRoot_.c_str(), &header_);
-    tree->Branch(vtpCollRoot_.c_str(), &vtpData);
-    tree->Branch(tsCollRoot_.c_str(),  &tsData);
+    addObject(tree, headCollRoot_, &header_);
+    addObject(tree, vtpCollRoot_, &vtpData);
+    addObject(tree, tsCollRoot_, &tsData);
+    vtpCollID_ = Event::getLCCollectionID(vtpCollLcio_);
+    tsCollID_ = Event::getLCCollectionID(tsCollLcio_);
     
     //Cache everything in a map
     if (!run_evt_list_.empty()) {
@@ -113,16 +117,14 @@ bool EventProcessor::process(IEvent* ievent) {
     header_->setSvtEventHeaderState(lc_event->getParameters().getIntVal("svt_event_header_good"));
 
     // First try to read "new/2019" trigger format, if not available assume it is "old/2016"
-    try { 
-        EVENT::LCCollection* vtp_data 
-            = static_cast<EVENT::LCCollection*>(event->getLCCollection(vtpCollLcio_.c_str()));
-
+    EVENT::LCCollection* vtp_data = event->tryGetLCCollection(vtpCollID_);
+    EVENT::LCCollection* ts_data = event->tryGetLCCollection(tsCollID_);
+    // The VTP bank isn't cleared with the event: don't keep the previous one when it's missing
+    vtpData->Clear();
+    if (vtp_data && ts_data) { 
         EVENT::LCGenericObject* vtp_datum 
             = static_cast<EVENT::LCGenericObject*>(vtp_data->getElementAt(0));
 
-        EVENT::LCCollection* ts_data 
-            = static_cast<EVENT::LCCollection*>(event->getLCCollection(tsCollLcio_.c_str()));
-
         EVENT::LCGenericObject* ts_datum 
             = static_cast<EVENT::LCGenericObject*>(ts_data->getElementAt(0));
 
@@ -130,7 +132,7 @@ bool EventProcessor::process(IEvent* ievent) {
         parseTSData(ts_datum);
 
     } 
-    catch(EVENT::DataNotAvailableException e) 
+    else 
     {
         // Get old version of trigger data
         EVENT::LCCollection* trigger_data 
@@ -200,157 +202,15 @@ bool EventProcessor::process(IEvent* ievent) {
 
 void EventProcessor::parseVTPData(EVENT::LCGenericObject* vtp_data_lcio)
 { 
-    // First Clear out all the old data.
-    //std::cout << "New VTP Block of size " << vtp_data_lcio->getNInt() << std::endl;
-    vtpData->Clear();
-    for(int i=0; i<vtp_data_lcio->getNInt()/2; ++i)
-    {
-        int data = vtp_data_lcio->getIntVal(i);
-        int secondWord = vtp_data_lcio->getIntVal(i+1);
-        if(!(data & 1<<31)) continue;
-        int type = (data>>27)&0x0F;
-        int subtype;
-        switch (type)
-        {
-            case 0:  // Block Header
-                vtpData->blockHeader.blocklevel = (data      )&0x00FF;
-                vtpData->blockHeader.blocknum   = (data >>  8)&0x03FF;
-                vtpData->blockHeader.nothing    = (data >> 18)&0x00FF;
-                vtpData->blockHeader.slotid     = (data >> 22)&0x001F;
-                vtpData->blockHeader.type       = (data >> 27)&0x000F;
-                vtpData->blockHeader.istype     = (data >> 31)&0x0001;
-                //std::cout << i << " BlockHeader " << vtpData->blockHeader.type << std::endl;
-                break;
-            case 1: //  Block Tail
-                vtpData->blockTail.nwords       = (data      )&0x03FFFFF;
-                vtpData->blockTail.slotid       = (data >> 22)&0x000001F;
-                vtpData->blockTail.type         = (data >> 27)&0x000000F;
-                vtpData->blockTail.istype       = (data >> 31)&0x0000001;
-                //std::cout << i << " BlockTail " << vtpData->blockTail.type << std::endl;
-                break;
-            case 2:  // Event Header
-                vtpData->eventHeader.eventnum   = (data      )&0x07FFFFFF;
-                vtpData->eventHeader.type       = (data >> 27)&0x0000000F;
-                vtpData->eventHeader.istype     = (data >> 31)&0x00000001;
-                //std::cout << i << " EventHeader " << vtpData->eventHeader.eventnum << std::endl;
-                break;
-            case 3:  // Trigger time
-                vtpData->trigTime = (data & 0x00FFFFFF) + ((secondWord & 0x00FFFFFF )<<24);
-                //std::cout << i << "&" << i+1 << " trigTime = " << vtpData->trigTime << std::endl;
-                i++;
-                break;
-            case 12:  // Expansion type
-                subtype = (data>>23)&0x0F;
-                switch(subtype){
-                    case 2: // HPS Cluster
-                        VTPData::hpsCluster  clus;
-                        clus.X        = (data      )&0x0003F;
-                        // If the first bit of the index is 1, then it is a negative number
-                        if((clus.X >> 5 & 0x1) == 0x1) clus.X = -((clus.X ^ 0x3F) + 1);
-                        clus.Y        = (data >>  6)&0x0000F;
-                       // If the first bit of the index is 1, then it is a negative number
-                        if((clus.Y  >> 3 & 0x1) == 0x1) clus.Y  = -((clus.Y ^ 0xF) + 1);
-                        clus.E        = (data >> 10)&0x01FFF;
-                        clus.subtype  = (data >> 23)&0x0000F;
-                        clus.type     = (data >> 27)&0x0000F;
-                        clus.istype   = (data >> 31)&0x00001;
-                        clus.T        = (secondWord      )&0x003FF;
-                        clus.N        = (secondWord >> 10)&0x0000F;
-                        clus.nothing  = (secondWord >> 14)&0x3FFFF;
-                        vtpData->clusters.push_back(clus);
-                        //std::cout << i << "&" << i+1 << " HPS Cluster " << clus.E << std::endl;
-                        i++;
-                        break;
-                    case 3: // HPS Single Trigger
-                        VTPData::hpsSingleTrig strig;
-                        strig.T        = (data      )&0x003FF;
-                        strig.emin     = (data >> 10)&0x00001;
-                        strig.emax     = (data >> 11)&0x00001;
-                        strig.nmin     = (data >> 12)&0x00001;
-                        strig.xmin     = (data >> 13)&0x00001;
-                        strig.pose     = (data >> 14)&0x00001;
-                        strig.hodo1c   = (data >> 15)&0x00001;
-                        strig.hodo2c   = (data >> 16)&0x00001;
-                        strig.hodogeo  = (data >> 17)&0x00001;
-                        strig.hodoecal = (data >> 18)&0x00001;
-                        strig.topnbot  = (data >> 19)&0x00001;
-                        strig.inst     = (data >> 20)&0x00007;
-                        strig.subtype  = (data >> 23)&0x0000F;
-                        strig.type     = (data >> 27)&0x0000F;
-                        strig.istype   = (data >> 31)&0x00001;
-                        //std::cout << i << " HPS Single Trigger " << strig.subtype << std::endl;
-                        vtpData->singletrigs.push_back(strig);
-                        break;
-                    case 4: // HPS Pair Trigger
-                        VTPData::hpsPairTrig ptrig;
-                        ptrig.T          = (data      )&0x003FF;
-                        ptrig.clusesum   = (data >> 10)&0x00001;
-                        ptrig.clusedif   = (data >> 11)&0x00001;
-                        ptrig.eslope     = (data >> 12)&0x00001;
-                        ptrig.coplane    = (data >> 13)&0x00001;
-                        ptrig.dummy      = (data >> 14)&0x0001F;
-                        ptrig.topnbot    = (data >> 19)&0x00001;
-                        ptrig.inst       = (data >> 20)&0x00007;
-                        ptrig.subtype    = (data >> 23)&0x0000F;
-                        ptrig.type       = (data >> 27)&0x0000F;
-                        ptrig.istype     = (data >> 31)&0x00001;
-                        //std::cout << i << " HPS Pair Trigger " << ptrig.subtype << std::endl;
-                        vtpData->pairtrigs.push_back(ptrig);
-                        break;
-                    case 5: // HPS Calibration Trigger
-                        VTPData::hpsCalibTrig ctrig;
-                        ctrig.T          = (data      )&0x003FF;
-                        ctrig.reserved   = (data >> 10)&0x001FF;
-                        ctrig.cosmicTrig = (data >> 19)&0x00001;
-                        ctrig.LEDTrig    = (data >> 20)&0x00001;
-                        ctrig.hodoTrig   = (data >> 21)&0x00001;
-                        ctrig.pulserTrig = (data >> 22)&0x00001;
-                        ctrig.subtype    = (data >> 23)&0x0000F;
-                        ctrig.type       = (data >> 27)&0x0000F;
-                        ctrig.istype     = (data >> 31)&0x00001;
-                        //std::cout << i << " HPS Cal Trigger " << ctrig.subtype << std::endl;
-                        vtpData->calibtrigs.push_back(ctrig);
-                        break;
-                    case 6: // HPS Cluster Multiplicity Trigger
-                        VTPData::hpsClusterMult clmul;
-                        clmul.T          = (data      )&0x003FF;
-                        clmul.multtop    = (data >> 10)&0x0000F;
-                        clmul.multbot    = (data >> 14)&0x0000F;
-                        clmul.multtot    = (data >> 18)&0x0000F;
-                        clmul.bitinst    = (data >> 22)&0x00001;
-                        clmul.subtype    = (data >> 23)&0x0000F;
-                        clmul.type       = (data >> 27)&0x0000F;
-                        clmul.istype     = (data >> 31)&0x00001;
-                        //std::cout << i << " HPS Clus Mult Trigger " << clmul.subtype << std::endl;
-                        vtpData->clustermult.push_back(clmul);
-                        break;
-                    case 7: // HPS FEE Trigger
-                        VTPData::hpsFEETrig fee;
-                        fee.T          = (data      )&0x003FF;
-                        fee.region     = (data >> 10)&0x0007F;
-                        fee.reserved   = (data >> 17)&0x0003F;
-                        fee.subtype    = (data >> 23)&0x0000F;
-                        fee.type       = (data >> 27)&0x0000F;
-                        fee.istype     = (data >> 31)&0x00001;
-                        //std::cout << i << " HPS FEE Trigger " << fee.subtype << std::endl;
-                        vtpData->feetrigger.push_back(fee);
-                        break;
-                    default:
-                        std::cout << "At " << i << " invalid HPS type: " << type << " subtype: " << subtype << std::endl;
-                        break;
-                }
-
-                break;
-            case 14:
-                std::cout << i << "VTP data type not valid: " << type << std::endl;
-                break;
-            default:
-                std::cout << i << "I was not expecting a VTP data type of " << type << std::endl;
-                break;
-        }
-    }
-    //std::cout << "---------------------------------------" << std::endl;
-    //std::cout << std::endl;
+    // Copy the words once, into a buffer that keeps its capacity across events
+    int nwords = vtp_data_lcio->getNInt();
+    vtpWords_.resize(nwords);
+    for (int iword = 0; iword < nwords; ++iword)
+        vtpWords_[iword] = vtp_data_lcio->getIntVal(iword);
+
+    if (vtpRawWords_)
+        vtpData->words.assign(vtpWords_.begin(), vtpWords_.end());
+    vtpData->decode(vtpWords_.data(), nwords, vtpSubBanks_);
 } //EventProcessor::parseVTPData(LCGenericObject* vtp_data_lcio)
 
 void EventProcessor::parseTSData(EVENT::LCGenericObject* ts_data_lcio)
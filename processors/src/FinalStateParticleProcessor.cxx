@@ -4,6 +4,7 @@
  * @author Cameron Bravo, SLAC
  */
 #include "FinalStateParticleProcessor.h" 
+#include "IndexRefs.h"
 #include "utilities.h"
 
 FinalStateParticleProcessor::FinalStateParticleProcessor(const std::string& name, Process& process)
@@ -26,6 +27,7 @@ void FinalStateParticleProcessor::configure(const ParameterSet& parameters) {
         hitFitsCollLcio_   = parameters.getString("hitFitsCollLcio", hitFitsCollLcio_);    
         trkhitCollRoot_    = parameters.getString("trkhitCollRoot",trkhitCollRoot_);
         rawhitCollRoot_    = parameters.getString("rawhitCollRoot",rawhitCollRoot_);
+        useIndexRefs_      = parameters.getInteger("useIndexRefs",useIndexRefs_);
     }
     catch (std::runtime_error& error)
     {
@@ -37,11 +39,24 @@ void FinalStateParticleProcessor::initialize(TTree* tree) {
     // Add branches to tree
    
     if (!trkhitCollRoot_.empty())
-        tree->Branch(trkhitCollRoot_.c_str(), &hits_);
+        addCollection(tree, trkhitCollRoot_, &hits_);
     
     if (!rawhitCollRoot_.empty())
-        tree->Branch(rawhitCollRoot_.c_str(), &rawhits_); 
-    tree->Branch(fspCollRoot_.c_str(),  &fsps_);
+        addCollection(tree, rawhitCollRoot_, &rawhits_); 
+    addCollection(tree, fspCollRoot_, &fsps_);
+
+    // Let the readers find the collections the indices point into
+    if (useIndexRefs_) { 
+        if (!trkhitCollRoot_.empty())
+            IndexRefs::setTarget(tree, fspCollRoot_, trkhitCollRoot_);
+        if (!trkhitCollRoot_.empty() && !rawhitCollRoot_.empty())
+            IndexRefs::setTarget(tree, trkhitCollRoot_, rawhitCollRoot_);
+    }
+
+    // Optional input collections
+    kinkRelCollID_ = Event::getLCCollectionID(kinkRelCollLcio_);
+    trkRelCollID_ = Event::getLCCollectionID(trkRelCollLcio_);
+    hitFitsCollID_ = Event::getLCCollectionID(hitFitsCollLcio_);
 }
 
 bool FinalStateParticleProcessor::process(IEvent* ievent) {
@@ -83,41 +98,19 @@ bool FinalStateParticleProcessor::process(IEvent* ievent) {
     }
 
     // Get the collection of LCRelations between GBL tracks and kink data and track data variables.
-    EVENT::LCCollection* gbl_kink_data{nullptr};
-    EVENT::LCCollection* track_data{nullptr};
-        
-    try
-    {
-        if (!kinkRelCollLcio_.empty())
-            gbl_kink_data = static_cast<EVENT::LCCollection*>(event->getLCCollection(kinkRelCollLcio_.c_str()));
-        if (!trkRelCollLcio_.empty())
-            track_data = static_cast<EVENT::LCCollection*>(event->getLCCollection(trkRelCollLcio_.c_str()));
-    }
-    catch (EVENT::DataNotAvailableException e)
-    {
-        std::cout << e.what() << std::endl;
-        if (!gbl_kink_data)
-            std::cout<<"Failed retrieving " << kinkRelCollLcio_ <<std::endl;
-        if (!track_data)
-            std::cout<<"Failed retrieving " << trkRelCollLcio_ <<std::endl;
-        
-    }
+    EVENT::LCCollection* gbl_kink_data = event->tryGetLCCollection(kinkRelCollID_);
+    EVENT::LCCollection* track_data = event->tryGetLCCollection(trkRelCollID_);
+    if (!gbl_kink_data && !kinkRelCollLcio_.empty())
+        std::cout<<"Failed retrieving " << kinkRelCollLcio_ <<std::endl;
+    if (!track_data && !trkRelCollLcio_.empty())
+        std::cout<<"Failed retrieving " << trkRelCollLcio_ <<std::endl;
     
     
     if (debug_ > 0) std::cout << "FinalStateParticleProcessor: Converting"<< std::endl;
 
     bool rotateHits = true;
     int hitType = 0;
-    EVENT::LCCollection* raw_svt_hit_fits = nullptr;
-
-    auto evColls = event->getLCEvent()->getCollectionNames();
-    auto it = std::find (evColls->begin(), evColls->end(), hitFitsCollLcio_.c_str());
-    bool hasFits = true;
-    if(it == evColls->end()) hasFits = false; 
-    if(hasFits)
-    {
-        raw_svt_hit_fits = event->getLCCollection(hitFitsCollLcio_.c_str()); 
-    }
+    EVENT::LCCollection* raw_svt_hit_fits = event->tryGetLCCollection(hitFitsCollID_);
     for (int ifsp = 0 ; ifsp < lc_fsps->getNumberOfElements(); ++ifsp) 
     {
         if (debug_ > 0) std::cout << "FinalStateParticleProcessor: Converting FinalStateParticle " << ifsp << std::endl;
@@ -125,26 +118,30 @@ bool FinalStateParticleProcessor::process(IEvent* ievent) {
         lc_fsp = static_cast<EVENT::ReconstructedParticle*>(lc_fsps->getElementAt(ifsp));
         if (debug_ > 0) std::cout << "FinalStateParticleProcessor: Build Particle" << std::endl;
         
-        Particle * fsp = utils::buildParticle(lc_fsp,"", gbl_kink_data, track_data);
+        Particle * fsp = utils::buildParticle(lc_fsp,"", gbl_kink_data, track_data, &event->getConversionCache());
         if (lc_fsp->getTracks().size()>0){
             EVENT::Track* lc_track = static_cast<EVENT::Track*>(lc_fsp->getTracks()[0]);
-            Track* track = utils::buildTrack(lc_track,"",gbl_kink_data,track_data);
+            Track track(*utils::getTrack(lc_track,"",gbl_kink_data,track_data,event->getConversionCache()));
             EVENT::TrackerHitVec lc_tracker_hits = lc_track->getTrackerHits(); 
             for (auto lc_tracker_hit : lc_tracker_hits) {
                 TrackerHit* tracker_hit = utils::buildTrackerHit(static_cast<IMPL::TrackerHitImpl*>(lc_tracker_hit),rotateHits,hitType);
                 std::vector<RawSvtHit*> rawSvthitsOn3d;
                 utils::addRawInfoTo3dHit(tracker_hit,static_cast<IMPL::TrackerHitImpl*>(lc_tracker_hit),
-                                         raw_svt_hit_fits,&rawSvthitsOn3d,hitType);
+                                         raw_svt_hit_fits,&rawSvthitsOn3d,hitType,true,
+                                         useIndexRefs_ ? (int)rawhits_.size() : -1);
                 for (auto rhit : rawSvthitsOn3d)
                     rawhits_.push_back(rhit);
                     //rawhits_->addHit(rhit); 
 
-                track->addHit(tracker_hit);
+                if (useIndexRefs_)
+                    track.addHitIndex(hits_.size());
+                else
+                    track.addHit(tracker_hit);
                 hits_.push_back(tracker_hit);
                 rawSvthitsOn3d.clear();
                 // loop on j>i tracks
             }
-            fsp->setTrack(track);
+            fsp->setTrack(&track);
         }   
          
         if (debug_ > 0) std::cout << "FinalStateParticleProcessor: Add Particle" << std::endl;
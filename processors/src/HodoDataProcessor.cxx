@@ -7,8 +7,8 @@
 #include "HodoDataProcessor.h"
 
 void HodoDataProcessor::initialize(TTree* tree) {
-  tree->Branch(hitCollRoot_.c_str(), &hits_);
-  tree->Branch(clusCollRoot_.c_str(), &clusters_);
+  addCollection(tree, hitCollRoot_, &hits_);
+  addCollection(tree, clusCollRoot_, &clusters_);
 }
 
 
@@ -57,11 +57,12 @@ bool HodoDataProcessor::process(IEvent* ievent) {
     IMPL::CalorimeterHitImpl *hit=static_cast<IMPL::CalorimeterHitImpl *>(lcio_hits->getElementAt(i));
 
     // TODO: This is inefficient, doing a new and delete on every hit for every event ==> implement proper memory use.
+    cellid::HodoID id = cellid::Hodo::decode(cellid::value(hit->getCellID0(), hit->getCellID1()));
     hits_.push_back(new HodoHit(
-                                getIdentifierFieldValue("ix", hit),
-                                getIdentifierFieldValue("iy", hit),
-                                getIdentifierFieldValue("layer", hit),
-                                getIdentifierFieldValue("hole", hit),
+                                id.ix,
+                                id.iy,
+                                id.layer,
+                                id.hole,
                                 hit->getEnergy(),
                                 hit->getTime()
                                 )
@@ -96,13 +97,4 @@ bool HodoDataProcessor::process(IEvent* ievent) {
   return true;
 }
 
-UTIL::BitFieldValue HodoDataProcessor::getIdentifierFieldValue(std::string field, EVENT::CalorimeterHit* hit){
-  
-  UTIL::BitField64 decoder(encoder_string_);
-  long long value = (long long)( hit->getCellID0() & 0xffffffff ) | ( (long long)( hit->getCellID1() ) << 32 ) ;
-  decoder.setValue(value);
-  
-  return decoder[field];
-}
-
 DECLARE_PROCESSOR(HodoDataProcessor); 
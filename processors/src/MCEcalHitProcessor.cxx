@@ -29,7 +29,7 @@ void MCEcalHitProcessor::configure(const ParameterSet& parameters) {
 
 void MCEcalHitProcessor::initialize(TTree* tree) {
 
-    tree->Branch(hitCollRoot_.c_str(), &ecalhits_);
+    addCollection(tree, hitCollRoot_, &ecalhits_);
 }
 
 bool MCEcalHitProcessor::process(IEvent* ievent) {
@@ -47,9 +47,6 @@ bool MCEcalHitProcessor::process(IEvent* ievent) {
     }
 
 
-    // Get decoders to read cellids
-    UTIL::BitField64 decoder("system:0:6,layer:6:2,ix:8:-8,iy:16:-6");
-    //decoder[field] returns the value
 
     // Loop over all of the raw SVT hits in the LCIO event and add them to the 
     // HPS event
@@ -61,18 +58,17 @@ bool MCEcalHitProcessor::process(IEvent* ievent) {
         EVENT::SimCalorimeterHit* lcio_mcEcal_hit 
             = static_cast<EVENT::SimCalorimeterHit*>(lcio_ecalhits->getElementAt(ihit));
         //Decode the cellid
-        EVENT::long64 value = EVENT::long64( lcio_mcEcal_hit->getCellID0() & 0xffffffff ) | 
-            ( EVENT::long64( lcio_mcEcal_hit->getCellID1() ) << 32 ) ;
-        decoder.setValue(value);
+        cellid::EcalID id = cellid::Ecal::decode(
+                cellid::value(lcio_mcEcal_hit->getCellID0(), lcio_mcEcal_hit->getCellID1()));
 
         // Add a mc ecal hit to the event
         MCEcalHit* mc_ecal_hit = new MCEcalHit();
 
         // Set sensitive detector identification
-        mc_ecal_hit->setSystem(decoder["system"]);
-        mc_ecal_hit->setLayer(decoder["layer"]);
-        mc_ecal_hit->setIX(decoder["ix"]);
-        mc_ecal_hit->setIY(decoder["iy"]);
+        mc_ecal_hit->setSystem(id.system);
+        mc_ecal_hit->setLayer(id.layer);
+        mc_ecal_hit->setIX(id.ix);
+        mc_ecal_hit->setIY(id.iy);
 
         // Set the position of the hit, dealing with it being a float and not double
         const float hitPosF[3] = {lcio_mcEcal_hit->getPosition()[0], lcio_mcEcal_hit->getPosition()[1], lcio_mcEcal_hit->getPosition()[2]};
@@ -22,6 +22,7 @@ void MCParticleProcessor::configure(const ParameterSet& parameters) {
         debug_          = parameters.getInteger("debug", debug_ );
         mcPartCollLcio_    = parameters.getString("mcPartCollLcio", mcPartCollLcio_);
         mcPartCollRoot_    = parameters.getString("mcPartCollRoot", mcPartCollRoot_);
+        writeGenealogy_    = parameters.getInteger("writeGenealogy", writeGenealogy_);
     }
     catch (std::runtime_error& error)
     {
@@ -33,8 +34,11 @@ void MCParticleProcessor::configure(const ParameterSet& parameters) {
 
 void MCParticleProcessor::initialize(TTree* tree) {
     // Add branch to tree
-    tree->Branch(mcPartCollRoot_.c_str(),&mc_particles_);
+    addCollection(tree, mcPartCollRoot_, &mc_particles_);
 
+    // The daughters of each particle are a contiguous range of this collection
+    if (writeGenealogy_)
+        addCollection(tree, mcPartCollRoot_+"_daughters", &mc_daughters_);
 }
 
 bool MCParticleProcessor::process(IEvent* ievent) {
@@ -62,6 +66,8 @@ bool MCParticleProcessor::process(IEvent* ievent) {
         }
         mc_particles_.clear();
     }
+    mc_daughters_.clear();
+    lc_indices_.clear();
 
 
     // Loop through all of the particles in the event
@@ -98,6 +104,10 @@ bool MCParticleProcessor::process(IEvent* ievent) {
         // Set the LCIO id of the particle
         particle->setID(lc_particle->id());    
 
+        // Set the position of the particle in the collection
+        particle->setIndex(iparticle);
+        if (writeGenealogy_) lc_indices_[lc_particle] = iparticle;
+
         // Set the PDG of the particle
         std::vector<EVENT::MCParticle*> parentVec = lc_particle->getParents();
         if(parentVec.size() > 0) particle->setMomPDG(parentVec.at(parentVec.size()-1)->getPDG());    
@@ -192,6 +202,28 @@ bool MCParticleProcessor::process(IEvent* ievent) {
         }*/
     }   
 
+    if (writeGenealogy_) {
+        for (int iparticle = 0; iparticle < lc_particles->getNumberOfElements(); ++iparticle) {
+            IMPL::MCParticleImpl* lc_particle
+                = static_cast<IMPL::MCParticleImpl*>(lc_particles->getElementAt(iparticle)); 
+            MCParticle* particle = mc_particles_[iparticle];
+
+            // The mother is the parent the mother PDG is taken from
+            const std::vector<EVENT::MCParticle*>& parents = lc_particle->getParents();
+            if (!parents.empty()) {
+                auto it = lc_indices_.find(parents.back());
+                if (it != lc_indices_.end()) particle->setMomIndex(it->second);
+            }
+
+            int begin = mc_daughters_.size();
+            for (auto daughter : lc_particle->getDaughters()) {
+                auto it = lc_indices_.find(daughter);
+                if (it != lc_indices_.end()) mc_daughters_.push_back(it->second);
+            }
+            particle->setDaughterRange(begin, mc_daughters_.size());
+        }
+    }
+
     return true;
 }
 
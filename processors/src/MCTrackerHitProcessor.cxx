@@ -29,7 +29,7 @@ void MCTrackerHitProcessor::configure(const ParameterSet& parameters) {
 
 void MCTrackerHitProcessor::initialize(TTree* tree) {
 
-    tree->Branch(hitCollRoot_.c_str(), &trackerhits_);
+    addCollection(tree, hitCollRoot_, &trackerhits_);
 }
 
 bool MCTrackerHitProcessor::process(IEvent* ievent) {
@@ -46,9 +46,6 @@ bool MCTrackerHitProcessor::process(IEvent* ievent) {
         std::cout << e.what() << std::endl;
     }
 
-    // Get decoders to read cellids
-    UTIL::BitField64 decoder("system:0:6,barrel:6:3,layer:9:4,module:13:12,sensor:25:1,side:32:-2,strip:34:12");
-    //decoder[field] returns the value
 
     // Loop over all of the raw SVT hits in the LCIO event and add them to the 
     // HPS event
@@ -60,16 +57,15 @@ bool MCTrackerHitProcessor::process(IEvent* ievent) {
         EVENT::SimTrackerHit* lcio_mcTracker_hit 
             = static_cast<EVENT::SimTrackerHit*>(lcio_trackerhits->getElementAt(ihit));
         //Decode the cellid
-        EVENT::long64 value = EVENT::long64( lcio_mcTracker_hit->getCellID0() & 0xffffffff ) | 
-            ( EVENT::long64( lcio_mcTracker_hit->getCellID1() ) << 32 ) ;
-        decoder.setValue(value);
+        cellid::SvtID id = cellid::Svt::decode(
+                cellid::value(lcio_mcTracker_hit->getCellID0(), lcio_mcTracker_hit->getCellID1()));
 
         // Add a raw tracker hit to the event
         MCTrackerHit* mc_tracker_hit = new MCTrackerHit();
 
         // Set sensitive detector identification
-        mc_tracker_hit->setLayer(decoder["layer"]);
-        mc_tracker_hit->setModule(decoder["module"]);
+        mc_tracker_hit->setLayer(id.layer);
+        mc_tracker_hit->setModule(id.module);
 
         // Set the position of the hit
         double hitPos[3];
@@ -23,9 +23,9 @@ void RefittedTracksProcessor::configure(const ParameterSet& parameters) {
 
 void RefittedTracksProcessor::initialize(TTree* tree) {
   
-    tree->Branch("GBLRefittedTracks", &tracks_);
-    tree->Branch("V0Vertices", &vertices_);
-    tree->Branch("V0Vertices_refit", &vertices_refit_);
+    addCollection(tree, "GBLRefittedTracks", &tracks_);
+    addCollection(tree, "V0Vertices", &vertices_);
+    addCollection(tree, "V0Vertices_refit", &vertices_refit_);
   
   
     //Original hists
@@ -78,7 +78,7 @@ bool RefittedTracksProcessor::process(IEvent* ievent) {
     //Grab the vertices and the vtx candidates
     EVENT::LCCollection* u_vtx_candidates = nullptr;
     EVENT::LCCollection* u_vtxs = nullptr;
-    if (utils::hasCollection(event->getLCEvent(),Collections::UC_V0CANDIDATES)) { 
+    if (event->hasLCCollection(Collections::UC_V0CANDIDATES)) { 
         //Get the vertex candidates
         u_vtx_candidates  = event->getLCCollection(Collections::UC_V0CANDIDATES);
         //Get the vertices 
@@ -96,7 +96,7 @@ bool RefittedTracksProcessor::process(IEvent* ievent) {
     //Grab the vertices and the vtx candidates
     EVENT::LCCollection* u_vtx_candidates_r = nullptr;
     EVENT::LCCollection* u_vtxs_r = nullptr;
-    if (utils::hasCollection(event->getLCEvent(),"UnconstrainedV0Candidates_refit")) { 
+    if (event->hasLCCollection("UnconstrainedV0Candidates_refit")) { 
         //Get the vertex candidates
         u_vtx_candidates_r  = event->getLCCollection("UnconstrainedV0Candidates_refit");
         //Get the vertices 
@@ -1,4 +1,5 @@
 #include "SimpZBiOptimizationProcessor.h"
+#include "Process.h"
 #include <string>
 #include <cstdlib>
 #include <iostream>
@@ -9,7 +10,10 @@ SimpZBiOptimizationProcessor::SimpZBiOptimizationProcessor(const std::string& na
     std::cout << "[SimpZBiOptimizationProcessor] Constructor()" << std::endl;
 }
 
-SimpZBiOptimizationProcessor::~SimpZBiOptimizationProcessor(){}
+SimpZBiOptimizationProcessor::~SimpZBiOptimizationProcessor(){
+    delete signalMTT_;
+    delete bkgMTT_;
+}
 
 void SimpZBiOptimizationProcessor::configure(const ParameterSet& parameters) {
     std::cout << "[SimpZBiOptimizationProcessor] configure()" << std::endl;
@@ -192,8 +196,8 @@ void SimpZBiOptimizationProcessor::fillEventHistograms(std::shared_ptr<ZBiHistos
 double SimpZBiOptimizationProcessor::countControlRegionBackgroundRate(std::string inFilename, std::string tree_name, 
         double m_Ap, double Mbin, double dNdm_sf){
     double dNdm = 0.0;
-    TFile inFile(inFilename.c_str(), "READ");
-    TTree* tree = (TTree*)inFile.Get((tree_name+"/"+tree_name+"_tree").c_str());
+    TFile* inFile = process_.openInputFile(inFilename);
+    TTree* tree = (TTree*)inFile->Get((tree_name+"/"+tree_name+"_tree").c_str());
     double mass;
     std::cout << "Counting: Ap mass is " << m_Ap << std::endl;
     tree->SetBranchAddress("unc_vtx_mass", &mass);
@@ -207,7 +211,8 @@ double SimpZBiOptimizationProcessor::countControlRegionBackgroundRate(std::strin
     dNdm = dNdm/Mbin;
     dNdm = dNdm * dNdm_sf;
     std::cout << "Background Rate in CR: " << dNdm << std::endl;
-    inFile.Close();
+    tree->ResetBranchAddresses();
+    process_.closeInputFile(inFile);
 
     return dNdm;
 }
@@ -235,12 +240,24 @@ void SimpZBiOptimizationProcessor::initialize(std::string inFilename, std::strin
     outFile_->cd();
     signalSimZ_h_->Write();
 
+    //The mutable tuples only depend on the input tuples, the mass window and the new variables, 
+    //so they are kept when initializing again with the same ones (e.g. for an epsilon scan).
+    std::string tupleKey = signalVtxAnaFilename_ + ":" + signalVtxAnaTreename_ + ":" 
+        + bkgVtxAnaFilename_ + ":" + bkgVtxAnaTreename_ + ":" 
+        + std::to_string(lowMass_) + ":" + std::to_string(highMass_);
+    for(size_t i = 0; i < new_variables_.size(); i++)
+        tupleKey += ":" + new_variables_.at(i) + "=" + std::to_string(new_variable_params_.at(i));
+    bool buildTuples = (signalMTT_ == nullptr || tupleKey != tupleKey_);
+
     //Read signal ana vertex tuple, and convert to mutable tuple
-    std::cout << "[SimpZBiOptimization]::Reading Signal AnaVertex Tuple from file " 
-        << signalVtxAnaFilename_.c_str() << std::endl;
-    TFile* signalVtxAnaFile = new TFile(signalVtxAnaFilename_.c_str(),"READ");
-    signalMTT_ = new SimpAnaTTree(signalVtxAnaFile,(signalVtxAnaTreename_+"/"+signalVtxAnaTreename_+"_tree").c_str());
-    signalMTT_->defineMassWindow(lowMass_, highMass_);
+    TFile* signalVtxAnaFile = process_.openInputFile(signalVtxAnaFilename_);
+    if(buildTuples){
+        std::cout << "[SimpZBiOptimization]::Reading Signal AnaVertex Tuple from file " 
+            << signalVtxAnaFilename_.c_str() << std::endl;
+        delete signalMTT_;
+        signalMTT_ = new SimpAnaTTree(signalVtxAnaFile,(signalVtxAnaTreename_+"/"+signalVtxAnaTreename_+"_tree").c_str());
+        signalMTT_->defineMassWindow(lowMass_, highMass_);
+    }
 
     //Get Simp Mean Truth Energy
     std::cout << "Get Mean Truth Energy" << std::endl;
@@ -250,26 +267,37 @@ void SimpZBiOptimizationProcessor::initialize(std::string inFilename, std::strin
     E_Vd_ = (double)signalEnergy_h->GetMean();
     std::cout << "Mean Energy is " << E_Vd_ << std::endl;
 
-    //Read background ana vertex tuple, and convert to mutable tuple
-    std::cout << "[SimpZBiOptimization]::Reading Background AnaVertex Tuple from file " 
-        << signalVtxAnaFilename_.c_str() << std::endl;
-    TFile* bkgVtxAnaFile = new TFile(bkgVtxAnaFilename_.c_str(),"READ");
-    bkgMTT_ = new SimpAnaTTree(bkgVtxAnaFile, (bkgVtxAnaTreename_+"/"+bkgVtxAnaTreename_+"_tree").c_str());
-    bkgMTT_->defineMassWindow(lowMass_, highMass_);
-
-    //Add new variables, as defined in SimpAnaTTree.cxx, from the processor configuration script
-    for(std::vector<std::string>::iterator it = new_variables_.begin(); it != new_variables_.end(); it++){
-        int param_idx = std::distance(new_variables_.begin(), it);
-        std::cout << "[SimpZBiOptimization]::Attempting to add new variable " << *it << 
-            " with parameter " << new_variable_params_.at(param_idx) << std::endl;
-        addNewVariables(signalMTT_, *it, new_variable_params_.at(param_idx));
-        addNewVariables(bkgMTT_, *it, new_variable_params_.at(param_idx));
+    if(buildTuples){
+        //Read background ana vertex tuple, and convert to mutable tuple
+        std::cout << "[SimpZBiOptimization]::Reading Background AnaVertex Tuple from file " 
+            << bkgVtxAnaFilename_.c_str() << std::endl;
+        TFile* bkgVtxAnaFile = process_.openInputFile(bkgVtxAnaFilename_);
+        delete bkgMTT_;
+        bkgMTT_ = new SimpAnaTTree(bkgVtxAnaFile, (bkgVtxAnaTreename_+"/"+bkgVtxAnaTreename_+"_tree").c_str());
+        bkgMTT_->defineMassWindow(lowMass_, highMass_);
+
+        //Add new variables, as defined in SimpAnaTTree.cxx, from the processor configuration script
+        for(std::vector<std::string>::iterator it = new_variables_.begin(); it != new_variables_.end(); it++){
+            int param_idx = std::distance(new_variables_.begin(), it);
+            std::cout << "[SimpZBiOptimization]::Attempting to add new variable " << *it << 
+                " with parameter " << new_variable_params_.at(param_idx) << std::endl;
+            addNewVariables(signalMTT_, *it, new_variable_params_.at(param_idx));
+            addNewVariables(bkgMTT_, *it, new_variable_params_.at(param_idx));
+        }
+
+        //Finalize Initialization of New Mutable Tuples
+        std::cout << "[SimpZBiOptimization]::Finalizing Initialization of New Mutable Tuples" << std::endl;
+        signalMTT_->Fill();
+        bkgMTT_->Fill();
+        tupleKey_ = tupleKey;
+
+        //The mutable tuples are held in memory
+        process_.closeInputFile(bkgVtxAnaFile);
     }
+    process_.closeInputFile(signalVtxAnaFile);
 
-    //Finalize Initialization of New Mutable Tuples
-    std::cout << "[SimpZBiOptimization]::Finalizing Initialization of New Mutable Tuples" << std::endl;
-    signalMTT_->Fill();
-    bkgMTT_->Fill();
+    //Objects created from here on belong to the output file, and are released when it is closed
+    outFile_->cd();
 
     //Initialize Persistent Cut Selector. These cuts are applied to all events.
     //Persistent Cut values are updated each iteration with the value of the best performing Test Cut in
@@ -801,6 +829,19 @@ void SimpZBiOptimizationProcessor::finalize() {
 
     processorHistos_->saveHistos(outFile_);
     testCutHistos_->writeGraphs(outFile_,"");
+
+    //Close the output so that each configuration is written as soon as it is done
+    outFile_->Close();
+    delete outFile_;
+    outFile_ = nullptr;
+    signalSimZ_h_ = nullptr;
+
+    delete persistentCutsSelector_;
+    persistentCutsSelector_ = nullptr;
+    delete testCutsSelector_;
+    testCutsSelector_ = nullptr;
+    delete simpEqs_;
+    simpEqs_ = nullptr;
 }
 
 double SimpZBiOptimizationProcessor::calculateZBi(double n_on, double n_off, double tau){
@@ -854,13 +895,12 @@ void SimpZBiOptimizationProcessor::getSignalMCAnaVtxZ_h(std::string signalMCAnaF
         std::string signal_pdgid){
     //Read pre-trigger Signal MCAna vertex z distribution
     signalSimZ_h_ = new TH1F("signal_SimZ_h_","signal_SimZ;true z_{vtx} [mm];events", 200, -50.3, 149.7);
-    TFile* signalMCAnaFile = new TFile(signalMCAnaFilename_.c_str(), "READ");
+    TFile* signalMCAnaFile = process_.openInputFile(signalMCAnaFilename_);
     TH1F* mcAnaSimZ_h = (TH1F*)signalMCAnaFile->Get(("mcAna/mcAna_mc"+signal_pdgid+"Z_h").c_str()); 
     for(int i=0; i < 201; i++){
         signalSimZ_h_->SetBinContent(i,mcAnaSimZ_h->GetBinContent(i));
     }
-    signalMCAnaFile->Close();
-    delete signalMCAnaFile;
+    process_.closeInputFile(signalMCAnaFile);
 }
 
 void SimpZBiOptimizationProcessor::writeTH1F(TFile* outF, std::string folder, TH1F* h){
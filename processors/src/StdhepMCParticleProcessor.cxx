@@ -6,6 +6,7 @@
 
 #include "StdhepMCParticleProcessor.h" 
 #include "utilities.h"
+#include "TROOT.h"
 
 StdhepMCParticleProcessor::StdhepMCParticleProcessor(const std::string& name, Process& process)
     : Processor(name, process) { 
@@ -22,6 +23,7 @@ void StdhepMCParticleProcessor::configure(const ParameterSet& parameters) {
         mcPartCollRoot_ = parameters.getString("mcPartCollRoot", mcPartCollRoot_);
         maxEvent_ = parameters.getInteger("maxEvent",maxEvent_);
         skipEvent_ = parameters.getInteger("skipEvent",skipEvent_);   
+        batchSize_ = std::max(1, parameters.getInteger("batchSize",batchSize_));
     }
     catch (std::runtime_error& error)
     {
@@ -42,105 +44,148 @@ void StdhepMCParticleProcessor::initialize(std::string inFilename, std::string o
     tree_->Branch(mcPartCollRoot_.c_str(),&mc_particles_);
 }
 
-bool StdhepMCParticleProcessor::process() {
-    std::cout << "[StdhepMCParticleProcessor] Starting process()" << std::endl;
-       
-    std::cout << "opening file : " << inFilename_ << std::endl;
-    UTIL::LCStdHepRdr rdr(inFilename_.c_str());
-    rdr.printHeader();
-    std::stringstream description;
+void StdhepMCParticleProcessor::fillParticle(MCParticle* particle, IMPL::MCParticleImpl* lc_particle) {
 
-    description << " file generated with LCIO stdhepjob from "  << inFilename_;
+    //Set charge of HpsMCParticle
+    particle->setCharge(lc_particle->getCharge());
 
-    int count = skipEvent_;
+    // Set the HpsMCParticle type
+    particle->setTime(lc_particle->getTime());
 
-    try {
-     
-        while( maxEvent_ < 0  || count < maxEvent_ ){
-
-           if (mc_particles_.size() > 0){
-                for (std::vector<MCParticle*>::iterator it = mc_particles_.begin(); it != mc_particles_.end(); ++it){
-                    delete *it;
-                }
-                mc_particles_.clear();
-            }
-             
-            std::auto_ptr<IMPL::LCEventImpl> evt( new IMPL::LCEventImpl() ) ;
-            evt->setRunNumber(0) ;
-            evt->setEventNumber(count) ;
-             
-            // read the next stdhep event and add an MCParticle collection to the event
-            rdr.updateNextEvent(evt.get(),mcPartCollStdhep_.c_str()) ;
+    // Set the energy of the HpsMCParticle
+    particle->setEnergy(lc_particle->getEnergy());
 
-            //Get collection from event
-            EVENT::LCCollection* lc_particles{nullptr};
-            try
-            {
-                lc_particles = evt->getCollection(mcPartCollStdhep_.c_str());
-                //Loop through all particles in event
-                for (int iparticle = 0; iparticle < lc_particles->getNumberOfElements(); ++iparticle){
-                    //Get particle from LCEvent
-                    IMPL::MCParticleImpl* lc_particle = static_cast<IMPL::MCParticleImpl*>(lc_particles->getElementAt(iparticle));
+    // Set the momentum of the HpsMCParticle
+    particle->setMomentum(lc_particle->getMomentum());
 
-                    //Make MCParticle to build
-                    MCParticle* particle = new MCParticle();
+    // Set the momentum of HpsMCParticle at Endpoint
+    particle->setEndpointMomentum(lc_particle->getMomentumAtEndpoint());
 
-                    //Set charge of HpsMCParticle
-                    particle->setCharge(lc_particle->getCharge());
+    // Set the mass of the HpsMCParticle
+    particle->setMass(lc_particle->getMass());
 
-                    // Set the HpsMCParticle type
-                    particle->setTime(lc_particle->getTime());
+    // Set the PDG of the particle
+    particle->setPDG(lc_particle->getPDG());
 
-                    // Set the energy of the HpsMCParticle
-                    particle->setEnergy(lc_particle->getEnergy());
+    // Set the LCIO id of the particle
+    particle->setID(lc_particle->id());
 
-                    // Set the momentum of the HpsMCParticle
-                    particle->setMomentum(lc_particle->getMomentum());
+    // Set the PDG of the particle. Buffers are reused, so reset it if 
+    // there is no parent.
+    const EVENT::MCParticleVec& parentVec = lc_particle->getParents();
+    particle->setMomPDG(parentVec.size() > 0 ? parentVec.at(0)->getPDG() : -9999);
 
-                    // Set the momentum of HpsMCParticle at Endpoint
-                    particle->setEndpointMomentum(lc_particle->getMomentumAtEndpoint());
+    // Set the generator status of the particle
+    particle->setGenStatus(lc_particle->getGeneratorStatus());
 
-                    // Set the mass of the HpsMCParticle
-                    particle->setMass(lc_particle->getMass());
+    // Set the generator status of the particle
+    particle->setSimStatus(lc_particle->getSimulatorStatus());
 
-                    // Set the PDG of the particle
-                    particle->setPDG(lc_particle->getPDG());
+    // Set the vertex position of the particle
+    particle->setVertexPosition(lc_particle->getVertex());
 
-                    // Set the LCIO id of the particle
-                    particle->setID(lc_particle->id());
+    // Set the vertex position of the particle
+    particle->setEndPoint(lc_particle->getEndpoint());
+}
 
-                    // Set the PDG of the particle
-                    std::vector<EVENT::MCParticle*> parentVec = lc_particle->getParents();
-                    if(parentVec.size() > 0) particle->setMomPDG(parentVec.at(0)->getPDG());
+void StdhepMCParticleProcessor::readBatch(UTIL::LCStdHepRdr& rdr, EventBatch& batch, int& count) {
 
-                    // Set the generator status of the particle
-                    particle->setGenStatus(lc_particle->getGeneratorStatus());
+    batch.nevents = 0;
+    batch.end = false;
+    if (batch.events.size() < (std::size_t)batchSize_) { 
+        batch.events.resize(batchSize_);
+        batch.nparts.resize(batchSize_);
+    }
 
-                    // Set the generator status of the particle
-                    particle->setSimStatus(lc_particle->getSimulatorStatus());
-                    
-                    // Set the vertex position of the particle
-                    particle->setVertexPosition(lc_particle->getVertex());
+    try {
+        while (batch.nevents < batchSize_) {
 
-                    // Set the vertex position of the particle
-                    particle->setEndPoint(lc_particle->getEndpoint());
+            if (maxEvent_ >= 0 && count >= maxEvent_) {
+                batch.end = true;
+                return;
+            }
 
-                    mc_particles_.push_back(particle);
-                }
+            std::unique_ptr<IMPL::LCEventImpl> evt( new IMPL::LCEventImpl() ) ;
+            evt->setRunNumber(0) ;
+            evt->setEventNumber(count) ;
 
-                tree_->Fill();
+            // read the next stdhep event and add an MCParticle collection to the event
+            rdr.updateNextEvent(evt.get(),mcPartCollStdhep_.c_str()) ;
+            ++count ;
+
+            //Get collection from event
+            EVENT::LCCollection* lc_particles{nullptr};
+            try
+            {
+                lc_particles = evt->getCollection(mcPartCollStdhep_.c_str());
             }
             catch (EVENT::DataNotAvailableException e)
             {
                 std::cout << e.what() << std::endl;
+                continue;
             }
-             
-            ++count ;
-             
-        } // evt loop
-    }
 
+            // Convert the particles into the buffers of this batch slot, 
+            // allocating only when the slot has never held that many.
+            std::vector<MCParticle*>& particles = batch.events[batch.nevents];
+            int nparts = lc_particles->getNumberOfElements();
+            while (particles.size() < (std::size_t)nparts) particles.push_back(new MCParticle());
+            for (int iparticle = 0; iparticle < nparts; ++iparticle) {
+                fillParticle(particles[iparticle], 
+                        static_cast<IMPL::MCParticleImpl*>(lc_particles->getElementAt(iparticle)));
+            }
+            batch.nparts[batch.nevents] = nparts;
+            ++batch.nevents;
+        }
+    }
     catch( IO::EndOfDataException& e ) {  
+        batch.end = true;
+    }
+}
+
+bool StdhepMCParticleProcessor::process() {
+    std::cout << "[StdhepMCParticleProcessor] Starting process()" << std::endl;
+       
+    std::cout << "opening file : " << inFilename_ << std::endl;
+    UTIL::LCStdHepRdr rdr(inFilename_.c_str());
+    rdr.printHeader();
+
+    int count = skipEvent_;
+
+    // Two batches of events: the next batch is read from the stdhep file on 
+    // a helper thread while the current one is written to the tree.
+    ROOT::EnableThreadSafety();
+    EventBatch batches[2];
+    int current = 0;
+    std::future<void> next = std::async(std::launch::async, 
+            [this, &rdr, &batches, &count]() { readBatch(rdr, batches[0], count); });
+
+    while (true) { 
+
+        next.get();
+        EventBatch& batch = batches[current];
+        if (!batch.end) { 
+            EventBatch* following = &batches[1 - current];
+            next = std::async(std::launch::async, 
+                    [this, &rdr, following, &count]() { readBatch(rdr, *following, count); });
+        }
+
+        for (int ievent = 0; ievent < batch.nevents; ++ievent) { 
+            mc_particles_.assign(batch.events[ievent].begin(), 
+                    batch.events[ievent].begin() + batch.nparts[ievent]);
+            tree_->Fill();
+        }
+
+        if (batch.end) break;
+        current = 1 - current;
+    }
+
+    // The particles are owned by the batches
+    mc_particles_.clear();
+    for (auto& batch : batches) { 
+        for (auto& particles : batch.events) { 
+            for (auto particle : particles) delete particle;
+        }
     }
 
     std::cout << "  converted " << count <<  std::endl ;
@@ -1,7 +1,5 @@
 #include "SvtBl2DAnaProcessor.h"
 #include "TBranch.h"
-#include <fstream>
-#include <map>
 
 SvtBl2DAnaProcessor::SvtBl2DAnaProcessor(const std::string& name, Process& process) : Processor(name,process){
     mmapper_ = new ModuleMapper();
@@ -20,6 +18,11 @@ void SvtBl2DAnaProcessor::configure(const ParameterSet& parameters) {
         histCfgFilename_ = parameters.getString("histCfg");
         triggerBankColl_   = parameters.getString("triggerBankColl"); 
         triggerFilename_   = parameters.getString("triggerBankCfg"); 
+        flatRawHits_     = parameters.getInteger("flatRawHits", flatRawHits_);
+        nThreads_        = parameters.getInteger("nThreads", nThreads_);
+        lazyRawHits_     = parameters.getInteger("lazyRawHits", lazyRawHits_);
+        triggerUseStatus_ = parameters.getInteger("triggerUseStatus", triggerUseStatus_);
+        acceptAllTriggers_ = parameters.getInteger("acceptAllTriggers", acceptAllTriggers_);
     }
     catch (std::runtime_error& error)
     {
@@ -37,83 +40,58 @@ void SvtBl2DAnaProcessor::initialize(TTree* tree) {
 
     if (debug_ > 0) std::cout << "[SvtBl2DAnaProcessor] Define 2DHistos" << std::endl;
     svtCondHistos->Svt2DBlHistos::DefineHistos();
+    svtCondHistos->setThreads(nThreads_);
     if (debug_ > 0) std::cout << "[SvtBl2DAnaProcessor] Defined 2DHistos" << std::endl;
 
     tree_ = tree;
-    tree_->SetBranchAddress(rawSvtHitsColl_.c_str(), &rawSvtHits_, &brawSvtHits_);
+    if (flatRawHits_)
+        rawSvtHitArrays_.setBranchAddresses(tree_, rawSvtHitsColl_);
+    else
+        tree_->SetBranchAddress(rawSvtHitsColl_.c_str(), &rawSvtHits_, &brawSvtHits_);
     tree_->SetBranchAddress(triggerBankColl_.c_str(), &triggerBank_, &btriggerBank_);
     if (debug_ > 0) std::cout << "[SvtBl2DAnaProcessor] TTree Initialized" << std::endl;
 
     //Read triggerBankCollection configuration file to only run on specified triggers
+    triggerSelection_.setUseStatus(triggerUseStatus_);
+    triggerSelection_.setAcceptAll(acceptAllTriggers_);
     if(!triggerFilename_.empty()){
-        std::ifstream i_file(triggerFilename_);
-        i_file >> triggers_;
-        i_file.close();
+        triggerSelection_.load(triggerFilename_);
+    }
+    else if (!acceptAllTriggers_) {
+        std::cout << "[SvtBl2DAnaProcessor] WARNING: no trigger selection, all events are rejected" << std::endl;
+    }
+
+    //The raw hits are the bulk of the event: optionally only read them for the events passing the 
+    //trigger selection. Their branches are disabled on the shared tree, so no other processor can read them.
+    if (lazyRawHits_ && !triggerSelection_.empty()) {
+        //Only the branches read here: other collections may share the name as a prefix
+        std::vector<std::string> names = flatRawHits_ ? RawSvtHitArrays::branchNames(rawSvtHitsColl_)
+            : std::vector<std::string>{rawSvtHitsColl_};
+        for (auto& name : names) {
+            TBranch* branch = tree_->GetBranch(name.c_str());
+            if (!branch)
+                continue;
+            tree_->SetBranchStatus(name.c_str(), 0);
+            hitBranches_.push_back(branch);
+        }
     }
 }
 
 bool SvtBl2DAnaProcessor::process(IEvent* ievent) {
 
     TSData* tsdata = (TSData*) triggerBank_;
-    
-    //Build binary map of triggers based on TSData.h
-    //make this just trigger map
-    //add random -> tsdata->ext.Pulsar
-    prescaledtriggerMap_["Single_0_Top"] = tsdata->prescaled.Single_0_Top;  
-    prescaledtriggerMap_["Single_1_Top"] = tsdata->prescaled.Single_1_Top; 
-    prescaledtriggerMap_["Single_2_Top"] = tsdata->prescaled.Single_2_Top; 
-    prescaledtriggerMap_["Single_3_Top"] = tsdata->prescaled.Single_3_Top; 
-    prescaledtriggerMap_["Single_0_Bot"] = tsdata->prescaled.Single_0_Bot; 
-    prescaledtriggerMap_["Single_1_Bot"] = tsdata->prescaled.Single_1_Bot; 
-    prescaledtriggerMap_["Single_2_Bot"] = tsdata->prescaled.Single_2_Bot; 
-    prescaledtriggerMap_["Single_3_Bot"] = tsdata->prescaled.Single_3_Bot; 
-    prescaledtriggerMap_["Pair_0      "] = tsdata->prescaled.Pair_0      ; 
-    prescaledtriggerMap_["Pair_1      "] = tsdata->prescaled.Pair_1      ; 
-    prescaledtriggerMap_["Pair_2      "] = tsdata->prescaled.Pair_2      ; 
-    prescaledtriggerMap_["Pair_3      "] = tsdata->prescaled.Pair_3      ; 
-    prescaledtriggerMap_["LED         "] = tsdata->prescaled.LED         ; 
-    prescaledtriggerMap_["Cosmic      "] = tsdata->prescaled.Cosmic      ; 
-    prescaledtriggerMap_["Hodoscope   "] = tsdata->prescaled.Hodoscope   ; 
-    prescaledtriggerMap_["Pulser      "] = tsdata->prescaled.Pulser      ; 
-    prescaledtriggerMap_["Mult_0      "] = tsdata->prescaled.Mult_0      ; 
-    prescaledtriggerMap_["Mult_1      "] = tsdata->prescaled.Mult_1      ;
-    prescaledtriggerMap_["FEE_Top     "] = tsdata->prescaled.FEE_Top     ;
-    prescaledtriggerMap_["FEE_Bot     "] = tsdata->prescaled.FEE_Bot     ;   
-
-    //dont need ext trigger map to require specific triggers
-    //unless we want to require randoms
-    exttriggerMap_["Single_0_Top"] = tsdata->ext.Single_0_Top; 
-    exttriggerMap_["Single_1_Top"] = tsdata->ext.Single_1_Top; 
-    exttriggerMap_["Single_2_Top"] = tsdata->ext.Single_2_Top; 
-    exttriggerMap_["Single_3_Top"] = tsdata->ext.Single_3_Top; 
-    exttriggerMap_["Single_0_Bot"] = tsdata->ext.Single_0_Bot; 
-    exttriggerMap_["Single_1_Bot"] = tsdata->ext.Single_1_Bot; 
-    exttriggerMap_["Single_2_Bot"] = tsdata->ext.Single_2_Bot; 
-    exttriggerMap_["Single_3_Bot"] = tsdata->ext.Single_3_Bot; 
-    exttriggerMap_["Pair_0      "] = tsdata->ext.Pair_0      ; 
-    exttriggerMap_["Pair_1      "] = tsdata->ext.Pair_1      ; 
-    exttriggerMap_["Pair_2      "] = tsdata->ext.Pair_2      ; 
-    exttriggerMap_["Pair_3      "] = tsdata->ext.Pair_3      ; 
-    exttriggerMap_["LED         "] = tsdata->ext.LED         ; 
-    exttriggerMap_["Cosmic      "] = tsdata->ext.Cosmic      ; 
-    exttriggerMap_["Hodoscope   "] = tsdata->ext.Hodoscope   ; 
-    exttriggerMap_["Pulser      "] = tsdata->ext.Pulser      ; 
-    exttriggerMap_["Mult_0      "] = tsdata->ext.Mult_0      ; 
-    exttriggerMap_["Mult_1      "] = tsdata->ext.Mult_1      ;
-    exttriggerMap_["FEE_Top     "] = tsdata->ext.FEE_Top     ;
-    exttriggerMap_["FEE_Bot     "] = tsdata->ext.FEE_Bot     ;   
-    
-    bool triggerFound = false;
-    for (auto trigger : triggers_.items()){
-        if ( (prescaledtriggerMap_[trigger.key()] > 0) || (exttriggerMap_[trigger.key()]) > 0 ){
-            triggerFound = true;
-        }
-    }
 
-    if (!triggerFound)
+    if (!triggerSelection_.pass(tsdata))
         return true;
+
+    Long64_t entry = tree_->GetReadEntry();
+    for (auto branch : hitBranches_)
+        branch->GetEntry(entry, 1);
     
-    svtCondHistos->FillHistograms(rawSvtHits_,1.);
+    if (flatRawHits_)
+        svtCondHistos->FillHistograms(rawSvtHitArrays_,1.);
+    else
+        svtCondHistos->FillHistograms(rawSvtHits_,1.);
 
     return true;
 }
@@ -10,8 +10,8 @@ SvtDataProcessor::~SvtDataProcessor() {
 
 void SvtDataProcessor::initialize(TTree* tree) {
     // Add branches to tree
-    tree->Branch(Collections::GBL_TRACKS, &tracks_);
-    tree->Branch(Collections::TRACKER_HITS, &hits_);
+    addCollection(tree, Collections::GBL_TRACKS, &tracks_);
+    addCollection(tree, Collections::TRACKER_HITS, &hits_);
 }
 
 bool SvtDataProcessor::process(IEvent* ievent) {
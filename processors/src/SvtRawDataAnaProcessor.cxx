@@ -4,7 +4,9 @@
  * @author Cameron Bravo, SLAC National Accelerator Laboratory
  */     
 #include "SvtRawDataAnaProcessor.h"
+#include "IndexRefs.h"
 
+#include <fstream>
 #include <iostream>
 
 SvtRawDataAnaProcessor::SvtRawDataAnaProcessor(const std::string& name, Process& process) : Processor(name,process){
@@ -30,6 +32,10 @@ void SvtRawDataAnaProcessor::configure(const ParameterSet& parameters) {
         baselineFile_ = parameters.getString("baselineFile");
         timeProfiles_ = parameters.getString("timeProfiles");
         tphase_ = parameters.getInteger("tphase");
+        fspHitColl_ = parameters.getString("fspHitColl", fspHitColl_);
+        fspRawHitColl_ = parameters.getString("fspRawHitColl", fspRawHitColl_);
+        channelStatsFile_ = parameters.getString("channelStatsFile", channelStatsFile_);
+        hybridStatsFile_ = parameters.getString("hybridStatsFile", hybridStatsFile_);
     }
     catch (std::runtime_error& error)
     {
@@ -222,6 +228,14 @@ void SvtRawDataAnaProcessor::initialize(TTree* tree) {
     //tree_->SetBranchAddress("RecoEcalClusters",&recoClu_,&brecoClu_ );
     //tree_->SetBranchAddress("KalmanFullTracks",&Trk_,&bTrk_);
     tree_->SetBranchAddress("FinalStateParticles_KF",&Part_,&bPart_);
+    // Hits and raw hits on track are only needed to resolve index based references
+    fspHitColl_ = IndexRefs::findTarget(tree_, "FinalStateParticles_KF", fspHitColl_);
+    if (!fspHitColl_.empty())
+        fspRawHitColl_ = IndexRefs::findTarget(tree_, fspHitColl_, fspRawHitColl_);
+    if (!fspHitColl_.empty())
+        tree_->SetBranchAddress(fspHitColl_.c_str(),&fspHits_,&bfspHits_);
+    if (!fspRawHitColl_.empty())
+        tree_->SetBranchAddress(fspRawHitColl_.c_str(),&fspRawHits_,&bfspRawHits_);
     tree_->SetBranchAddress("EventHeader",&evH_,&bevH_);
     
     for (unsigned int i_reg = 0; i_reg < regionSelections_.size(); i_reg++) 
@@ -238,6 +252,8 @@ void SvtRawDataAnaProcessor::initialize(TTree* tree) {
         reg_histos_[regname]->DefineHistos();
 
         regions_.push_back(regname);
+        if (!channelStatsFile_.empty() || !hybridStatsFile_.empty())
+            hitStats_[regname].reset(new RegionHitStats());
     }
 }
 
@@ -281,11 +297,14 @@ bool SvtRawDataAnaProcessor::process(IEvent* ievent) {
                 if(Part_->at(i)->getCluster().getEnergy()<0){continue;}
                 if(not((Part_->at(i)->getCluster().getTime()<=40)and(Part_->at(i)->getCluster().getTime()>=36))){continue;}
                 //std::cout<<"For each Tracker Hit I now print out Raw Hit Info: "<<std::endl;
-                for(int j = 0; j<Part_->at(i)->getTrack().getSvtHits().GetEntries();j++){
-                    TrackerHit * tHit = (TrackerHit*)(Part_->at(i)->getTrack().getSvtHits().At(j));
+                Track track = Part_->at(i)->getTrack();
+                for(int j = 0; j<track.getNSvtHits();j++){
+                    TrackerHit * tHit = track.getSvtHit(j, fspHits_);
+                    if(!tHit){continue;}
                     //std::cout<<tHit->getTime()<<std::endl;
-                    for(int k = 0;k<tHit->getRawHits().GetEntries();k++){
-                        RawSvtHit * rHit = (RawSvtHit*)(tHit->getRawHits().At(k));
+                    for(int k = 0;k<tHit->getNRawHits();k++){
+                        RawSvtHit * rHit = tHit->getRawHit(k, fspRawHits_);
+                        if(!rHit){continue;}
                         if(rHit->getT0(0)==thisHit->getT0(0)){Continue=false;}
                         //std::cout<<"Raw Hit T0: "<<rHit->getT0(0)<<std::endl;
                     }
@@ -381,6 +400,9 @@ bool SvtRawDataAnaProcessor::process(IEvent* ievent) {
                 }
 
                 reg_histos_[regions_[i_reg]]->FillHistograms(thisHit,weight,J,i,TimeDiff,AmpDiff);
+                if(!hitStats_.empty()){
+                    fillHitStats(thisHit,regions_[i_reg],J);
+                }
             }
             }
         }
@@ -399,15 +421,9 @@ bool SvtRawDataAnaProcessor::process(IEvent* ievent) {
      */
 
     void SvtRawDataAnaProcessor::sample(RawSvtHit* thisHit,std::string word, IEvent* ievent,long T,int N){
-        auto mod = std::to_string(thisHit->getModule());
-        auto lay = std::to_string(thisHit->getLayer());
-        //swTag= mmapper_->getStringFromSw("ly"+lay+"_m"+mod);
-        std::string helper = mmapper_->getHwFromSw("ly"+lay+"_m"+mod); 
-        //std::cout<<helper<<std::endl;
-        char char_array[helper.length()+1];
-        std::strcpy(char_array,helper.c_str());
-        int feb = (int)char_array[1]-48;
-        int hyb = (int)char_array[3]-48;
+        int feb, hyb;
+        mmapper_->getFebHybridFromSw(thisHit->getLayer(), thisHit->getModule(), feb, hyb);
+        if(feb<0){return;}
         
         
         if((feb>=2)and(word=="OneFit")){return;}
@@ -417,13 +433,7 @@ bool SvtRawDataAnaProcessor::process(IEvent* ievent) {
         
         
         //std::cout<<"Feb "<<feb<<" ,Hyb "<<hyb<<" ,Baseline Feb<=1: "<<baseErr1_[0][0][(int)thisHit->getStrip()][0]<<" ,Baseline Feb>1: "<<baseErr1_[0][1][(int)thisHit->getStrip()][0]<<" More Baselines "<<baseErr1_[0][2][(int)thisHit->getStrip()][0]<<" ,Baseline Feb>1: "<<baseErr1_[0][3][(int)thisHit->getStrip()][0]<<std::endl;
-        int BigCount = 0;
-        if(feb<=1){
-            BigCount+=feb*2048+hyb*512+(int)(thisHit->getStrip());
-        }else{
-            BigCount+=4096;
-            BigCount+=(feb-2)*2560+hyb*640+(int)(thisHit->getStrip());
-        }
+        int BigCount = getSvtChannel(feb,hyb,(int)(thisHit->getStrip()));
         //std::cout<<"READ HERE "<<BigCount<<" "<<feb<<" "<<hyb<<" "<<(int)thisHit->getStrip()<<" "<<baseErr1_[feb][hyb][(int)thisHit->getStrip()][0]<<std::endl;
         int * adcs2=thisHit->getADCs(); 
         //std::cout<<regions_[i_reg]<<" "<<readout<<std::endl;
@@ -589,8 +599,58 @@ bool SvtRawDataAnaProcessor::process(IEvent* ievent) {
      *
      */
 
+    void SvtRawDataAnaProcessor::fillHitStats(RawSvtHit* hit, const std::string& region, int fit){
+        int feb, hyb;
+        mmapper_->getFebHybridFromSw(hit->getLayer(), hit->getModule(), feb, hyb);
+        if(feb<0){return;}
+        RegionHitStats& stats = *hitStats_[region];
+        int channel = getSvtChannel(feb,hyb,(int)(hit->getStrip()));
+        stats.t0[channel].fill(hit->getT0(fit));
+        stats.amp[channel].fill(hit->getAmp(fit));
+        stats.hybridT0[feb*4+hyb].fill(hit->getT0(fit));
+    }
+
+    /*
+     *WRITES THE HIT STATISTICS OF EACH REGION: MEAN AND RMS OF THE TIME AND AMPLITUDE PER CHANNEL, 
+     MEDIAN AND 68% WINDOW OF THE TIME PER HYBRID. CHANNELS AND HYBRIDS WITHOUT HITS ARE LEFT OUT.
+     *
+     */
+
+    void SvtRawDataAnaProcessor::writeHitStats() const {
+        if(!channelStatsFile_.empty()){
+            std::ofstream channelFile(channelStatsFile_);
+            channelFile << "region,channel,entries,t0_mean,t0_rms,amp_mean,amp_rms\n";
+            for(auto& region : hitStats_){
+                const RegionHitStats& stats = *region.second;
+                for(int channel = 0; channel < N_SVT_CHANNELS; channel++){
+                    if(stats.t0[channel].getEntries()==0){continue;}
+                    channelFile << region.first << "," << channel << "," << stats.t0[channel].getEntries() << ","
+                        << stats.t0[channel].getMean() << "," << stats.t0[channel].getRMS() << ","
+                        << stats.amp[channel].getMean() << "," << stats.amp[channel].getRMS() << "\n";
+                }
+            }
+        }
+        if(!hybridStatsFile_.empty()){
+            std::ofstream hybridFile(hybridStatsFile_);
+            hybridFile << "region,feb,hybrid,entries,t0_median,t0_q16,t0_q84\n";
+            for(auto& region : hitStats_){
+                const RegionHitStats& stats = *region.second;
+                for(int hybrid = 0; hybrid < N_SVT_HYBRIDS; hybrid++){
+                    const BinnedCounts& t0 = stats.hybridT0[hybrid];
+                    if(t0.getEntries()==0){continue;}
+                    hybridFile << region.first << "," << hybrid/4 << "," << hybrid%4 << "," << t0.getEntries() << ","
+                        << t0.getQuantile(0.5) << "," << t0.getQuantile(0.16) << "," << t0.getQuantile(0.84) << "\n";
+                }
+            }
+        }
+    }
+
     void SvtRawDataAnaProcessor::finalize() {
 
+        if(!hitStats_.empty()){
+            writeHitStats();
+        }
+
         outF_->cd();
         for(reg_it it = reg_histos_.begin(); it!=reg_histos_.end(); ++it){
             std::string dirName = it->first;
@@ -22,6 +22,7 @@ void SvtRawDataProcessor::configure(const ParameterSet& parameters) {
         hitCollLcio_   = parameters.getString("hitCollLcio", hitCollLcio_);
         hitfitCollLcio_   = parameters.getString("hitfitCollLcio", hitfitCollLcio_);
         hitCollRoot_   = parameters.getString("hitCollRoot", hitCollRoot_);
+        flatOutput_    = parameters.getInteger("flatOutput", flatOutput_);
     }
     catch (std::runtime_error& error)
     {
@@ -32,7 +33,13 @@ void SvtRawDataProcessor::configure(const ParameterSet& parameters) {
 
 void SvtRawDataProcessor::initialize(TTree* tree) {
 
-    tree->Branch(hitCollRoot_.c_str(),&rawhits_);
+    if (flatOutput_)
+        rawhitArrays_.branch(tree, hitCollRoot_);
+    else
+        addCollection(tree, hitCollRoot_, &rawhits_);
+
+    // Optional input collection
+    hitfitCollID_ = Event::getLCCollectionID(hitfitCollLcio_);
 }
 
 bool SvtRawDataProcessor::process(IEvent* ievent) {
@@ -52,22 +59,26 @@ bool SvtRawDataProcessor::process(IEvent* ievent) {
     }
 
     //Check to see if fits are in the file
-    auto evColls = event->getLCEvent()->getCollectionNames();
-    auto it = std::find (evColls->begin(), evColls->end(), hitfitCollLcio_.c_str());
-    bool hasFits = true;
-    EVENT::LCCollection* raw_svt_hit_fits;
-    if(it == evColls->end()) hasFits = false;
+    EVENT::LCCollection* raw_svt_hit_fits = event->tryGetLCCollection(hitfitCollID_);
+    bool hasFits = raw_svt_hit_fits != nullptr;
     if(hasFits) 
     {
-        raw_svt_hit_fits = event->getLCCollection(hitfitCollLcio_.c_str()); 
         // Heap an LCRelation navigator which will allow faster access 
         rawTracker_hit_fits_nav = new UTIL::LCRelationNavigator(raw_svt_hit_fits);
 
     }
 
-    // Get decoders to read cellids
-    UTIL::BitField64 decoder("system:6,barrel:3,layer:4,module:12,sensor:1,side:32:-2,strip:12");
-    //decoder[field] returns the value
+    // The cellids are decoded with the compiled cellid::Svt layout. In debug 
+    // mode every decoded id is checked against the LCIO decoder.
+    std::unique_ptr<UTIL::BitField64> decoder;
+    if (debug_ > 0)
+        decoder.reset(new UTIL::BitField64("system:6,barrel:3,layer:4,module:12,sensor:1,side:32:-2,strip:12"));
+
+    if (flatOutput_) {
+        fillArrays(raw_svt_hits, hasFits ? rawTracker_hit_fits_nav : nullptr, decoder.get());
+        if (hasFits) delete rawTracker_hit_fits_nav;
+        return true;
+    }
 
     // Loop over all of the raw SVT hits in the LCIO event and add them to the 
     // HPS event
@@ -80,29 +91,30 @@ bool SvtRawDataProcessor::process(IEvent* ievent) {
         EVENT::TrackerRawData* rawTracker_hit 
             = static_cast<EVENT::TrackerRawData*>(raw_svt_hits->getElementAt(ihit));
         //Decode the cellid
-        EVENT::long64 value = EVENT::long64( rawTracker_hit->getCellID0() & 0xffffffff ) | 
-            ( EVENT::long64( rawTracker_hit->getCellID1() ) << 32 ) ;
-        decoder.setValue(value);
+        EVENT::long64 value = cellid::value(rawTracker_hit->getCellID0(), rawTracker_hit->getCellID1());
+        cellid::SvtID id = cellid::Svt::decode(value);
+        if (decoder) utils::checkSvtCellID(*decoder, value, id);
 
         // Add a raw tracker hit to the event
         RawSvtHit* rawHit = new RawSvtHit();
 
-        rawHit->setSystem(decoder["system"]);
-        rawHit->setBarrel(decoder["barrel"]);
-        rawHit->setLayer(decoder["layer"]);
-        rawHit->setModule(decoder["module"]);
-        rawHit->setSensor(decoder["sensor"]);
-        rawHit->setSide(decoder["side"]);
-        rawHit->setStrip(decoder["strip"]);
+        rawHit->setSystem(id.system);
+        rawHit->setBarrel(id.barrel);
+        rawHit->setLayer(id.layer);
+        rawHit->setModule(id.module);
+        rawHit->setSensor(id.sensor);
+        rawHit->setSide(id.side);
+        rawHit->setStrip(id.strip);
 
         // Extract ADC values for this hit
+        const EVENT::ShortVec& adcs = rawTracker_hit->getADCValues();
         int hit_adcs[6] = { 
-            (int)rawTracker_hit->getADCValues().at(0), 
-            (int)rawTracker_hit->getADCValues().at(1), 
-            (int)rawTracker_hit->getADCValues().at(2), 
-            (int)rawTracker_hit->getADCValues().at(3), 
-            (int)rawTracker_hit->getADCValues().at(4), 
-            (int)rawTracker_hit->getADCValues().at(5)
+            (int)adcs.at(0), 
+            (int)adcs.at(1), 
+            (int)adcs.at(2), 
+            (int)adcs.at(3), 
+            (int)adcs.at(4), 
+            (int)adcs.at(5)
         };
         rawHit->setADCs(hit_adcs);
 
@@ -147,6 +159,45 @@ bool SvtRawDataProcessor::process(IEvent* ievent) {
     return true;
 }
 
+void SvtRawDataProcessor::fillArrays(EVENT::LCCollection* raw_svt_hits, 
+        UTIL::LCRelationNavigator* fits_nav, UTIL::BitField64* decoder) {
+
+    rawhitArrays_.clear();
+    rawhitArrays_.reserve(raw_svt_hits->getNumberOfElements());
+
+    for (int ihit = 0; ihit < raw_svt_hits->getNumberOfElements(); ++ihit) {
+
+        EVENT::TrackerRawData* rawTracker_hit 
+            = static_cast<EVENT::TrackerRawData*>(raw_svt_hits->getElementAt(ihit));
+
+        //Decode the cellid
+        EVENT::long64 value = cellid::value(rawTracker_hit->getCellID0(), rawTracker_hit->getCellID1());
+        cellid::SvtID id = cellid::Svt::decode(value);
+        if (decoder) utils::checkSvtCellID(*decoder, value, id);
+
+        const EVENT::ShortVec& adcs = rawTracker_hit->getADCValues();
+        if (adcs.size() < (std::size_t)RawSvtHitArrays::N_ADCS)
+            throw std::runtime_error("[ SvtRawDataProcessor ]: Raw hit with less than 6 adc samples.");
+
+        std::size_t ihit_out = rawhitArrays_.addHit(id.system, id.barrel, id.layer, id.module, 
+                id.sensor, id.side, id.strip, adcs.data());
+
+        if (!fits_nav) continue;
+
+        // Get the list of fit params associated with the raw tracker hit
+        const EVENT::LCObjectVec& fits = fits_nav->getRelatedToObjects(rawTracker_hit);
+        int nfits = std::min<int>(fits.size(), RawSvtHitArrays::N_FITS);
+        for (int ifit = 0; ifit < nfits; ++ifit) {
+            IMPL::LCGenericObjectImpl* hit_fit_param = static_cast<IMPL::LCGenericObjectImpl*>(fits.at(ifit));
+            double fit_params[RawSvtHitArrays::N_FIT_PARS];
+            for (int ipar = 0; ipar < RawSvtHitArrays::N_FIT_PARS; ++ipar)
+                fit_params[ipar] = hit_fit_param->getDoubleVal(ipar);
+            rawhitArrays_.setFit(ihit_out, ifit, fit_params);
+        }
+        rawhitArrays_.setFitN(ihit_out, fits.size());
+    }
+}
+
 void SvtRawDataProcessor::finalize() { 
 }
 
@@ -1,6 +1,7 @@
 #include "TrackHitAnaProcessor.h"
 #include <iomanip>
 #include "utilities.h"
+#include "IndexRefs.h"
 
 TrackHitAnaProcessor::TrackHitAnaProcessor(const std::string& name, Process& process)
     : Processor(name, process) { 
@@ -16,6 +17,7 @@ void TrackHitAnaProcessor::configure(const ParameterSet& parameters) {
     {
         debug_                = parameters.getInteger("debug",debug_);
         trkCollName_          = parameters.getString("trkCollName",trkCollName_);
+        hitCollName_          = parameters.getString("hitCollName",hitCollName_);
         histCfgFilename_      = parameters.getString("histCfg",histCfgFilename_);
         doTruth_              = (bool) parameters.getInteger("doTruth",doTruth_);
         truthHistCfgFilename_ = parameters.getString("truthHistCfg",truthHistCfgFilename_);
@@ -38,6 +40,10 @@ void TrackHitAnaProcessor::initialize(TTree* tree) {
     trkHistos_->DefineHistos();
     // Init tree
     tree->SetBranchAddress(trkCollName_.c_str(), &tracks_, &btracks_);
+    // Hits are only needed to resolve index based track->hit references
+    hitCollName_ = IndexRefs::findTarget(tree, trkCollName_, hitCollName_);
+    if (!hitCollName_.empty())
+        tree->SetBranchAddress(hitCollName_.c_str(), &hits_, &bhits_);
     
     if (!selectionCfg_.empty()) {
         trkSelector_ = std::make_shared<BaseSelector>(name_+"_trkSelector",selectionCfg_);
@@ -111,8 +117,9 @@ bool TrackHitAnaProcessor::process(IEvent* ievent) {
         std::vector<int> hit_layers;
         int hitCode = 0;
         int n12hits = 0;
-        for (int ihit = 0; ihit<track->getSvtHits().GetEntries(); ++ihit) {
-            TrackerHit* hit = (TrackerHit*) track->getSvtHits().At(ihit);
+        for (int ihit = 0; ihit<track->getNSvtHits(); ++ihit) {
+            TrackerHit* hit = track->getSvtHit(ihit, hits_);
+            if (!hit) continue;
             int layer = hit->getLayer();
             hit_layers.push_back(layer);
             if (isKF)
@@ -135,7 +142,7 @@ bool TrackHitAnaProcessor::process(IEvent* ievent) {
 
         trkHistos_->Fill1DHisto("hitCode_h", hitCode);
         trkHistos_->Fill2DHisto("hitCode_trkType_hh", hitCode, trkType);
-        trkHistos_->Fill1DTrack(track, weight, "");
+        trkHistos_->Fill1DTrack(track, weight, "", hits_);
 
         n_sel_tracks++;
 
@@ -158,10 +165,10 @@ bool TrackHitAnaProcessor::process(IEvent* ievent) {
 
             if(debug_) std::cout<<"Pass region "<<region<<std::endl;
             reg_histos_[region]->Fill1DHisto("hitCode_h", hitCode,weight);
-            if(isTop&&isPos) reg_histos_[region]->Fill1DTrack(track, weight, "topPos_");
-            if(isTop&&!isPos) reg_histos_[region]->Fill1DTrack(track, weight, "topEle_");
-            if(!isTop&&isPos) reg_histos_[region]->Fill1DTrack(track, weight, "botPos_");
-            if(!isTop&&!isPos) reg_histos_[region]->Fill1DTrack(track, weight, "botEle_");
+            if(isTop&&isPos) reg_histos_[region]->Fill1DTrack(track, weight, "topPos_", hits_);
+            if(isTop&&!isPos) reg_histos_[region]->Fill1DTrack(track, weight, "topEle_", hits_);
+            if(!isTop&&isPos) reg_histos_[region]->Fill1DTrack(track, weight, "botPos_", hits_);
+            if(!isTop&&!isPos) reg_histos_[region]->Fill1DTrack(track, weight, "botEle_", hits_);
         }
     }//Loop on tracks
 
@@ -27,7 +27,11 @@ void Tracker2DHitProcessor::configure(const ParameterSet& parameters) {
 
 void Tracker2DHitProcessor::initialize(TTree* tree) {
     // Add branches to tree
-    tree->Branch(hitCollRoot_.c_str(), &hits_);
+    addCollection(tree, hitCollRoot_, &hits_);
+
+    // Optional input collections
+    hitFitCollID_ = Event::getLCCollectionID(hitFitCollLcio_);
+    mcPartRelID_ = Event::getLCCollectionID(mcPartRelLcio_);
 }
 
 bool Tracker2DHitProcessor::process(IEvent* ievent) {
@@ -52,26 +56,19 @@ bool Tracker2DHitProcessor::process(IEvent* ievent) {
     }
 
     //Check to see if fits are in the file
-    auto evColls = event->getLCEvent()->getCollectionNames();
-    auto it = std::find (evColls->begin(), evColls->end(), hitFitCollLcio_.c_str());
-    bool hasFits = true;
-    EVENT::LCCollection* raw_svt_hit_fits;
-    if(it == evColls->end()) hasFits = false;
+    EVENT::LCCollection* raw_svt_hit_fits = event->tryGetLCCollection(hitFitCollID_);
+    bool hasFits = raw_svt_hit_fits != nullptr;
     if(hasFits)
     {
-        raw_svt_hit_fits = event->getLCCollection(hitFitCollLcio_.c_str());
         // Heap an LCRelation navigator which will allow faster access 
         rawTracker_hit_fits_nav = new UTIL::LCRelationNavigator(raw_svt_hit_fits);
     }
 
     //Check to see if MC Particles are in the file
-    it = std::find (evColls->begin(), evColls->end(), mcPartRelLcio_.c_str());
-    bool hasMCParts = true;
-    EVENT::LCCollection* mcPartRel;
-    if(it == evColls->end()) hasMCParts = false;
+    EVENT::LCCollection* mcPartRel = event->tryGetLCCollection(mcPartRelID_);
+    bool hasMCParts = mcPartRel != nullptr;
     if(hasMCParts)
     {
-        mcPartRel = event->getLCCollection(mcPartRelLcio_.c_str());
         // Heap an LCRelation navigator which will allow faster access 
         mcPartRel_nav = new UTIL::LCRelationNavigator(mcPartRel);
 
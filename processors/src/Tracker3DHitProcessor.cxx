@@ -26,7 +26,10 @@ void Tracker3DHitProcessor::configure(const ParameterSet& parameters) {
 
 void Tracker3DHitProcessor::initialize(TTree* tree) {
     // Add branches to tree
-    tree->Branch(hitCollRoot_.c_str(), &hits_);
+    addCollection(tree, hitCollRoot_, &hits_);
+
+    // Optional input collection
+    mcPartRelID_ = Event::getLCCollectionID(mcPartRelLcio_);
 }
 
 bool Tracker3DHitProcessor::process(IEvent* ievent) {
@@ -50,14 +53,10 @@ bool Tracker3DHitProcessor::process(IEvent* ievent) {
     }
 
     //Check to see if MC Particles are in the file
-    auto evColls = event->getLCEvent()->getCollectionNames();
-    auto it = std::find (evColls->begin(), evColls->end(), mcPartRelLcio_.c_str());
-    bool hasMCParts = true;
-    EVENT::LCCollection* mcPartRel;
-    if(it == evColls->end()) hasMCParts = false;
+    EVENT::LCCollection* mcPartRel = event->tryGetLCCollection(mcPartRelID_);
+    bool hasMCParts = mcPartRel != nullptr;
     if(hasMCParts)
     {
-        mcPartRel = event->getLCCollection(mcPartRelLcio_.c_str());
         // Heap an LCRelation navigator which will allow faster access 
         mcPartRel_nav = new UTIL::LCRelationNavigator(mcPartRel);
 
@@ -1,5 +1,6 @@
 
 #include "TrackingProcessor.h" 
+#include "IndexRefs.h"
 #include "utilities.h"
 
 TrackingProcessor::TrackingProcessor(const std::string& name, Process& process)
@@ -26,6 +27,7 @@ void TrackingProcessor::configure(const ParameterSet& parameters) {
         truthTracksCollRoot_     = parameters.getString("truthTrackCollRoot",truthTracksCollRoot_);
         bfield_                  = parameters.getDouble("bfield",bfield_);
         trackStateLocation_      = parameters.getString("trackStateLocation",trackStateLocation_);
+        useIndexRefs_            = parameters.getInteger("useIndexRefs",useIndexRefs_);
 
         //Residual plotting is done in this processor for the moment.
         doResiduals_             = parameters.getInteger("doResiduals",doResiduals_);
@@ -42,16 +44,24 @@ void TrackingProcessor::configure(const ParameterSet& parameters) {
 }
 
 void TrackingProcessor::initialize(TTree* tree) {
-    tree->Branch(trkCollRoot_.c_str(), &tracks_);
+    addCollection(tree, trkCollRoot_, &tracks_);
     
     if (!trkhitCollRoot_.empty())
-        tree->Branch(trkhitCollRoot_.c_str(), &hits_);
+        addCollection(tree, trkhitCollRoot_, &hits_);
     
     if (!rawhitCollRoot_.empty())
-        tree->Branch(rawhitCollRoot_.c_str(), &rawhits_);
+        addCollection(tree, rawhitCollRoot_, &rawhits_);
     
     if (!truthTracksCollRoot_.empty())
-        tree->Branch(truthTracksCollRoot_.c_str(),&truthTracks_);
+        addCollection(tree, truthTracksCollRoot_, &truthTracks_);
+
+    // Let the readers find the collections the indices point into
+    if (useIndexRefs_) { 
+        if (!trkhitCollRoot_.empty())
+            IndexRefs::setTarget(tree, trkCollRoot_, trkhitCollRoot_);
+        if (!trkhitCollRoot_.empty() && !rawhitCollRoot_.empty())
+            IndexRefs::setTarget(tree, trkhitCollRoot_, rawhitCollRoot_);
+    }
 
 
     //Residual plotting
@@ -62,7 +72,13 @@ void TrackingProcessor::initialize(TTree* tree) {
         trkResHistos_->doTrackComparisonPlots(false);
         trkResHistos_->DefineHistos();
     }
-    
+
+    // Optional input collections
+    kinkRelCollID_ = Event::getLCCollectionID(kinkRelCollLcio_);
+    trkRelCollID_ = Event::getLCCollectionID(trkRelCollLcio_);
+    hitFitsCollID_ = Event::getLCCollectionID(hitFitsCollLcio_);
+    truthTracksCollID_ = Event::getLCCollectionID(truthTracksCollLcio_);
+    trackResDataID_ = Event::getLCCollectionID(trackResDataLcio_);
 }
 
 bool TrackingProcessor::process(IEvent* ievent) {
@@ -100,19 +116,12 @@ bool TrackingProcessor::process(IEvent* ievent) {
     // Get the collection of 3D hits from the LCIO event. If no such collection 
     // exist, a DataNotAvailableException is thrown
     
-    // Get decoders to read cellids
-    UTIL::BitField64 decoder("system:6,barrel:3,layer:4,module:12,sensor:1,side:32:-2,strip:12");
-
     UTIL::LCRelationNavigator* rawTracker_hit_fits_nav = nullptr;
-    EVENT::LCCollection* raw_svt_hit_fits              = nullptr;
     //Check to see if fits are in the file
-    auto evColls = event->getLCEvent()->getCollectionNames();
-    auto it = std::find (evColls->begin(), evColls->end(), hitFitsCollLcio_.c_str());
-    bool hasFits = true;
-    if(it == evColls->end()) hasFits = false;
+    EVENT::LCCollection* raw_svt_hit_fits = event->tryGetLCCollection(hitFitsCollID_);
+    bool hasFits = raw_svt_hit_fits != nullptr;
     if(hasFits) 
     {
-        raw_svt_hit_fits = event->getLCCollection(hitFitsCollLcio_.c_str()); 
         // Heap an LCRelation navigator which will allow faster access 
         rawTracker_hit_fits_nav = new UTIL::LCRelationNavigator(raw_svt_hit_fits);     
     }
@@ -150,27 +159,17 @@ bool TrackingProcessor::process(IEvent* ievent) {
 
         // Get the collection of LCRelations between GBL kink data and track data variables 
         // and the corresponding track.
-        EVENT::LCCollection* gbl_kink_data{nullptr};
-        EVENT::LCCollection* track_data{nullptr};
-        try
-        {
-            if (!kinkRelCollLcio_.empty())
-                gbl_kink_data = static_cast<EVENT::LCCollection*>(event->getLCCollection(kinkRelCollLcio_.c_str()));
-            if (!trkRelCollLcio_.empty())
-                track_data = static_cast<EVENT::LCCollection*>(event->getLCCollection(trkRelCollLcio_.c_str()));
-        }
-        catch (EVENT::DataNotAvailableException e)
-        {
-            std::cout << e.what() << std::endl;
-            if (!gbl_kink_data)
-                std::cout<<"TrackingProcessor::Failed retrieving " << kinkRelCollLcio_ <<std::endl;
-            if (!track_data)
-                std::cout<<"TrackingProcessor::Failed retrieving " << trkRelCollLcio_ <<std::endl;
-            
-        }
-
-        // Add a track to the event
-        Track* track = utils::buildTrack(lc_track,trackStateLocation_, gbl_kink_data,track_data);
+        EVENT::LCCollection* gbl_kink_data = event->tryGetLCCollection(kinkRelCollID_);
+        EVENT::LCCollection* track_data = event->tryGetLCCollection(trkRelCollID_);
+        if (!gbl_kink_data && !kinkRelCollLcio_.empty())
+            std::cout<<"TrackingProcessor::Failed retrieving " << kinkRelCollLcio_ <<std::endl;
+        if (!track_data && !trkRelCollLcio_.empty())
+            std::cout<<"TrackingProcessor::Failed retrieving " << trkRelCollLcio_ <<std::endl;
+
+        // Add a track to the event. The conversion is shared with the 
+        // other converters of the event through the conversion cache.
+        Track* track = new Track(*utils::getTrack(lc_track,trackStateLocation_, gbl_kink_data,track_data, 
+                                                  event->getConversionCache()));
         
         //Override the momentum of the track if the bfield_ > 0
         if (bfield_>0)
@@ -193,7 +192,8 @@ bool TrackingProcessor::process(IEvent* ievent) {
             
             std::vector<RawSvtHit*> rawSvthitsOn3d;
             utils::addRawInfoTo3dHit(tracker_hit,static_cast<IMPL::TrackerHitImpl*>(lc_tracker_hit),
-                                     raw_svt_hit_fits,&rawSvthitsOn3d,hitType);
+                                     raw_svt_hit_fits,&rawSvthitsOn3d,hitType,true,
+                                     useIndexRefs_ ? (int)rawhits_.size() : -1);
             
             for (auto rhit : rawSvthitsOn3d)
                 rawhits_.push_back(rhit);
@@ -203,7 +203,10 @@ bool TrackingProcessor::process(IEvent* ievent) {
             if (debug_)
                 std::cout<<tracker_hit->getRawHits().GetEntries()<<std::endl;
             // Add a reference to the hit
-            track->addHit(tracker_hit);
+            if (useIndexRefs_)
+                track->addHitIndex(hits_.size());
+            else
+                track->addHit(tracker_hit);
             hits_.push_back(tracker_hit);
             
             //Get shared Hits information
@@ -239,19 +242,9 @@ bool TrackingProcessor::process(IEvent* ievent) {
         
         // Get the collection of LCRelations between GBL kink data and track data variables 
         // and the corresponding track.
-        EVENT::LCCollection* truth_tracks_rel{nullptr};
-        
-        try
-        {
-            if (!truthTracksCollLcio_.empty())
-                truth_tracks_rel = static_cast<EVENT::LCCollection*>(event->getLCCollection(truthTracksCollLcio_.c_str()));
-        }
-        catch (EVENT::DataNotAvailableException e)
-        {
-            std::cout << e.what() << std::endl;
-            if (!truth_tracks_rel)
-                std::cout<<"Failed retrieving " << truthTracksCollLcio_ <<std::endl;
-        }
+        EVENT::LCCollection* truth_tracks_rel = event->tryGetLCCollection(truthTracksCollID_);
+        if (!truth_tracks_rel && !truthTracksCollLcio_.empty())
+            std::cout<<"Failed retrieving " << truthTracksCollLcio_ <<std::endl;
         
 
         if (truth_tracks_rel) { 
@@ -282,15 +275,9 @@ bool TrackingProcessor::process(IEvent* ievent) {
         
         //Do the residual plots -- should be in another function
         if (doResiduals_)  {
-            EVENT::LCCollection* trackRes_data_rel{nullptr};
-            try {
-                if (!trackResDataLcio_.empty())
-                    trackRes_data_rel = static_cast<EVENT::LCCollection*>(event->getLCCollection(trackResDataLcio_.c_str()));
-            }
-            catch (EVENT::DataNotAvailableException e)
-            {
-                std::cout<<e.what()<<std::endl;
-            }
+            EVENT::LCCollection* trackRes_data_rel = event->tryGetLCCollection(trackResDataID_);
+            if (!trackRes_data_rel && !trackResDataLcio_.empty())
+                std::cout<<"Failed retrieving " << trackResDataLcio_ <<std::endl;
             
             if (trackRes_data_rel) {
                 std::shared_ptr<UTIL::LCRelationNavigator> trackRes_data_nav = std::make_shared<UTIL::LCRelationNavigator>(trackRes_data_rel);
@@ -311,7 +298,7 @@ bool TrackingProcessor::process(IEvent* ievent) {
                     int ly = trackRes_data->getIntVal(i_res);
                     double res = trackRes_data->getDoubleVal(i_res);
                     double sigma = trackRes_data->getFloatVal(i_res);
-                    trkResHistos_->FillResidualHistograms(track,ly,res,sigma);
+                    trkResHistos_->FillResidualHistograms(track,ly,res,sigma,&hits_);
                 }
             }//trackResData exists
         }//doResiduals
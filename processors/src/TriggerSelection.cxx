@@ -0,0 +1,73 @@
+#include "TriggerSelection.h"
+#include "JsonConfigCache.h"
+
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+    /** Names of the trigger bits, in the order of TSData::tsBits */
+    const std::string triggerNames[TriggerSelection::N_TRIGGER_BITS] = {
+        "Single_0_Top",
+        "Single_1_Top",
+        "Single_2_Top",
+        "Single_3_Top",
+        "Single_0_Bot",
+        "Single_1_Bot",
+        "Single_2_Bot",
+        "Single_3_Bot",
+        "Pair_0",
+        "Pair_1",
+        "Pair_2",
+        "Pair_3",
+        "LED",
+        "Cosmic",
+        "Hodoscope",
+        "Pulser",
+        "Mult_0",
+        "Mult_1",
+        "FEE_Top",
+        "FEE_Bot"
+    };
+}
+
+void TriggerSelection::load(const std::string& cfgFile) {
+    load(JsonConfigCache::get(cfgFile));
+}
+
+void TriggerSelection::load(const json& triggers) {
+    mask_ = 0;
+    for (auto& trigger : triggers.items()) {
+        int bit = getBit(trigger.key());
+        if (bit < 0)
+            throw std::runtime_error("[ TriggerSelection ]: Unknown trigger "+trigger.key());
+
+        const json& cfg = trigger.value();
+        if (useStatus_ && cfg.is_object() && cfg.value("status", 1) == 0)
+            continue;
+
+        std::string bits = cfg.is_object() ? cfg.value("bits", std::string("both")) : "both";
+        if (bits == "prescaled" || bits == "both")
+            mask_ |= std::uint64_t(1) << bit;
+        if (bits == "ext" || bits == "both")
+            mask_ |= std::uint64_t(1) << (bit+32);
+        if (bits != "prescaled" && bits != "ext" && bits != "both")
+            throw std::runtime_error("[ TriggerSelection ]: Unknown bits "+bits+" for trigger "+trigger.key());
+    }
+    loaded_ = true;
+
+    if (mask_ == 0)
+        std::cout << "[ TriggerSelection ]: WARNING: no trigger is accepted, all events are rejected" << std::endl;
+}
+
+int TriggerSelection::getBit(const std::string& name) {
+    std::size_t first = name.find_first_not_of(' ');
+    if (first == std::string::npos)
+        return -1;
+    std::string trimmed = name.substr(first, name.find_last_not_of(' ')-first+1);
+    for (int bit = 0; bit < N_TRIGGER_BITS; ++bit) {
+        if (triggerNames[bit] == trimmed)
+            return bit;
+    }
+    return -1;
+}
@@ -5,6 +5,7 @@
  */
 
 #include "VertexAnaProcessor.h"
+#include "IndexRefs.h"
 #include <iostream>
 #include <fstream>
 #include <map>
@@ -27,6 +28,7 @@ void VertexAnaProcessor::configure(const ParameterSet& parameters) {
         vtxColl_ = parameters.getString("vtxColl",vtxColl_);
         trkColl_ = parameters.getString("trkColl",trkColl_);
         hitColl_ = parameters.getString("hitColl",hitColl_);
+        partColl_ = parameters.getString("partColl",partColl_);
         ecalColl_ = parameters.getString("ecalColl",ecalColl_);
         mcColl_  = parameters.getString("mcColl",mcColl_);
         isRadPDG_ = parameters.getInteger("isRadPDG",isRadPDG_);
@@ -111,93 +113,95 @@ void VertexAnaProcessor::initialize(TTree* tree) {
           //Build a flat tuple for vertex and track params
         if (makeFlatTuple_){
             _reg_tuples[regname] = std::make_shared<FlatTupleMaker>(anaName_+"_"+regname+"_tree");
+            std::shared_ptr<FlatTupleMaker>& tuple = _reg_tuples[regname];
+            VertexTupleSlots& slots = _reg_tuple_slots[regname];
 
             //vtx vars
-            _reg_tuples[regname]->addVariable("unc_vtx_mass");
-            _reg_tuples[regname]->addVariable("unc_vtx_z");
-            _reg_tuples[regname]->addVariable("unc_vtx_chi2");
-            _reg_tuples[regname]->addVariable("unc_vtx_psum");
-            _reg_tuples[regname]->addVariable("unc_vtx_px");
-            _reg_tuples[regname]->addVariable("unc_vtx_py");
-            _reg_tuples[regname]->addVariable("unc_vtx_pz");
-            _reg_tuples[regname]->addVariable("unc_vtx_x");
-            _reg_tuples[regname]->addVariable("unc_vtx_y");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_pos_clus_dt");
-            _reg_tuples[regname]->addVariable("run_number");
-            _reg_tuples[regname]->addVariable("unc_vtx_cxx");
-            _reg_tuples[regname]->addVariable("unc_vtx_cyy");
-            _reg_tuples[regname]->addVariable("unc_vtx_czz");
-            _reg_tuples[regname]->addVariable("unc_vtx_cyx");
-            _reg_tuples[regname]->addVariable("unc_vtx_czy");
-            _reg_tuples[regname]->addVariable("unc_vtx_czx");
+            slots.unc_vtx_mass = tuple->addDouble("unc_vtx_mass");
+            slots.unc_vtx_z = tuple->addDouble("unc_vtx_z");
+            slots.unc_vtx_chi2 = tuple->addDouble("unc_vtx_chi2");
+            slots.unc_vtx_psum = tuple->addDouble("unc_vtx_psum");
+            slots.unc_vtx_px = tuple->addDouble("unc_vtx_px");
+            slots.unc_vtx_py = tuple->addDouble("unc_vtx_py");
+            slots.unc_vtx_pz = tuple->addDouble("unc_vtx_pz");
+            slots.unc_vtx_x = tuple->addDouble("unc_vtx_x");
+            slots.unc_vtx_y = tuple->addDouble("unc_vtx_y");
+            slots.unc_vtx_ele_pos_clus_dt = tuple->addDouble("unc_vtx_ele_pos_clus_dt");
+            slots.run_number = tuple->addDouble("run_number");
+            slots.unc_vtx_cxx = tuple->addDouble("unc_vtx_cxx");
+            slots.unc_vtx_cyy = tuple->addDouble("unc_vtx_cyy");
+            slots.unc_vtx_czz = tuple->addDouble("unc_vtx_czz");
+            slots.unc_vtx_cyx = tuple->addDouble("unc_vtx_cyx");
+            slots.unc_vtx_czy = tuple->addDouble("unc_vtx_czy");
+            slots.unc_vtx_czx = tuple->addDouble("unc_vtx_czx");
 
             //track vars
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_p");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_t");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_d0");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_phi0");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_omega");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_tanLambda");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_z0");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_chi2ndf");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_clust_dt");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_z0Err");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_d0Err");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_tanLambdaErr");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_PhiErr");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_OmegaErr");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_L1_isolation");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_nhits");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_x");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_y");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_z");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_px");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_py");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_track_pz");
-
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_clust_dt");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_p");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_t");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_d0");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_phi0");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_omega");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_tanLambda");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_z0");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_chi2ndf");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_z0Err");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_d0Err");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_tanLambdaErr");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_PhiErr");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_OmegaErr");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_L1_isolation");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_nhits");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_x");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_y");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_z");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_px");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_py");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_track_pz");
+            slots.unc_vtx_ele_track_p = tuple->addDouble("unc_vtx_ele_track_p");
+            slots.unc_vtx_ele_track_t = tuple->addDouble("unc_vtx_ele_track_t");
+            slots.unc_vtx_ele_track_d0 = tuple->addDouble("unc_vtx_ele_track_d0");
+            slots.unc_vtx_ele_track_phi0 = tuple->addDouble("unc_vtx_ele_track_phi0");
+            slots.unc_vtx_ele_track_omega = tuple->addDouble("unc_vtx_ele_track_omega");
+            slots.unc_vtx_ele_track_tanLambda = tuple->addDouble("unc_vtx_ele_track_tanLambda");
+            slots.unc_vtx_ele_track_z0 = tuple->addDouble("unc_vtx_ele_track_z0");
+            slots.unc_vtx_ele_track_chi2ndf = tuple->addDouble("unc_vtx_ele_track_chi2ndf");
+            slots.unc_vtx_ele_track_clust_dt = tuple->addDouble("unc_vtx_ele_track_clust_dt");
+            slots.unc_vtx_ele_track_z0Err = tuple->addDouble("unc_vtx_ele_track_z0Err");
+            slots.unc_vtx_ele_track_d0Err = tuple->addDouble("unc_vtx_ele_track_d0Err");
+            slots.unc_vtx_ele_track_tanLambdaErr = tuple->addDouble("unc_vtx_ele_track_tanLambdaErr");
+            slots.unc_vtx_ele_track_PhiErr = tuple->addDouble("unc_vtx_ele_track_PhiErr");
+            slots.unc_vtx_ele_track_OmegaErr = tuple->addDouble("unc_vtx_ele_track_OmegaErr");
+            slots.unc_vtx_ele_track_L1_isolation = tuple->addDouble("unc_vtx_ele_track_L1_isolation");
+            slots.unc_vtx_ele_track_nhits = tuple->addDouble("unc_vtx_ele_track_nhits");
+            slots.unc_vtx_ele_track_x = tuple->addDouble("unc_vtx_ele_track_x");
+            slots.unc_vtx_ele_track_y = tuple->addDouble("unc_vtx_ele_track_y");
+            slots.unc_vtx_ele_track_z = tuple->addDouble("unc_vtx_ele_track_z");
+            slots.unc_vtx_ele_track_px = tuple->addDouble("unc_vtx_ele_track_px");
+            slots.unc_vtx_ele_track_py = tuple->addDouble("unc_vtx_ele_track_py");
+            slots.unc_vtx_ele_track_pz = tuple->addDouble("unc_vtx_ele_track_pz");
+
+            slots.unc_vtx_pos_track_clust_dt = tuple->addDouble("unc_vtx_pos_track_clust_dt");
+            slots.unc_vtx_pos_track_p = tuple->addDouble("unc_vtx_pos_track_p");
+            slots.unc_vtx_pos_track_t = tuple->addDouble("unc_vtx_pos_track_t");
+            slots.unc_vtx_pos_track_d0 = tuple->addDouble("unc_vtx_pos_track_d0");
+            slots.unc_vtx_pos_track_phi0 = tuple->addDouble("unc_vtx_pos_track_phi0");
+            slots.unc_vtx_pos_track_omega = tuple->addDouble("unc_vtx_pos_track_omega");
+            slots.unc_vtx_pos_track_tanLambda = tuple->addDouble("unc_vtx_pos_track_tanLambda");
+            slots.unc_vtx_pos_track_z0 = tuple->addDouble("unc_vtx_pos_track_z0");
+            slots.unc_vtx_pos_track_chi2ndf = tuple->addDouble("unc_vtx_pos_track_chi2ndf");
+            slots.unc_vtx_pos_track_z0Err = tuple->addDouble("unc_vtx_pos_track_z0Err");
+            slots.unc_vtx_pos_track_d0Err = tuple->addDouble("unc_vtx_pos_track_d0Err");
+            slots.unc_vtx_pos_track_tanLambdaErr = tuple->addDouble("unc_vtx_pos_track_tanLambdaErr");
+            slots.unc_vtx_pos_track_PhiErr = tuple->addDouble("unc_vtx_pos_track_PhiErr");
+            slots.unc_vtx_pos_track_OmegaErr = tuple->addDouble("unc_vtx_pos_track_OmegaErr");
+            slots.unc_vtx_pos_track_L1_isolation = tuple->addDouble("unc_vtx_pos_track_L1_isolation");
+            slots.unc_vtx_pos_track_nhits = tuple->addDouble("unc_vtx_pos_track_nhits");
+            slots.unc_vtx_pos_track_x = tuple->addDouble("unc_vtx_pos_track_x");
+            slots.unc_vtx_pos_track_y = tuple->addDouble("unc_vtx_pos_track_y");
+            slots.unc_vtx_pos_track_z = tuple->addDouble("unc_vtx_pos_track_z");
+            slots.unc_vtx_pos_track_px = tuple->addDouble("unc_vtx_pos_track_px");
+            slots.unc_vtx_pos_track_py = tuple->addDouble("unc_vtx_pos_track_py");
+            slots.unc_vtx_pos_track_pz = tuple->addDouble("unc_vtx_pos_track_pz");
 
             //clust vars
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_clust_E");
-            _reg_tuples[regname]->addVariable("unc_vtx_ele_clust_corr_t");
+            slots.unc_vtx_ele_clust_E = tuple->addDouble("unc_vtx_ele_clust_E");
+            slots.unc_vtx_ele_clust_corr_t = tuple->addDouble("unc_vtx_ele_clust_corr_t");
 
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_clust_E");
-            _reg_tuples[regname]->addVariable("unc_vtx_pos_clust_corr_t");
+            slots.unc_vtx_pos_clust_E = tuple->addDouble("unc_vtx_pos_clust_E");
+            slots.unc_vtx_pos_clust_corr_t = tuple->addDouble("unc_vtx_pos_clust_corr_t");
 
             if(!isData_)
             {
-                _reg_tuples[regname]->addVariable("true_vtx_z");
-                _reg_tuples[regname]->addVariable("true_vtx_mass");
-                _reg_tuples[regname]->addVariable("ap_true_vtx_z");
-                _reg_tuples[regname]->addVariable("ap_true_vtx_mass");
-                _reg_tuples[regname]->addVariable("ap_true_vtx_energy");
-                _reg_tuples[regname]->addVariable("vd_true_vtx_z");
-                _reg_tuples[regname]->addVariable("vd_true_vtx_mass");
-                _reg_tuples[regname]->addVariable("vd_true_vtx_energy");
-                _reg_tuples[regname]->addVariable("hitCode");
-                _reg_tuples[regname]->addVariable("L1hitCode");
-                _reg_tuples[regname]->addVariable("L2hitCode");
+                slots.true_vtx_z = tuple->addDouble("true_vtx_z");
+                slots.true_vtx_mass = tuple->addDouble("true_vtx_mass");
+                slots.ap_true_vtx_z = tuple->addDouble("ap_true_vtx_z");
+                slots.ap_true_vtx_mass = tuple->addDouble("ap_true_vtx_mass");
+                slots.ap_true_vtx_energy = tuple->addDouble("ap_true_vtx_energy");
+                slots.vd_true_vtx_z = tuple->addDouble("vd_true_vtx_z");
+                slots.vd_true_vtx_mass = tuple->addDouble("vd_true_vtx_mass");
+                slots.vd_true_vtx_energy = tuple->addDouble("vd_true_vtx_energy");
+                slots.hitCode = tuple->addDouble("hitCode");
+                slots.L1hitCode = tuple->addDouble("L1hitCode");
+                slots.L2hitCode = tuple->addDouble("L2hitCode");
             }
         }
 
@@ -219,8 +223,14 @@ void VertexAnaProcessor::initialize(TTree* tree) {
     if (brMap_.find(tsColl_.c_str()) != brMap_.end()) tree_->SetBranchAddress(tsColl_.c_str(), &ts_ , &bts_);
     tree_->SetBranchAddress(vtxColl_.c_str(), &vtxs_ , &bvtxs_);
     tree_->SetBranchAddress(hitColl_.c_str(), &hits_   , &bhits_);
+    // Particles are only needed to resolve index based vertex->particle references
+    partColl_ = IndexRefs::findTarget(tree_, vtxColl_, partColl_);
+    if (!partColl_.empty())
+        tree_->SetBranchAddress(partColl_.c_str(), &parts_, &bparts_);
     tree_->SetBranchAddress(ecalColl_.c_str(), &ecal_  , &becal_);
     if(!isData_ && !mcColl_.empty()) tree_->SetBranchAddress(mcColl_.c_str() , &mcParts_, &bmcParts_);
+    if(!isData_ && brMap_.find((mcColl_+"_daughters").c_str()) != brMap_.end()) 
+        tree_->SetBranchAddress((mcColl_+"_daughters").c_str(), &mcDaughters_, &bmcDaughters_);
     //If track collection name is empty take the tracks from the particles. TODO:: change this
     if (!trkColl_.empty())
         tree_->SetBranchAddress(trkColl_.c_str(),&trks_, &btrks_);
@@ -276,27 +286,51 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
     _vtx_histos->Fill2DHisto("n_tracks_hh", NeleTrks, NposTrks); 
     _vtx_histos->Fill1DHisto("n_vtx_h", vtxs_->size()); 
 
+    mcGenealogy_.build(mcParts_, mcDaughters_);
     if (mcParts_) {
-        for(int i = 0; i < mcParts_->size(); i++)
+        if (MCParticle* ap = mcGenealogy_.getLastWithPDG(622))
         {
-            if(mcParts_->at(i)->getPDG() == 622)
-            {
-                apMass = mcParts_->at(i)->getMass();
-                apZ = mcParts_->at(i)->getVertexPosition().at(2);
-                apEnergy = mcParts_->at(i)->getEnergy();
-            }
-            if(mcParts_->at(i)->getPDG() == 625)
-            {
-                vdMass = mcParts_->at(i)->getMass();
-                vdZ = mcParts_->at(i)->getVertexPosition().at(2);
-                vdEnergy = mcParts_->at(i)->getEnergy();
-            }
+            apMass = ap->getMass();
+            apZ = ap->getVertexPosition().at(2);
+            apEnergy = ap->getEnergy();
+        }
+        if (MCParticle* vd = mcGenealogy_.getLastWithPDG(625))
+        {
+            vdMass = vd->getMass();
+            vdZ = vd->getVertexPosition().at(2);
+            vdEnergy = vd->getEnergy();
         }
 
         if (!isData_) _mc_vtx_histos->FillMCParticles(mcParts_, analysis_);
     }
+
+    //Index the MC truth of the hits once per event for the truth matching of the vertex tracks
+    TVector3 trueRadEleP(-999,-999,-999);
+    TVector3 trueRadPosP(-999,-999,-999);
+    float trueRadEleE = -1;
+    float trueRadPosE = -1;
+    if (!isData_) {
+        truthIndex_.build(hits_, mcParts_);
+        //Last radiative electron and positron in collection order
+        for (int ipart : mcGenealogy_.getIndicesWithPDG(11))
+        {
+            MCParticle* part = mcGenealogy_.getParticle(ipart);
+            if (part->getMomPDG() != isRadPDG_) continue;
+            std::vector<double> lP = part->getMomentum();
+            trueRadEleP.SetXYZ(lP[0],lP[1],lP[2]);
+            trueRadEleE = part->getEnergy();
+        }
+        for (int ipart : mcGenealogy_.getIndicesWithPDG(-11))
+        {
+            MCParticle* part = mcGenealogy_.getParticle(ipart);
+            if (part->getMomPDG() != isRadPDG_) continue;
+            std::vector<double> lP = part->getMomentum();
+            trueRadPosP.SetXYZ(lP[0],lP[1],lP[2]);
+            trueRadPosE = part->getEnergy();
+        }
+    }
     //Store processed number of events
-    std::vector<Vertex*> selected_vtxs;
+    std::vector<VertexCandidate> selected_vtxs;
     bool passVtxPresel = false;
 
     // Fill some diagnostic histos
@@ -329,6 +363,9 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
         std::cout<<"Number of vertices found in event: "<< vtxs_->size()<<std::endl;
     }
 
+    // Tracks cloned from the particles when no track collection is given
+    std::vector<std::unique_ptr<Track>> clonedTrks;
+
     // Loop over vertices in event and make selections
     for ( int i_vtx = 0; i_vtx <  vtxs_->size(); i_vtx++ ) {
         vtxSelector->getCutFlowHisto()->Fill(0.,weight);
@@ -346,7 +383,7 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
                 break;
         }
 
-        bool foundParts = _ah->GetParticlesFromVtx(vtx,ele,pos);
+        bool foundParts = _ah->GetParticlesFromVtx(vtx,ele,pos,parts_);
         if (!foundParts) {
             if(debug_) std::cout<<"VertexAnaProcessor::WARNING::Found vtx without ele/pos. Skip."<<std::endl;
             continue;
@@ -364,6 +401,8 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
         else {
             ele_trk = (Track*)ele->getTrack().Clone();
             pos_trk = (Track*)pos->getTrack().Clone();
+            clonedTrks.emplace_back(ele_trk);
+            clonedTrks.emplace_back(pos_trk);
         }
 
         //Beam Position Corrections
@@ -377,179 +416,33 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
         //ele_trk->setMomentum(ele->getMomentum()[0],ele->getMomentum()[1],ele->getMomentum()[2]);
         //pos_trk->setMomentum(pos->getMomentum()[0],pos->getMomentum()[1],pos->getMomentum()[2]);
 
-        double ele_E = ele->getEnergy();
-        double pos_E = pos->getEnergy();
-
-        CalCluster eleClus = ele->getCluster();
-        CalCluster posClus = pos->getCluster();
-
-
         //Compute analysis variables here.
-        TLorentzVector p_ele;
-        p_ele.SetPxPyPzE(ele_trk->getMomentum()[0],ele_trk->getMomentum()[1],ele_trk->getMomentum()[2],ele->getEnergy());
-        TLorentzVector p_pos;
-        p_pos.SetPxPyPzE(pos_trk->getMomentum()[0],pos_trk->getMomentum()[1],pos_trk->getMomentum()[2],ele->getEnergy());
-
-        //Tracks in opposite volumes - useless
-        //if (!vtxSelector->passCutLt("eleposTanLambaProd_lt",ele_trk->getTanLambda() * pos_trk->getTanLambda(),weight))
-        //  continue;
-
-        //Ele Track Time
-        if (!vtxSelector->passCutLt("eleTrkTime_lt",fabs(ele_trk->getTrackTime()),weight))
-            continue;
-
-        //Pos Track Time
-        if (!vtxSelector->passCutLt("posTrkTime_lt",fabs(pos_trk->getTrackTime()),weight))
-            continue;
-
-        //Ele Track-cluster match
-        if (!vtxSelector->passCutLt("eleTrkCluMatch_lt",ele->getGoodnessOfPID(),weight))
-            continue;
-
-        //Pos Track-cluster match
-        if (!vtxSelector->passCutLt("posTrkCluMatch_lt",pos->getGoodnessOfPID(),weight))
-            continue;
-
-        //Require Positron Cluster exists
-        if (!vtxSelector->passCutGt("posClusE_gt",posClus.getEnergy(),weight))
-            continue;
-
-        //Require Positron Cluster does NOT exists
-        if (!vtxSelector->passCutLt("posClusE_lt",posClus.getEnergy(),weight))
-            continue;
-
-
-        double corr_eleClusterTime = ele->getCluster().getTime() - timeOffset_;
-        double corr_posClusterTime = pos->getCluster().getTime() - timeOffset_;
-
-        double botClusTime = 0.0;
-        if(ele->getCluster().getPosition().at(1) < 0.0) botClusTime = ele->getCluster().getTime();
-        else botClusTime = pos->getCluster().getTime();
-
-        //Bottom Cluster Time
-        if (!vtxSelector->passCutLt("botCluTime_lt", botClusTime, weight))
-            continue;
-
-        if (!vtxSelector->passCutGt("botCluTime_gt", botClusTime, weight))
-            continue;
-
-        //Ele Pos Cluster Time Difference
-        if (!vtxSelector->passCutLt("eleposCluTimeDiff_lt",fabs(corr_eleClusterTime - corr_posClusterTime),weight))
-            continue;
-
-        //Ele Track-Cluster Time Difference
-        if (!vtxSelector->passCutLt("eleTrkCluTimeDiff_lt",fabs(ele_trk->getTrackTime() - corr_eleClusterTime),weight))
-            continue;
-
-        //Pos Track-Cluster Time Difference
-        if (!vtxSelector->passCutLt("posTrkCluTimeDiff_lt",fabs(pos_trk->getTrackTime() - corr_posClusterTime),weight))
-            continue;
-
-        TVector3 ele_mom;
-        //ele_mom.SetX(ele->getMomentum()[0]);
-        //ele_mom.SetY(ele->getMomentum()[1]);
-        //ele_mom.SetZ(ele->getMomentum()[2]);
-        ele_mom.SetX(ele_trk->getMomentum()[0]);
-        ele_mom.SetY(ele_trk->getMomentum()[1]);
-        ele_mom.SetZ(ele_trk->getMomentum()[2]);
-
-
-        TVector3 pos_mom;
-        //pos_mom.SetX(pos->getMomentum()[0]);
-        //pos_mom.SetY(pos->getMomentum()[1]);
-        //pos_mom.SetZ(pos->getMomentum()[2]);
-        pos_mom.SetX(pos_trk->getMomentum()[0]);
-        pos_mom.SetY(pos_trk->getMomentum()[1]);
-        pos_mom.SetZ(pos_trk->getMomentum()[2]);
-
-
-
-        //Ele Track Quality - Chi2
-        if (!vtxSelector->passCutLt("eleTrkChi2_lt",ele_trk->getChi2(),weight))
-            continue;
-
-        //Pos Track Quality - Chi2
-        if (!vtxSelector->passCutLt("posTrkChi2_lt",pos_trk->getChi2(),weight))
-            continue;
-
-        //Ele Track Quality - Chi2Ndf
-        if (!vtxSelector->passCutLt("eleTrkChi2Ndf_lt",ele_trk->getChi2Ndf(),weight))
-            continue;
-
-        //Pos Track Quality - Chi2Ndf
-        if (!vtxSelector->passCutLt("posTrkChi2Ndf_lt",pos_trk->getChi2Ndf(),weight))
-            continue;
-
-        //Beam Electron cut
-        if (!vtxSelector->passCutLt("eleMom_lt",ele_mom.Mag(),weight))
-            continue;
-
-        //Ele min momentum cut
-        if (!vtxSelector->passCutGt("eleMom_gt",ele_mom.Mag(),weight))
-            continue;
-
-        //Pos min momentum cut
-        if (!vtxSelector->passCutGt("posMom_gt",pos_mom.Mag(),weight))
-            continue;
-
-        //Ele nHits
-        int ele2dHits = ele_trk->getTrackerHitCount();
-        if (!ele_trk->isKalmanTrack())
-            ele2dHits*=2;
-
-        if (!vtxSelector->passCutGt("eleN2Dhits_gt",ele2dHits,weight))  {
-            continue;
-        }
-
-        //Pos nHits
-        int pos2dHits = pos_trk->getTrackerHitCount();
-        if (!pos_trk->isKalmanTrack())
-            pos2dHits*=2;
+        VertexCandidate cand;
+        cand.build(vtx, ele, pos, ele_trk, pos_trk, timeOffset_);
 
-        if (!vtxSelector->passCutGt("posN2Dhits_gt",pos2dHits,weight))  {
+        if (!passVertexPreselection(*vtxSelector, cand, weight))
             continue;
-        }
-
-        //Less than 4 shared hits for ele/pos track
-        if (!vtxSelector->passCutLt("eleNshared_lt",ele_trk->getNShared(),weight)) {
-            continue;
-        }
-
-        if (!vtxSelector->passCutLt("posNshared_lt",pos_trk->getNShared(),weight)) {
-            continue;
-        }
 
-
-        //Vertex Quality
-        if (!vtxSelector->passCutLt("chi2unc_lt",vtx->getChi2(),weight))
-            continue;
-
-        //Max vtx momentum
-        if (!vtxSelector->passCutLt("maxVtxMom_lt",(ele_mom+pos_mom).Mag(),weight))
-            continue;
-
-        //Min vtx momentum
-
-        if (!vtxSelector->passCutGt("minVtxMom_gt",(ele_mom+pos_mom).Mag(),weight))
-            continue;
-
-        _vtx_histos->Fill1DVertex(vtx,
-                ele,
-                pos,
-                ele_trk,
-                pos_trk,
-                weight);
-
-        double ele_pos_dt = corr_eleClusterTime - corr_posClusterTime;
-        double psum = ele_mom.Mag()+pos_mom.Mag();
-
-        _vtx_histos->Fill1DTrack(ele_trk,weight, "ele_");
-        _vtx_histos->Fill1DTrack(pos_trk,weight, "pos_");
+        _vtx_histos->Fill1DVertex(cand, weight, hits_);
+
+        double corr_eleClusterTime = cand[VertexCandidate::ELE_CLUS_CORR_TIME];
+        double corr_posClusterTime = cand[VertexCandidate::POS_CLUS_CORR_TIME];
+        double ele_pos_dt = cand[VertexCandidate::ELE_POS_CLUS_DT];
+        double ele_trk_clus_dt = cand[VertexCandidate::ELE_TRK_CLUS_DT];
+        double pos_trk_clus_dt = cand[VertexCandidate::POS_TRK_CLUS_DT];
+        double psum = cand[VertexCandidate::P_SUM];
+        int ele2dHits = cand[VertexCandidate::ELE_N2D_HITS];
+        int pos2dHits = cand[VertexCandidate::POS_N2D_HITS];
+        double eleClusE = cand[VertexCandidate::ELE_CLUS_E];
+        double posClusE = cand[VertexCandidate::POS_CLUS_E];
+
+        _vtx_histos->Fill1DTrack(ele_trk, ele2dHits, weight, "ele_", hits_);
+        _vtx_histos->Fill1DTrack(pos_trk, pos2dHits, weight, "pos_", hits_);
         _vtx_histos->Fill1DHisto("ele_track_n2dhits_h", ele2dHits, weight);
         _vtx_histos->Fill1DHisto("pos_track_n2dhits_h", pos2dHits, weight);
-        _vtx_histos->Fill1DHisto("vtx_Psum_h", p_ele.P()+p_pos.P(), weight);
-        _vtx_histos->Fill1DHisto("vtx_Esum_h", ele_E + pos_E, weight);
-        _vtx_histos->Fill1DHisto("ele_pos_clusTimeDiff_h", (corr_eleClusterTime - corr_posClusterTime), weight);
+        _vtx_histos->Fill1DHisto("vtx_Psum_h", psum, weight);
+        _vtx_histos->Fill1DHisto("vtx_Esum_h", cand[VertexCandidate::E_SUM], weight);
+        _vtx_histos->Fill1DHisto("ele_pos_clusTimeDiff_h", ele_pos_dt, weight);
         _vtx_histos->Fill2DHisto("ele_vtxZ_iso_hh", TMath::Min(ele_trk->getIsolation(0), ele_trk->getIsolation(1)), vtx->getZ(), weight);
         _vtx_histos->Fill2DHisto("pos_vtxZ_iso_hh", TMath::Min(pos_trk->getIsolation(0), pos_trk->getIsolation(1)), vtx->getZ(), weight);
         _vtx_histos->Fill2DHistograms(vtx,weight);
@@ -564,13 +457,13 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
         _vtx_histos->Fill2DHisto("pos_clusT_v_pos_trackT_hh", pos_trk->getTrackTime(), corr_posClusterTime, weight);
         _vtx_histos->Fill2DHisto("ele_track_time_v_P_hh", ele_trk->getP(), ele_trk->getTrackTime(), weight);
         _vtx_histos->Fill2DHisto("pos_track_time_v_P_hh", pos_trk->getP(), pos_trk->getTrackTime(), weight);
-        _vtx_histos->Fill2DHisto("ele_pos_clusTimeDiff_v_pSum_hh",ele_mom.Mag()+pos_mom.Mag(), ele_pos_dt, weight);
-        _vtx_histos->Fill2DHisto("ele_cluster_energy_v_track_p_hh",ele_trk->getP(), eleClus.getEnergy(), weight);
-        _vtx_histos->Fill2DHisto("pos_cluster_energy_v_track_p_hh",pos_trk->getP(), posClus.getEnergy(), weight);
-        _vtx_histos->Fill2DHisto("ele_track_cluster_dt_v_EoverP_hh",eleClus.getEnergy()/ele_trk->getP(), ele_trk->getTrackTime() - corr_eleClusterTime, weight);
-        _vtx_histos->Fill2DHisto("pos_track_cluster_dt_v_EoverP_hh",posClus.getEnergy()/pos_trk->getP(), pos_trk->getTrackTime() - corr_posClusterTime, weight);
-        _vtx_histos->Fill2DHisto("ele_track_clus_dt_v_p_hh",ele_trk->getP(), ele_trk->getTrackTime() - corr_eleClusterTime, weight);
-        _vtx_histos->Fill2DHisto("pos_track_clus_dt_v_p_hh",pos_trk->getP(), pos_trk->getTrackTime() - corr_posClusterTime, weight);
+        _vtx_histos->Fill2DHisto("ele_pos_clusTimeDiff_v_pSum_hh", psum, ele_pos_dt, weight);
+        _vtx_histos->Fill2DHisto("ele_cluster_energy_v_track_p_hh",ele_trk->getP(), eleClusE, weight);
+        _vtx_histos->Fill2DHisto("pos_cluster_energy_v_track_p_hh",pos_trk->getP(), posClusE, weight);
+        _vtx_histos->Fill2DHisto("ele_track_cluster_dt_v_EoverP_hh",eleClusE/ele_trk->getP(), ele_trk_clus_dt, weight);
+        _vtx_histos->Fill2DHisto("pos_track_cluster_dt_v_EoverP_hh",posClusE/pos_trk->getP(), pos_trk_clus_dt, weight);
+        _vtx_histos->Fill2DHisto("ele_track_clus_dt_v_p_hh",ele_trk->getP(), ele_trk_clus_dt, weight);
+        _vtx_histos->Fill2DHisto("pos_track_clus_dt_v_p_hh",pos_trk->getP(), pos_trk_clus_dt, weight);
         //chi2 2d plots
         _vtx_histos->Fill2DHisto("ele_track_chi2ndf_v_time_hh", ele_trk->getTrackTime(), ele_trk->getChi2Ndf(), weight);
         _vtx_histos->Fill2DHisto("ele_track_chi2ndf_v_p_hh", ele_trk->getP(), ele_trk->getChi2Ndf(), weight);
@@ -587,12 +480,14 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
 
 
         //1d histos
-        _vtx_histos->Fill1DHisto("ele_track_clus_dt_h", ele_trk->getTrackTime() - corr_eleClusterTime, weight);
-        _vtx_histos->Fill1DHisto("pos_track_clus_dt_h", pos_trk->getTrackTime() - corr_posClusterTime, weight);
+        _vtx_histos->Fill1DHisto("ele_track_clus_dt_h", ele_trk_clus_dt, weight);
+        _vtx_histos->Fill1DHisto("pos_track_clus_dt_h", pos_trk_clus_dt, weight);
 
         passVtxPresel = true;
 
-        selected_vtxs.push_back(vtx);
+        //The innermost layers are only needed by the region selections
+        cand.checkInnermostLayers(*_ah, hits_);
+        selected_vtxs.push_back(cand);
         vtxSelector->clearSelector();
     }
 
@@ -615,96 +510,33 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
     for (auto region : _regions ) {
 
         int nGoodVtx = 0;
-        Vertex* goodVtx = nullptr;
-        std::vector<Vertex*> goodVtxs;
+        std::vector<const VertexCandidate*> goodVtxs;
 
         float truePsum = -1;
         float trueEsum = -1;
 
-        for ( auto vtx : selected_vtxs) {
+        for (const VertexCandidate& cand : selected_vtxs) {
 
             //No cuts.
             _reg_vtx_selectors[region]->getCutFlowHisto()->Fill(0.,weight);
 
+            Vertex* vtx = cand.getVertex();
+            Particle* ele = cand.getElectron();
+            Track* ele_trk_gbl = cand.getEleTrack();
+            Track* pos_trk_gbl = cand.getPosTrack();
 
-            Particle* ele = nullptr;
-            Particle* pos = nullptr;
-
-            _ah->GetParticlesFromVtx(vtx,ele,pos);
-
-            CalCluster eleClus = ele->getCluster();
-            CalCluster posClus = pos->getCluster();
             //vtx Z position
             if (!_reg_vtx_selectors[region]->passCutGt("uncVtxZ_gt",vtx->getZ(),weight))
                 continue;
 
-            double ele_E = ele->getEnergy();
-            double pos_E = pos->getEnergy();
-
-            //Compute analysis variables here.
-
-            Track ele_trk = ele->getTrack();
-            Track pos_trk = pos->getTrack();
-
-            //Beam Position Corrections
-            ele_trk.applyCorrection("z0", beamPosCorrections_.at(1));
-            pos_trk.applyCorrection("z0", beamPosCorrections_.at(1));
-            //Track Time Corrections
-            ele_trk.applyCorrection("track_time",eleTrackTimeBias_);
-            pos_trk.applyCorrection("track_time", posTrackTimeBias_);
-
-            //Get the shared info - TODO change and improve
-
-            Track* ele_trk_gbl = nullptr;
-            Track* pos_trk_gbl = nullptr;
-
-            if (!trkColl_.empty()) {
-                bool foundTracks = _ah->MatchToGBLTracks(ele_trk.getID(),pos_trk.getID(),
-                        ele_trk_gbl, pos_trk_gbl, *trks_);
-
-                if (!foundTracks) {
-                    if (debug_)
-                        std::cout<<"VertexAnaProcessor::ERROR couldn't find ele/pos in the "<<trkColl_ <<"collection"<<std::endl;
-                    continue;
-                }
-            }
-            else {
-
-                ele_trk_gbl = (Track*) ele_trk.Clone();
-                pos_trk_gbl = (Track*) pos_trk.Clone();
-            }
-
-            //Add the momenta to the tracks
-            //ele_trk_gbl->setMomentum(ele->getMomentum()[0],ele->getMomentum()[1],ele->getMomentum()[2]);
-            //pos_trk_gbl->setMomentum(pos->getMomentum()[0],pos->getMomentum()[1],pos->getMomentum()[2]);
-            TVector3 recEleP(ele->getMomentum()[0],ele->getMomentum()[1],ele->getMomentum()[2]);
-            TLorentzVector p_ele;
-            p_ele.SetPxPyPzE(ele_trk_gbl->getMomentum()[0],ele_trk_gbl->getMomentum()[1],ele_trk_gbl->getMomentum()[2], ele_E);
-            TLorentzVector p_pos;
-            p_pos.SetPxPyPzE(pos_trk_gbl->getMomentum()[0],pos_trk_gbl->getMomentum()[1],pos_trk_gbl->getMomentum()[2], pos_E);
-
             //Defining these here so they are in scope elsewhere
             TVector3 trueEleP;
             TVector3 truePosP;
 
-            if (debug_) {
-                std::cout<<"Check on ele_Track"<<std::endl;
-                std::cout<<"Number of hits:"<<ele_trk_gbl->getTrackerHitCount()<<std::endl;
-            }
-
-            bool foundL1ele = false;
-            bool foundL2ele = false;
-            _ah->InnermostLayerCheck(ele_trk_gbl, foundL1ele, foundL2ele);
-
-
-            if (debug_) {
-                std::cout<<"Check on pos_Track"<<std::endl;
-                std::cout<<"Number of hits:"<<ele_trk_gbl->getTrackerHitCount()<<std::endl;
-            }
-            bool foundL1pos = false;
-            bool foundL2pos = false;
-
-            _ah->InnermostLayerCheck(pos_trk_gbl, foundL1pos, foundL2pos);
+            bool foundL1ele = cand[VertexCandidate::ELE_L1];
+            bool foundL2ele = cand[VertexCandidate::ELE_L2];
+            bool foundL1pos = cand[VertexCandidate::POS_L1];
+            bool foundL2pos = cand[VertexCandidate::POS_L2];
 
             if (debug_) {
                 std::cout<<"Check on pos_Track"<<std::endl;
@@ -716,134 +548,8 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
                 if (!_reg_vtx_selectors[region]->passCutEq("Pair1_eq",(int)evth_->isPair1Trigger(),weight))
                     break;
             }
-            //Ele Track Time
-            if (!_reg_vtx_selectors[region]->passCutLt("eleTrkTime_lt",fabs(ele_trk_gbl->getTrackTime()),weight))
-                continue;
-
-            //Pos Track Time
-            if (!_reg_vtx_selectors[region]->passCutLt("posTrkTime_lt",fabs(pos_trk_gbl->getTrackTime()),weight))
+            if (!passVertexPreselection(*_reg_vtx_selectors[region], cand, weight))
                 continue;
-
-            //Ele Track-cluster match
-            if (!_reg_vtx_selectors[region]->passCutLt("eleTrkCluMatch_lt",ele->getGoodnessOfPID(),weight))
-                continue;
-
-            //Pos Track-cluster match
-            if (!_reg_vtx_selectors[region]->passCutLt("posTrkCluMatch_lt",pos->getGoodnessOfPID(),weight))
-                continue;
-
-            //Require Positron Cluster exists
-            if (!_reg_vtx_selectors[region]->passCutGt("posClusE_gt",posClus.getEnergy(),weight))
-                continue;
-
-            //Require Positron Cluster does NOT exists
-            if (!_reg_vtx_selectors[region]->passCutLt("posClusE_lt",posClus.getEnergy(),weight))
-                continue;
-
-            double corr_eleClusterTime = ele->getCluster().getTime() - timeOffset_;
-            double corr_posClusterTime = pos->getCluster().getTime() - timeOffset_;
-
-            double botClusTime = 0.0;
-            if(ele->getCluster().getPosition().at(1) < 0.0) botClusTime = ele->getCluster().getTime();
-            else botClusTime = pos->getCluster().getTime();
-
-            //Bottom Cluster Time
-            if (!_reg_vtx_selectors[region]->passCutLt("botCluTime_lt", botClusTime, weight))
-                continue;
-
-            if (!_reg_vtx_selectors[region]->passCutGt("botCluTime_gt", botClusTime, weight))
-                continue;
-
-            //Ele Pos Cluster Time Difference
-            if (!_reg_vtx_selectors[region]->passCutLt("eleposCluTimeDiff_lt",fabs(corr_eleClusterTime - corr_posClusterTime),weight))
-                continue;
-
-            //Ele Track-Cluster Time Difference
-            if (!_reg_vtx_selectors[region]->passCutLt("eleTrkCluTimeDiff_lt",fabs(ele_trk_gbl->getTrackTime() - corr_eleClusterTime),weight))
-                continue;
-
-            //Pos Track-Cluster Time Difference
-            if (!_reg_vtx_selectors[region]->passCutLt("posTrkCluTimeDiff_lt",fabs(pos_trk_gbl->getTrackTime() - corr_posClusterTime),weight))
-                continue;
-
-            TVector3 ele_mom;
-            ele_mom.SetX(ele_trk_gbl->getMomentum()[0]);
-            ele_mom.SetY(ele_trk_gbl->getMomentum()[1]);
-            ele_mom.SetZ(ele_trk_gbl->getMomentum()[2]);
-
-
-            TVector3 pos_mom;
-            pos_mom.SetX(pos_trk_gbl->getMomentum()[0]);
-            pos_mom.SetY(pos_trk_gbl->getMomentum()[1]);
-            pos_mom.SetZ(pos_trk_gbl->getMomentum()[2]);
-
-            //Ele Track Quality - Chi2
-            if (!_reg_vtx_selectors[region]->passCutLt("eleTrkChi2_lt",ele_trk_gbl->getChi2(),weight))
-                continue;
-
-            //Pos Track Quality - Chi2
-            if (!_reg_vtx_selectors[region]->passCutLt("posTrkChi2_lt",pos_trk_gbl->getChi2(),weight))
-                continue;
-
-            //Ele Track Quality - Chi2Ndf
-            if (!_reg_vtx_selectors[region]->passCutLt("eleTrkChi2Ndf_lt",ele_trk_gbl->getChi2Ndf(),weight))
-                continue;
-
-            //Pos Track Quality - Chi2Ndf
-            if (!_reg_vtx_selectors[region]->passCutLt("posTrkChi2Ndf_lt",pos_trk_gbl->getChi2Ndf(),weight))
-                continue;
-
-            //Beam Electron cut
-            if (!_reg_vtx_selectors[region]->passCutLt("eleMom_lt",ele_mom.Mag(),weight))
-                continue;
-
-            //Ele min momentum cut
-            if (!_reg_vtx_selectors[region]->passCutGt("eleMom_gt",ele_mom.Mag(),weight))
-                continue;
-
-            //Pos min momentum cut
-            if (!_reg_vtx_selectors[region]->passCutGt("posMom_gt",pos_mom.Mag(),weight))
-                continue;
-
-            //Ele nHits
-            int ele2dHits = ele_trk_gbl->getTrackerHitCount();
-            if (!ele_trk_gbl->isKalmanTrack())
-                ele2dHits*=2;
-
-            if (!_reg_vtx_selectors[region]->passCutGt("eleN2Dhits_gt",ele2dHits,weight))  {
-                continue;
-            }
-
-            //Pos nHits
-            int pos2dHits = pos_trk_gbl->getTrackerHitCount();
-            if (!pos_trk_gbl->isKalmanTrack())
-                pos2dHits*=2;
-
-            if (!_reg_vtx_selectors[region]->passCutGt("posN2Dhits_gt",pos2dHits,weight))  {
-                continue;
-            }
-
-            //Less than 4 shared hits for ele/pos track
-            if (!_reg_vtx_selectors[region]->passCutLt("eleNshared_lt",ele_trk_gbl->getNShared(),weight)) {
-                continue;
-            }
-
-            if (!_reg_vtx_selectors[region]->passCutLt("posNshared_lt",pos_trk_gbl->getNShared(),weight)) {
-                continue;
-            }
-
-            //Vertex Quality
-            if (!_reg_vtx_selectors[region]->passCutLt("chi2unc_lt",vtx->getChi2(),weight))
-                continue;
-
-            //Max vtx momentum
-            if (!_reg_vtx_selectors[region]->passCutLt("maxVtxMom_lt",(ele_mom+pos_mom).Mag(),weight))
-                continue;
-
-            //Min vtx momentum
-            if (!_reg_vtx_selectors[region]->passCutGt("minVtxMom_gt",(ele_mom+pos_mom).Mag(),weight))
-                continue;
-
             //END PRESELECTION CUTS
 
             //L1 requirement
@@ -859,28 +565,28 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
                 continue;
 
             //ESum low cut
-            if (!_reg_vtx_selectors[region]->passCutLt("eSum_lt",(ele_E+pos_E),weight))
+            if (!_reg_vtx_selectors[region]->passCutLt("eSum_lt",cand[VertexCandidate::E_SUM],weight))
                 continue;
 
             //ESum high cut
-            if (!_reg_vtx_selectors[region]->passCutGt("eSum_gt",(ele_E+pos_E),weight))
+            if (!_reg_vtx_selectors[region]->passCutGt("eSum_gt",cand[VertexCandidate::E_SUM],weight))
                 continue;
 
             //PSum low cut
-            if (!_reg_vtx_selectors[region]->passCutLt("pSum_lt",(p_ele.P()+p_pos.P()),weight))
+            if (!_reg_vtx_selectors[region]->passCutLt("pSum_lt",cand[VertexCandidate::P_SUM],weight))
                 continue;
 
             //PSum high cut
-            if (!_reg_vtx_selectors[region]->passCutGt("pSum_gt",(p_ele.P()+p_pos.P()),weight))
+            if (!_reg_vtx_selectors[region]->passCutGt("pSum_gt",cand[VertexCandidate::P_SUM],weight))
                 continue;
 
             //Require Electron Cluster exists
-            if (!_reg_vtx_selectors[region]->passCutGt("eleClusE_gt",eleClus.getEnergy(),weight))
+            if (!_reg_vtx_selectors[region]->passCutGt("eleClusE_gt",cand[VertexCandidate::ELE_CLUS_E],weight))
                 continue;
 
 
             //Require Electron Cluster does NOT exists
-            if (!_reg_vtx_selectors[region]->passCutLt("eleClusE_lt",eleClus.getEnergy(),weight))
+            if (!_reg_vtx_selectors[region]->passCutLt("eleClusE_lt",cand[VertexCandidate::ELE_CLUS_E],weight))
                 continue;
 
             //No shared hits requirement
@@ -902,10 +608,10 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
                 continue;
 
             //Tracking Volume for positron
-            if (!_reg_vtx_selectors[region]->passCutGt("volPos_top", p_pos.Py(), weight))
+            if (!_reg_vtx_selectors[region]->passCutGt("volPos_top", cand[VertexCandidate::POS_PY], weight))
                 continue;
 
-            if (!_reg_vtx_selectors[region]->passCutLt("volPos_bot", p_pos.Py(), weight))
+            if (!_reg_vtx_selectors[region]->passCutLt("volPos_bot", cand[VertexCandidate::POS_PY], weight))
                 continue;
 
             //If this is MC check if MCParticle matched to the electron track is from rad or recoil
@@ -915,86 +621,33 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
                 //Fill MC plots after all selections
                 if (!isData_) _reg_mc_vtx_histos[region]->FillMCParticles(mcParts_, analysis_);
 
-                //Build map of hits and the associated MC part ids for later
-                TRefArray ele_trk_hits = ele_trk_gbl->getSvtHits();
-                TRefArray pos_trk_hits = pos_trk_gbl->getSvtHits();
-                std::map<int, std::vector<int> > trueHitIDs;
-                for(int i = 0; i < hits_->size(); i++)
-                {
-                    TrackerHit* hit = hits_->at(i);
-                    trueHitIDs[hit->getID()] = hit->getMCPartIDs();
-                }
-                //Count the number of hits per part on the ele track
-                std::map<int, int> nHits4part;
-                for(int i = 0; i < ele_trk_hits.GetEntries(); i++)
-                {
-                    TrackerHit* eleHit = (TrackerHit*)ele_trk_hits.At(i);
-                    for(int idI = 0; idI < trueHitIDs[eleHit->getID()].size(); idI++ )
-                    {
-                        int partID = trueHitIDs[eleHit->getID()].at(idI);
-                        if ( nHits4part.find(partID) == nHits4part.end() )
-                        {
-                            // not found
-                            nHits4part[partID] = 1;
-                        }
-                        else
-                        {
-                            // found
-                            nHits4part[partID]++;
-                        }
-                    }
-                }
-
                 //Determine the MC part with the most hits on the track
-                int maxNHits = 0;
-                int maxID = 0;
-                for (std::map<int,int>::iterator it=nHits4part.begin(); it!=nHits4part.end(); ++it)
-                {
-                    if(it->second > maxNHits)
-                    {
-                        maxNHits = it->second;
-                        maxID = it->first;
-                    }
-                }
+                int maxID = truthIndex_.getMajorityParticle(ele_trk_gbl, hits_);
 
                 //Find the correct mc part and grab mother id
                 int isRadEle = -999;
                 int isRecEle = -999;
 
-
                 trueEleP.SetXYZ(-999,-999,-999);
                 truePosP.SetXYZ(-999,-999,-999);
                 if (mcParts_) {
-                    float trueEleE = -1;
-                    float truePosE = -1;
-                    for(int i = 0; i < mcParts_->size(); i++)
-                    {
-                        int momPDG = mcParts_->at(i)->getMomPDG();
-                        if(mcParts_->at(i)->getPDG() == 11 && momPDG == isRadPDG_)
-                        {
-                            std::vector<double> lP = mcParts_->at(i)->getMomentum();
-                            trueEleP.SetXYZ(lP[0],lP[1],lP[2]);
-                            trueEleE = mcParts_->at(i)->getEnergy();
-
-                        }
-                        if(mcParts_->at(i)->getPDG() == -11 && momPDG == isRadPDG_)
-                        {
-                            std::vector<double> lP = mcParts_->at(i)->getMomentum();
-                            truePosP.SetXYZ(lP[0],lP[1],lP[2]);
-                            truePosE = mcParts_->at(i)->getEnergy();
-
-                        }
-                        if(trueEleP.X() != -999 && truePosP.X() != -999){
-                            truePsum =  trueEleP.Mag() + trueEleP.Mag();
-                            trueEsum = trueEleE + truePosE;
-                        }
-
-                        if(mcParts_->at(i)->getID() != maxID) continue;
+                    trueEleP = trueRadEleP;
+                    truePosP = trueRadPosP;
+                    if(trueEleP.X() != -999 && truePosP.X() != -999){
+                        truePsum =  trueEleP.Mag() + trueEleP.Mag();
+                        trueEsum = trueRadEleE + trueRadPosE;
+                    }
+
+                    MCParticle* maxPart = truthIndex_.getParticle(maxID);
+                    if (maxPart) {
+                        int momPDG = maxPart->getMomPDG();
                         //Default isRadPDG = 622
                         if(momPDG == isRadPDG_) isRadEle = 1;
                         if(momPDG == 623) isRecEle = 1;
                     }
                 }
+                std::vector<double> eleP = ele->getMomentum();
+                TVector3 recEleP(eleP[0],eleP[1],eleP[2]);
                 double momRatio = recEleP.Mag() / trueEleP.Mag();
                 double momAngle = trueEleP.Angle(recEleP) * TMath::RadToDeg();
                 if (!_reg_vtx_selectors[region]->passCutLt("momRatio_lt", momRatio, weight)) continue;
@@ -1006,9 +659,8 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
                 if (!_reg_vtx_selectors[region]->passCutEq("isRecEle_eq", isRecEle, weight)) continue;
             }
 
-            goodVtx = vtx;
             nGoodVtx++;
-            goodVtxs.push_back(vtx);
+            goodVtxs.push_back(&cand);
         } // selected vertices
 
         //N selected vertices - this is quite a silly cut to make at the end. But okay. that's how we decided atm.
@@ -1018,48 +670,23 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
         _reg_vtx_histos[region]->Fill1DHisto("n_vertices_h", nGoodVtx, weight);
 
         //Loop over all selected vertices in the region
-        for(std::vector<Vertex*>::iterator it = goodVtxs.begin(); it != goodVtxs.end(); it++){
-
-            Vertex* vtx = *it;
-
-            Particle* ele = nullptr;
-            Particle* pos = nullptr;
-
-            if (!vtx || !_ah->GetParticlesFromVtx(vtx,ele,pos))
-                continue;
-
-            CalCluster eleClus = ele->getCluster();
-            CalCluster posClus = pos->getCluster();
-
-            double corr_eleClusterTime = ele->getCluster().getTime() - timeOffset_;
-            double corr_posClusterTime = pos->getCluster().getTime() - timeOffset_;
-
-            double ele_E = ele->getEnergy();
-            double pos_E = pos->getEnergy();
-
-            //Compute analysis variables here.
-            Track ele_trk = ele->getTrack();
-            Track pos_trk = pos->getTrack();
-            //Get the shared info - TODO change and improve
-
-            Track* ele_trk_gbl = nullptr;
-            Track* pos_trk_gbl = nullptr;
-
-            if (!trkColl_.empty()) {
-                bool foundTracks = _ah->MatchToGBLTracks(ele_trk.getID(),pos_trk.getID(),
-                        ele_trk_gbl, pos_trk_gbl, *trks_);
-
-                if (!foundTracks) {
-                    if (debug_)
-                        std::cout<<"VertexAnaProcessor::ERROR couldn't find ele/pos in the "<<trkColl_ <<"collection"<<std::endl;
-                    continue;
-                }
-            }
-            else {
-
-                ele_trk_gbl = (Track*) ele_trk.Clone();
-                pos_trk_gbl = (Track*) pos_trk.Clone();
-            }
+        for (const VertexCandidate* cand : goodVtxs) {
+
+            Vertex* vtx = cand->getVertex();
+            Track* ele_trk_gbl = cand->getEleTrack();
+            Track* pos_trk_gbl = cand->getPosTrack();
+
+            double corr_eleClusterTime = (*cand)[VertexCandidate::ELE_CLUS_CORR_TIME];
+            double corr_posClusterTime = (*cand)[VertexCandidate::POS_CLUS_CORR_TIME];
+            double ele_pos_dt = (*cand)[VertexCandidate::ELE_POS_CLUS_DT];
+            double ele_trk_clus_dt = (*cand)[VertexCandidate::ELE_TRK_CLUS_DT];
+            double pos_trk_clus_dt = (*cand)[VertexCandidate::POS_TRK_CLUS_DT];
+            double psum = (*cand)[VertexCandidate::P_SUM];
+            double clusEsum = (*cand)[VertexCandidate::CLUS_E_SUM];
+            double eleClusE = (*cand)[VertexCandidate::ELE_CLUS_E];
+            double posClusE = (*cand)[VertexCandidate::POS_CLUS_E];
+            int ele2dHits = (*cand)[VertexCandidate::ELE_N2D_HITS];
+            int pos2dHits = (*cand)[VertexCandidate::POS_N2D_HITS];
 
             //Vertex Covariance
             std::vector<float> vtx_cov = vtx->getCovariance();
@@ -1076,7 +703,7 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
             int L2hitCode = 0; // hit code '1111' means truth in L2_ele_ax, L2_ele_ster, L2_pos_ax, L2_pos_ster
             if(!isData_){
                 //Get hit codes. Only sure this works for 2016 KF as is.
-                utils::get2016KFMCTruthHitCodes(ele_trk_gbl, pos_trk_gbl, hits_, L1L2hitCode, L1hitCode, L2hitCode);
+                utils::get2016KFMCTruthHitCodes(ele_trk_gbl, pos_trk_gbl, hits_, truthIndex_, L1L2hitCode, L1hitCode, L2hitCode);
                 //L1L2 truth hit selection
                 if (!_reg_vtx_selectors[region]->passCutLt("hitCode_lt",((double)L1L2hitCode)-0.5, weight)) continue;
                 if (!_reg_vtx_selectors[region]->passCutGt("hitCode_gt",((double)L1L2hitCode)+0.5, weight)) continue;
@@ -1088,53 +715,16 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
 
             //track isolations
             //Only calculate isolations if both track L1 and L2 hits exist
-            bool hasL1ele = false;
-            bool hasL2ele = false;
-            _ah->InnermostLayerCheck(ele_trk_gbl, hasL1ele, hasL2ele);
-
-            bool hasL1pos = false;
-            bool hasL2pos = false;
-            _ah->InnermostLayerCheck(pos_trk_gbl, hasL1pos, hasL2pos);
-
             double ele_trk_iso_L1 = 99999.9;
             double pos_trk_iso_L1 = 99999.9;
-            if(hasL1ele && hasL2ele && hasL1pos && hasL2pos){
+            if((*cand)[VertexCandidate::ELE_L1] && (*cand)[VertexCandidate::ELE_L2] &&
+                    (*cand)[VertexCandidate::POS_L1] && (*cand)[VertexCandidate::POS_L2]){
                 if (ele_trk_gbl->isKalmanTrack()){
-                    ele_trk_iso_L1 = utils::getKalmanTrackL1Isolations(ele_trk_gbl, hits_);
-                    pos_trk_iso_L1 = utils::getKalmanTrackL1Isolations(pos_trk_gbl, hits_);
+                    ele_trk_iso_L1 = utils::getKalmanTrackL1Isolations(ele_trk_gbl, hits_, hits_);
+                    pos_trk_iso_L1 = utils::getKalmanTrackL1Isolations(pos_trk_gbl, hits_, hits_);
                 }
             }
 
-            TVector3 ele_mom;
-            //ele_mom.SetX(ele->getMomentum()[0]);
-            //ele_mom.SetY(ele->getMomentum()[1]);
-            //ele_mom.SetZ(ele->getMomentum()[2]);
-            ele_mom.SetX(ele_trk_gbl->getMomentum()[0]);
-            ele_mom.SetY(ele_trk_gbl->getMomentum()[1]);
-            ele_mom.SetZ(ele_trk_gbl->getMomentum()[2]);
-
-
-            TVector3 pos_mom;
-            //pos_mom.SetX(pos->getMomentum()[0]);
-            //pos_mom.SetY(pos->getMomentum()[1]);
-            //pos_mom.SetZ(pos->getMomentum()[2]);
-            pos_mom.SetX(pos_trk_gbl->getMomentum()[0]);
-            pos_mom.SetY(pos_trk_gbl->getMomentum()[1]);
-            pos_mom.SetZ(pos_trk_gbl->getMomentum()[2]);
-
-            double ele_pos_dt = corr_eleClusterTime - corr_posClusterTime;
-            double psum = ele_mom.Mag()+pos_mom.Mag();
-
-            //Ele nHits
-            int ele2dHits = ele_trk_gbl->getTrackerHitCount();
-            if (!ele_trk_gbl->isKalmanTrack())
-                ele2dHits*=2;
-
-            //pos nHits
-            int pos2dHits = pos_trk_gbl->getTrackerHitCount();
-            if (!pos_trk_gbl->isKalmanTrack())
-                pos2dHits*=2;
-
             if(ts_ != nullptr)
             {
                 _reg_vtx_histos[region]->Fill2DHisto("trig_count_hh", 
@@ -1151,29 +741,14 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
             }
             _reg_vtx_histos[region]->Fill2DHisto("n_tracks_hh", NeleTrks, NposTrks); 
 
-            //Add the momenta to the tracks
-            //ele_trk_gbl->setMomentum(ele->getMomentum()[0],ele->getMomentum()[1],ele->getMomentum()[2]);
-            //pos_trk_gbl->setMomentum(pos->getMomentum()[0],pos->getMomentum()[1],pos->getMomentum()[2]);
-            TVector3 recEleP(ele->getMomentum()[0],ele->getMomentum()[1],ele->getMomentum()[2]);
-            TLorentzVector p_ele;
-            p_ele.SetPxPyPzE(ele_trk_gbl->getMomentum()[0],ele_trk_gbl->getMomentum()[1],ele_trk_gbl->getMomentum()[2], ele_E);
-            TLorentzVector p_pos;
-            p_pos.SetPxPyPzE(pos_trk_gbl->getMomentum()[0],pos_trk_gbl->getMomentum()[1],pos_trk_gbl->getMomentum()[2], pos_E);
-
-
             _reg_vtx_histos[region]->Fill2DHistograms(vtx,weight);
-            _reg_vtx_histos[region]->Fill1DVertex(vtx,
-                    ele,
-                    pos,
-                    ele_trk_gbl,
-                    pos_trk_gbl,
-                    weight);
-
-            _reg_vtx_histos[region]->Fill1DHisto("ele_pos_clusTimeDiff_h", (corr_eleClusterTime - corr_posClusterTime), weight);
+            _reg_vtx_histos[region]->Fill1DVertex(*cand, weight, hits_);
+
+            _reg_vtx_histos[region]->Fill1DHisto("ele_pos_clusTimeDiff_h", ele_pos_dt, weight);
             _reg_vtx_histos[region]->Fill1DHisto("ele_track_n2dhits_h", ele2dHits, weight);
             _reg_vtx_histos[region]->Fill1DHisto("pos_track_n2dhits_h", pos2dHits, weight);
-            _reg_vtx_histos[region]->Fill1DHisto("vtx_Psum_h", p_ele.P()+p_pos.P(), weight);
-            _reg_vtx_histos[region]->Fill1DHisto("vtx_Esum_h", eleClus.getEnergy()+posClus.getEnergy(), weight);
+            _reg_vtx_histos[region]->Fill1DHisto("vtx_Psum_h", psum, weight);
+            _reg_vtx_histos[region]->Fill1DHisto("vtx_Esum_h", clusEsum, weight);
             _reg_vtx_histos[region]->Fill2DHisto("ele_vtxZ_iso_hh", TMath::Min(ele_trk_gbl->getIsolation(0), ele_trk_gbl->getIsolation(1)), vtx->getZ(), weight);
             _reg_vtx_histos[region]->Fill2DHisto("pos_vtxZ_iso_hh", TMath::Min(pos_trk_gbl->getIsolation(0), pos_trk_gbl->getIsolation(1)), vtx->getZ(), weight);
             _reg_vtx_histos[region]->Fill2DTrack(ele_trk_gbl,weight,"ele_");
@@ -1190,8 +765,8 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
             //Just for the selected vertex
             if(!isData_)
             {
-                _reg_vtx_histos[region]->Fill2DHisto("vtx_Esum_vs_true_Esum_hh",eleClus.getEnergy()+posClus.getEnergy(), trueEsum, weight);
-                _reg_vtx_histos[region]->Fill2DHisto("vtx_Psum_vs_true_Psum_hh",p_ele.P()+p_pos.P(), truePsum, weight);
+                _reg_vtx_histos[region]->Fill2DHisto("vtx_Esum_vs_true_Esum_hh",clusEsum, trueEsum, weight);
+                _reg_vtx_histos[region]->Fill2DHisto("vtx_Psum_vs_true_Psum_hh",psum, truePsum, weight);
                 _reg_vtx_histos[region]->Fill1DHisto("true_vtx_psum_h",truePsum,weight);
             }
 
@@ -1224,13 +799,13 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
             _reg_vtx_histos[region]->Fill2DHisto("pos_clusT_v_pos_trackT_hh", pos_trk_gbl->getTrackTime(), corr_posClusterTime, weight);
             _reg_vtx_histos[region]->Fill2DHisto("ele_track_time_v_P_hh", ele_trk_gbl->getP(), ele_trk_gbl->getTrackTime(), weight);
             _reg_vtx_histos[region]->Fill2DHisto("pos_track_time_v_P_hh", pos_trk_gbl->getP(), pos_trk_gbl->getTrackTime(), weight);
-            _reg_vtx_histos[region]->Fill2DHisto("ele_pos_clusTimeDiff_v_pSum_hh",ele_mom.Mag()+pos_mom.Mag(), ele_pos_dt, weight);
-            _reg_vtx_histos[region]->Fill2DHisto("ele_cluster_energy_v_track_p_hh",ele_trk_gbl->getP(), eleClus.getEnergy(), weight);
-            _reg_vtx_histos[region]->Fill2DHisto("pos_cluster_energy_v_track_p_hh",pos_trk_gbl->getP(), posClus.getEnergy(), weight);
-            _reg_vtx_histos[region]->Fill2DHisto("ele_track_cluster_dt_v_EoverP_hh",eleClus.getEnergy()/ele_trk_gbl->getP(), ele_trk_gbl->getTrackTime() - corr_eleClusterTime, weight);
-            _reg_vtx_histos[region]->Fill2DHisto("pos_track_cluster_dt_v_EoverP_hh",posClus.getEnergy()/pos_trk_gbl->getP(), pos_trk_gbl->getTrackTime() - corr_posClusterTime, weight);
-            _reg_vtx_histos[region]->Fill2DHisto("ele_track_clus_dt_v_p_hh",ele_trk_gbl->getP(), ele_trk_gbl->getTrackTime() - corr_eleClusterTime, weight);
-            _reg_vtx_histos[region]->Fill2DHisto("pos_track_clus_dt_v_p_hh",pos_trk_gbl->getP(), pos_trk_gbl->getTrackTime() - corr_posClusterTime, weight);
+            _reg_vtx_histos[region]->Fill2DHisto("ele_pos_clusTimeDiff_v_pSum_hh",psum, ele_pos_dt, weight);
+            _reg_vtx_histos[region]->Fill2DHisto("ele_cluster_energy_v_track_p_hh",ele_trk_gbl->getP(), eleClusE, weight);
+            _reg_vtx_histos[region]->Fill2DHisto("pos_cluster_energy_v_track_p_hh",pos_trk_gbl->getP(), posClusE, weight);
+            _reg_vtx_histos[region]->Fill2DHisto("ele_track_cluster_dt_v_EoverP_hh",eleClusE/ele_trk_gbl->getP(), ele_trk_clus_dt, weight);
+            _reg_vtx_histos[region]->Fill2DHisto("pos_track_cluster_dt_v_EoverP_hh",posClusE/pos_trk_gbl->getP(), pos_trk_clus_dt, weight);
+            _reg_vtx_histos[region]->Fill2DHisto("ele_track_clus_dt_v_p_hh",ele_trk_gbl->getP(), ele_trk_clus_dt, weight);
+            _reg_vtx_histos[region]->Fill2DHisto("pos_track_clus_dt_v_p_hh",pos_trk_gbl->getP(), pos_trk_clus_dt, weight);
             _reg_vtx_histos[region]->Fill2DHisto("ele_z0_vs_pos_z0_hh",ele_trk_gbl->getZ0(), pos_trk_gbl->getZ0(), weight);
             //chi2 2d plots
             _reg_vtx_histos[region]->Fill2DHisto("ele_track_chi2ndf_v_time_hh", ele_trk_gbl->getTrackTime(), ele_trk_gbl->getChi2Ndf(), weight);
@@ -1248,8 +823,8 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
 
 
             //1d histos
-            _reg_vtx_histos[region]->Fill1DHisto("ele_track_clus_dt_h", ele_trk_gbl->getTrackTime() - corr_eleClusterTime, weight);
-            _reg_vtx_histos[region]->Fill1DHisto("pos_track_clus_dt_h", pos_trk_gbl->getTrackTime() - corr_posClusterTime, weight);
+            _reg_vtx_histos[region]->Fill1DHisto("ele_track_clus_dt_h", ele_trk_clus_dt, weight);
+            _reg_vtx_histos[region]->Fill1DHisto("pos_track_clus_dt_h", pos_trk_clus_dt, weight);
 
             //TODO put this in the Vertex!
             TVector3 vtxPosSvt;
@@ -1260,92 +835,96 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
 
             //Just for the selected vertex
             if (makeFlatTuple_){
+                std::shared_ptr<FlatTupleMaker>& tuple = _reg_tuples[region];
+                const VertexTupleSlots& slots = _reg_tuple_slots[region];
                 if(!isData_){
-                    _reg_tuples[region]->setVariableValue("ap_true_vtx_z", apZ);
-                    _reg_tuples[region]->setVariableValue("ap_true_vtx_mass", apMass);
-                    _reg_tuples[region]->setVariableValue("ap_true_vtx_energy", apEnergy);
-                    _reg_tuples[region]->setVariableValue("vd_true_vtx_z", vdZ);
-                    _reg_tuples[region]->setVariableValue("vd_true_vtx_mass", vdMass);
-                    _reg_tuples[region]->setVariableValue("vd_true_vtx_energy", vdEnergy);
-                    _reg_tuples[region]->setVariableValue("hitCode", float(L1L2hitCode));
-                    _reg_tuples[region]->setVariableValue("L1hitCode", float(L1hitCode));
-                    _reg_tuples[region]->setVariableValue("L2hitCode", float(L2hitCode));
+                    tuple->set(slots.ap_true_vtx_z, apZ);
+                    tuple->set(slots.ap_true_vtx_mass, apMass);
+                    tuple->set(slots.ap_true_vtx_energy, apEnergy);
+                    tuple->set(slots.vd_true_vtx_z, vdZ);
+                    tuple->set(slots.vd_true_vtx_mass, vdMass);
+                    tuple->set(slots.vd_true_vtx_energy, vdEnergy);
+                    tuple->set(slots.hitCode, float(L1L2hitCode));
+                    tuple->set(slots.L1hitCode, float(L1hitCode));
+                    tuple->set(slots.L2hitCode, float(L2hitCode));
                 }
 
-                _reg_tuples[region]->setVariableValue("unc_vtx_mass", vtx->getInvMass());
-                _reg_tuples[region]->setVariableValue("unc_vtx_z"   , vtxPosSvt.Z());
-                _reg_tuples[region]->setVariableValue("unc_vtx_chi2", vtx->getChi2());
-                _reg_tuples[region]->setVariableValue("unc_vtx_psum", p_ele.P()+p_pos.P());
-                _reg_tuples[region]->setVariableValue("unc_vtx_px", vtx->getP().X());
-                _reg_tuples[region]->setVariableValue("unc_vtx_py", vtx->getP().Y());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pz", vtx->getP().Z());
-                _reg_tuples[region]->setVariableValue("unc_vtx_x", vtx->getX());
-                _reg_tuples[region]->setVariableValue("unc_vtx_y", vtx->getY());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_pos_clust_dt", corr_eleClusterTime - corr_posClusterTime);
-                _reg_tuples[region]->setVariableValue("unc_vtx_cxx", cxx);
-                _reg_tuples[region]->setVariableValue("unc_vtx_cyy", cyy);
-                _reg_tuples[region]->setVariableValue("unc_vtx_czz", czz);
-                _reg_tuples[region]->setVariableValue("unc_vtx_cyx", cyx);
-                _reg_tuples[region]->setVariableValue("unc_vtx_czy", czy);
-                _reg_tuples[region]->setVariableValue("unc_vtx_czx", czx);
+                tuple->set(slots.unc_vtx_mass, vtx->getInvMass());
+                tuple->set(slots.unc_vtx_z, vtxPosSvt.Z());
+                tuple->set(slots.unc_vtx_chi2, vtx->getChi2());
+                tuple->set(slots.unc_vtx_psum, psum);
+                tuple->set(slots.unc_vtx_px, vtx->getP().X());
+                tuple->set(slots.unc_vtx_py, vtx->getP().Y());
+                tuple->set(slots.unc_vtx_pz, vtx->getP().Z());
+                tuple->set(slots.unc_vtx_x, vtx->getX());
+                tuple->set(slots.unc_vtx_y, vtx->getY());
+                tuple->set(slots.unc_vtx_ele_pos_clus_dt, ele_pos_dt);
+                tuple->set(slots.unc_vtx_cxx, cxx);
+                tuple->set(slots.unc_vtx_cyy, cyy);
+                tuple->set(slots.unc_vtx_czz, czz);
+                tuple->set(slots.unc_vtx_cyx, cyx);
+                tuple->set(slots.unc_vtx_czy, czy);
+                tuple->set(slots.unc_vtx_czx, czx);
 
                 //track vars
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_p", ele_trk_gbl->getP());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_t", ele_trk_gbl->getTrackTime());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_d0", ele_trk_gbl->getD0());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_phi0", ele_trk_gbl->getPhi());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_omega", ele_trk_gbl->getOmega());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_tanLambda", ele_trk_gbl->getTanLambda());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_z0", ele_trk_gbl->getZ0());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_chi2ndf", ele_trk_gbl->getChi2Ndf());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_clust_dt", ele_trk_gbl->getTrackTime() - corr_eleClusterTime);
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_z0Err",ele_trk_gbl->getZ0Err());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_d0Err", ele_trk_gbl->getD0Err());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_tanLambdaErr", ele_trk_gbl->getTanLambdaErr());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_PhiErr", ele_trk_gbl->getPhiErr());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_OmegaErr", ele_trk_gbl->getOmegaErr());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_L1_isolation",ele_trk_iso_L1);
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_nhits",ele2dHits);
-
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_p", pos_trk_gbl->getP());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_t", pos_trk_gbl->getTrackTime());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_d0", pos_trk_gbl->getD0());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_phi0", pos_trk_gbl->getPhi());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_omega", pos_trk_gbl->getOmega());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_tanLambda", pos_trk_gbl->getTanLambda());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_z0", pos_trk_gbl->getZ0());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_chi2ndf", pos_trk_gbl->getChi2Ndf());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_clust_dt", pos_trk_gbl->getTrackTime() - corr_posClusterTime);
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_z0Err",pos_trk_gbl->getZ0Err());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_d0Err", pos_trk_gbl->getD0Err());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_tanLambdaErr", pos_trk_gbl->getTanLambdaErr());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_PhiErr", pos_trk_gbl->getPhiErr());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_OmegaErr", pos_trk_gbl->getOmegaErr());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_L1_isolation",pos_trk_iso_L1);
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_nhits",pos2dHits);
+                tuple->set(slots.unc_vtx_ele_track_p, ele_trk_gbl->getP());
+                tuple->set(slots.unc_vtx_ele_track_t, ele_trk_gbl->getTrackTime());
+                tuple->set(slots.unc_vtx_ele_track_d0, ele_trk_gbl->getD0());
+                tuple->set(slots.unc_vtx_ele_track_phi0, ele_trk_gbl->getPhi());
+                tuple->set(slots.unc_vtx_ele_track_omega, ele_trk_gbl->getOmega());
+                tuple->set(slots.unc_vtx_ele_track_tanLambda, ele_trk_gbl->getTanLambda());
+                tuple->set(slots.unc_vtx_ele_track_z0, ele_trk_gbl->getZ0());
+                tuple->set(slots.unc_vtx_ele_track_chi2ndf, ele_trk_gbl->getChi2Ndf());
+                tuple->set(slots.unc_vtx_ele_track_clust_dt, ele_trk_clus_dt);
+                tuple->set(slots.unc_vtx_ele_track_z0Err, ele_trk_gbl->getZ0Err());
+                tuple->set(slots.unc_vtx_ele_track_d0Err, ele_trk_gbl->getD0Err());
+                tuple->set(slots.unc_vtx_ele_track_tanLambdaErr, ele_trk_gbl->getTanLambdaErr());
+                tuple->set(slots.unc_vtx_ele_track_PhiErr, ele_trk_gbl->getPhiErr());
+                tuple->set(slots.unc_vtx_ele_track_OmegaErr, ele_trk_gbl->getOmegaErr());
+                tuple->set(slots.unc_vtx_ele_track_L1_isolation, ele_trk_iso_L1);
+                tuple->set(slots.unc_vtx_ele_track_nhits, ele2dHits);
+
+                tuple->set(slots.unc_vtx_pos_track_p, pos_trk_gbl->getP());
+                tuple->set(slots.unc_vtx_pos_track_t, pos_trk_gbl->getTrackTime());
+                tuple->set(slots.unc_vtx_pos_track_d0, pos_trk_gbl->getD0());
+                tuple->set(slots.unc_vtx_pos_track_phi0, pos_trk_gbl->getPhi());
+                tuple->set(slots.unc_vtx_pos_track_omega, pos_trk_gbl->getOmega());
+                tuple->set(slots.unc_vtx_pos_track_tanLambda, pos_trk_gbl->getTanLambda());
+                tuple->set(slots.unc_vtx_pos_track_z0, pos_trk_gbl->getZ0());
+                tuple->set(slots.unc_vtx_pos_track_chi2ndf, pos_trk_gbl->getChi2Ndf());
+                tuple->set(slots.unc_vtx_pos_track_clust_dt, pos_trk_clus_dt);
+                tuple->set(slots.unc_vtx_pos_track_z0Err, pos_trk_gbl->getZ0Err());
+                tuple->set(slots.unc_vtx_pos_track_d0Err, pos_trk_gbl->getD0Err());
+                tuple->set(slots.unc_vtx_pos_track_tanLambdaErr, pos_trk_gbl->getTanLambdaErr());
+                tuple->set(slots.unc_vtx_pos_track_PhiErr, pos_trk_gbl->getPhiErr());
+                tuple->set(slots.unc_vtx_pos_track_OmegaErr, pos_trk_gbl->getOmegaErr());
+                tuple->set(slots.unc_vtx_pos_track_L1_isolation, pos_trk_iso_L1);
+                tuple->set(slots.unc_vtx_pos_track_nhits, pos2dHits);
 
                 //clust vars
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_clust_E", eleClus.getEnergy());
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_clust_corr_t",corr_eleClusterTime);
-
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_clust_E", posClus.getEnergy());
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_clust_corr_t",corr_posClusterTime);
-                _reg_tuples[region]->setVariableValue("run_number", evth_->getRunNumber());
-
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_x", ele_trk_gbl->getPosition().at(0));
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_y", ele_trk_gbl->getPosition().at(1));
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_z", ele_trk_gbl->getPosition().at(2));
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_x", pos_trk_gbl->getPosition().at(0));
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_y", pos_trk_gbl->getPosition().at(1));
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_z", pos_trk_gbl->getPosition().at(2));
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_px", ele_trk_gbl->getMomentum().at(0));
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_py", ele_trk_gbl->getMomentum().at(1));
-                _reg_tuples[region]->setVariableValue("unc_vtx_ele_track_pz", ele_trk_gbl->getMomentum().at(2));
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_px", pos_trk_gbl->getMomentum().at(0));
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_py", pos_trk_gbl->getMomentum().at(1));
-                _reg_tuples[region]->setVariableValue("unc_vtx_pos_track_pz", pos_trk_gbl->getMomentum().at(2));
-
-                _reg_tuples[region]->fill();
+                tuple->set(slots.unc_vtx_ele_clust_E, eleClusE);
+                tuple->set(slots.unc_vtx_ele_clust_corr_t, corr_eleClusterTime);
+
+                tuple->set(slots.unc_vtx_pos_clust_E, posClusE);
+                tuple->set(slots.unc_vtx_pos_clust_corr_t, corr_posClusterTime);
+                tuple->set(slots.run_number, evth_->getRunNumber());
+
+                std::vector<double> ele_trk_pos = ele_trk_gbl->getPosition();
+                std::vector<double> pos_trk_pos = pos_trk_gbl->getPosition();
+                tuple->set(slots.unc_vtx_ele_track_x, ele_trk_pos.at(0));
+                tuple->set(slots.unc_vtx_ele_track_y, ele_trk_pos.at(1));
+                tuple->set(slots.unc_vtx_ele_track_z, ele_trk_pos.at(2));
+                tuple->set(slots.unc_vtx_pos_track_x, pos_trk_pos.at(0));
+                tuple->set(slots.unc_vtx_pos_track_y, pos_trk_pos.at(1));
+                tuple->set(slots.unc_vtx_pos_track_z, pos_trk_pos.at(2));
+                tuple->set(slots.unc_vtx_ele_track_px, (*cand)[VertexCandidate::ELE_PX]);
+                tuple->set(slots.unc_vtx_ele_track_py, (*cand)[VertexCandidate::ELE_PY]);
+                tuple->set(slots.unc_vtx_ele_track_pz, (*cand)[VertexCandidate::ELE_PZ]);
+                tuple->set(slots.unc_vtx_pos_track_px, (*cand)[VertexCandidate::POS_PX]);
+                tuple->set(slots.unc_vtx_pos_track_py, (*cand)[VertexCandidate::POS_PY]);
+                tuple->set(slots.unc_vtx_pos_track_pz, (*cand)[VertexCandidate::POS_PZ]);
+
+                tuple->fill();
             }
         }
 
@@ -1354,6 +933,109 @@ bool VertexAnaProcessor::process(IEvent* ievent) {
     return true;
 }
 
+bool VertexAnaProcessor::passVertexPreselection(BaseSelector& selector, const VertexCandidate& cand, double weight) {
+
+    //Ele Track Time
+    if (!selector.passCutLt("eleTrkTime_lt",fabs(cand[VertexCandidate::ELE_TRK_TIME]),weight))
+        return false;
+
+    //Pos Track Time
+    if (!selector.passCutLt("posTrkTime_lt",fabs(cand[VertexCandidate::POS_TRK_TIME]),weight))
+        return false;
+
+    //Ele Track-cluster match
+    if (!selector.passCutLt("eleTrkCluMatch_lt",cand[VertexCandidate::ELE_TRK_CLUS_MATCH],weight))
+        return false;
+
+    //Pos Track-cluster match
+    if (!selector.passCutLt("posTrkCluMatch_lt",cand[VertexCandidate::POS_TRK_CLUS_MATCH],weight))
+        return false;
+
+    //Require Positron Cluster exists
+    if (!selector.passCutGt("posClusE_gt",cand[VertexCandidate::POS_CLUS_E],weight))
+        return false;
+
+    //Require Positron Cluster does NOT exists
+    if (!selector.passCutLt("posClusE_lt",cand[VertexCandidate::POS_CLUS_E],weight))
+        return false;
+
+    //Bottom Cluster Time
+    if (!selector.passCutLt("botCluTime_lt",cand[VertexCandidate::BOT_CLUS_TIME],weight))
+        return false;
+
+    if (!selector.passCutGt("botCluTime_gt",cand[VertexCandidate::BOT_CLUS_TIME],weight))
+        return false;
+
+    //Ele Pos Cluster Time Difference
+    if (!selector.passCutLt("eleposCluTimeDiff_lt",fabs(cand[VertexCandidate::ELE_POS_CLUS_DT]),weight))
+        return false;
+
+    //Ele Track-Cluster Time Difference
+    if (!selector.passCutLt("eleTrkCluTimeDiff_lt",fabs(cand[VertexCandidate::ELE_TRK_CLUS_DT]),weight))
+        return false;
+
+    //Pos Track-Cluster Time Difference
+    if (!selector.passCutLt("posTrkCluTimeDiff_lt",fabs(cand[VertexCandidate::POS_TRK_CLUS_DT]),weight))
+        return false;
+
+    //Ele Track Quality - Chi2
+    if (!selector.passCutLt("eleTrkChi2_lt",cand[VertexCandidate::ELE_CHI2],weight))
+        return false;
+
+    //Pos Track Quality - Chi2
+    if (!selector.passCutLt("posTrkChi2_lt",cand[VertexCandidate::POS_CHI2],weight))
+        return false;
+
+    //Ele Track Quality - Chi2Ndf
+    if (!selector.passCutLt("eleTrkChi2Ndf_lt",cand[VertexCandidate::ELE_CHI2NDF],weight))
+        return false;
+
+    //Pos Track Quality - Chi2Ndf
+    if (!selector.passCutLt("posTrkChi2Ndf_lt",cand[VertexCandidate::POS_CHI2NDF],weight))
+        return false;
+
+    //Beam Electron cut
+    if (!selector.passCutLt("eleMom_lt",cand[VertexCandidate::ELE_P],weight))
+        return false;
+
+    //Ele min momentum cut
+    if (!selector.passCutGt("eleMom_gt",cand[VertexCandidate::ELE_P],weight))
+        return false;
+
+    //Pos min momentum cut
+    if (!selector.passCutGt("posMom_gt",cand[VertexCandidate::POS_P],weight))
+        return false;
+
+    //Ele nHits
+    if (!selector.passCutGt("eleN2Dhits_gt",cand[VertexCandidate::ELE_N2D_HITS],weight))
+        return false;
+
+    //Pos nHits
+    if (!selector.passCutGt("posN2Dhits_gt",cand[VertexCandidate::POS_N2D_HITS],weight))
+        return false;
+
+    //Less than 4 shared hits for ele/pos track
+    if (!selector.passCutLt("eleNshared_lt",cand[VertexCandidate::ELE_NSHARED],weight))
+        return false;
+
+    if (!selector.passCutLt("posNshared_lt",cand[VertexCandidate::POS_NSHARED],weight))
+        return false;
+
+    //Vertex Quality
+    if (!selector.passCutLt("chi2unc_lt",cand.getVertex()->getChi2(),weight))
+        return false;
+
+    //Max vtx momentum
+    if (!selector.passCutLt("maxVtxMom_lt",cand[VertexCandidate::VTX_P],weight))
+        return false;
+
+    //Min vtx momentum
+    if (!selector.passCutGt("minVtxMom_gt",cand[VertexCandidate::VTX_P],weight))
+        return false;
+
+    return true;
+}
+
 void VertexAnaProcessor::finalize() {
 
     //TODO clean this up a little.
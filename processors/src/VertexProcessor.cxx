@@ -4,6 +4,7 @@
  * @author Cameron Bravo, SLAC
  */
 #include "VertexProcessor.h" 
+#include "IndexRefs.h"
 #include "utilities.h"
 
 VertexProcessor::VertexProcessor(const std::string& name, Process& process)
@@ -25,6 +26,7 @@ void VertexProcessor::configure(const ParameterSet& parameters) {
         kinkRelCollLcio_   = parameters.getString("kinkRelCollLcio", kinkRelCollLcio_);
         trkRelCollLcio_    = parameters.getString("trkRelCollLcio", trkRelCollLcio_);
         trackStateLocation_= parameters.getString("trackStateLocation", trackStateLocation_);
+        useIndexRefs_      = parameters.getInteger("useIndexRefs", useIndexRefs_);
         
     }
     catch (std::runtime_error& error)
@@ -35,8 +37,16 @@ void VertexProcessor::configure(const ParameterSet& parameters) {
 
 void VertexProcessor::initialize(TTree* tree) {
     // Add branches to tree
-    tree->Branch(vtxCollRoot_.c_str(),  &vtxs_);
-    tree->Branch(partCollRoot_.c_str(), &parts_);
+    addCollection(tree, vtxCollRoot_, &vtxs_);
+    addCollection(tree, partCollRoot_, &parts_);
+
+    // Let the readers find the collection the indices point into
+    if (useIndexRefs_)
+        IndexRefs::setTarget(tree, vtxCollRoot_, partCollRoot_);
+
+    // Optional input collections
+    kinkRelCollID_ = Event::getLCCollectionID(kinkRelCollLcio_);
+    trkRelCollID_ = Event::getLCCollectionID(trkRelCollLcio_);
 }
 
 bool VertexProcessor::process(IEvent* ievent) {
@@ -64,25 +74,12 @@ bool VertexProcessor::process(IEvent* ievent) {
     }
 
     // Get the collection of LCRelations between GBL tracks and kink data and track data variables.
-    EVENT::LCCollection* gbl_kink_data{nullptr};
-    EVENT::LCCollection* track_data{nullptr};
-        
-    try
-    {
-        if (!kinkRelCollLcio_.empty())
-            gbl_kink_data = static_cast<EVENT::LCCollection*>(event->getLCCollection(kinkRelCollLcio_.c_str()));
-        if (!trkRelCollLcio_.empty())
-            track_data = static_cast<EVENT::LCCollection*>(event->getLCCollection(trkRelCollLcio_.c_str()));
-    }
-    catch (EVENT::DataNotAvailableException e)
-    {
-        std::cout << e.what() << std::endl;
-        if (!gbl_kink_data)
-            std::cout<<"Failed retrieving " << kinkRelCollLcio_ <<std::endl;
-        if (!track_data)
-            std::cout<<"Failed retrieving " << trkRelCollLcio_ <<std::endl;
-        
-    }
+    EVENT::LCCollection* gbl_kink_data = event->tryGetLCCollection(kinkRelCollID_);
+    EVENT::LCCollection* track_data = event->tryGetLCCollection(trkRelCollID_);
+    if (!gbl_kink_data && !kinkRelCollLcio_.empty())
+        std::cout<<"Failed retrieving " << kinkRelCollLcio_ <<std::endl;
+    if (!track_data && !trkRelCollLcio_.empty())
+        std::cout<<"Failed retrieving " << trkRelCollLcio_ <<std::endl;
     
     
     if (debug_ > 0) std::cout << "VertexProcessor: Converting Verteces" << std::endl;
@@ -100,10 +97,14 @@ bool VertexProcessor::process(IEvent* ievent) {
         for(auto lc_part : lc_parts)
         {
            if (debug_ > 0) std::cout << "VertexProcessor: Build particle" << std::endl;
-           Particle * part = utils::buildParticle(lc_part,trackStateLocation_, gbl_kink_data, track_data);
+           Particle * part = utils::buildParticle(lc_part,trackStateLocation_, gbl_kink_data, track_data, 
+                                                &event->getConversionCache());
            if (debug_ > 0) std::cout << "VertexProcessor: Add particle" << std::endl;
+            if (useIndexRefs_)
+                vtx->addParticleIndex(parts_.size());
+            else
+                vtx->addParticle(part);
             parts_.push_back(part);
-            vtx->addParticle(part);
         }
 
         if (debug_ > 0) std::cout << "VertexProcessor: Add Vertex" << std::endl;
@@ -22,6 +22,8 @@ void VtxHistoProcessor::configure(const ParameterSet& parameters) {
         rebin_          = parameters.getInteger("rebin");
         selections_     = parameters.getVString("selections");
         projections_    = parameters.getVString("projections");
+        nThreads_       = parameters.getInteger("nThreads", nThreads_);
+        fastFitEntries_ = parameters.getDouble("fastFitEntries", fastFitEntries_);
     }
     catch (std::runtime_error& error)
     {
@@ -79,7 +81,8 @@ bool VtxHistoProcessor::process() {
         _histos1d[it->first+"_sigma"]->Sumw2();
         
         std::cout<<"Fitting::"<<it->first<<std::endl;
-        HistogramHelpers::profileYwithIterativeGaussFit(it->second,_histos1d[it->first+"_mu"],_histos1d[it->first+"_sigma"],1,0);
+        HistogramHelpers::profileYwithIterativeGaussFit(it->second,_histos1d[it->first+"_mu"],_histos1d[it->first+"_sigma"],1,0,
+                                                        nThreads_,fastFitEntries_);
     }       
     return true;
 }
@@ -56,7 +56,8 @@ Vertex* utils::buildVertex(EVENT::Vertex* lc_vertex) {
 Particle* utils::buildParticle(EVENT::ReconstructedParticle* lc_particle,
         std::string trackstate_location,
         EVENT::LCCollection* gbl_kink_data,
-        EVENT::LCCollection* track_data)
+        EVENT::LCCollection* track_data,
+        LCConversionCache* cache)
 
 { 
 
@@ -88,17 +89,28 @@ Particle* utils::buildParticle(EVENT::ReconstructedParticle* lc_particle,
     // Set the Track for the HpsParticle
     if (lc_particle->getTracks().size()>0)
     {
-        Track * trkPtr = utils::buildTrack(lc_particle->getTracks()[0],trackstate_location, gbl_kink_data, track_data);
-        part->setTrack(trkPtr);
-        delete trkPtr;
+        if (cache) {
+            Track * trkPtr = utils::getTrack(lc_particle->getTracks()[0],trackstate_location, gbl_kink_data, track_data, *cache);
+            if (trkPtr) part->setTrack(trkPtr);
+        }
+        else {
+            Track * trkPtr = utils::buildTrack(lc_particle->getTracks()[0],trackstate_location, gbl_kink_data, track_data);
+            part->setTrack(trkPtr);
+            delete trkPtr;
+        }
     }
 
     // Set the Track for the HpsParticle
     if (lc_particle->getClusters().size() > 0)
     {
-        CalCluster * clusBuf = utils::buildCalCluster(lc_particle->getClusters()[0]);
-        part->setCluster(clusBuf);
-        delete clusBuf;
+        if (cache) {
+            part->setCluster(utils::getCalCluster(lc_particle->getClusters()[0], *cache));
+        }
+        else {
+            CalCluster * clusBuf = utils::buildCalCluster(lc_particle->getClusters()[0]);
+            part->setCluster(clusBuf);
+            delete clusBuf;
+        }
     }
 
     return part;
@@ -140,6 +152,16 @@ CalCluster* utils::buildCalCluster(EVENT::Cluster* lc_cluster)
     return cluster;
 }
 
+CalCluster* utils::getCalCluster(EVENT::Cluster* lc_cluster, LCConversionCache& cache) 
+{ 
+    CalCluster* cluster = cache.getCluster(lc_cluster);
+    if (!cluster && lc_cluster) {
+        cluster = utils::buildCalCluster(lc_cluster);
+        cache.addCluster(lc_cluster, cluster);
+    }
+    return cluster;
+}
+
 bool utils::IsSameTrack(Track* trk1, Track* trk2) {
     double tol = 1e-6;
     if (fabs(trk1->getD0()        - trk2->getD0())        > tol ||
@@ -155,10 +177,25 @@ bool utils::IsSameTrack(Track* trk1, Track* trk2) {
 }
 
 
+Track* utils::getTrack(EVENT::Track* lc_track,
+        std::string trackstate_location,
+        EVENT::LCCollection* gbl_kink_data,
+        EVENT::LCCollection* track_data,
+        LCConversionCache& cache) {
+
+    Track* track = cache.getTrack(lc_track, trackstate_location, gbl_kink_data, track_data);
+    if (!track && lc_track) {
+        track = utils::buildTrack(lc_track, trackstate_location, gbl_kink_data, track_data, &cache);
+        if (track) cache.addTrack(lc_track, trackstate_location, gbl_kink_data, track_data, track);
+    }
+    return track;
+}
+
 Track* utils::buildTrack(EVENT::Track* lc_track,
         std::string trackstate_location,
         EVENT::LCCollection* gbl_kink_data,
-        EVENT::LCCollection* track_data) {
+        EVENT::LCCollection* track_data,
+        LCConversionCache* cache) {
 
     if (!lc_track)
         return nullptr;
@@ -247,8 +284,15 @@ Track* utils::buildTrack(EVENT::Track* lc_track,
 
     if (gbl_kink_data) {
         // Instantiate an LCRelation navigator which will allow faster access 
-        // to GBLKinkData object
-        std::shared_ptr<UTIL::LCRelationNavigator> gbl_kink_data_nav = std::make_shared<UTIL::LCRelationNavigator>(gbl_kink_data);
+        // to GBLKinkData object, or reuse the one of the event if cached
+        std::unique_ptr<UTIL::LCRelationNavigator> own_gbl_kink_data_nav;
+        UTIL::LCRelationNavigator* gbl_kink_data_nav = nullptr;
+        if (cache)
+            gbl_kink_data_nav = cache->getNavigator(gbl_kink_data);
+        else {
+            own_gbl_kink_data_nav.reset(new UTIL::LCRelationNavigator(gbl_kink_data));
+            gbl_kink_data_nav = own_gbl_kink_data_nav.get();
+        }
 
         // Get the list of GBLKinkData associated with the LCIO Track
         EVENT::LCObjectVec gbl_kink_data_list 
@@ -281,8 +325,15 @@ Track* utils::buildTrack(EVENT::Track* lc_track,
     if (track_data) { 
 
         // Instantiate an LCRelation navigator which will allow faster access
-        // to TrackData objects  
-        std::shared_ptr<UTIL::LCRelationNavigator> track_data_nav = std::make_shared<UTIL::LCRelationNavigator>(track_data);
+        // to TrackData objects, or reuse the one of the event if cached
+        std::unique_ptr<UTIL::LCRelationNavigator> own_track_data_nav;
+        UTIL::LCRelationNavigator* track_data_nav = nullptr;
+        if (cache)
+            track_data_nav = cache->getNavigator(track_data);
+        else {
+            own_track_data_nav.reset(new UTIL::LCRelationNavigator(track_data));
+            track_data_nav = own_track_data_nav.get();
+        }
 
         // Get the list of TrackData associated with the LCIO Track
         EVENT::LCObjectVec track_data_list = track_data_nav->getRelatedFromObjects(lc_track);
@@ -337,22 +388,32 @@ Track* utils::buildTrack(EVENT::Track* lc_track,
     return track;
 }
 
+void utils::checkSvtCellID(UTIL::BitField64& decoder, EVENT::long64 value, const cellid::SvtID& id) {
+
+    decoder.setValue(value);
+    if (decoder["system"] != id.system || decoder["barrel"] != id.barrel 
+            || decoder["layer"] != id.layer || decoder["module"] != id.module 
+            || decoder["sensor"] != id.sensor || decoder["side"] != id.side 
+            || decoder["strip"] != id.strip) {
+        throw std::runtime_error("[ utilities ]: Compiled SVT cellid decoder disagrees with BitField64 for cellid " 
+                + std::to_string(value));
+    }
+}
+
 RawSvtHit* utils::buildRawHit(EVENT::TrackerRawData* rawTracker_hit,
         EVENT::LCCollection* raw_svt_hit_fits) {
 
-    EVENT::long64 value =
-        EVENT::long64(rawTracker_hit->getCellID0() & 0xffffffff) |
-        ( EVENT::long64(rawTracker_hit->getCellID1() ) << 32       );
-    decoder.setValue(value);
+    cellid::SvtID id = cellid::Svt::decode(
+            cellid::value(rawTracker_hit->getCellID0(), rawTracker_hit->getCellID1()));
 
     RawSvtHit* rawHit = new RawSvtHit();
-    rawHit->setSystem(decoder["system"]);
-    rawHit->setBarrel(decoder["barrel"]);
-    rawHit->setLayer(decoder["layer"]);
-    rawHit->setModule(decoder["module"]);
-    rawHit->setSensor(decoder["sensor"]);
-    rawHit->setSide(decoder["side"]);
-    rawHit->setStrip(decoder["strip"]);
+    rawHit->setSystem(id.system);
+    rawHit->setBarrel(id.barrel);
+    rawHit->setLayer(id.layer);
+    rawHit->setModule(id.module);
+    rawHit->setSensor(id.sensor);
+    rawHit->setSide(id.side);
+    rawHit->setStrip(id.strip);
 
     // Extract ADC values for this hit
     int hit_adcs[6] = { 
@@ -439,7 +500,8 @@ TrackerHit* utils::buildTrackerHit(IMPL::TrackerHitImpl* lc_tracker_hit, bool ro
 //type 0 rotatedHelicalHit  type 1 SiClusterHit
 bool utils::addRawInfoTo3dHit(TrackerHit* tracker_hit, 
         IMPL::TrackerHitImpl* lc_tracker_hit,
-        EVENT::LCCollection* raw_svt_fits, std::vector<RawSvtHit*>* rawHits,int type, bool storeRawHit) {
+        EVENT::LCCollection* raw_svt_fits, std::vector<RawSvtHit*>* rawHits,int type, bool storeRawHit,
+        int rawHitOffset) {
 
     if (!tracker_hit || !lc_tracker_hit)
         return false;
@@ -450,9 +512,6 @@ bool utils::addRawInfoTo3dHit(TrackerHit* tracker_hit,
     //1-6(7) for rotated  0-13 for SiCluster
     int layer = -1;
 
-    // Get decoders to read cellids
-    UTIL::BitField64 decoder("system:6,barrel:3,layer:4,module:12,sensor:1,side:32:-2,strip:12");
-
     //Get the Raw content of the tracker hits
     EVENT::LCObjectVec lc_rawHits             = lc_tracker_hit->getRawHits();  
 
@@ -462,13 +521,9 @@ bool utils::addRawInfoTo3dHit(TrackerHit* tracker_hit,
         EVENT::TrackerRawData* rawTracker_hit
             = static_cast<EVENT::TrackerRawData*>(lc_rawHits.at(irh));
 
-        //Decode the cellid
-        EVENT::long64 value = EVENT::long64( rawTracker_hit->getCellID0() & 0xffffffff ) |
-            ( EVENT::long64( rawTracker_hit->getCellID1() ) << 32 ) ;
-        decoder.setValue(value);
-
-        //Get rawhit strip number
-        int stripnumber = decoder["strip"];
+        //Get rawhit strip number from the cellid
+        int stripnumber = cellid::Svt::strip::decode(
+                cellid::value(rawTracker_hit->getCellID0(), rawTracker_hit->getCellID1()));
         rawhit_strips.push_back(stripnumber);
 
         //TODO useless to build all of it?
@@ -493,7 +548,10 @@ bool utils::addRawInfoTo3dHit(TrackerHit* tracker_hit,
         }
 
         if(storeRawHit){
-            tracker_hit->addRawHit(rawHit);
+            if (rawHitOffset >= 0 && rawHits)
+                tracker_hit->addRawHitIndex(rawHitOffset + rawHits->size());
+            else
+                tracker_hit->addRawHit(rawHit);
             if (rawHits)
                 rawHits->push_back(rawHit);
         }
@@ -538,15 +596,18 @@ bool utils::isUsedByTrack(TrackerHit* tracker_hit,
 }
 
 
-bool utils::getParticlesFromVertex(Vertex* vtx, Particle* ele, Particle* pos) {
+bool utils::getParticlesFromVertex(Vertex* vtx, Particle* ele, Particle* pos, 
+        const std::vector<Particle*>* parts) {
 
-    for (int ipart = 0; ipart < vtx->getParticles().GetEntries(); ++ipart) {
-        int pdg_id = ((Particle*)vtx->getParticles().At(ipart))->getPDG();
+    for (int ipart = 0; ipart < vtx->getNParticles(); ++ipart) {
+        Particle* part = vtx->getParticle(ipart, parts);
+        if (!part) continue;
+        int pdg_id = part->getPDG();
         if (pdg_id == 11) {
-            ele = (Particle*)vtx->getParticles().At(ipart);
+            ele = part;
         }
         else if (pdg_id == -11) {
-            pos = (Particle*)vtx->getParticles().At(ipart);
+            pos = part;
         }
 
         else {
@@ -563,12 +624,15 @@ bool utils::getParticlesFromVertex(Vertex* vtx, Particle* ele, Particle* pos) {
     return true;
 }
 
-double utils::getKalmanTrackL1Isolations(Track* track, std::vector<TrackerHit*>* siClusters){
+double utils::getKalmanTrackL1Isolations(Track* track, std::vector<TrackerHit*>* siClusters,
+        const std::vector<TrackerHit*>* hits){
     double L1_axial_iso = 999999.9;
     double L1_stereo_iso = 999999.9;
     //Loop over hits on track
-    for(int i = 0; i < track->getSvtHits().GetEntries(); i++){
-        TrackerHit* track_hit = (TrackerHit*)track->getSvtHits().At(i);
+    for(int i = 0; i < track->getNSvtHits(); i++){
+        TrackerHit* track_hit = track->getSvtHit(i, hits);
+        if (!track_hit)
+            continue;
         //Track hit info
         int trackhit_id = track_hit->getID();
         int trackhit_layer = track_hit->getLayer();
@@ -671,210 +735,85 @@ double utils::getKalmanTrackL1Isolations(Track* track, std::vector<TrackerHit*>*
 }
 
 void utils::get2016KFMCTruthHitCodes(Track* ele_trk, Track* pos_trk, std::vector<TrackerHit*>* hits, int& L1L2hitCode, int& L1hitCode, int& L2hitCode){
-    //Build map of hits and the associated MC part ids for later
-    TRefArray ele_trk_hits = ele_trk->getSvtHits();
-    TRefArray pos_trk_hits = pos_trk->getSvtHits();
-    std::map<int, std::vector<int> > trueHitIDs;
-    for(int i = 0; i < hits->size(); i++)
-    {
-        TrackerHit* hit = hits->at(i);
-        trueHitIDs[hit->getID()] = hit->getMCPartIDs();
-    }
-    //Count the number of hits per part on the ele track
-    std::map<int, int> nHits4part_ele;
-    for(int i = 0; i < ele_trk_hits.GetEntries(); i++)
-    {
-        TrackerHit* eleHit = (TrackerHit*)ele_trk_hits.At(i);
-        for(int idI = 0; idI < trueHitIDs[eleHit->getID()].size(); idI++ )
-        {
-            int partID = trueHitIDs[eleHit->getID()].at(idI);
-            if ( nHits4part_ele.find(partID) == nHits4part_ele.end() )
-            {
-                // not found
-                nHits4part_ele[partID] = 1;
-            }
-            else
-            {
-                // found
-                nHits4part_ele[partID]++;
-            }
-        }
-    }
+    //Build index of hits and the associated MC part ids
+    MCTruthIndex truthIndex;
+    truthIndex.build(hits, nullptr);
+    get2016KFMCTruthHitCodes(ele_trk, pos_trk, hits, truthIndex, L1L2hitCode, L1hitCode, L2hitCode);
+}
+
+/**
+ * @brief Flag the L1 and L2 axial and stereo hits of a KF track that come 
+ *        from the MC particle with the most hits on the track
+ */
+static void getKFTrackTruthLayers(Track* trk, std::vector<TrackerHit*>* hits, const MCTruthIndex& truthIndex,
+                                  bool& trueAxialL1, bool& trueStereoL1, bool& trueAxialL2, bool& trueStereoL2){
+    trueAxialL1 = false;
+    trueStereoL1 = false;
+    trueAxialL2 = false;
+    trueStereoL2 = false;
+    if (!trk->isKalmanTrack()) return;
 
     //Determine the MC part with the most hits on the track
-    int maxNHits_ele = 0;
-    int maxID_ele = 0;
-    for (std::map<int,int>::iterator it=nHits4part_ele.begin(); it!=nHits4part_ele.end(); ++it)
-    {
-        if(it->second > maxNHits_ele)
-        {
-            maxNHits_ele = it->second;
-            maxID_ele = it->first;
-        }
-    }
+    int maxID = truthIndex.getMajorityParticle(trk, hits);
 
-    //Count the number of hits per part on the pos track
-    std::map<int, int> nHits4part_pos;
-    for(int i = 0; i < pos_trk_hits.GetEntries(); i++)
+    for(int i = 0; i < trk->getNSvtHits(); i++)
     {
-        TrackerHit* posHit = (TrackerHit*)pos_trk_hits.At(i);
-        for(int idI = 0; idI < trueHitIDs[posHit->getID()].size(); idI++ )
-        {
-            int partID = trueHitIDs[posHit->getID()].at(idI);
-            if ( nHits4part_pos.find(partID) == nHits4part_pos.end() )
-            {
-                // not found
-                nHits4part_pos[partID] = 1;
-            }
+        TrackerHit* hit = trk->getSvtHit(i, hits);
+        if (!hit)
+            continue;
+        int trackhit_layer = hit->getLayer();
+        int trackhit_volume = hit->getVolume();
+        bool isAxial = false;
+        bool isStereo = false; 
+        bool isL1 = false;
+        bool isL2 = false;
+
+        //L1 and L2 only
+        if(trackhit_layer < 2)
+            isL1 = true;
+        else if(trackhit_layer > 1 && trackhit_layer < 4)
+            isL2 = true;
+        else
+            continue;
+
+        if(trackhit_volume == 1){
+            if(trackhit_layer%2 == 1)
+                isAxial = true;
             else
-            {
-                // found
-                nHits4part_pos[partID]++;
-            }
+                isStereo = true;
         }
-    }
-
-    //Determine the MC part with the most hits on the track
-    int maxNHits_pos = 0;
-    int maxID_pos = 0;
-    for (std::map<int,int>::iterator it=nHits4part_pos.begin(); it!=nHits4part_pos.end(); ++it)
-    {
-        if(it->second > maxNHits_pos)
-        {
-            maxNHits_pos = it->second;
-            maxID_pos = it->first;
+        if(trackhit_volume == 0){
+            if(trackhit_layer%2 == 0)
+                isAxial = true;
+            else
+                isStereo = true;
         }
-    }
 
-    //Determine Ele L1 and L2 truth information
-    bool ele_trueAxialL1 = false;
-    bool ele_trueStereoL1 = false;
-    bool ele_trueAxialL2 = false;
-    bool ele_trueStereoL2 = false;
-    bool pos_trueAxialL1 = false;
-    bool pos_trueStereoL1 = false;
-    bool pos_trueAxialL2 = false;
-    bool pos_trueStereoL2 = false;
-    if (ele_trk->isKalmanTrack()){
-
-        for(int i = 0; i < ele_trk_hits.GetEntries(); i++)
-        {
-            TrackerHit* hit = (TrackerHit*)ele_trk_hits.At(i);
-            int trackhit_layer = hit->getLayer();
-            int trackhit_volume = hit->getVolume();
-            bool isAxial = false;
-            bool isStereo = false; 
-            bool isL1 = false;
-            bool isL2 = false;
-            bool isGood = false;
-
-            //L1 and L2 only
-            if(trackhit_layer < 2)
-                isL1 = true;
-            else if(trackhit_layer > 1 && trackhit_layer < 4)
-                isL2 = true;
-            else
-                continue;
+        //Check if truth hit is from truth track MCP
+        if(!truthIndex.hasMCPart(hit->getID(), maxID)) continue;
 
-            if(trackhit_volume == 1){
-                if(trackhit_layer%2 == 1)
-                    isAxial = true;
-                else
-                    isStereo = true;
-            }
-            if(trackhit_volume == 0){
-                if(trackhit_layer%2 == 0)
-                    isAxial = true;
-                else
-                    isStereo = true;
-            }
-            //Check if truth hit is from truth track MCP
-            for(int idI = 0; idI < trueHitIDs[hit->getID()].size(); idI++ )
-            {
-                int partID = trueHitIDs[hit->getID()].at(idI);
-                //hit is from best track MCP
-                if(partID == maxID_ele){
-                    isGood = true;
-                }
-            }
-
-            if(isGood){
-                if(isAxial){
-                    if(isL1)
-                        ele_trueAxialL1 = true;
-                    if(isL2)
-                        ele_trueAxialL2 = true;
-                }
-                if(isStereo){
-                    if(isL1)
-                        ele_trueStereoL1 = true;
-                    if(isL2)
-                        ele_trueStereoL2 = true;
-                }
-            }
+        if(isAxial){
+            if(isL1)
+                trueAxialL1 = true;
+            if(isL2)
+                trueAxialL2 = true;
+        }
+        if(isStereo){
+            if(isL1)
+                trueStereoL1 = true;
+            if(isL2)
+                trueStereoL2 = true;
         }
     }
+}
 
-    //Positron
-    if (pos_trk->isKalmanTrack()){
-
-        for(int i = 0; i < pos_trk_hits.GetEntries(); i++)
-        {
-            TrackerHit* hit = (TrackerHit*)pos_trk_hits.At(i);
-            int trackhit_layer = hit->getLayer();
-            int trackhit_volume = hit->getVolume();
-            bool isAxial = false;
-            bool isStereo = false; 
-            bool isL1 = false;
-            bool isL2 = false;
-            bool isGood = false;
-
-            //L1 and L2 only
-            if(trackhit_layer < 2)
-                isL1 = true;
-            else if(trackhit_layer > 1 && trackhit_layer < 4)
-                isL2 = true;
-            else
-                continue;
-
-            if(trackhit_volume == 1){
-                if(trackhit_layer%2 == 1)
-                    isAxial = true;
-                else
-                    isStereo = true;
-            }
-            if(trackhit_volume == 0){
-                if(trackhit_layer%2 == 0)
-                    isAxial = true;
-                else
-                    isStereo = true;
-            }
-            //Check if truth hit is from truth track MCP
-            for(int idI = 0; idI < trueHitIDs[hit->getID()].size(); idI++ )
-            {
-                int partID = trueHitIDs[hit->getID()].at(idI);
-                //hit is from best track MCP
-                if(partID == maxID_pos){
-                    isGood = true;
-                }
-            }
+void utils::get2016KFMCTruthHitCodes(Track* ele_trk, Track* pos_trk, std::vector<TrackerHit*>* hits, const MCTruthIndex& truthIndex, int& L1L2hitCode, int& L1hitCode, int& L2hitCode){
+    //Determine Ele and Pos L1 and L2 truth information
+    bool ele_trueAxialL1, ele_trueStereoL1, ele_trueAxialL2, ele_trueStereoL2;
+    bool pos_trueAxialL1, pos_trueStereoL1, pos_trueAxialL2, pos_trueStereoL2;
+    getKFTrackTruthLayers(ele_trk, hits, truthIndex, ele_trueAxialL1, ele_trueStereoL1, ele_trueAxialL2, ele_trueStereoL2);
+    getKFTrackTruthLayers(pos_trk, hits, truthIndex, pos_trueAxialL1, pos_trueStereoL1, pos_trueAxialL2, pos_trueStereoL2);
 
-            if(isGood){
-                if(isAxial){
-                    if(isL1)
-                        pos_trueAxialL1 = true;
-                    if(isL2)
-                        pos_trueAxialL2 = true;
-                }
-                if(isStereo){
-                    if(isL1)
-                        pos_trueStereoL1 = true;
-                    if(isL2)
-                        pos_trueStereoL2 = true;
-                }
-            }
-        }
-    }
     //Require both Axial and Stereo truth hits to be 'Good' hit
     if(ele_trueAxialL1 && ele_trueStereoL1) L1L2hitCode = L1L2hitCode | (0x1 << 3);           
     if(pos_trueAxialL1 && pos_trueStereoL1) L1L2hitCode = L1L2hitCode | (0x1 << 2);           
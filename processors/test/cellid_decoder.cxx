@@ -0,0 +1,86 @@
+/**
+ * @file cellid_decoder.cxx
+ * @brief Check the compile time cell ID decoders against LCIO's BitField64.
+ */
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+
+//----------//
+//   LCIO   //
+//----------//
+#include <UTIL/BitField64.h>
+
+//-----------//
+//   hpstr   //
+//-----------//
+#include "CellIDDecoder.h"
+
+namespace {
+
+    int failures{0};
+
+    void check(const std::string& what, std::int64_t value, int decoded,
+            UTIL::BitField64& reference, const std::string& field) {
+        int expected = int(reference[field].value());
+        if (decoded == expected) return;
+        ++failures;
+        std::cerr << "---- [ cellid-decoder ]: " << what << " " << field << " of 0x"
+            << std::hex << value << std::dec << " is " << decoded
+            << ", BitField64 gives " << expected << std::endl;
+    }
+}
+
+int main(int, char**) {
+
+    UTIL::BitField64 svt("system:6,barrel:3,layer:4,module:12,sensor:1,side:32:-2,strip:12");
+    UTIL::BitField64 ecal("system:6,layer:2,ix:-8,iy:-6");
+    UTIL::BitField64 hodo("system:6,barrel:3,layer:4,ix:4,iy:-3,hole:-3");
+
+    // Random IDs cover every bit pattern of the fields, signed ones included
+    std::mt19937 rng(4242);
+    std::uniform_int_distribution<std::uint32_t> word;
+    for (int i = 0; i < 100000; ++i) {
+        std::int64_t value = cellid::value(int(word(rng)), int(word(rng)));
+
+        svt.setValue(value);
+        cellid::SvtID svt_id = cellid::Svt::decode(value);
+        check("SVT", value, svt_id.system, svt, "system");
+        check("SVT", value, svt_id.barrel, svt, "barrel");
+        check("SVT", value, svt_id.layer, svt, "layer");
+        check("SVT", value, svt_id.module, svt, "module");
+        check("SVT", value, svt_id.sensor, svt, "sensor");
+        check("SVT", value, svt_id.side, svt, "side");
+        check("SVT", value, svt_id.strip, svt, "strip");
+
+        ecal.setValue(value);
+        cellid::EcalID ecal_id = cellid::Ecal::decode(value);
+        check("ECal", value, ecal_id.system, ecal, "system");
+        check("ECal", value, ecal_id.layer, ecal, "layer");
+        check("ECal", value, ecal_id.ix, ecal, "ix");
+        check("ECal", value, ecal_id.iy, ecal, "iy");
+
+        hodo.setValue(value);
+        cellid::HodoID hodo_id = cellid::Hodo::decode(value);
+        check("Hodo", value, hodo_id.system, hodo, "system");
+        check("Hodo", value, hodo_id.barrel, hodo, "barrel");
+        check("Hodo", value, hodo_id.layer, hodo, "layer");
+        check("Hodo", value, hodo_id.ix, hodo, "ix");
+        check("Hodo", value, hodo_id.iy, hodo, "iy");
+        check("Hodo", value, hodo_id.hole, hodo, "hole");
+
+        if (failures > 20) break;
+    }
+
+    if (failures) {
+        std::cerr << "---- [ cellid-decoder ]: " << failures << " mismatches" << std::endl;
+        return 1;
+    }
+    std::cout << "---- [ cellid-decoder ]: OK" << std::endl;
+    return 0;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file trigger_selection.cxx
+ * @brief Check the trigger masks of TriggerSelection against the trigger
+ *        maps SvtBl2DAnaProcessor used to build for every event.
+ */
+
+//----------------//
+//   C++ StdLib   //
+//----------------//
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+//-----------//
+//   hpstr   //
+//-----------//
+#include "TSData.h"
+#include "TriggerSelection.h"
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+namespace {
+
+    int failures{0};
+
+    void check(bool ok, const std::string& what) {
+        if (ok) return;
+        ++failures;
+        std::cerr << "---- [ trigger-selection ]: " << what << std::endl;
+    }
+
+    /** Names of the trigger bits, as the keys of the trigger configurations */
+    const std::string names[TriggerSelection::N_TRIGGER_BITS] = {
+        "Single_0_Top", "Single_1_Top", "Single_2_Top", "Single_3_Top",
+        "Single_0_Bot", "Single_1_Bot", "Single_2_Bot", "Single_3_Bot",
+        "Pair_0", "Pair_1", "Pair_2", "Pair_3", "LED", "Cosmic", "Hodoscope",
+        "Pulser", "Mult_0", "Mult_1", "FEE_Top", "FEE_Bot"
+    };
+
+    /** Fill the bits of a TS word from its full word, as EventProcessor does */
+    void setBits(TSData::tsBits& bits, unsigned int word) {
+        bits.intval = word;
+        bool* flags[TriggerSelection::N_TRIGGER_BITS] = {
+            &bits.Single_0_Top, &bits.Single_1_Top, &bits.Single_2_Top, &bits.Single_3_Top,
+            &bits.Single_0_Bot, &bits.Single_1_Bot, &bits.Single_2_Bot, &bits.Single_3_Bot,
+            &bits.Pair_0, &bits.Pair_1, &bits.Pair_2, &bits.Pair_3, &bits.LED, &bits.Cosmic,
+            &bits.Hodoscope, &bits.Pulser, &bits.Mult_0, &bits.Mult_1, &bits.FEE_Top, &bits.FEE_Bot
+        };
+        for (int bit = 0; bit < TriggerSelection::N_TRIGGER_BITS; ++bit)
+            *flags[bit] = (word >> bit) & 0x1;
+    }
+
+    /** The former selection: any configured trigger set in either word, whatever its status */
+    bool mapSelection(const json& triggers, const TSData& tsdata) {
+        std::map<std::string, bool> prescaled, ext;
+        for (int bit = 0; bit < TriggerSelection::N_TRIGGER_BITS; ++bit) {
+            prescaled[names[bit]] = (tsdata.prescaled.intval >> bit) & 0x1;
+            ext[names[bit]] = (tsdata.ext.intval >> bit) & 0x1;
+        }
+        for (auto& trigger : triggers.items()) {
+            if (prescaled[trigger.key()] || ext[trigger.key()])
+                return true;
+        }
+        return false;
+    }
+
+    /** Random configurations and words give the same decisions as the trigger maps */
+    void checkAgainstMaps() {
+        std::mt19937 rng(4321);
+        std::uniform_int_distribution<unsigned int> word(0, 0xffffffff);
+        for (int icfg = 0; icfg < 200; ++icfg) {
+            json triggers = json::object();
+            json enabled = json::object();
+            unsigned int used = word(rng);
+            for (int bit = 0; bit < TriggerSelection::N_TRIGGER_BITS; ++bit) {
+                if (!((used >> bit) & 0x1))
+                    continue;
+                int status = (used >> (bit+1)) & 0x1;
+                triggers[names[bit]] = {{"status", status}};
+                if (status)
+                    enabled[names[bit]] = {{"status", status}};
+            }
+
+            TriggerSelection selection;
+            selection.load(triggers);
+            TriggerSelection withStatus;
+            withStatus.setUseStatus(true);
+            withStatus.load(triggers);
+
+            std::string what = "configuration " + triggers.dump();
+            for (int ievent = 0; ievent < 200; ++ievent) {
+                TSData tsdata;
+                // Sparse words, so that some events fire none of the triggers
+                setBits(tsdata.prescaled, word(rng) & word(rng) & word(rng));
+                setBits(tsdata.ext, word(rng) & word(rng) & word(rng));
+                check(selection.pass(&tsdata) == mapSelection(triggers, tsdata),
+                        what + ": differs from the trigger maps");
+                check(withStatus.pass(&tsdata) == mapSelection(enabled, tsdata),
+                        what + ": status not honoured");
+            }
+        }
+    }
+
+    /** Masks of the trigger words, names and options */
+    void checkMasks() {
+        TriggerSelection selection;
+        selection.load(json{{"Single_0_Top", {{"status", 1}}}, {"Pair_0      ", {{"bits", "prescaled"}}},
+                {"FEE_Bot", {{"bits", "ext"}, {"status", 0}}}});
+        check(selection.getPrescaledMask() == ((1u << 0) | (1u << 8)), "wrong prescaled mask");
+        check(selection.getExtMask() == ((1u << 0) | (1u << 19)), "wrong ext mask");
+
+        check(TriggerSelection::getBit("  Hodoscope ") == 14, "padded name not found");
+        check(TriggerSelection::getBit("Random") == -1, "unknown name found");
+        check(TriggerSelection::getBit("   ") == -1, "blank name found");
+
+        bool thrown = false;
+        try {
+            selection.load(json{{"Random", {{"status", 1}}}});
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        check(thrown, "unknown trigger accepted");
+
+        thrown = false;
+        try {
+            selection.load(json{{"LED", {{"bits", "both words"}}}});
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+        check(thrown, "unknown bits accepted");
+    }
+
+    /** Without a configuration all events are rejected, unless asked otherwise */
+    void checkEmpty() {
+        TSData tsdata;
+        setBits(tsdata.prescaled, 0xfffff);
+        setBits(tsdata.ext, 0xfffff);
+
+        TriggerSelection selection;
+        check(selection.empty(), "new selection not empty");
+        check(!selection.pass(&tsdata), "empty selection accepts events");
+        selection.setAcceptAll(true);
+        check(selection.pass(&tsdata), "empty selection rejects events with setAcceptAll");
+
+        setBits(tsdata.prescaled, 0);
+        setBits(tsdata.ext, 0);
+        check(selection.pass(&tsdata), "empty selection rejects events without triggers with setAcceptAll");
+        selection.load(json{{"LED", {{"status", 1}}}});
+        check(!selection.pass(&tsdata), "loaded selection still accepts all events");
+
+        TriggerSelection disabled;
+        disabled.setUseStatus(true);
+        disabled.load(json{{"LED", {{"status", 0}}}});
+        setBits(tsdata.prescaled, 0xfffff);
+        check(!disabled.empty() && !disabled.pass(&tsdata), "selection disabling every trigger accepts events");
+    }
+}
+
+int main(int, char**) {
+    checkAgainstMaps();
+    checkMasks();
+    checkEmpty();
+
+    if (failures) {
+        std::cerr << "---- [ trigger-selection ]: " << failures << " failures" << std::endl;
+        return 1;
+    }
+    std::cout << "---- [ trigger-selection ]: OK" << std::endl;
+    return 0;
+}